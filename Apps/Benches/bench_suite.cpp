@@ -0,0 +1,331 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+
+#include "Container/attributeContainer.h"
+
+#include "Algo/Tiling/Surface/triangular.h"
+#include "Algo/Import/import.h"
+#include "Algo/Export/export.h"
+#include "Algo/Geometry/normal.h"
+#include "Algo/Geometry/curvature.h"
+#include "Algo/Modelisation/subdivision.h"
+#include "Algo/Modelisation/planeCutting.h"
+#include "Algo/Decimation/decimation.h"
+#include "Algo/MC/marchingcube.h"
+
+#include "Utils/benchmark.h"
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_DOUBLE
+{
+	// definition of the map
+	typedef EmbeddedMap2 MAP ;
+};
+
+typedef PFP::MAP MAP ;
+typedef PFP::VEC3 VEC3 ;
+typedef PFP::REAL REAL ;
+
+/**
+ * synthetic mesh : closed triangulated torus of size x size vertices
+ */
+void buildTore(MAP& map, VertexAttribute<VEC3, MAP>& position, unsigned int size)
+{
+	map.clear(false) ;
+	position = map.getAttribute<VEC3, VERTEX, MAP>("position") ;
+	if (!position.isValid())
+		position = map.addAttribute<VEC3, VERTEX, MAP>("position") ;
+	Algo::Surface::Tilings::Triangular::Tore<PFP> tore(map, size, size) ;
+	tore.embedIntoTore(position, 3.0f, 1.0f) ;
+}
+
+template <TraversalOptim OPT>
+void benchTraversal(Utils::Benchmark& bench, MAP& map, VertexAttribute<VEC3, MAP>& position, unsigned int size, const std::string& optName)
+{
+	bench.run("traversal/vertex_" + optName, size, [&] ()
+	{
+		VEC3 sum(0) ;
+		foreach_cell<VERTEX>(map, [&] (Vertex v) { sum += position[v] ; }, OPT) ;
+		Utils::doNotOptimize(sum) ;
+	});
+	bench.run("traversal/edge_" + optName, size, [&] ()
+	{
+		VEC3 sum(0) ;
+		foreach_cell<EDGE>(map, [&] (Edge e) { sum += position[e.dart] ; }, OPT) ;
+		Utils::doNotOptimize(sum) ;
+	});
+	bench.run("traversal/face_" + optName, size, [&] ()
+	{
+		VEC3 sum(0) ;
+		foreach_cell<FACE>(map, [&] (Face f) { sum += position[f.dart] ; }, OPT) ;
+		Utils::doNotOptimize(sum) ;
+	});
+}
+
+void usage(const char* prog)
+{
+	CGoGNout << "usage: " << prog << " [options]" << CGoGNendl ;
+	CGoGNout << "  -s size       resolution of the generated meshes (default 200)" << CGoGNendl ;
+	CGoGNout << "  -r runs       number of measured runs (default 10)" << CGoGNendl ;
+	CGoGNout << "  -w warmup     number of warm-up runs (default 2)" << CGoGNendl ;
+	CGoGNout << "  -f filter     only run benchmarks whose name contains filter" << CGoGNendl ;
+	CGoGNout << "  -j file.json  save results as JSON" << CGoGNendl ;
+	CGoGNout << "  -c file.csv   save results as CSV" << CGoGNendl ;
+	CGoGNout << "  -b file.csv   compare with a baseline CSV (exit code = number of regressions)" << CGoGNendl ;
+	CGoGNout << "  -t tolerance  relative slowdown of the median reported as regression (default 0.1)" << CGoGNendl ;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned int size = 200 ;
+	unsigned int nbRuns = 10 ;
+	unsigned int nbWarmup = 2 ;
+	double tolerance = 0.1 ;
+	std::string filter, jsonFile, csvFile, baselineFile ;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (i + 1 >= argc || argv[i][0] != '-' || strlen(argv[i]) != 2)
+		{
+			usage(argv[0]) ;
+			return 1 ;
+		}
+		const char* val = argv[++i] ;
+		switch (argv[i-1][1])
+		{
+			case 's': size = atoi(val) ; break ;
+			case 'r': nbRuns = atoi(val) ; break ;
+			case 'w': nbWarmup = atoi(val) ; break ;
+			case 'f': filter = val ; break ;
+			case 'j': jsonFile = val ; break ;
+			case 'c': csvFile = val ; break ;
+			case 'b': baselineFile = val ; break ;
+			case 't': tolerance = atof(val) ; break ;
+			default: usage(argv[0]) ; return 1 ;
+		}
+	}
+	if (size < 4)
+		size = 4 ;
+
+	Utils::Benchmark bench("cgogn", nbRuns, nbWarmup) ;
+	bench.setFilter(filter) ;
+
+	MAP map ;
+	VertexAttribute<VEC3, MAP> position ;
+	buildTore(map, position, size) ;
+	const unsigned int nbVertices = size * size ;
+
+	// container operations
+	{
+		AttributeContainer cont ;
+		AttributeMultiVector<VEC3>* att = cont.addAttribute<VEC3>("position") ;
+		bench.run("container/insert_lines", size, [&] () { cont.clear(false) ; }, [&] ()
+		{
+			for (unsigned int i = 0; i < nbVertices; ++i)
+				(*att)[cont.insertLine()] = VEC3(REAL(i)) ;
+		});
+		bench.run("container/remove_lines", size, [&] ()
+		{
+			cont.clear(false) ;
+			for (unsigned int i = 0; i < nbVertices; ++i)
+				cont.insertLine() ;
+		}, [&] ()
+		{
+			for (unsigned int i = 0; i < nbVertices; i += 2)
+				cont.removeLine(i) ;
+		});
+	}
+	VertexAttribute<VEC3, MAP> position2 = map.addAttribute<VEC3, VERTEX, MAP>("position2") ;
+	bench.run("container/copy_attribute", size, [&] () { map.copyAttribute(position2, position) ; }) ;
+	bench.run("container/add_remove_attribute", size, [&] ()
+	{
+		VertexAttribute<REAL, MAP> tmp = map.addAttribute<REAL, VERTEX, MAP>("tmp") ;
+		map.removeAttribute(tmp) ;
+	});
+
+	// traversals
+	benchTraversal<AUTO>(bench, map, position, size, "auto") ;
+	benchTraversal<FORCE_DART_MARKING>(bench, map, position, size, "dart_marking") ;
+	benchTraversal<FORCE_CELL_MARKING>(bench, map, position, size, "cell_marking") ;
+	map.enableQuickTraversal<MAP, VERTEX>() ;
+	map.enableQuickTraversal<MAP, EDGE>() ;
+	map.enableQuickTraversal<MAP, FACE>() ;
+	benchTraversal<FORCE_QUICK_TRAVERSAL>(bench, map, position, size, "quick") ;
+	map.disableQuickTraversal<VERTEX>() ;
+	map.disableQuickTraversal<EDGE>() ;
+	map.disableQuickTraversal<FACE>() ;
+	bench.run("traversal/vertex_parallel", size, [&] ()
+	{
+		CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int) { position2[v] = position[v] * REAL(2) ; }) ;
+	});
+	bench.run("traversal/one_ring", size, [&] ()
+	{
+		VEC3 sum(0) ;
+		foreach_cell<VERTEX>(map, [&] (Vertex v)
+		{
+			foreach_adjacent2<EDGE>(map, v, [&] (Vertex w) { sum += position[w] ; }) ;
+		});
+		Utils::doNotOptimize(sum) ;
+	});
+
+	// markers
+	bench.run("marker/dart_marker_vertex_orbits", size, [&] ()
+	{
+		DartMarker<MAP> dm(map) ;
+		foreach_cell<VERTEX>(map, [&] (Vertex v) { dm.markOrbit(v) ; }, FORCE_CELL_MARKING) ;
+	});
+	bench.run("marker/dart_marker_store_vertex_orbits", size, [&] ()
+	{
+		DartMarkerStore<MAP> dm(map) ;
+		foreach_cell<VERTEX>(map, [&] (Vertex v) { dm.markOrbit(v) ; }, FORCE_CELL_MARKING) ;
+	});
+	bench.run("marker/cell_marker_vertex", size, [&] ()
+	{
+		CellMarker<MAP, VERTEX> cm(map) ;
+		foreach_cell<VERTEX>(map, [&] (Vertex v) { cm.mark(v) ; }, FORCE_CELL_MARKING) ;
+	});
+	bench.run("marker/cell_marker_store_vertex", size, [&] ()
+	{
+		CellMarkerStore<MAP, VERTEX> cm(map) ;
+		foreach_cell<VERTEX>(map, [&] (Vertex v) { cm.mark(v) ; }, FORCE_CELL_MARKING) ;
+	});
+	map.removeAttribute(position2) ;
+
+	// import
+	const std::string offFile("bench_suite_tmp.off") ;
+	if (bench.isSelected("import/off"))
+	{
+		Algo::Surface::Export::exportOFF<PFP>(map, position, offFile.c_str()) ;
+		MAP importMap ;
+		bench.run("import/off", size, [&] () { importMap.clear(true) ; }, [&] ()
+		{
+			std::vector<std::string> attrNames ;
+			Algo::Surface::Import::importMesh<PFP>(importMap, offFile, attrNames) ;
+		});
+		remove(offFile.c_str()) ;
+	}
+
+	// geometry
+	VertexAttribute<VEC3, MAP> normal = map.addAttribute<VEC3, VERTEX, MAP>("normal") ;
+	bench.run("geometry/normals", size, [&] ()
+	{
+		Algo::Surface::Geometry::computeNormalVertices<PFP>(map, position, normal) ;
+	});
+	if (bench.isSelected("geometry/curvature_quadratic_fitting"))
+	{
+		Algo::Surface::Geometry::computeNormalVertices<PFP>(map, position, normal) ;
+		VertexAttribute<REAL, MAP> kmax = map.addAttribute<REAL, VERTEX, MAP>("kmax") ;
+		VertexAttribute<REAL, MAP> kmin = map.addAttribute<REAL, VERTEX, MAP>("kmin") ;
+		VertexAttribute<VEC3, MAP> Kmax = map.addAttribute<VEC3, VERTEX, MAP>("Kmax") ;
+		VertexAttribute<VEC3, MAP> Kmin = map.addAttribute<VEC3, VERTEX, MAP>("Kmin") ;
+		bench.run("geometry/curvature_quadratic_fitting", size, [&] ()
+		{
+			Algo::Surface::Geometry::computeCurvatureVertices_QuadraticFitting<PFP>(map, position, normal, kmax, kmin, Kmax, Kmin) ;
+		});
+		map.removeAttribute(kmax) ;
+		map.removeAttribute(kmin) ;
+		map.removeAttribute(Kmax) ;
+		map.removeAttribute(Kmin) ;
+	}
+	map.removeAttribute(normal) ;
+
+	// modifications (the mesh is rebuilt before each run)
+	bench.run("modelisation/loop_subdivision", size, [&] () { buildTore(map, position, size) ; }, [&] ()
+	{
+		Algo::Surface::Modelisation::LoopSubdivision<PFP>(map, position) ;
+	});
+	bench.run("decimation/qem_10_percent", size, [&] () { buildTore(map, position, size) ; }, [&] ()
+	{
+		std::vector<VertexAttribute<VEC3, MAP> > attribs ;
+		attribs.push_back(position) ;
+		Algo::Surface::Decimation::decimate<PFP>(map, Algo::Surface::Decimation::S_QEM, Algo::Surface::Decimation::A_QEM, attribs, nbVertices / 10) ;
+	});
+
+	// plane cutting: serial, parallel pipeline, and a stack of 64 contours without modification
+	const Geom::Plane3D<REAL> cutPlane(VEC3(0.3, 0.2, 1.0).normalized(), VEC3(0.1, 0.05, 0.3)) ;
+	bench.run("modelisation/plane_cut", size, [&] () { buildTore(map, position, size) ; }, [&] ()
+	{
+		CellMarker<MAP, FACE> over(map) ;
+		Algo::Surface::Modelisation::planeCut<PFP>(map, position, cutPlane, over) ;
+	});
+	bench.run("modelisation/plane_cut_parallel", size, [&] () { buildTore(map, position, size) ; }, [&] ()
+	{
+		CellMarker<MAP, FACE> over(map) ;
+		Algo::Surface::Modelisation::Parallel::planeCut<PFP>(map, position, cutPlane, over) ;
+	});
+	if (bench.isSelected("modelisation/plane_slices_64"))
+	{
+		buildTore(map, position, size) ;
+		std::vector<REAL> heights ;
+		for (unsigned int i = 0; i < 64; ++i)
+			heights.push_back(REAL(-1) + REAL(2) * (REAL(i) + REAL(0.5)) / REAL(64)) ;
+		std::vector< std::vector<VEC3> > segments ;
+		bench.run("modelisation/plane_slices_64", size, [&] ()
+		{
+			Algo::Surface::Modelisation::planeSlices<PFP>(map, position, VEC3(0, 0, 1), heights, segments) ;
+			Utils::doNotOptimize(segments) ;
+		});
+	}
+
+	// marching cube on a size^3 image of a sphere
+	if (bench.isSelected("mc/sphere"))
+	{
+		std::vector<unsigned char> img(size * size * size) ;
+		float c = float(size) / 2.0f ;
+		for (unsigned int z = 0; z < size; ++z)
+			for (unsigned int y = 0; y < size; ++y)
+				for (unsigned int x = 0; x < size; ++x)
+				{
+					Geom::Vec3f V(x - c, y - c, z - c) ;
+					img[(z * size + y) * size + x] = V.norm() < 0.4f * float(size) ? 255 : 0 ;
+				}
+		Algo::Surface::MC::Image<unsigned char> image(&img[0], size, size, size, 1.0f, 1.0f, 1.0f, true) ;
+		Algo::Surface::MC::WindowingGreater<unsigned char> wind ;
+		wind.setIsoValue(127) ;
+		bench.run("mc/sphere", size, [&] () { map.clear(false) ; position = map.getAttribute<VEC3, VERTEX, MAP>("position") ; }, [&] ()
+		{
+			Algo::Surface::MC::MarchingCube<unsigned char, Algo::Surface::MC::WindowingGreater, PFP> mc(&image, &map, position, wind, false) ;
+			mc.simpleMeshing() ;
+		});
+	}
+
+	bench.printSummary() ;
+
+	if (!jsonFile.empty())
+		bench.saveJSON(jsonFile) ;
+	if (!csvFile.empty())
+		bench.saveCSV(csvFile) ;
+	if (!baselineFile.empty())
+		return int(bench.compare(baselineFile, tolerance)) ;
+
+	return 0 ;
+}
@@ -14,7 +14,8 @@ struct PFP1 : public PFP_STANDARD
 };
 
 template bool Algo::Surface::Export::exportVTU<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const char* filename);
-template bool Algo::Surface::Export::exportVTUBinary<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const char* filename);
+template bool Algo::Surface::Export::exportVTUBinary<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const char* filename, unsigned int nbThreads);
+template bool Algo::Surface::Export::exportVTUCompressed<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const char* filename, unsigned int nbThreads);
 template class Algo::Surface::Export::VTUExporter<PFP1>;
 
 
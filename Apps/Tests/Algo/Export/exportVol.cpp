@@ -1,7 +1,7 @@
 #include "Topology/generic/parameters.h"
 #include "Topology/map/embeddedMap3.h"
 
-#include "Algo/Export/exportVol.hpp"
+#include "Algo/Export/exportVol.h"
 
 using namespace CGoGN;
 
@@ -12,6 +12,8 @@ struct PFP1 : public PFP_STANDARD
 
 
 template bool Algo::Volume::Export::exportMesh<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const std::string& filename) ;
+template bool Algo::Volume::Export::exportVTUCompressed<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const char* filename, unsigned int nbThreads) ;
+template bool Algo::Volume::Export::exportVolBinGz<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const char* filename, unsigned int nbThreads) ;
 
 int test_exportVol()
 {
@@ -27,6 +27,10 @@ struct PFP3 : public PFP_DOUBLE
 template void Algo::Surface::Filtering::filterAverageAttribute_OneRing<PFP1, Geom::Vec3d>(PFP1::MAP& map,
 const VertexAttribute<Geom::Vec3d, PFP1::MAP>& attIn, VertexAttribute<Geom::Vec3d, PFP1::MAP>& attOut, int neigh);
 
+template void Algo::Surface::Filtering::filterAverageAttribute_OneRing<PFP1, Geom::Vec3d>(PFP1::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP1>& rings,
+	const VertexAttribute<Geom::Vec3d, PFP1::MAP>& attIn, VertexAttribute<Geom::Vec3d, PFP1::MAP>& attOut, int neigh, unsigned int nbIterations, unsigned int nbth);
+
 template void Algo::Surface::Filtering::filterAverageVertexAttribute_WithinSphere<PFP1, Geom::Vec3d>(PFP1::MAP& map,
 	const VertexAttribute<Geom::Vec3d, PFP1::MAP>& attIn, VertexAttribute<Geom::Vec3d, PFP1::MAP>& attOut, int neigh,
 	VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, PFP1::REAL radius);
@@ -39,11 +43,28 @@ template void Algo::Surface::Filtering::filterAverageFaceAttribute_WithinSphere<
 	const FaceAttribute<Geom::Vec3d, PFP1::MAP>& attIn, FaceAttribute<Geom::Vec3d, PFP1::MAP>& attOut, int neigh,
 	VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, PFP1::REAL radius);
 
+template void Algo::Surface::Filtering::filterAverageVertexAttribute_WithinSphere<PFP1, Geom::Vec3d>(PFP1::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_WithinSphere<PFP1>& neighborhoods,
+	const VertexAttribute<Geom::Vec3d, PFP1::MAP>& attIn, VertexAttribute<Geom::Vec3d, PFP1::MAP>& attOut, int neigh,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, unsigned int nbth);
+
+template void Algo::Surface::Filtering::filterAverageEdgeAttribute_WithinSphere<PFP1, Geom::Vec3d>(PFP1::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_WithinSphere<PFP1>& neighborhoods,
+	const EdgeAttribute<Geom::Vec3d, PFP1::MAP>& attIn, EdgeAttribute<Geom::Vec3d, PFP1::MAP>& attOut, int neigh, unsigned int nbth);
+
+template void Algo::Surface::Filtering::filterAverageFaceAttribute_WithinSphere<PFP1, Geom::Vec3d>(PFP1::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_WithinSphere<PFP1>& neighborhoods,
+	const FaceAttribute<Geom::Vec3d, PFP1::MAP>& attIn, FaceAttribute<Geom::Vec3d, PFP1::MAP>& attOut, int neigh, unsigned int nbth);
+
 
 
 template void Algo::Surface::Filtering::filterAverageAttribute_OneRing<PFP2, Geom::Vec3f>(PFP2::MAP& map,
 	const VertexAttribute<Geom::Vec3f, PFP2::MAP>& attIn, VertexAttribute<Geom::Vec3f, PFP2::MAP>& attOut, int neigh);
 
+template void Algo::Surface::Filtering::filterAverageAttribute_OneRing<PFP2, Geom::Vec3f>(PFP2::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP2>& rings,
+	const VertexAttribute<Geom::Vec3f, PFP2::MAP>& attIn, VertexAttribute<Geom::Vec3f, PFP2::MAP>& attOut, int neigh, unsigned int nbIterations, unsigned int nbth);
+
 template void Algo::Surface::Filtering::filterAverageVertexAttribute_WithinSphere<PFP2, Geom::Vec3f>(PFP2::MAP& map,
 	const VertexAttribute<Geom::Vec3f, PFP2::MAP>& attIn, VertexAttribute<Geom::Vec3f, PFP2::MAP>& attOut, int neigh,
 	VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, PFP2::REAL radius);
@@ -56,11 +77,28 @@ template void Algo::Surface::Filtering::filterAverageFaceAttribute_WithinSphere<
 	const FaceAttribute<Geom::Vec3f, PFP2::MAP>& attIn, FaceAttribute<Geom::Vec3f, PFP2::MAP>& attOut, int neigh,
 	VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, PFP2::REAL radius);
 
+template void Algo::Surface::Filtering::filterAverageVertexAttribute_WithinSphere<PFP2, Geom::Vec3f>(PFP2::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_WithinSphere<PFP2>& neighborhoods,
+	const VertexAttribute<Geom::Vec3f, PFP2::MAP>& attIn, VertexAttribute<Geom::Vec3f, PFP2::MAP>& attOut, int neigh,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, unsigned int nbth);
+
+template void Algo::Surface::Filtering::filterAverageEdgeAttribute_WithinSphere<PFP2, Geom::Vec3f>(PFP2::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_WithinSphere<PFP2>& neighborhoods,
+	const EdgeAttribute<Geom::Vec3f, PFP2::MAP>& attIn, EdgeAttribute<Geom::Vec3f, PFP2::MAP>& attOut, int neigh, unsigned int nbth);
+
+template void Algo::Surface::Filtering::filterAverageFaceAttribute_WithinSphere<PFP2, Geom::Vec3f>(PFP2::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_WithinSphere<PFP2>& neighborhoods,
+	const FaceAttribute<Geom::Vec3f, PFP2::MAP>& attIn, FaceAttribute<Geom::Vec3f, PFP2::MAP>& attOut, int neigh, unsigned int nbth);
+
 
 
 template void Algo::Surface::Filtering::filterAverageAttribute_OneRing<PFP3, Geom::Vec3f>(PFP3::MAP& map,
 	const VertexAttribute<Geom::Vec3f, PFP3::MAP>& attIn, VertexAttribute<Geom::Vec3f, PFP3::MAP>& attOut, int neigh);
 
+template void Algo::Surface::Filtering::filterAverageAttribute_OneRing<PFP3, Geom::Vec3f>(PFP3::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP3>& rings,
+	const VertexAttribute<Geom::Vec3f, PFP3::MAP>& attIn, VertexAttribute<Geom::Vec3f, PFP3::MAP>& attOut, int neigh, unsigned int nbIterations, unsigned int nbth);
+
 template void Algo::Surface::Filtering::filterAverageVertexAttribute_WithinSphere<PFP3, Geom::Vec3f>(PFP3::MAP& map,
 	const VertexAttribute<Geom::Vec3f, PFP3::MAP>& attIn, VertexAttribute<Geom::Vec3f, PFP3::MAP>& attOut, int neigh,
 	VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, PFP3::REAL radius);
@@ -73,6 +111,19 @@ template void Algo::Surface::Filtering::filterAverageFaceAttribute_WithinSphere<
 	const FaceAttribute<Geom::Vec3f, PFP3::MAP>& attIn, FaceAttribute<Geom::Vec3f, PFP3::MAP>& attOut, int neigh,
 	VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, PFP3::REAL radius);
 
+template void Algo::Surface::Filtering::filterAverageVertexAttribute_WithinSphere<PFP3, Geom::Vec3f>(PFP3::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_WithinSphere<PFP3>& neighborhoods,
+	const VertexAttribute<Geom::Vec3f, PFP3::MAP>& attIn, VertexAttribute<Geom::Vec3f, PFP3::MAP>& attOut, int neigh,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, unsigned int nbth);
+
+template void Algo::Surface::Filtering::filterAverageEdgeAttribute_WithinSphere<PFP3, Geom::Vec3f>(PFP3::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_WithinSphere<PFP3>& neighborhoods,
+	const EdgeAttribute<Geom::Vec3f, PFP3::MAP>& attIn, EdgeAttribute<Geom::Vec3f, PFP3::MAP>& attOut, int neigh, unsigned int nbth);
+
+template void Algo::Surface::Filtering::filterAverageFaceAttribute_WithinSphere<PFP3, Geom::Vec3f>(PFP3::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_WithinSphere<PFP3>& neighborhoods,
+	const FaceAttribute<Geom::Vec3f, PFP3::MAP>& attIn, FaceAttribute<Geom::Vec3f, PFP3::MAP>& attOut, int neigh, unsigned int nbth);
+
 int test_average()
 {
 
@@ -33,6 +33,8 @@ template void Algo::Surface::Filtering::computeNewPositionsFromFaceNormals<PFP1>
 
 template void Algo::Surface::Filtering::filterAverageNormals<PFP1>(PFP1::MAP& map,
 	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position2);
+template void Algo::Surface::Filtering::filterAverageNormals<PFP1>(PFP1::MAP& map,
+	const VertexAttributeView<PFP1::VEC3, PFP1::MAP>& position, VertexAttributeView<PFP1::VEC3, PFP1::MAP>& position2);
 
 template void Algo::Surface::Filtering::filterMMSE<PFP1>(PFP1::MAP& map, float sigmaN2,
 	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position2);
@@ -31,6 +31,20 @@ template void Algo::Surface::Filtering::filterSUSAN<PFP1>(PFP1::MAP& map, float
 	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,	VertexAttribute<PFP1::VEC3, PFP1::MAP>& position2,
 	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& normal);
 
+template void Algo::Surface::Filtering::filterBilateral<PFP1>(PFP1::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP1>& rings,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& positionIn, VertexAttribute<PFP1::VEC3, PFP1::MAP>& positionOut,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& normal, unsigned int nbIterations, unsigned int nbth);
+
+template void Algo::Surface::Filtering::filterSUSAN<PFP1>(PFP1::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP1>& rings, float SUSANthreshold,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position2,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& normal, unsigned int nbIterations, unsigned int nbth);
+
+template void Algo::Surface::Filtering::filterBilateral<PFP1>( PFP1::MAP& map,
+	const VertexAttributeView<PFP1::VEC3, PFP1::MAP>& positionIn, VertexAttribute<PFP1::VEC3, PFP1::MAP>& positionOut,
+	const VertexAttributeView<PFP1::VEC3, PFP1::MAP>& normal);
+
 
 
 template void Algo::Surface::Filtering::filterBilateral<PFP2>(PFP2::MAP& map,
@@ -41,6 +55,16 @@ template void Algo::Surface::Filtering::filterSUSAN<PFP2>(PFP2::MAP& map, float
 	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position2,
 	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& normal);
 
+template void Algo::Surface::Filtering::filterBilateral<PFP2>(PFP2::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP2>& rings,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& positionIn, VertexAttribute<PFP2::VEC3, PFP2::MAP>& positionOut,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& normal, unsigned int nbIterations, unsigned int nbth);
+
+template void Algo::Surface::Filtering::filterSUSAN<PFP2>(PFP2::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP2>& rings, float SUSANthreshold,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position2,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& normal, unsigned int nbIterations, unsigned int nbth);
+
 
 
 template void Algo::Surface::Filtering::filterBilateral<PFP3>(PFP3::MAP& map,
@@ -51,6 +75,16 @@ template void Algo::Surface::Filtering::filterSUSAN<PFP3>(PFP3::MAP& map, float
 	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position2,
 	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& normal);
 
+template void Algo::Surface::Filtering::filterBilateral<PFP3>(PFP3::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP3>& rings,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& positionIn, VertexAttribute<PFP3::VEC3, PFP3::MAP>& positionOut,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& normal, unsigned int nbIterations, unsigned int nbth);
+
+template void Algo::Surface::Filtering::filterSUSAN<PFP3>(PFP3::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP3>& rings, float SUSANthreshold,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position2,
+	const VertexAttribute<PFP3::VEC3, PFP3::MAP>& normal, unsigned int nbIterations, unsigned int nbth);
+
 
 int test_bilateral()
 {
@@ -27,23 +27,50 @@ struct PFP3 : public PFP_DOUBLE
 template void Algo::Surface::Filtering::filterTaubin<PFP1>(PFP1::MAP& map,
 	VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position2);
 
+template void Algo::Surface::Filtering::filterTaubin<PFP1>(PFP1::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP1>& rings,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position2, unsigned int nbIterations, unsigned int nbth);
+
 template void Algo::Surface::Filtering::filterTaubin_modified<PFP1>(PFP1::MAP& map,
 	VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position2, PFP1::REAL radius);
 
+template void Algo::Surface::Filtering::filterTaubin_modified<PFP1>(PFP1::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_WithinSphere<PFP1>& neighborhoods,
+	Algo::Surface::Selection::CollectorCache_WithinSphere<PFP1>& shrunkNeighborhoods,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position2, unsigned int nbth);
+
 
 template void Algo::Surface::Filtering::filterTaubin<PFP2>(PFP2::MAP& map,
 	VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position2);
 
+template void Algo::Surface::Filtering::filterTaubin<PFP2>(PFP2::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP2>& rings,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position2, unsigned int nbIterations, unsigned int nbth);
+
 template void Algo::Surface::Filtering::filterTaubin_modified<PFP2>(PFP2::MAP& map,
 	VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position2, PFP2::REAL radius);
 
+template void Algo::Surface::Filtering::filterTaubin_modified<PFP2>(PFP2::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_WithinSphere<PFP2>& neighborhoods,
+	Algo::Surface::Selection::CollectorCache_WithinSphere<PFP2>& shrunkNeighborhoods,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position2, unsigned int nbth);
+
 
 template void Algo::Surface::Filtering::filterTaubin<PFP3>(PFP3::MAP& map,
 	VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position2);
 
+template void Algo::Surface::Filtering::filterTaubin<PFP3>(PFP3::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP3>& rings,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position2, unsigned int nbIterations, unsigned int nbth);
+
 template void Algo::Surface::Filtering::filterTaubin_modified<PFP3>(PFP3::MAP& map,
 	VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position2, PFP3::REAL radius);
 
+template void Algo::Surface::Filtering::filterTaubin_modified<PFP3>(PFP3::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_WithinSphere<PFP3>& neighborhoods,
+	Algo::Surface::Selection::CollectorCache_WithinSphere<PFP3>& shrunkNeighborhoods,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position2, unsigned int nbth);
+
 
 int test_taubin()
 {
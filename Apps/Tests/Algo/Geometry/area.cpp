@@ -51,6 +51,10 @@ template void Algo::Surface::Geometry::Parallel::computeOneRingAreaVertices<PFP1
 template void Algo::Surface::Geometry::Parallel::computeBarycentricAreaVertices<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, VertexAttribute<PFP1::REAL, PFP1::MAP>& vertex_area);
 template void Algo::Surface::Geometry::Parallel::computeVoronoiAreaVertices<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, VertexAttribute<PFP1::REAL, PFP1::MAP>& area);
 
+template PFP1::REAL Algo::Surface::Geometry::totalArea<PFP1>(PFP1::MAP& map, const VertexAttributeView<PFP1::VEC3, PFP1::MAP>& position);
+template void Algo::Surface::Geometry::computeVoronoiAreaVertices<PFP1>(PFP1::MAP& map, const VertexAttributeView<PFP1::VEC3, PFP1::MAP>& position, VertexAttribute<PFP1::REAL, PFP1::MAP>& vertex_area);
+template void Algo::Surface::Geometry::Parallel::computeAreaFaces<PFP1>(PFP1::MAP& map, const VertexAttributeView<PFP1::VEC3, PFP1::MAP>& position, FaceAttribute<PFP1::REAL, PFP1::MAP>& area);
+
 
 template PFP2::REAL Algo::Surface::Geometry::triangleArea<PFP2>(PFP2::MAP& map, Face f, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position);
 template PFP2::REAL Algo::Surface::Geometry::convexFaceArea<PFP2>(PFP2::MAP& map, Face f, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position);
@@ -109,6 +109,63 @@ template std::vector<PFP1::VEC3> Algo::Surface::Geometry::occludingContoursDetec
 	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
 	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& normal) ;
 
+template unsigned int Algo::Surface::Geometry::chainRidgeSegments<PFP1>(
+	PFP1::MAP& map,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	const FaceAttribute<RidgeSegment<PFP1::REAL>, PFP1::MAP>& ridge_segments,
+	std::vector< std::vector<PFP1::VEC3> >& polylines,
+	bool featureOnly) ;
+
+template void Algo::Surface::Geometry::Parallel::featureEdgeDetection<PFP1>(
+	PFP1::MAP& map,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	CellMarker<PFP1::MAP, EDGE>& featureEdge,
+	unsigned int nbth) ;
+
+template void Algo::Surface::Geometry::Parallel::computeFaceGradient<PFP1>(
+	PFP1::MAP& map,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	const FaceAttribute<PFP1::VEC3, PFP1::MAP>& face_normal,
+	const VertexAttribute<PFP1::REAL, PFP1::MAP>& scalar,
+	const FaceAttribute<PFP1::REAL, PFP1::MAP>& face_area,
+	FaceAttribute<PFP1::VEC3, PFP1::MAP>& face_gradient,
+	unsigned int nbth) ;
+
+template void Algo::Surface::Geometry::Parallel::computeVertexGradient<PFP1>(
+	PFP1::MAP& map,
+	const FaceAttribute<PFP1::VEC3, PFP1::MAP>& face_gradient,
+	const FaceAttribute<PFP1::REAL, PFP1::MAP>& face_area,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& vertex_gradient,
+	unsigned int nbth) ;
+
+template void Algo::Surface::Geometry::Parallel::computeTriangleType<PFP1>(
+	PFP1::MAP& map,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& K,
+	CellMarker<PFP1::MAP, FACE>& regularMarker,
+	unsigned int nbth) ;
+
+template void Algo::Surface::Geometry::Parallel::initRidgeSegments<PFP1>(
+	PFP1::MAP& map,
+	FaceAttribute<RidgeSegment<PFP1::REAL>, PFP1::MAP>& ridge_segments,
+	unsigned int nbth) ;
+
+template void Algo::Surface::Geometry::Parallel::computeRidgeLines<PFP1>(
+	PFP1::MAP& map,
+	CellMarker<PFP1::MAP, FACE>& regularMarker,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& K,
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& vertex_gradient,
+	const VertexAttribute<PFP1::REAL, PFP1::MAP>& k,
+	const VertexAttribute<PFP1::REAL, PFP1::MAP>& k2,
+	FaceAttribute<RidgeSegment<PFP1::REAL>, PFP1::MAP>& ridge_segments,
+	unsigned int nbth) ;
+
+template void Algo::Surface::Geometry::Parallel::computeSingularTriangle<PFP1>(
+	PFP1::MAP& map,
+	CellMarker<PFP1::MAP, FACE>& regularMarker,
+	FaceAttribute<RidgeSegment<PFP1::REAL>, PFP1::MAP>& ridge_segments,
+	unsigned int nbth) ;
+
 
 // WITH DOUBLE
 
@@ -202,6 +259,63 @@ template std::vector<PFP2::VEC3> Algo::Surface::Geometry::occludingContoursDetec
 	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
 	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& normal);
 
+template unsigned int Algo::Surface::Geometry::chainRidgeSegments<PFP2>(
+	PFP2::MAP& map,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	const FaceAttribute<RidgeSegment<PFP2::REAL>, PFP2::MAP>& ridge_segments,
+	std::vector< std::vector<PFP2::VEC3> >& polylines,
+	bool featureOnly);
+
+template void Algo::Surface::Geometry::Parallel::featureEdgeDetection<PFP2>(
+	PFP2::MAP& map,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	CellMarker<PFP2::MAP, EDGE>& featureEdge,
+	unsigned int nbth);
+
+template void Algo::Surface::Geometry::Parallel::computeFaceGradient<PFP2>(
+	PFP2::MAP& map,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	const FaceAttribute<PFP2::VEC3, PFP2::MAP>& face_normal,
+	const VertexAttribute<PFP2::REAL, PFP2::MAP>& scalar,
+	const FaceAttribute<PFP2::REAL, PFP2::MAP>& face_area,
+	FaceAttribute<PFP2::VEC3, PFP2::MAP>& face_gradient,
+	unsigned int nbth);
+
+template void Algo::Surface::Geometry::Parallel::computeVertexGradient<PFP2>(
+	PFP2::MAP& map,
+	const FaceAttribute<PFP2::VEC3, PFP2::MAP>& face_gradient,
+	const FaceAttribute<PFP2::REAL, PFP2::MAP>& face_area,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& vertex_gradient,
+	unsigned int nbth);
+
+template void Algo::Surface::Geometry::Parallel::computeTriangleType<PFP2>(
+	PFP2::MAP& map,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& K,
+	CellMarker<PFP2::MAP, FACE>& regularMarker,
+	unsigned int nbth);
+
+template void Algo::Surface::Geometry::Parallel::initRidgeSegments<PFP2>(
+	PFP2::MAP& map,
+	FaceAttribute<RidgeSegment<PFP2::REAL>, PFP2::MAP>& ridge_segments,
+	unsigned int nbth);
+
+template void Algo::Surface::Geometry::Parallel::computeRidgeLines<PFP2>(
+	PFP2::MAP& map,
+	CellMarker<PFP2::MAP, FACE>& regularMarker,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& K,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& vertex_gradient,
+	const VertexAttribute<PFP2::REAL, PFP2::MAP>& k,
+	const VertexAttribute<PFP2::REAL, PFP2::MAP>& k2,
+	FaceAttribute<RidgeSegment<PFP2::REAL>, PFP2::MAP>& ridge_segments,
+	unsigned int nbth);
+
+template void Algo::Surface::Geometry::Parallel::computeSingularTriangle<PFP2>(
+	PFP2::MAP& map,
+	CellMarker<PFP2::MAP, FACE>& regularMarker,
+	FaceAttribute<RidgeSegment<PFP2::REAL>, PFP2::MAP>& ridge_segments,
+	unsigned int nbth);
+
 
 int test_feature()
 {
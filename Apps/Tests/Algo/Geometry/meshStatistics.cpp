@@ -0,0 +1,47 @@
+#include <iostream>
+#include "Topology/generic/parameters.h"
+#include "Topology/gmap/embeddedGMap2.h"
+#include "Topology/map/embeddedMap2.h"
+
+#include "Algo/Geometry/meshStatistics.h"
+
+
+using namespace CGoGN;
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP3 : public PFP_STANDARD
+{
+	typedef EmbeddedGMap2 MAP;
+};
+
+
+using namespace CGoGN;
+
+
+/*****************************************
+*		 INSTANTIATION
+*****************************************/
+
+template struct Algo::Surface::Geometry::MeshStatistics<PFP1>;
+template void Algo::Surface::Geometry::computeMeshStatistics<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, Algo::Surface::Geometry::MeshStatistics<PFP1>& stats, unsigned int nbBins, PFP1::REAL edgeLengthRange, unsigned int nbth);
+
+template struct Algo::Surface::Geometry::MeshStatistics<PFP2>;
+template void Algo::Surface::Geometry::computeMeshStatistics<PFP2>(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, Algo::Surface::Geometry::MeshStatistics<PFP2>& stats, unsigned int nbBins, PFP2::REAL edgeLengthRange, unsigned int nbth);
+
+template struct Algo::Surface::Geometry::MeshStatistics<PFP3>;
+template void Algo::Surface::Geometry::computeMeshStatistics<PFP3>(PFP3::MAP& map, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, Algo::Surface::Geometry::MeshStatistics<PFP3>& stats, unsigned int nbBins, PFP3::REAL edgeLengthRange, unsigned int nbth);
+
+
+int test_meshStatistics()
+{
+	return 0;
+}
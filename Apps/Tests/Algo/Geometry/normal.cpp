@@ -25,6 +25,13 @@ template void Algo::Surface::Geometry::computeNormalVertices<PFP1, VATT1>(PFP1::
 template PFP1::REAL Algo::Surface::Geometry::computeAngleBetweenNormalsOnEdge<PFP1, VATT1>(PFP1::MAP& map, Edge d, const VATT1& position);
 template void Algo::Surface::Geometry::computeAnglesBetweenNormalsOnEdges<PFP1,VATT1,EATT1>(PFP1::MAP& map, const VATT1& position, EATT1& angles);
 
+typedef VertexAttributeView<PFP1::VEC3, PFP1::MAP> VVIEW1;
+typedef FaceAttributeView<PFP1::VEC3, PFP1::MAP> FVIEW1;
+
+template void Algo::Surface::Geometry::computeNormalFaces<PFP1, VVIEW1, FVIEW1>(PFP1::MAP& map, const VVIEW1& position, FVIEW1& face_normal);
+template void Algo::Surface::Geometry::computeNormalVertices<PFP1, VVIEW1>(PFP1::MAP& map, const VVIEW1& position, VVIEW1& normal);
+template void Algo::Surface::Geometry::Parallel::computeNormalVertices<PFP1, VVIEW1>(PFP1::MAP& map, const VVIEW1& position, VVIEW1& normal);
+
 
 struct PFP11 : public PFP_STANDARD
 {
@@ -16,6 +16,7 @@ typedef VertexAttribute<Geom::Vec3f, PFP1::MAP> VAC1;
 typedef CellMarker<PFP1::MAP, VERTEX> CM1;
 
 template void Algo::Histogram::Histogram::initData<VA1>(const VA1& attr);
+template void Algo::Histogram::Histogram::updateData<VA1>(const VA1& attr, const std::vector<unsigned int>& changed);
 template void Algo::Histogram::Histogram::histoColorize<VAC1>(VAC1& colors);
 template void Algo::Histogram::Histogram::quantilesColorize<VAC1>(VAC1& colors, const std::vector<Geom::Vec3f>& tc);
 template unsigned int Algo::Histogram::Histogram::markCellsOfHistogramColumn<CM1>(unsigned int c, CM1& cm) const;
@@ -15,6 +15,7 @@ struct PFP1 : public PFP_STANDARD
 
 template bool Algo::Surface::Import::importMesh<PFP1>(PFP1::MAP& map, const std::string& filename, std::vector<std::string>& attrNames, bool mergeCloseVertices);
 template bool Algo::Surface::Import::importVoxellisation<PFP1>(PFP1::MAP& map, Algo::Surface::Modelisation::Voxellisation& voxellisation, std::vector<std::string>& attrNames, bool mergeCloseVertices);
+template bool Algo::Surface::Import::importVoxellisation<PFP1>(PFP1::MAP& map, Algo::Surface::Modelisation::SparseVoxellisation& voxellisation, std::vector<std::string>& attrNames, bool mergeCloseVertices);
 //template bool Algo::Surface::Import::importChoupi<PFP1>(const std::string& filename, const std::vector<PFP1::VEC3>& tabV, const std::vector<unsigned int>& tabE);
 
 struct PFP2 : public PFP_DOUBLE
@@ -24,6 +25,7 @@ struct PFP2 : public PFP_DOUBLE
 
 template bool Algo::Surface::Import::importMesh<PFP2>(PFP2::MAP& map, const std::string& filename, std::vector<std::string>& attrNames, bool mergeCloseVertices);
 template bool Algo::Surface::Import::importVoxellisation<PFP2>(PFP2::MAP& map, Algo::Surface::Modelisation::Voxellisation& voxellisation, std::vector<std::string>& attrNames, bool mergeCloseVertices);
+template bool Algo::Surface::Import::importVoxellisation<PFP2>(PFP2::MAP& map, Algo::Surface::Modelisation::SparseVoxellisation& voxellisation, std::vector<std::string>& attrNames, bool mergeCloseVertices);
 //template bool Algo::Surface::Import::importChoupi<PFP2>(const std::string& filename, const std::vector<PFP2::VEC3>& tabV, const std::vector<unsigned int>& tabE);
 
 struct PFP3 : public PFP_DOUBLE
@@ -33,6 +35,7 @@ struct PFP3 : public PFP_DOUBLE
 
 template bool Algo::Surface::Import::importMesh<PFP3>(PFP3::MAP& map, const std::string& filename, std::vector<std::string>& attrNames, bool mergeCloseVertices);
 template bool Algo::Surface::Import::importVoxellisation<PFP3>(PFP3::MAP& map, Algo::Surface::Modelisation::Voxellisation& voxellisation, std::vector<std::string>& attrNames, bool mergeCloseVertices);
+template bool Algo::Surface::Import::importVoxellisation<PFP3>(PFP3::MAP& map, Algo::Surface::Modelisation::SparseVoxellisation& voxellisation, std::vector<std::string>& attrNames, bool mergeCloseVertices);
 //template bool Algo::Surface::Import::importChoupi<PFP3>(const std::string& filename, const std::vector<PFP3::VEC3>& tabV, const std::vector<unsigned int>& tabE);
 
 
@@ -11,14 +11,15 @@ extern int test_voxellisation();
 
 int main()
 {
-	test_extrusion();
-	test_planeCutting();
-	test_polyhedron();
-	test_subdivision();
-	test_subdivision3();
-	test_tetrahedralization();
-	test_triangulation();
-	test_voxellisation();
+	int r = 0;
+	r |= test_extrusion();
+	r |= test_planeCutting();
+	r |= test_polyhedron();
+	r |= test_subdivision();
+	r |= test_subdivision3();
+	r |= test_tetrahedralization();
+	r |= test_triangulation();
+	r |= test_voxellisation();
 
-	return 0;
+	return r;
 }
@@ -19,6 +19,15 @@ template void Algo::Surface::Modelisation::planeCut<PFP1>(PFP1::MAP& map, Vertex
 template void Algo::Surface::Modelisation::planeCut2<PFP1>(PFP1::MAP& map, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
 	const Geom::Plane3D<PFP1::REAL>& plane, CellMarker<PFP1::MAP, FACE>& cmf_over, bool with_unsew);
 
+template void Algo::Surface::Modelisation::planeSlices<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	const PFP1::VEC3& normal, const std::vector<PFP1::REAL>& heights, std::vector< std::vector<PFP1::VEC3> >& segments, unsigned int nbth);
+
+template void Algo::Surface::Modelisation::Parallel::planeCut<PFP1>(PFP1::MAP& map, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	const Geom::Plane3D<PFP1::REAL>& plane, CellMarker<PFP1::MAP, FACE>& cmf_over, bool keepTriangles, bool with_unsew, unsigned int nbth);
+
+template void Algo::Surface::Modelisation::Parallel::planeCut2<PFP1>(PFP1::MAP& map, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position,
+	const Geom::Plane3D<PFP1::REAL>& plane, CellMarker<PFP1::MAP, FACE>& cmf_over, bool with_unsew, unsigned int nbth);
+
 
 
 struct PFP2 : public PFP_DOUBLE
@@ -32,6 +41,15 @@ template void Algo::Surface::Modelisation::planeCut<PFP2>(PFP2::MAP& map, Vertex
 template void Algo::Surface::Modelisation::planeCut2<PFP2>(PFP2::MAP& map, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
 	const Geom::Plane3D<PFP2::REAL>& plane, CellMarker<PFP2::MAP, FACE>& cmf_over, bool with_unsew);
 
+template void Algo::Surface::Modelisation::planeSlices<PFP2>(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	const PFP2::VEC3& normal, const std::vector<PFP2::REAL>& heights, std::vector< std::vector<PFP2::VEC3> >& segments, unsigned int nbth);
+
+template void Algo::Surface::Modelisation::Parallel::planeCut<PFP2>(PFP2::MAP& map, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	const Geom::Plane3D<PFP2::REAL>& plane, CellMarker<PFP2::MAP, FACE>& cmf_over, bool keepTriangles, bool with_unsew, unsigned int nbth);
+
+template void Algo::Surface::Modelisation::Parallel::planeCut2<PFP2>(PFP2::MAP& map, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	const Geom::Plane3D<PFP2::REAL>& plane, CellMarker<PFP2::MAP, FACE>& cmf_over, bool with_unsew, unsigned int nbth);
+
 
 
 struct PFP3 : public PFP_DOUBLE
@@ -45,6 +63,15 @@ template void Algo::Surface::Modelisation::planeCut<PFP3>(PFP3::MAP& map, Vertex
 template void Algo::Surface::Modelisation::planeCut2<PFP3>(PFP3::MAP& map, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position,
 	const Geom::Plane3D<PFP3::REAL>& plane, CellMarker<PFP3::MAP, FACE>& cmf_over, bool with_unsew);
 
+template void Algo::Surface::Modelisation::planeSlices<PFP3>(PFP3::MAP& map, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position,
+	const PFP3::VEC3& normal, const std::vector<PFP3::REAL>& heights, std::vector< std::vector<PFP3::VEC3> >& segments, unsigned int nbth);
+
+template void Algo::Surface::Modelisation::Parallel::planeCut<PFP3>(PFP3::MAP& map, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position,
+	const Geom::Plane3D<PFP3::REAL>& plane, CellMarker<PFP3::MAP, FACE>& cmf_over, bool keepTriangles, bool with_unsew, unsigned int nbth);
+
+template void Algo::Surface::Modelisation::Parallel::planeCut2<PFP3>(PFP3::MAP& map, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position,
+	const Geom::Plane3D<PFP3::REAL>& plane, CellMarker<PFP3::MAP, FACE>& cmf_over, bool with_unsew, unsigned int nbth);
+
 
 
 
@@ -56,6 +83,9 @@ struct PFP4 : public PFP_DOUBLE
 template void Algo::Volume::Modelisation::planeCut<PFP4>(PFP4::MAP& map, VertexAttribute<PFP4::VEC3, PFP4::MAP>& position,
 	const Geom::Plane3D<PFP4::REAL>& plane, CellMarker<PFP4::MAP, FACE>& cmv_over, bool keepTetrahedra, bool with_unsew);
 
+template void Algo::Volume::Modelisation::Parallel::planeCut<PFP4>(PFP4::MAP& map, VertexAttribute<PFP4::VEC3, PFP4::MAP>& position,
+	const Geom::Plane3D<PFP4::REAL>& plane, CellMarker<PFP4::MAP, FACE>& cmv_over, bool keepTetrahedra, bool with_unsew, unsigned int nbth);
+
 
 int test_planeCutting()
 {
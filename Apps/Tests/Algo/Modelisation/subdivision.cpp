@@ -25,6 +25,8 @@ template void Algo::Surface::Modelisation::quadranguleFaces<PFP1, VPOS1>(PFP1::M
 template void Algo::Surface::Modelisation::CatmullClarkSubdivision<PFP1, VPOS1>(PFP1::MAP& map, VPOS1& attributs);
 template void Algo::Surface::Modelisation::CatmullClarkInterpolSubdivision<PFP1, VPOS1>(PFP1::MAP& map, VPOS1& attributs);
 template void Algo::Surface::Modelisation::LoopSubdivision<PFP1, VPOS1>(PFP1::MAP& map, VPOS1& attributs);
+template void Algo::Surface::Modelisation::Parallel::CatmullClarkSubdivision<PFP1, VPOS1>(PFP1::MAP& map, VPOS1& attributs, unsigned int nbLevels, unsigned int nbThreads);
+template void Algo::Surface::Modelisation::Parallel::LoopSubdivision<PFP1, VPOS1>(PFP1::MAP& map, VPOS1& attributs, unsigned int nbLevels, unsigned int nbThreads);
 template void Algo::Surface::Modelisation::LoopSubdivisionGen<PFP1>(PFP1::MAP& map, VertexAttributeGen& attrib);
 template void Algo::Surface::Modelisation::LoopSubdivisionAttribNameTyped<PFP1, Geom::Vec3d>(PFP1::MAP& map, const std::string& nameAttrib);
 template void Algo::Surface::Modelisation::LoopSubdivisionAttribName<PFP1>(PFP1::MAP& map, const std::string& nameAttrib);
@@ -53,6 +55,8 @@ template void Algo::Surface::Modelisation::quadranguleFaces<PFP2, VPOS2>(PFP2::M
 template void Algo::Surface::Modelisation::CatmullClarkSubdivision<PFP2, VPOS2>(PFP2::MAP& map, VPOS2& attributs);
 template void Algo::Surface::Modelisation::CatmullClarkInterpolSubdivision<PFP2, VPOS2>(PFP2::MAP& map, VPOS2& attributs);
 template void Algo::Surface::Modelisation::LoopSubdivision<PFP2, VPOS2>(PFP2::MAP& map, VPOS2& attributs);
+template void Algo::Surface::Modelisation::Parallel::CatmullClarkSubdivision<PFP2, VPOS2>(PFP2::MAP& map, VPOS2& attributs, unsigned int nbLevels, unsigned int nbThreads);
+template void Algo::Surface::Modelisation::Parallel::LoopSubdivision<PFP2, VPOS2>(PFP2::MAP& map, VPOS2& attributs, unsigned int nbLevels, unsigned int nbThreads);
 template void Algo::Surface::Modelisation::LoopSubdivisionGen<PFP2>(PFP2::MAP& map, VertexAttributeGen& attrib);
 template void Algo::Surface::Modelisation::LoopSubdivisionAttribNameTyped<PFP2, Geom::Vec3d>(PFP2::MAP& map, const std::string& nameAttrib);
 template void Algo::Surface::Modelisation::LoopSubdivisionAttribName<PFP2>(PFP2::MAP& map, const std::string& nameAttrib);
@@ -82,6 +86,8 @@ template void Algo::Surface::Modelisation::quadranguleFaces<PFP3, VPOS3>(PFP3::M
 template void Algo::Surface::Modelisation::CatmullClarkSubdivision<PFP3, VPOS3>(PFP3::MAP& map, VPOS3& attributs);
 template void Algo::Surface::Modelisation::CatmullClarkInterpolSubdivision<PFP3, VPOS3>(PFP3::MAP& map, VPOS3& attributs);
 template void Algo::Surface::Modelisation::LoopSubdivision<PFP3, VPOS3>(PFP3::MAP& map, VPOS3& attributs);
+template void Algo::Surface::Modelisation::Parallel::CatmullClarkSubdivision<PFP3, VPOS3>(PFP3::MAP& map, VPOS3& attributs, unsigned int nbLevels, unsigned int nbThreads);
+template void Algo::Surface::Modelisation::Parallel::LoopSubdivision<PFP3, VPOS3>(PFP3::MAP& map, VPOS3& attributs, unsigned int nbLevels, unsigned int nbThreads);
 template void Algo::Surface::Modelisation::LoopSubdivisionGen<PFP3>(PFP3::MAP& map, VertexAttributeGen& attrib);
 template void Algo::Surface::Modelisation::LoopSubdivisionAttribNameTyped<PFP3, Geom::Vec3d>(PFP3::MAP& map, const std::string& nameAttrib);
 template void Algo::Surface::Modelisation::LoopSubdivisionAttribName<PFP3>(PFP3::MAP& map, const std::string& nameAttrib);
@@ -4,6 +4,7 @@
 
 
 #include "Algo/Modelisation/voxellisation.h"
+#include "Algo/Modelisation/sparseVoxellisation.h"
 
 using namespace CGoGN;
 
@@ -15,10 +16,56 @@ struct PFP1 : public PFP_STANDARD
 
 
 
+// hollow box [lo,hi]^3 in a grid of resolution res: the states of the voxels are known
+// (the inside spans whole uniform bricks when the box is large)
+int testSparseBox(int res, int lo, int hi)
+{
+	Algo::Surface::Modelisation::SparseVoxellisation svox(Geom::Vec3i(res, res, res));
+	for (int x = lo; x <= hi; ++x)
+		for (int y = lo; y <= hi; ++y)
+			for (int z = lo; z <= hi; ++z)
+				if (x == lo || x == hi || y == lo || y == hi || z == lo || z == hi)
+					svox.addVoxel(x, y, z);
+
+	const int c = (lo + hi) / 2;
+	const unsigned long long shell = (unsigned long long)(hi - lo + 1) * (hi - lo + 1) * (hi - lo + 1)
+		- (unsigned long long)(hi - lo - 1) * (hi - lo - 1) * (hi - lo - 1);
+	if (svox.size() != shell || svox.getVoxel(lo, c, c) != 1 || svox.getVoxel(c, c, c) != 0)
+		return 1;
+
+	svox.marqueVoxelsExterieurs();
+	if (svox.getVoxel(-1, -1, -1) != 2 || svox.getVoxel(lo - 1, c, c) != 2 || svox.getVoxel(res - 1, res - 1, res - 1) != 2)
+		return 1;
+	if (svox.getVoxel(c, c, c) != 0 || svox.getVoxel(lo + 1, lo + 1, lo + 1) != 0 || svox.getVoxel(hi, hi, hi) != 1)
+		return 1;
+
+	svox.remplit();
+	if (svox.size() != (unsigned long long)(hi - lo + 1) * (hi - lo + 1) * (hi - lo + 1))
+		return 1;
+	if (svox.getVoxel(c, c, c) != 1 || svox.getVoxel(lo + 1, lo + 1, lo + 1) != 1 || svox.getVoxel(hi + 1, c, c) != 2)
+		return 1;
+
+	return 0;
+}
+
 int test_voxellisation()
 {
 
 	Algo::Surface::Modelisation::Voxellisation vox;
 
+	Algo::Surface::Modelisation::SparseVoxellisation svox(Geom::Vec3i(8, 8, 8));
+	std::vector< std::vector<Geom::Vec3i> > polygones(1);
+	polygones[0].push_back(Geom::Vec3i(1, 1, 1));
+	polygones[0].push_back(Geom::Vec3i(6, 1, 1));
+	polygones[0].push_back(Geom::Vec3i(6, 6, 1));
+	svox.voxellisePolygones(polygones, 2);
+	svox.marqueVoxelsExterieurs();
+	svox.remplit();
+	svox.dilate(1, 2);
+	svox.extractionBord();
+
+	if (testSparseBox(8, 2, 5) || testSparseBox(40, 3, 36))
+		return 1;
+
 	return 0;
-}
\ No newline at end of file
+}
@@ -6,15 +6,18 @@ extern int test_particle_cell_2D_secured();
 extern int test_particle_cell_2DandHalf();
 extern int test_particle_cell_2DandHalf_memo();
 extern int test_particle_cell_3D();
+extern int test_particle_system_2D();
 
 int main()
 {
-	test_particle_cell_2D();
-	test_particle_cell_2D_memo();
-	test_particle_cell_2D_secured();
-	test_particle_cell_2DandHalf();
-	test_particle_cell_2DandHalf_memo();
-	test_particle_cell_3D();
+	int r = 0;
+	r |= test_particle_cell_2D();
+	r |= test_particle_cell_2D_memo();
+	r |= test_particle_cell_2D_secured();
+	r |= test_particle_cell_2DandHalf();
+	r |= test_particle_cell_2DandHalf_memo();
+	r |= test_particle_cell_3D();
+	r |= test_particle_system_2D();
 
-	return 0;
+	return r;
 }
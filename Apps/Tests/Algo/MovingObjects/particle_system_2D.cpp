@@ -0,0 +1,78 @@
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+
+#include "Algo/Tiling/Surface/square.h"
+#include "Algo/MovingObjects/particle_system_2D.h"
+
+using namespace CGoGN;
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+template class Algo::Surface::MovingObjects::ParticleSystem2D<PFP1>;
+
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+template class Algo::Surface::MovingObjects::ParticleSystem2D<PFP2>;
+
+
+int test_particle_system_2D()
+{
+	typedef PFP2::MAP MAP;
+	typedef PFP2::VEC3 VEC3;
+
+	MAP map;
+	VertexAttribute<VEC3, MAP> position = map.addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::Tilings::Square::Grid<PFP2> grid(map, 8, 8, true);
+	grid.embedIntoGrid(position, 8.0f, 8.0f, 0.0f);
+
+	std::vector<Dart> faces;
+	foreach_cell<FACE>(map, [&] (Face f) { faces.push_back(f.dart); });
+
+	// one particle at the center of each face, moving with the same shift:
+	// the result must not depend on the number of threads nor on the order of the particles
+	Algo::Surface::MovingObjects::ParticleSystem2D<PFP2> ps1(map, position, 1);
+	Algo::Surface::MovingObjects::ParticleSystem2D<PFP2> ps4(map, position, 4);
+	for (unsigned int i = 0; i < faces.size(); ++i)
+	{
+		Dart d = faces[i];
+		VEC3 c = (position[d] + position[map.phi1(map.phi1(d))]) / 2.0;
+		ps1.addParticle(d, c);
+		ps4.addParticle(d, c);
+	}
+	ps4.groupByFace();
+
+	std::vector<VEC3> goals1(ps1.size()), goals4(ps4.size());
+	for (unsigned int step = 0; step < 3; ++step)
+	{
+		VEC3 shift(0.37, -0.23, 0.0);
+		for (unsigned int i = 0; i < ps1.size(); ++i)
+		{
+			VEC3 g = ps1.getPosition(i) + shift;
+			if (g[0] > 3.9) g[0] -= 7.3;
+			if (g[1] < -3.9) g[1] += 7.1;
+			goals1[i] = g;
+		}
+		for (unsigned int i = 0; i < ps4.size(); ++i)
+			goals4[i] = goals1[ps4.getId(i)];
+		ps1.move(goals1);
+		ps4.move(goals4);
+	}
+
+	for (unsigned int i = 0; i < ps4.size(); ++i)
+	{
+		unsigned int j = ps4.getId(i);
+		if (ps4.getCell(i) != ps1.getCell(j) || ps4.getPosition(i) != ps1.getPosition(j))
+			return 1;
+	}
+	if (ps1.getCrossings().empty())
+		return 1;
+
+	return 0;
+}
@@ -22,9 +22,9 @@ struct PFP3 : public PFP_DOUBLE
 	typedef EmbeddedGMap2 MAP;
 };
 
-// TODO modif ProgressiveMesh
-//template class Algo::Surface::PMesh::ProgressiveMesh<PFP1>;
-//template class Algo::Surface::PMesh::ProgressiveMesh<PFP2>;
+template class Algo::Surface::PMesh::ProgressiveMesh<PFP1>;
+template class Algo::Surface::PMesh::ProgressiveMesh<PFP2>;
+// TODO modif ProgressiveMesh (decimation selectors do not compile with GMap2)
 //template class Algo::Surface::PMesh::ProgressiveMesh<PFP3>;
 
 
@@ -26,6 +26,9 @@ struct PFP3 : public PFP_DOUBLE
 template void  Algo::Surface::Remeshing::pliantRemeshing<PFP1>(PFP1::MAP& map, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, VertexAttribute<PFP1::VEC3, PFP1::MAP>& normal);
 template void  Algo::Surface::Remeshing::pliantRemeshing<PFP2>(PFP2::MAP& map, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, VertexAttribute<PFP2::VEC3, PFP2::MAP>& normal);
 template void  Algo::Surface::Remeshing::pliantRemeshing<PFP3>(PFP3::MAP& map, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, VertexAttribute<PFP3::VEC3, PFP3::MAP>& normal);
+template void  Algo::Surface::Remeshing::isotropicRemeshing<PFP1>(PFP1::MAP& map, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, VertexAttribute<PFP1::VEC3, PFP1::MAP>& normal, VertexAttribute<PFP1::REAL, PFP1::MAP>& targetLength, unsigned int nbIterations, unsigned int nbThreads);
+template void  Algo::Surface::Remeshing::isotropicRemeshing<PFP2>(PFP2::MAP& map, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, VertexAttribute<PFP2::VEC3, PFP2::MAP>& normal, VertexAttribute<PFP2::REAL, PFP2::MAP>& targetLength, unsigned int nbIterations, unsigned int nbThreads);
+template void  Algo::Surface::Remeshing::isotropicRemeshing<PFP3>(PFP3::MAP& map, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, VertexAttribute<PFP3::VEC3, PFP3::MAP>& normal, VertexAttribute<PFP3::REAL, PFP3::MAP>& targetLength, unsigned int nbIterations, unsigned int nbThreads);
 
 
 int test_pliant()
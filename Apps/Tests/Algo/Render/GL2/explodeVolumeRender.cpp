@@ -18,6 +18,13 @@ typedef VolumeAttribute<Geom::Vec3f, PFP1::MAP> WATT1;
 
 template void Algo::Render::GL2::ExplodeVolumeRender::updateData<PFP1,VATT1>(PFP1::MAP& map, const VATT1& positions);
 template void Algo::Render::GL2::ExplodeVolumeRender::updateData<PFP1,VATT1,WATT1>(PFP1::MAP& map, const VATT1& positions, const WATT1& colorPerFace);
+template void Algo::Render::GL2::ExplodeVolumeRender::updateVolumes<PFP1, VATT1>(PFP1::MAP& map, const VATT1& positions, const std::vector<Dart>& volumes);
+template void Algo::Render::GL2::ExplodeVolumeRender::updateVolumes<PFP1, VATT1, WATT1>(PFP1::MAP& map, const VATT1& positions, const WATT1& colorPerFace, const std::vector<Dart>& volumes);
+
+// color per face
+typedef FaceAttribute<Geom::Vec3f, PFP1::MAP> FATT1;
+template void Algo::Render::GL2::ExplodeVolumeRender::updateData<PFP1,VATT1,FATT1>(PFP1::MAP& map, const VATT1& positions, const FATT1& colorPerFace);
+template void Algo::Render::GL2::ExplodeVolumeRender::updateVolumes<PFP1, VATT1, FATT1>(PFP1::MAP& map, const VATT1& positions, const FATT1& colorPerFace, const std::vector<Dart>& volumes);
 
 
 
@@ -30,6 +37,8 @@ typedef VolumeAttribute<Geom::Vec3d, PFP2::MAP> WATT2;
 
 template void Algo::Render::GL2::ExplodeVolumeRender::updateData<PFP2, VATT2>(PFP2::MAP& map, const VATT2& positions);
 template void Algo::Render::GL2::ExplodeVolumeRender::updateData<PFP2, VATT2, WATT2>(PFP2::MAP& map, const VATT2& positions, const WATT2& colorPerFace);
+template void Algo::Render::GL2::ExplodeVolumeRender::updateVolumes<PFP2, VATT2>(PFP2::MAP& map, const VATT2& positions, const std::vector<Dart>& volumes);
+template void Algo::Render::GL2::ExplodeVolumeRender::updateVolumes<PFP2, VATT2, WATT2>(PFP2::MAP& map, const VATT2& positions, const WATT2& colorPerFace, const std::vector<Dart>& volumes);
 
 
 
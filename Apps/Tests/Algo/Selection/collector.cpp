@@ -26,6 +26,8 @@ struct PFP3 : public PFP_DOUBLE
 template class Algo::Surface::Selection::Collector_OneRing<PFP1>;
 template class Algo::Surface::Selection::Collector_OneRing_AroundEdge<PFP1>;
 template class Algo::Surface::Selection::Collector_WithinSphere<PFP1>;
+template class Algo::Surface::Selection::CollectorCache_WithinSphere<PFP1>;
+template class Algo::Surface::Selection::CollectorCache_OneRing<PFP1>;
 template class Algo::Surface::Selection::Collector_NormalAngle<PFP1>;
 template class Algo::Surface::Selection::Collector_NormalAngle_Triangles<PFP1>;
 template class Algo::Surface::Selection::CollectorCriterion_VertexNormalAngle<PFP1>;
@@ -39,6 +41,8 @@ template class Algo::Surface::Selection::Collector_Dijkstra<PFP1>;
 template class Algo::Surface::Selection::Collector_OneRing<PFP2>;
 template class Algo::Surface::Selection::Collector_OneRing_AroundEdge<PFP2>;
 template class Algo::Surface::Selection::Collector_WithinSphere<PFP2>;
+template class Algo::Surface::Selection::CollectorCache_WithinSphere<PFP2>;
+template class Algo::Surface::Selection::CollectorCache_OneRing<PFP2>;
 template class Algo::Surface::Selection::Collector_NormalAngle<PFP2>;
 template class Algo::Surface::Selection::Collector_NormalAngle_Triangles<PFP2>;
 template class Algo::Surface::Selection::CollectorCriterion_VertexNormalAngle<PFP2>;
@@ -53,6 +57,8 @@ template class Algo::Surface::Selection::Collector_Dijkstra<PFP2>;
 template class Algo::Surface::Selection::Collector_OneRing<PFP3>;
 template class Algo::Surface::Selection::Collector_OneRing_AroundEdge<PFP3>;
 template class Algo::Surface::Selection::Collector_WithinSphere<PFP3>;
+template class Algo::Surface::Selection::CollectorCache_WithinSphere<PFP3>;
+template class Algo::Surface::Selection::CollectorCache_OneRing<PFP3>;
 template class Algo::Surface::Selection::Collector_NormalAngle<PFP3>;
 template class Algo::Surface::Selection::Collector_NormalAngle_Triangles<PFP3>;
 template class Algo::Surface::Selection::CollectorCriterion_VertexNormalAngle<PFP3>;
@@ -39,8 +39,21 @@ template class Algo::Surface::Tilings::Triangular::Cube<PFP3>;
 template class Algo::Surface::Tilings::Triangular::Tore<PFP3>;
 
 
+// the open grids of the top and bottom faces are sewn to the sides
+template <typename PFP>
+bool testCube(unsigned int x, unsigned int y, unsigned int z)
+{
+	typename PFP::MAP map;
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP> position = map.template addAttribute<typename PFP::VEC3, VERTEX, typename PFP::MAP>("position");
+	Algo::Surface::Tilings::Triangular::Cube<PFP> cube(map, x, y, z);
+	cube.embedIntoCube(position, 1.0f, 1.0f, 1.0f);
+	return map.check();
+}
+
 int test_triangular()
 {
+	if (!testCube<PFP1>(1, 1, 1) || !testCube<PFP1>(4, 3, 2) || !testCube<PFP2>(5, 6, 7))
+		return 1;
 	return 0;
 }
 
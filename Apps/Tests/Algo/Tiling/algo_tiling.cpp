@@ -4,14 +4,16 @@ extern int test_square();
 extern int test_triangular();
 extern int test_hexagonal();
 extern int test_cubic();
+extern int test_bulkGrid();
 
 int main()
 {
-	test_square();
-	test_triangular();
-	test_hexagonal();
-	test_cubic();
+	int r = 0;
+	r |= test_square();
+	r |= test_triangular();
+	r |= test_hexagonal();
+	r |= test_cubic();
+	r |= test_bulkGrid();
 
-
-	return 0;
+	return r;
 }
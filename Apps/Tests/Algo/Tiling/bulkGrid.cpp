@@ -0,0 +1,33 @@
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/map/embeddedMap3.h"
+#include "Topology/gmap/embeddedGMap2.h"
+
+#include "Algo/Tiling/bulkGrid.h"
+
+using namespace CGoGN;
+
+template bool Algo::Surface::Tilings::bulkGrid<EmbeddedMap2>(EmbeddedMap2&, unsigned int, unsigned int, const std::vector< std::vector<unsigned int> >&, bool, std::vector<Dart>&, std::vector<Dart>&, unsigned int);
+template bool Algo::Surface::Tilings::bulkGrid<EmbeddedGMap2>(EmbeddedGMap2&, unsigned int, unsigned int, const std::vector< std::vector<unsigned int> >&, bool, std::vector<Dart>&, std::vector<Dart>&, unsigned int);
+template bool Algo::Volume::Tilings::bulkHexaGrid<EmbeddedMap3>(EmbeddedMap3&, unsigned int, unsigned int, unsigned int, std::vector<Dart>&, unsigned int);
+
+
+int test_bulkGrid()
+{
+	EmbeddedMap3 map;
+	std::vector<Dart> vertexDarts;
+	if (!Algo::Volume::Tilings::bulkHexaGrid(map, 2, 3, 4, vertexDarts))
+		return 1;
+
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	{
+		if (map.phi_1(map.phi1(d)) != d || map.phi2(map.phi2(d)) != d || map.phi3(map.phi3(d)) != d)
+			return 1;
+	}
+
+	// 24 darts per hexahedron and 4 per boundary face
+	if (map.getNbDarts() != 24*2*3*4 + 4*2*(2*3 + 3*4 + 2*4) || vertexDarts.size() != 3*4*5)
+		return 1;
+
+	return 0;
+}
@@ -4,6 +4,9 @@
 
 #include "Algo/Topo/Map2/uniformOrientation.h"
 
+#include <iostream>
+#include <map>
+
 using namespace CGoGN;
 
 template void Algo::Topo::uniformOrientationCC<EmbeddedMap2>(EmbeddedMap2& map, Dart faceSeed);
@@ -12,7 +15,95 @@ template void Algo::Topo::uniformOrientationCC<EmbeddedMap2>(EmbeddedMap2& map,
 //template void Algo::Topo::uniformOrientationCC<EmbeddedGMap2>(EmbeddedGMap2& map, Dart faceSeed);
 
 
-int test_uniformOrientation()
+// triangles of a n x n grid, one over two (pseudo randomly) reversed:
+// only the couples of triangles with compatible orientations are sewn (as done by an import)
+Dart buildMixedGrid(EmbeddedMap2& map, unsigned int n)
+{
+	map.addEmbedding<VERTEX>();
+	std::vector<unsigned int> vEmb((n + 1) * (n + 1));
+	for (unsigned int i = 0; i < vEmb.size(); ++i)
+		vEmb[i] = map.newCell<VERTEX>();
+
+	std::map<std::pair<unsigned int, unsigned int>, Dart> edges;
+	unsigned int seed = 7;
+	for (unsigned int j = 0; j < n; ++j)
+	{
+		for (unsigned int i = 0; i < n; ++i)
+		{
+			unsigned int a = vEmb[j * (n + 1) + i];
+			unsigned int b = vEmb[j * (n + 1) + i + 1];
+			unsigned int c = vEmb[(j + 1) * (n + 1) + i + 1];
+			unsigned int d = vEmb[(j + 1) * (n + 1) + i];
+			unsigned int tris[2][3] = { { a, b, c }, { a, c, d } };
+			for (unsigned int t = 0; t < 2; ++t)
+			{
+				seed = seed * 1103515245u + 12345u;
+				if ((seed >> 16) & 1)
+					std::swap(tris[t][1], tris[t][2]);
+
+				Dart f = map.newFace(3);
+				Dart x = f;
+				for (unsigned int k = 0; k < 3; ++k)
+				{
+					map.setDartEmbedding<VERTEX>(x, tris[t][k]);
+					map.setDartEmbedding<VERTEX>(map.phi2(x), tris[t][(k + 1) % 3]);
+					x = map.phi1(x);
+				}
+				for (unsigned int k = 0; k < 3; ++k)
+				{
+					std::map<std::pair<unsigned int, unsigned int>, Dart>::iterator it = edges.find(std::make_pair(tris[t][(k + 1) % 3], tris[t][k]));
+					if (it != edges.end())
+						map.sewFaces(x, it->second);
+					else
+						edges[std::make_pair(tris[t][k], tris[t][(k + 1) % 3])] = x;
+					x = map.phi1(x);
+				}
+			}
+		}
+	}
+	return map.begin();
+}
+
+int testUniformOrientation(unsigned int n)
 {
+	EmbeddedMap2 map;
+	Dart seed = buildMixedGrid(map, n);
+	while (map.isBoundaryMarked<2>(seed))
+		map.next(seed);
+
+	Algo::Topo::uniformOrientationCC<EmbeddedMap2>(map, seed);
+
+	if (!map.check())
+	{
+		std::cerr << "uniformOrientationCC: invalid map" << std::endl;
+		return 1;
+	}
+
+	// everything is sewn but the border of the grid, with vertex embeddings that agree
+	unsigned int nbBoundaryEdges = 0;
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	{
+		if (map.isBoundaryMarked<2>(d))
+			++nbBoundaryEdges;
+		if (map.getEmbedding<VERTEX>(map.phi2(d)) != map.getEmbedding<VERTEX>(map.phi1(d)))
+		{
+			std::cerr << "uniformOrientationCC: inconsistent vertex embedding" << std::endl;
+			return 1;
+		}
+	}
+	if (nbBoundaryEdges != 4 * n)
+	{
+		std::cerr << "uniformOrientationCC: " << nbBoundaryEdges << " boundary edges instead of " << 4 * n << std::endl;
+		return 1;
+	}
 	return 0;
 }
+
+int test_uniformOrientation()
+{
+	int r = 0;
+	r |= testUniformOrientation(1);
+	r |= testUniformOrientation(5);
+	r |= testUniformOrientation(40);
+	return r;
+}
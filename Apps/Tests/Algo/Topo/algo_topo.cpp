@@ -7,11 +7,11 @@ extern int test_uniformOrientation();
 
 int main()
 {
-	test_basic();
-	test_embedding();
-	test_simplex();
-	test_uniformOrientation();
+	int r = 0;
+	r |= test_basic();
+	r |= test_embedding();
+	r |= test_simplex();
+	r |= test_uniformOrientation();
 
-
-	return 0;
+	return r;
 }
@@ -21,6 +21,41 @@ template class AttributeMultiVector< NoTypeNameAttribute<std::vector<Geom::Vec2i
 
 int test_attributeMultiVector()
 {
+	using namespace CGoGN;
+
+	// dirty tracking & range coalescing
+	AttributeMultiVector<float> amv("dirty", "float");
+	amv.setNbBlocks(3);
+	amv.setDirtyTracking(true);
+	amv.clearDirty();
+	if (amv.isDirty())
+		return 1;
+
+	amv.markDirty(10);
+	amv.markDirty(11);
+	amv.markDirty(12, 20);
+	amv.markDirty(5000);
+	amv.initElt(9000);
+
+	std::vector< std::pair<unsigned int, unsigned int> > ranges;
+	amv.getDirtyRanges(ranges);
+	if (ranges.size() != 3 || ranges[0] != std::make_pair(10u, 20u) || ranges[2] != std::make_pair(9000u, 9001u))
+		return 1;
+
+	amv.getDirtyRanges(ranges, 5000);
+	if (ranges.size() != 1 || ranges[0] != std::make_pair(10u, 9001u))
+		return 1;
+
+	// const access does not flag, non-const access flags the whole block
+	amv.clearDirty();
+	const AttributeMultiVector<float>& camv = amv;
+	float f = camv[100];
+	if (amv.isDirty())
+		return 1;
+	amv[4100] = f;
+	amv.getDirtyRanges(ranges);
+	if (ranges.size() != 1 || ranges[0] != std::make_pair(_BLOCKSIZE_, 2 * _BLOCKSIZE_) || amv.isBlockDirty(0))
+		return 1;
 
 	return 0;
 }
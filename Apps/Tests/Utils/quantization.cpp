@@ -1,21 +1,92 @@
 #include "Utils/quantization.h"
 #include "Geometry/vector_gen.h"
 
+#include <random>
+#include <cmath>
+
 using namespace CGoGN;
 
-//template struct Utils::CodeVector<Geom::Vec3f>;
-//template struct Utils::CodeVector<Geom::Vec3d>;
-//template struct Utils::CodeVector<Geom::Vec4d>;
+template struct Utils::CodeVector<Geom::Vec3f>;
+template struct Utils::CodeVector<Geom::Vec3d>;
+template struct Utils::CodeVector<Geom::Vec4d>;
 
+template class Utils::CodeVectorKDTree<Geom::Vec3f>;
+template class Utils::CodeVectorKDTree<Geom::Vec3d>;
+template class Utils::CodeVectorKDTree<Geom::Vec4d>;
 
 
-//template class Utils::Quantization<Geom::Vec3f>;
-//template class Utils::Quantization<Geom::Vec3d>;
-//template class Utils::Quantization<Geom::Vec4d>;
 
+template class Utils::Quantization<Geom::Vec3f>;
+template class Utils::Quantization<Geom::Vec3d>;
+template class Utils::Quantization<Geom::Vec4d>;
 
-int test_quantization()
+
+// the regions and the distortion must describe the returned codebook
+template <typename VEC>
+int testRegions(unsigned int nbSource, unsigned int nbRegions, bool miniBatch)
 {
+	std::mt19937 gen(1) ;
+	std::uniform_real_distribution<float> coord(-1.0f, 1.0f) ;
+	std::vector<VEC> source(nbSource) ;
+	for(unsigned int i = 0; i < nbSource; ++i)
+		for(unsigned int k = 0; k < VEC::DIMENSION; ++k)
+			source[i][k] = coord(gen) ;
+
+	Utils::Quantization<VEC> q(source) ;
+	std::vector<VEC> result ;
+	if(miniBatch)
+		q.vectorQuantizationMiniBatch(nbRegions, nbSource / 4, 20, result) ;
+	else
+		q.vectorQuantizationNbRegions(nbRegions, result) ;
 
-	return 0;
+	std::vector<VEC> codebook ;
+	std::vector<unsigned int> codes ;
+	q.getCodebook(codebook, codes) ;
+
+	double dist = 0.0 ;
+	for(unsigned int i = 0; i < nbSource; ++i)
+	{
+		double d = (source[i] - codebook[codes[i]]).norm2() ;
+		dist += d ;
+		for(unsigned int j = 0; j < codebook.size(); ++j)
+		{
+			if((source[i] - codebook[j]).norm2() < d * (1.0 - 1e-5))
+			{
+				std::cerr << "source vector " << i << " not associated to its nearest code vector" << std::endl ;
+				return 1 ;
+			}
+		}
+	}
+	dist /= nbSource ;
+
+	if(std::fabs(dist - q.getDistortion()) > 1e-4 * dist)
+	{
+		std::cerr << "distortion " << q.getDistortion() << " instead of " << dist << std::endl ;
+		return 1 ;
+	}
+	return 0 ;
+}
+
+int testEmptyMiniBatch()
+{
+	std::vector<Geom::Vec3f> source ;
+	Utils::Quantization<Geom::Vec3f> q(source) ;
+	std::vector<Geom::Vec3f> result(3) ;
+	q.vectorQuantizationMiniBatch(4, 16, 10, result) ;
+	if(!result.empty() || q.getNbCodeVectors() != 0)
+	{
+		std::cerr << "mini-batch quantization of an empty set" << std::endl ;
+		return 1 ;
+	}
+	return 0 ;
+}
+
+int test_quantization()
+{
+	int r = 0 ;
+	r |= testRegions<Geom::Vec3f>(2000, 16, false) ;
+	r |= testRegions<Geom::Vec3d>(1000, 37, false) ;
+	r |= testRegions<Geom::Vec3d>(4000, 16, true) ;
+	r |= testEmptyMiniBatch() ;
+	return r ;
 }
@@ -1,4 +1,5 @@
 #include "Utils/sphericalHarmonics.h"
+#include "Geometry/vector_gen.h"
 
 
 template class CGoGN::Utils::SphericalHarmonics<float, float>;
@@ -6,10 +7,14 @@ template class CGoGN::Utils::SphericalHarmonics<double, double>;
 template class CGoGN::Utils::SphericalHarmonics<float, double>;
 template class CGoGN::Utils::SphericalHarmonics<double, float>;
 
+template class CGoGN::Utils::SphericalHarmonicsBatch<float, float>;
+template class CGoGN::Utils::SphericalHarmonicsBatch<double, double>;
+template class CGoGN::Utils::SphericalHarmonicsBatch<float, CGoGN::Geom::Vec3f>;
+template class CGoGN::Utils::SphericalHarmonicsBatch<double, CGoGN::Geom::Vec3d>;
+
 
 int test_sphericalHarmonics()
 {
 
 	return 0;
 }
-
@@ -14,13 +14,14 @@ extern int test_texture();
 
 int main()
 {
-	//test_colorMaps();
-	test_colourConverter();
-	test_qem();
-	test_quadricRGBfunctions();
-	test_quantization();
-//	test_shared_mem();
-	test_sphericalHarmonics();
-	test_texture();
-	return 0;
+	int r = 0;
+	//r |= test_colorMaps();
+	r |= test_colourConverter();
+	r |= test_qem();
+	r |= test_quadricRGBfunctions();
+	r |= test_quantization();
+//	r |= test_shared_mem();
+	r |= test_sphericalHarmonics();
+	r |= test_texture();
+	return r;
 }
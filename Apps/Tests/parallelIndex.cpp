@@ -0,0 +1,87 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <vector>
+#include <atomic>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/square.h"
+
+using namespace CGoGN ;
+
+struct PFP2: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP2::MAP MAP;
+typedef PFP2::VEC3 VEC3;
+
+// run foreach_index with nbth threads: each index must be processed once, by a thread
+// whose index in the map stays in the per thread pools (markers are used in func)
+bool testForeachIndex(MAP& myMap, const std::vector<Dart>& faces, unsigned int nbth)
+{
+	std::vector<unsigned int> count(faces.size(), 0);
+	std::atomic<unsigned int> errors(0);
+
+	Parallel::foreach_index(myMap, (unsigned int)(faces.size()), [&] (unsigned int i, unsigned int thr)
+	{
+		if (thr >= nbth || myMap.getCurrentThreadIndex() >= NB_THREADS)
+			++errors;
+		DartMarkerStore<MAP> dm(myMap);
+		dm.markOrbit(Face(faces[i]));
+		++count[i];
+	}, nbth);
+
+	for (unsigned int c : count)
+		if (c != 1)
+			++errors;
+
+	if (errors > 0)
+		CGoGNerr << "foreach_index with " << nbth << " threads: " << errors << " errors" << CGoGNendl;
+	return errors == 0;
+}
+
+int main()
+{
+	MAP myMap;
+	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::Tilings::Square::Grid<PFP2> grid(myMap, 20, 20, true);
+	grid.embedIntoGrid(position, 1.0f, 1.0f, 0.0f);
+
+	std::vector<Dart> faces;
+	foreach_cell<FACE>(myMap, [&] (Face f) { faces.push_back(f.dart); });
+
+	bool ok = true;
+	const unsigned int nbths[] = { 1, 2, 15, NB_THREADS, NB_THREADS + 1, 2 * NB_THREADS + 3 };
+	for (unsigned int nbth : nbths)
+		ok = testForeachIndex(myMap, faces, nbth) && ok;
+
+	if (ok)
+		CGoGNout << "foreach_index: OK" << CGoGNendl;
+
+	return ok ? 0 : 1;
+}
@@ -218,6 +218,7 @@ int decimate(
 	void* callback_object
 )
 {
+	CGoGN_SCOPED_TIMER("Algo::Surface::Decimation::decimate");
 	for(typename std::vector<ApproximatorGen<PFP>*>::iterator it = approximators.begin(); it != approximators.end(); ++it)
 		(*it)->init() ;
 
@@ -331,10 +331,45 @@ bool EdgeSelector_QEM<PFP>::init()
 
 	edges.clear() ;
 
+	// init the edges with their optimal position by batches
+	std::vector<Dart> batch ;
 	for (Edge e : allEdgesOf(m))
 	{
-		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
+		if(m.edgeCanCollapse(e.dart))
+			batch.push_back(e.dart) ;
+		else
+			edgeInfo[e.dart] = EdgeInfo() ;
+	}
+
+	// the QEM approximator only writes the approximation of its edge:
+	// the approximations can be computed in parallel
+	unsigned int nbth = m_positionApproximator.getType() == A_QEM ? CGoGN::Parallel::NumberOfThreads : 1 ;
+	CGoGN::Parallel::foreach_index(m, (unsigned int)(batch.size()), [&] (unsigned int i, unsigned int)
+	{
+		m_positionApproximator.approximate(batch[i]) ;
+	}, nbth) ;
+
+	unsigned int nb = (unsigned int)(batch.size()) ;
+	std::vector<const Utils::Quadric<REAL>*> q1(nb), q2(nb) ;
+	std::vector<VEC3> approx(nb) ;
+	std::vector<REAL> err(nb) ;
+	for (unsigned int i = 0; i < nb; ++i)
+	{
+		Dart d = batch[i] ;
+		q1[i] = &(quadric[d]) ;
+		q2[i] = &(quadric[m.phi2(d)]) ;
+		approx[i] = m_positionApproximator.getApprox(d) ;
+	}
+	if (nb > 0)
+		Utils::Quadric<REAL>::evaluate(nb, &q1[0], &q2[0], &approx[0], &err[0]) ;
+
+	// and insert them in the multimap according to their error
+	for (unsigned int i = 0; i < nb; ++i)
+	{
+		EdgeInfo& einfo = edgeInfo[batch[i]] ;
+		einfo.it = edges.insert(std::make_pair(err[i], batch[i])) ;
+		einfo.valid = true ;
+	}
 
 	cur = edges.begin() ; // init the current edge to the first one
 
@@ -481,13 +516,13 @@ void EdgeSelector_QEM<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 
 	Dart dd = m.phi2(d) ;
 
-	Utils::Quadric<REAL> quad ;
-	quad += quadric[d] ;	// compute the sum of the
-	quad += quadric[dd] ;	// two vertices quadrics
-
 	m_positionApproximator.approximate(d) ;
 
-	REAL err = quad(m_positionApproximator.getApprox(d)) ;
+	// error of the sum of the two vertices quadrics
+	const Utils::Quadric<REAL>* q1 = &(quadric[d]) ;
+	const Utils::Quadric<REAL>* q2 = &(quadric[dd]) ;
+	REAL err ;
+	Utils::Quadric<REAL>::evaluate(1, &q1, &q2, &(m_positionApproximator.getApprox(d)), &err) ;
 
 	einfo.it = edges.insert(std::make_pair(err, d)) ;
 	einfo.valid = true ;
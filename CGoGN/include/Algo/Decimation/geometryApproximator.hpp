@@ -59,9 +59,13 @@ void Approximator_QEM<PFP>::approximate(Dart d)
 	// get some darts
 	Dart dd = m.phi2(d) ;
 
-	Utils::Quadric<REAL> q1, q2 ;
+	Utils::Quadric<REAL> quad ;
+	VEC3 res ;
+	bool opt ;
 	if(!m_quadric.isValid()) // if the selector is not QEM, compute local error quadrics
 	{
+		Utils::Quadric<REAL> q1, q2 ;
+
 		// compute the error quadric associated to v1
 		Dart it = d ;
 		do
@@ -79,19 +83,22 @@ void Approximator_QEM<PFP>::approximate(Dart d)
 			q2 += q ;
 			it = m.phi2_1(it) ;
 		} while(it != dd) ;
+
+		quad += q1 ;    // compute the sum of the
+		quad += q2 ;    // two vertices quadrics
+		opt = quad.findOptimizedPos(res) ; // try to compute an optimized position for the contraction of this edge
 	}
 	else // if the selector is QEM, use the error quadrics computed by the selector
 	{
-		q1 = m_quadric[d] ;
-		q2 = m_quadric[dd] ;
+		// the sum is only built if the optimization fails
+		opt = Utils::Quadric<REAL>::findOptimizedPos(m_quadric[d], m_quadric[dd], res) ;
+		if(!opt)
+		{
+			quad += m_quadric[d] ;
+			quad += m_quadric[dd] ;
+		}
 	}
 
-	Utils::Quadric<REAL> quad ;
-	quad += q1 ;    // compute the sum of the
-	quad += q2 ;    // two vertices quadrics
-
-	VEC3 res ;
-	bool opt = quad.findOptimizedPos(res) ; // try to compute an optimized position for the contraction of this edge
 	if(!opt)
 	{
 		VEC3 p1 = this->m_attr[d] ;    // let the new vertex lie
@@ -329,6 +329,7 @@ bool exportPLYnew(typename PFP::MAP& map, const std::vector<VertexAttribute<type
 template <typename PFP>
 bool exportOFF(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename)
 {
+	CGoGN_SCOPED_TIMER("Algo::Surface::Export::exportOFF");
 	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
 	
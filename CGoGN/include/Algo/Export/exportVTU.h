@@ -62,10 +62,19 @@ bool exportVTU(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3,
 * @return true if ok
 */
 template <typename PFP>
-bool exportVTUBinary(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename);
+bool exportVTUBinary(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename, unsigned int nbThreads = CGoGN::Parallel::NumberOfThreads);
 
-//template <typename PFP>
-//bool exportVTUCompressed(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, const char* filename);
+/**
+* export of the geometry of map into a binary VTU file with zlib compressed appended data
+* (vtkZLibDataCompressor: data split in independent blocks, compressed in parallel)
+* @param map map to be exported
+* @param position the position container
+* @param filename filename of vtu file
+* @param nbThreads number of threads used to gather and compress the data
+* @return true if ok
+*/
+template <typename PFP>
+bool exportVTUCompressed(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename, unsigned int nbThreads = CGoGN::Parallel::NumberOfThreads);
 
 /**
  * class that allow the export of VTU file (ascii or binary)
@@ -217,77 +217,118 @@ bool exportVTU(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3,
 
 
 
+// private function: gather in parallel the positions (as floats) and the cells of a surface
+// (triangles, then quads, then other polygons, each in traversal order)
 template <typename PFP>
-bool exportVTUBinary(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename)
+unsigned int gatherVTUBuffers(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	std::vector<float>& points, std::vector<int>& connectivity, std::vector<int>& offsets, std::vector<unsigned char>& types, unsigned int nbth)
 {
-	if (map.dimension() != 2)
-	{
-		CGoGNerr << "Surface::Export::exportVTU works only with map of dimension 2"<< CGoGNendl;
-		return false;
-	}
-
 	typedef typename PFP::MAP MAP;
-	typedef typename PFP::VEC3 VEC3;
-
-	// open file
-	std::ofstream fout ;
-	fout.open(filename, std::ios_base::out | std::ios_base::trunc) ;
-
-	if (!fout.good())
-	{
-		CGoGNerr << "Unable to open file " << filename << CGoGNendl ;
-		return false ;
-	}
 
 	VertexAutoAttribute<unsigned int,MAP> indices(map,"indices_vert");
 
-	unsigned int count=0;
+	std::vector<unsigned int> vertices;
+	vertices.reserve(position.nbElements());
 	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
 	{
-		indices[i] = count++;
+		indices[i] = (unsigned int)(vertices.size());
+		vertices.push_back(i);
 	}
 
-	std::vector<unsigned int> triangles;
-	std::vector<unsigned int> quads;
-	std::vector<unsigned int> others;
-	std::vector<unsigned int> others_begin;
-	triangles.reserve(2048);
-	quads.reserve(2048);
-	others.reserve(2048);
-	others_begin.reserve(2048);
+	points.resize(3 * vertices.size());
+	CGoGN::Parallel::foreach_index(map, (unsigned int)(vertices.size()), [&] (unsigned int i, unsigned int)
+	{
+		const typename PFP::VEC3& P = position[vertices[i]];
+		points[3*i] = float(P[0]);
+		points[3*i+1] = float(P[1]);
+		points[3*i+2] = float(P[2]);
+	}, nbth);
 
+	std::vector<Dart> faces;
 	TraversorF<MAP> trav(map) ;
 	for(Dart d = trav.begin(); d != trav.end(); d = trav.next())
+		faces.push_back(d);
+	unsigned int nbf = (unsigned int)(faces.size());
+
+	std::vector<unsigned int> degree(nbf);
+	CGoGN::Parallel::foreach_index(map, nbf, [&] (unsigned int i, unsigned int)
 	{
-		unsigned int degree = map.faceDegree(d);
-		Dart f=d;
-		switch(degree)
-		{
-			case 3:
-				triangles.push_back(indices[f]); f = map.phi1(f);
-				triangles.push_back(indices[f]); f = map.phi1(f);
-				triangles.push_back(indices[f]);
-				break;
-			case 4:
-				quads.push_back(indices[f]); f = map.phi1(f);
-				quads.push_back(indices[f]); f = map.phi1(f);
-				quads.push_back(indices[f]); f = map.phi1(f);
-				quads.push_back(indices[f]);
-				break;
+		degree[i] = map.faceDegree(faces[i]);
+	}, nbth);
 
-			default:
-				others_begin.push_back((unsigned int)(others.size()));
-				do
-				{
-					others.push_back(indices[f]); f = map.phi1(f);
+	// rank of each face in the cells (triangles, quads, others) and start of its indices
+	unsigned int nbTri = 0, nbQuad = 0;
+	for (unsigned int i = 0; i < nbf; ++i)
+	{
+		if (degree[i] == 3)
+			++nbTri;
+		else if (degree[i] == 4)
+			++nbQuad;
+	}
+	unsigned int cellTri = 0, cellQuad = nbTri, cellOther = nbTri + nbQuad;
+	std::vector<unsigned int> cell(nbf);
+	for (unsigned int i = 0; i < nbf; ++i)
+	{
+		if (degree[i] == 3)
+			cell[i] = cellTri++;
+		else if (degree[i] == 4)
+			cell[i] = cellQuad++;
+		else
+			cell[i] = cellOther++;
+	}
 
-				} while (f!=d);
-				break;
+	offsets.resize(nbf);
+	types.resize(nbf);
+	std::vector<unsigned int> sizes(nbf);
+	for (unsigned int i = 0; i < nbf; ++i)
+		sizes[cell[i]] = degree[i];
+	unsigned int offset = 0;
+	for (unsigned int c = 0; c < nbf; ++c)
+	{
+		offset += sizes[c];
+		offsets[c] = int(offset);
+		types[c] = sizes[c] == 3 ? (unsigned char)5 : (sizes[c] == 4 ? (unsigned char)9 : (unsigned char)7);
+	}
+
+	connectivity.resize(offset);
+	CGoGN::Parallel::foreach_index(map, nbf, [&] (unsigned int i, unsigned int)
+	{
+		unsigned int k = offsets[cell[i]] - degree[i];
+		Dart f = faces[i];
+		for (unsigned int j = 0; j < degree[i]; ++j)
+		{
+			connectivity[k++] = int(indices[f]);
+			f = map.phi1(f);
 		}
+	}, nbth);
+
+	return nbf;
+}
+
+template <typename PFP>
+bool exportVTUBinary(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename, unsigned int nbThreads)
+{
+	if (map.dimension() != 2)
+	{
+		CGoGNerr << "Surface::Export::exportVTU works only with map of dimension 2"<< CGoGNendl;
+		return false;
+	}
+
+	// open file
+	std::ofstream fout ;
+	fout.open(filename, std::ios_base::out | std::ios_base::trunc) ;
+
+	if (!fout.good())
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl ;
+		return false ;
 	}
-	others_begin.push_back(uint32(others.size()));
 
-	unsigned int nbtotal = uint32(triangles.size() / 3 + quads.size() / 4 + others_begin.size() - 1);
+	std::vector<float> points;
+	std::vector<int> connectivity;
+	std::vector<int> offsets;
+	std::vector<unsigned char> types;
+	unsigned int nbtotal = gatherVTUBuffers<PFP>(map, position, points, connectivity, offsets, types, nbThreads);
 
 	fout << "<?xml version=\"1.0\"?>" << std::endl;
 	fout << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">" << std::endl;
@@ -296,43 +337,17 @@ bool exportVTUBinary(typename PFP::MAP& map, const VertexAttribute<typename PFP:
 	fout << "<Points>" << std::endl;
 	fout << "<DataArray type =\"Float32\" Name =\"Position\" NumberOfComponents =\"3\" format =\"appended\" offset =\"0\"/>"  << std::endl;
 
-	unsigned int offsetAppend = position.nbElements() * 3 * sizeof(float) + sizeof(unsigned int);	// Data + sz of blk
+	unsigned int offsetAppend = uint32(points.size() * sizeof(float) + sizeof(unsigned int));	// Data + sz of blk
 
 	fout << "</Points>" << std::endl;
 
 	fout << "<Cells>" << std::endl;
 
-	std::vector<int> bufferInt;
-	bufferInt.reserve(triangles.size()+quads.size()+others.size());
-
-	for (unsigned int i=0; i<triangles.size(); i+=3)
-	{
-		bufferInt.push_back(triangles[i]);
-		bufferInt.push_back(triangles[i+1]);
-		bufferInt.push_back(triangles[i+2]);
-	}
-
-	for (unsigned int i=0; i<quads.size(); i+=4)
-	{
-		bufferInt.push_back(quads[i]);
-		bufferInt.push_back(quads[i+1]);
-		bufferInt.push_back(quads[i+2]);
-		bufferInt.push_back(quads[i+3]);
-	}
-
-	for (unsigned int i=1; i<others_begin.size(); ++i)
-	{
-		unsigned int beg = others_begin[i-1];
-		unsigned int end = others_begin[i];
-		for (unsigned int j=beg; j<end; ++j)
-			bufferInt.push_back(others[j]);
-	}
-
 	fout << "<DataArray type =\"Int32\" Name =\"connectivity\" format =\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
-	offsetAppend += uint32(bufferInt.size() * sizeof(unsigned int)+sizeof(unsigned int));
+	offsetAppend += uint32(connectivity.size() * sizeof(unsigned int)+sizeof(unsigned int));
 
 	fout << "<DataArray type =\"Int32\" Name =\"offsets\" format =\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
-	offsetAppend += uint32((triangles.size() / 3 + quads.size() / 4 + others_begin.size() - 1) * sizeof(unsigned int)+sizeof(unsigned int));
+	offsetAppend += uint32(offsets.size() * sizeof(unsigned int)+sizeof(unsigned int));
 
 	fout << "<DataArray type =\"UInt8\" Name =\"types\" format =\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
 
@@ -345,72 +360,25 @@ bool exportVTUBinary(typename PFP::MAP& map, const VertexAttribute<typename PFP:
 	fout.close();
 	fout.open(filename, std::ios_base::binary | std::ios_base::ate | std::ios_base::app);
 
-	unsigned int lengthBuff=0;
-	// bufferize and save position
-	{
-		std::vector<VEC3> bufferV3;
-		bufferV3.reserve(position.nbElements());
-		for (unsigned int i = position.begin(); i != position.end(); position.next(i))
-			bufferV3.push_back(position[i]);
-
-		lengthBuff = uint32(bufferV3.size()*sizeof(VEC3));
-		fout.write((char*)&lengthBuff,sizeof(unsigned int));
-
-		fout.write((char*)&bufferV3[0],lengthBuff);
-	}
-
-	// save already buffrized indices of primitives
-	lengthBuff = uint32(bufferInt.size()*sizeof(unsigned int));
+	unsigned int lengthBuff = uint32(points.size()*sizeof(float));
 	fout.write((char*)&lengthBuff,sizeof(unsigned int));
+	if (lengthBuff > 0)
+		fout.write((char*)&points[0],lengthBuff);
 
-	fout.write((char*)&(bufferInt[0]),lengthBuff);
-
-
-	// bufferize and save offsets of primitives
-	bufferInt.clear();
-	unsigned int offset = 0;
-	for (unsigned int i=0; i<triangles.size(); i+=3)
-	{
-		offset += 3;
-		bufferInt.push_back(offset);
-	}
-
-	for (unsigned int i=0; i<quads.size(); i+=4)
-	{
-		offset += 4;
-		bufferInt.push_back(offset);
-	}
-
-	for (unsigned int i=1; i<others_begin.size(); ++i)
-	{
-		unsigned int length = others_begin[i] - others_begin[i-1];
-		offset += length;
-		bufferInt.push_back(offset);
-	}
-
-	lengthBuff = uint32(bufferInt.size()*sizeof(unsigned int));
+	lengthBuff = uint32(connectivity.size()*sizeof(unsigned int));
 	fout.write((char*)&lengthBuff,sizeof(unsigned int));
+	if (lengthBuff > 0)
+		fout.write((char*)&(connectivity[0]),lengthBuff);
 
-	fout.write((char*)&(bufferInt[0]), lengthBuff);
-
-	// bufferize and save types of primitives
-
-	std::vector<unsigned char> bufferUC;
-	bufferUC.reserve(triangles.size()/3 + quads.size()/4 + others_begin.size());
-
-	for (unsigned int i=0; i<triangles.size(); i+=3)
-		bufferUC.push_back((unsigned char)5);
-
-	for (unsigned int i=0; i<quads.size(); i+=4)
-		bufferUC.push_back((unsigned char)9);
-
-	for (unsigned int i=1; i<others_begin.size(); ++i)
-		bufferUC.push_back((unsigned char)7);
-
-	lengthBuff = uint32(bufferUC.size()*sizeof(unsigned char));
+	lengthBuff = uint32(offsets.size()*sizeof(unsigned int));
 	fout.write((char*)&lengthBuff,sizeof(unsigned int));
+	if (lengthBuff > 0)
+		fout.write((char*)&(offsets[0]), lengthBuff);
 
-	fout.write((char*)&(bufferUC[0]), lengthBuff);
+	lengthBuff = uint32(types.size()*sizeof(unsigned char));
+	fout.write((char*)&lengthBuff,sizeof(unsigned int));
+	if (lengthBuff > 0)
+		fout.write((char*)&(types[0]), lengthBuff);
 
 	fout.close();
 	fout.open(filename, std::ios_base::ate | std::ios_base::app);
@@ -422,11 +390,8 @@ bool exportVTUBinary(typename PFP::MAP& map, const VertexAttribute<typename PFP:
 	return true;
 }
 
-
-
-/*
 template <typename PFP>
-bool exportVTUCompressed(typename PFP::MAP& map, const VertexAttribute<VEC3,MAP>& position, const char* filename)
+bool exportVTUCompressed(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename, unsigned int nbThreads)
 {
 	if (map.dimension() != 2)
 	{
@@ -434,9 +399,6 @@ bool exportVTUCompressed(typename PFP::MAP& map, const VertexAttribute<VEC3,MAP>
 		return false;
 	}
 
-	typedef typename PFP::MAP MAP;
-	typedef typename PFP::VEC3 VEC3;
-
 	// open file
 	std::ofstream fout ;
 	fout.open(filename, std::ios_base::out | std::ios_base::trunc) ;
@@ -447,103 +409,37 @@ bool exportVTUCompressed(typename PFP::MAP& map, const VertexAttribute<VEC3,MAP>
 		return false ;
 	}
 
-	VertexAutoAttribute<unsigned int> indices(map,"indices_vert");
-
-	unsigned int count=0;
-	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
-	{
-		indices[i] = count++;
-	}
-
-	std::vector<unsigned int> triangles;
-	std::vector<unsigned int> quads;
-	std::vector<unsigned int> others;
-	std::vector<unsigned int> others_begin;
-	triangles.reserve(2048);
-	quads.reserve(2048);
-	others.reserve(2048);
-	others_begin.reserve(2048);
-
-	TraversorF<MAP> trav(map) ;
-	for(Dart d = trav.begin(); d != trav.end(); d = trav.next())
-	{
-		unsigned int degree = map.faceDegree(d);
-		Dart f=d;
-		switch(degree)
-		{
-			case 3:
-				triangles.push_back(indices[f]); f = map.phi1(f);
-				triangles.push_back(indices[f]); f = map.phi1(f);
-				triangles.push_back(indices[f]);
-				break;
-			case 4:
-				quads.push_back(indices[f]); f = map.phi1(f);
-				quads.push_back(indices[f]); f = map.phi1(f);
-				quads.push_back(indices[f]); f = map.phi1(f);
-				quads.push_back(indices[f]);
-				break;
-
-			default:
-				others_begin.push_back(others.size());
-				do
-				{
-					others.push_back(indices[f]); f = map.phi1(f);
-
-				} while (f!=d);
-				break;
-		}
-	}
-	others_begin.push_back(others.size());
+	std::vector<float> points;
+	std::vector<int> connectivity;
+	std::vector<int> offsets;
+	std::vector<unsigned char> types;
+	unsigned int nbtotal = gatherVTUBuffers<PFP>(map, position, points, connectivity, offsets, types, nbThreads);
 
-	unsigned int nbtotal = triangles.size()/3 + quads.size()/4 + others_begin.size()-1;
+	// compress the arrays (blocks in parallel) first: the offsets depend on compressed sizes
+	std::vector<unsigned char> zPoints, zConnectivity, zOffsets, zTypes;
+	Utils::zlibVTUCompress((const unsigned char*)(points.empty() ? NULL : &points[0]), uint32(points.size()*sizeof(float)), zPoints, 1024*256, 6, nbThreads);
+	std::vector<float>().swap(points);
+	Utils::zlibVTUCompress((const unsigned char*)(connectivity.empty() ? NULL : &connectivity[0]), uint32(connectivity.size()*sizeof(int)), zConnectivity, 1024*256, 6, nbThreads);
+	std::vector<int>().swap(connectivity);
+	Utils::zlibVTUCompress((const unsigned char*)(offsets.empty() ? NULL : &offsets[0]), uint32(offsets.size()*sizeof(int)), zOffsets, 1024*256, 6, nbThreads);
+	Utils::zlibVTUCompress(types.empty() ? NULL : &types[0], uint32(types.size()), zTypes, 1024*256, 6, nbThreads);
 
 	fout << "<?xml version=\"1.0\"?>" << std::endl;
-	fout << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\" compressor=\"vtkZLibDataCompressor\">" << std::endl;
+	fout << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\" header_type=\"UInt32\" compressor=\"vtkZLibDataCompressor\">" << std::endl;
 	fout << "<UnstructuredGrid>" <<  std::endl;
 	fout << "<Piece NumberOfPoints=\"" << position.nbElements() << "\" NumberOfCells=\""<< nbtotal << "\">" << std::endl;
 	fout << "<Points>" << std::endl;
 	fout << "<DataArray type =\"Float32\" Name =\"Position\" NumberOfComponents =\"3\" format =\"appended\" offset =\"0\"/>"  << std::endl;
-
-	unsigned int offsetAppend = position.nbElements() * 3 * sizeof(float) + sizeof(unsigned int);	// Data + sz of blk
-
 	fout << "</Points>" << std::endl;
 
-	fout << "<Cells>" << std::endl;
-
-	std::vector<int> bufferInt;
-	bufferInt.reserve(triangles.size()+quads.size()+others.size());
-
-	for (unsigned int i=0; i<triangles.size(); i+=3)
-	{
-		bufferInt.push_back(triangles[i]);
-		bufferInt.push_back(triangles[i+1]);
-		bufferInt.push_back(triangles[i+2]);
-	}
-
-	for (unsigned int i=0; i<quads.size(); i+=4)
-	{
-		bufferInt.push_back(quads[i]);
-		bufferInt.push_back(quads[i+1]);
-		bufferInt.push_back(quads[i+2]);
-		bufferInt.push_back(quads[i+3]);
-	}
-
-	for (unsigned int i=1; i<others_begin.size(); ++i)
-	{
-		unsigned int beg = others_begin[i-1];
-		unsigned int end = others_begin[i];
-		for (unsigned int j=beg; j<end; ++j)
-			bufferInt.push_back(others[j]);
-	}
+	unsigned int offsetAppend = uint32(zPoints.size());
 
+	fout << "<Cells>" << std::endl;
 	fout << "<DataArray type =\"Int32\" Name =\"connectivity\" format =\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
-	offsetAppend +=bufferInt.size() * sizeof(unsigned int) + sizeof(unsigned int);
-
+	offsetAppend += uint32(zConnectivity.size());
 	fout << "<DataArray type =\"Int32\" Name =\"offsets\" format =\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
-	offsetAppend += (triangles.size()/3 + quads.size()/4 + others_begin.size()-1) * sizeof(unsigned int) + sizeof(unsigned int);
-
+	offsetAppend += uint32(zOffsets.size());
 	fout << "<DataArray type =\"UInt8\" Name =\"types\" format =\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
-
 	fout << "</Cells>" << std::endl;
 
 	fout << "</Piece>" << std::endl;
@@ -553,77 +449,10 @@ bool exportVTUCompressed(typename PFP::MAP& map, const VertexAttribute<VEC3,MAP>
 	fout.close();
 	fout.open(filename, std::ios_base::binary | std::ios_base::ate | std::ios_base::app);
 
-	unsigned int lengthBuff=0;
-	// bufferize and save position
-	{
-		std::vector<VEC3> bufferV3;
-		bufferV3.reserve(position.nbElements());
-		for (unsigned int i = position.begin(); i != position.end(); position.next(i))
-			bufferV3.push_back(position[i]);
-
-		lengthBuff = bufferV3.size()*sizeof(VEC3);
-		fout.write((char*)&lengthBuff,sizeof(unsigned int));
-
-		Utils::zlibVTUWriteCompressed((unsigned char*)&bufferV3[0], lengthBuff, fout);
-//		fout.write((char*)&bufferV3[0],lengthBuff);
-	}
-
-	// save already buffrized indices of primitives
-	lengthBuff = bufferInt.size()*sizeof(unsigned int);
-	fout.write((char*)&lengthBuff,sizeof(unsigned int));
-
-	Utils::zlibVTUWriteCompressed((unsigned char*)&(bufferInt[0]), lengthBuff, fout);
-//	fout.write((char*)&(bufferInt[0]),lengthBuff);
-
-
-	// bufferize and save offsets of primitives
-	bufferInt.clear();
-	unsigned int offset = 0;
-	for (unsigned int i=0; i<triangles.size(); i+=3)
-	{
-		offset += 3;
-		bufferInt.push_back(offset);
-	}
-
-	for (unsigned int i=0; i<quads.size(); i+=4)
-	{
-		offset += 4;
-		bufferInt.push_back(offset);
-	}
-
-	for (unsigned int i=1; i<others_begin.size(); ++i)
-	{
-		unsigned int length = others_begin[i] - others_begin[i-1];
-		offset += length;
-		bufferInt.push_back(offset);
-	}
-
-	lengthBuff = bufferInt.size()*sizeof(unsigned int);
-	fout.write((char*)&lengthBuff,sizeof(unsigned int));
-
-	Utils::zlibVTUWriteCompressed((unsigned char*)&(bufferInt[0]), lengthBuff, fout);
-//	fout.write((char*)&(bufferInt[0]), lengthBuff);
-
-	// bufferize and save types of primitives
-
-	std::vector<unsigned char> bufferUC;
-	bufferUC.reserve(triangles.size()/3 + quads.size()/4 + others_begin.size());
-
-	for (unsigned int i=0; i<triangles.size(); i+=3)
-		bufferUC.push_back((unsigned char)5);
-
-	for (unsigned int i=0; i<quads.size(); i+=4)
-		bufferUC.push_back((unsigned char)9);
-
-	for (unsigned int i=1; i<others_begin.size(); ++i)
-		bufferUC.push_back((unsigned char)7);
-
-	lengthBuff = bufferUC.size()*sizeof(unsigned char);
-	fout.write((char*)&lengthBuff,sizeof(unsigned int));
-
-	Utils::zlibVTUWriteCompressed((unsigned char*)&(bufferUC[0]), lengthBuff, fout);
-//	fout.write((char*)&(bufferUC[0]), lengthBuff);
-
+	fout.write((char*)&zPoints[0], zPoints.size());
+	fout.write((char*)&zConnectivity[0], zConnectivity.size());
+	fout.write((char*)&zOffsets[0], zOffsets.size());
+	fout.write((char*)&zTypes[0], zTypes.size());
 
 	fout.close();
 	fout.open(filename, std::ios_base::ate | std::ios_base::app);
@@ -635,8 +464,6 @@ bool exportVTUCompressed(typename PFP::MAP& map, const VertexAttribute<VEC3,MAP>
 	return true;
 }
 
-*/
-
 
 
 
@@ -65,10 +65,23 @@ bool exportNAS(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3,
 * @param the_map map to be exported
 * @param position the position container
 * @param filename filename of mesh file
+* @param nbThreads number of threads used to gather the cells
 * @return true
 */
 template <typename PFP>
-bool exportVTU(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename) ;
+bool exportVTU(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename, unsigned int nbThreads = CGoGN::Parallel::NumberOfThreads) ;
+
+/**
+* export the map into a binary vtu file with zlib compressed appended data
+* (vtkZLibDataCompressor: each array split in independent blocks, compressed in parallel)
+* @param the_map map to be exported
+* @param position the position container
+* @param filename filename of mesh file
+* @param nbThreads number of threads used to gather the cells and compress the data
+* @return true
+*/
+template <typename PFP>
+bool exportVTUCompressed(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename, unsigned int nbThreads = CGoGN::Parallel::NumberOfThreads) ;
 
 
 /**
@@ -109,9 +122,10 @@ bool exportNodeEle(typename PFP::MAP& map, const VertexAttribute<typename PFP::V
 * @param the_map map to be exported
 * @param position the position container
 * @param filename filename of mesh file
+* @param nbThreads number of threads used to gather the data (the gz stream is written sequentially)
  */
 template <typename PFP>
-bool exportVolBinGz(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename);
+bool exportVolBinGz(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename, unsigned int nbThreads = CGoGN::Parallel::NumberOfThreads);
 
 
 /**
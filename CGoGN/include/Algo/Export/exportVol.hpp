@@ -28,6 +28,7 @@
 #include "Topology/generic/traversor/traversor2.h"
 #include "Topology/generic/cellmarker.h"
 #include "Algo/Import/importFileTypes.h"
+#include "Utils/compress.h"
 
 namespace CGoGN
 {
@@ -58,6 +59,89 @@ inline std::string truncFloatTO8(float f)
 	return res.substr(0,8);
 }
 
+// private function: gather in parallel the indices of hexahedra and tetrahedra (traversal order)
+// vtkHexaOrder: hexa stored as VTK hexahedron (2 superposed quads, first in CW), else as bin vol file
+template <typename PFP>
+void gatherVolumeCells(typename PFP::MAP& map, const VertexAttribute<unsigned int, typename PFP::MAP>& indices,
+	std::vector<unsigned int>& hexa, std::vector<unsigned int>& tetra, bool vtkHexaOrder, unsigned int nbth)
+{
+	typedef typename PFP::MAP MAP;
+
+	std::vector<Dart> volumes;
+	TraversorW<MAP> trav(map) ;
+	for(Dart d = trav.begin(); d != trav.end(); d = trav.next())
+		volumes.push_back(d);
+	unsigned int nbw = uint32(volumes.size());
+
+	std::vector<unsigned char> degree(nbw);
+	CGoGN::Parallel::foreach_index(map, nbw, [&] (unsigned int i, unsigned int)
+	{
+		unsigned int deg = 0;
+		Traversor3WV<MAP> twv(map, volumes[i]) ;
+		for(Dart it = twv.begin(); it != twv.end(); it = twv.next())
+			++deg;
+		degree[i] = (deg == 8 || deg == 4) ? (unsigned char)(deg) : (unsigned char)(0);
+	}, nbth);
+
+	// rank of each volume among the hexa (or the tetra)
+	std::vector<unsigned int> rank(nbw);
+	unsigned int nbhexa = 0, nbtetra = 0;
+	for (unsigned int i = 0; i < nbw; ++i)
+	{
+		if (degree[i] == 8)
+			rank[i] = nbhexa++;
+		else if (degree[i] == 4)
+			rank[i] = nbtetra++;
+	}
+
+	hexa.resize(8 * nbhexa);
+	tetra.resize(4 * nbtetra);
+
+	CGoGN::Parallel::foreach_index(map, nbw, [&] (unsigned int i, unsigned int)
+	{
+		Dart e = volumes[i];
+		if (degree[i] == 8)
+		{
+			unsigned int* h = &hexa[8 * rank[i]];
+			if (vtkHexaOrder)
+			{
+				Dart f = map.template phi<21121>(e);
+				for (unsigned int j = 0; j < 4; ++j)
+				{
+					h[j] = indices[f];
+					f = map.phi_1(f);
+				}
+			}
+			for (unsigned int j = 0; j < 4; ++j)
+			{
+				h[vtkHexaOrder ? 4+j : j] = indices[e];
+				if (j < 3)
+					e = map.phi1(e);
+			}
+			if (!vtkHexaOrder)
+			{
+				e = map.template phi<2112>(e);
+				for (unsigned int j = 4; j < 8; ++j)
+				{
+					h[j] = indices[e];
+					e = map.phi1(e);
+				}
+			}
+		}
+		else if (degree[i] == 4)
+		{
+			unsigned int* t = &tetra[4 * rank[i]];
+			t[0] = indices[e];
+			e = map.phi1(e);
+			t[1] = indices[e];
+			e = map.phi1(e);
+			t[2] = indices[e];
+			e = map.template phi<211>(e);
+			t[3] = indices[e];
+		}
+	}, nbth);
+}
+
 template <typename PFP>
 bool exportNAS(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename)
 {
@@ -189,7 +273,7 @@ bool exportNAS(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3,
 }
 
 template <typename PFP>
-bool exportVTU(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename)
+bool exportVTU(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename, unsigned int nbThreads)
 {
 	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
@@ -214,54 +298,7 @@ bool exportVTU(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3,
 
 	std::vector<unsigned int> hexa;
 	std::vector<unsigned int> tetra;
-	hexa.reserve(2048);
-	tetra.reserve(2048);
-
-	TraversorW<MAP> trav(map) ;
-	for(Dart d = trav.begin(); d != trav.end(); d = trav.next())
-	{
-		unsigned int degree = 0 ;
-
-		Traversor3WV<typename PFP::MAP> twv(map, d) ;
-		for(Dart it = twv.begin(); it != twv.end(); it = twv.next())
-		{
-			degree++;
-		}
-
-		if (degree == 8)
-		{
-			//CAS HEXAEDRIQUE (ordre 2 quad superposes, le premier en CW)
-			Dart e = d;
-			Dart f = map.template phi<21121>(d);
-			hexa.push_back(indices[f]);
-			f = map.phi_1(f);
-			hexa.push_back(indices[f]);
-			f = map.phi_1(f);
-			hexa.push_back(indices[f]);
-			f = map.phi_1(f);
-			hexa.push_back(indices[f]);
-			hexa.push_back(indices[e]);
-			e = map.phi1(e);
-			hexa.push_back(indices[e]);
-			e = map.phi1(e);
-			hexa.push_back(indices[e]);
-			e = map.phi1(e);
-			hexa.push_back(indices[e]);
-		}
-
-		if (degree == 4)
-		{
-			//CAS TETRAEDRIQUE
-			Dart e = d;
-			tetra.push_back(indices[e]);
-			e = map.phi1(e);
-			tetra.push_back(indices[e]);
-			e = map.phi1(e);
-			tetra.push_back(indices[e]);
-			e = map.template phi<211>(e);
-			tetra.push_back(indices[e]);
-		}
-	}
+	gatherVolumeCells<PFP>(map, indices, hexa, tetra, true, nbThreads);
 
 	unsigned int nbhexa = uint32(hexa.size() / 8);
 	unsigned int nbtetra = uint32(tetra.size() / 4);
@@ -341,6 +378,117 @@ bool exportVTU(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3,
 	return true;
 }
 
+template <typename PFP>
+bool exportVTUCompressed(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename, unsigned int nbThreads)
+{
+	typedef typename PFP::MAP MAP;
+
+	// open file
+	std::ofstream fout ;
+	fout.open(filename, std::ios_base::out | std::ios_base::trunc) ;
+
+	if (!fout.good())
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl ;
+		return false ;
+	}
+
+	VertexAutoAttribute<unsigned int, MAP> indices(map, "indices_vert");
+
+	std::vector<unsigned int> vertices;
+	vertices.reserve(position.nbElements());
+	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+	{
+		indices[i] = uint32(vertices.size());
+		vertices.push_back(i);
+	}
+	unsigned int nbv = uint32(vertices.size());
+
+	std::vector<float> points(3 * nbv);
+	CGoGN::Parallel::foreach_index(map, nbv, [&] (unsigned int i, unsigned int)
+	{
+		const typename PFP::VEC3& P = position[vertices[i]];
+		points[3*i] = float(P[0]);
+		points[3*i+1] = float(P[1]);
+		points[3*i+2] = float(P[2]);
+	}, nbThreads);
+
+	std::vector<unsigned int> hexa;
+	std::vector<unsigned int> tetra;
+	gatherVolumeCells<PFP>(map, indices, hexa, tetra, true, nbThreads);
+
+	unsigned int nbhexa = uint32(hexa.size() / 8);
+	unsigned int nbtetra = uint32(tetra.size() / 4);
+
+	// cells: hexa then tetra
+	std::vector<int> connectivity;
+	connectivity.reserve(hexa.size() + tetra.size());
+	connectivity.insert(connectivity.end(), hexa.begin(), hexa.end());
+	connectivity.insert(connectivity.end(), tetra.begin(), tetra.end());
+	std::vector<unsigned int>().swap(hexa);
+	std::vector<unsigned int>().swap(tetra);
+
+	std::vector<int> offsets(nbhexa + nbtetra);
+	std::vector<unsigned char> types(nbhexa + nbtetra);
+	for (unsigned int i = 0; i < nbhexa; ++i)
+	{
+		offsets[i] = int(8 * (i+1));
+		types[i] = 12;
+	}
+	for (unsigned int i = 0; i < nbtetra; ++i)
+	{
+		offsets[nbhexa + i] = int(8 * nbhexa + 4 * (i+1));
+		types[nbhexa + i] = 10;
+	}
+
+	// compress the arrays (blocks in parallel) first: the offsets depend on compressed sizes
+	std::vector<unsigned char> zPoints, zConnectivity, zOffsets, zTypes;
+	Utils::zlibVTUCompress((const unsigned char*)(points.empty() ? NULL : &points[0]), uint32(points.size()*sizeof(float)), zPoints, 1024*256, 6, nbThreads);
+	std::vector<float>().swap(points);
+	Utils::zlibVTUCompress((const unsigned char*)(connectivity.empty() ? NULL : &connectivity[0]), uint32(connectivity.size()*sizeof(int)), zConnectivity, 1024*256, 6, nbThreads);
+	std::vector<int>().swap(connectivity);
+	Utils::zlibVTUCompress((const unsigned char*)(offsets.empty() ? NULL : &offsets[0]), uint32(offsets.size()*sizeof(int)), zOffsets, 1024*256, 6, nbThreads);
+	Utils::zlibVTUCompress(types.empty() ? NULL : &types[0], uint32(types.size()), zTypes, 1024*256, 6, nbThreads);
+
+	fout << "<?xml version=\"1.0\"?>" << std::endl;
+	fout << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\" header_type=\"UInt32\" compressor=\"vtkZLibDataCompressor\">" << std::endl;
+	fout << "  <UnstructuredGrid>" <<  std::endl;
+	fout << "    <Piece NumberOfPoints=\"" << nbv << "\" NumberOfCells=\""<< (nbhexa+nbtetra) << "\">" << std::endl;
+	fout << "      <Points>" << std::endl;
+	fout << "        <DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"appended\" offset=\"0\"/>" << std::endl;
+	fout << "      </Points>" << std::endl;
+
+	unsigned int offsetAppend = uint32(zPoints.size());
+
+	fout << "      <Cells>" << std::endl;
+	fout << "        <DataArray type=\"Int32\" Name=\"connectivity\" format=\"appended\" offset=\"" << offsetAppend << "\"/>" << std::endl;
+	offsetAppend += uint32(zConnectivity.size());
+	fout << "        <DataArray type=\"Int32\" Name=\"offsets\" format=\"appended\" offset=\"" << offsetAppend << "\"/>" << std::endl;
+	offsetAppend += uint32(zOffsets.size());
+	fout << "        <DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\"" << offsetAppend << "\"/>" << std::endl;
+	fout << "      </Cells>" << std::endl;
+	fout << "    </Piece>" << std::endl;
+	fout << "  </UnstructuredGrid>" << std::endl;
+	fout << "  <AppendedData encoding=\"raw\">" << std::endl << "_";
+
+	fout.close();
+	fout.open(filename, std::ios_base::binary | std::ios_base::ate | std::ios_base::app);
+
+	fout.write((char*)&zPoints[0], zPoints.size());
+	fout.write((char*)&zConnectivity[0], zConnectivity.size());
+	fout.write((char*)&zOffsets[0], zOffsets.size());
+	fout.write((char*)&zTypes[0], zTypes.size());
+
+	fout.close();
+	fout.open(filename, std::ios_base::ate | std::ios_base::app);
+
+	fout << std::endl << "  </AppendedData>" << std::endl;
+	fout << "</VTKFile>" << std::endl;
+
+	fout.close();
+	return true;
+}
+
 template <typename PFP>
 bool exportMSH(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename)
 {
@@ -622,7 +770,7 @@ bool exportNodeEle(typename PFP::MAP& map, const VertexAttribute<typename PFP::V
 }
 
 template <typename PFP>
-bool exportVolBinGz(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename)
+bool exportVolBinGz(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename, unsigned int nbThreads)
 {
 	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
@@ -641,73 +789,27 @@ bool exportVolBinGz(typename PFP::MAP& map, const VertexAttribute<typename PFP::
 
 	VertexAutoAttribute<unsigned int, MAP> indices(map,"indices_vert");
 
-	std::vector<typename PFP::VEC3> bufposi;
-	bufposi.reserve(position.nbElements());
+	std::vector<unsigned int> vertices;
+	vertices.reserve(position.nbElements());
 
 	unsigned int count=0;
 	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
 	{
-		const VEC3& P = position[i];
-		bufposi.push_back(P);
-//		fout << count << " " << P[0]<< " " << P[1]<< " " << P[2] << std::endl;
+		vertices.push_back(i);
 		indices[i] = count++;
 	}
-	if (count != bufposi.size())
+	if (count != position.nbElements())
 		CGoGNerr << "Warning problem wrong nbElements in position attributes ?" << CGoGNendl;
 
-	std::vector<unsigned int> hexa;
-	std::vector<unsigned int> tetra;
-
-	hexa.reserve(2048);
-	tetra.reserve(2048);
-
-	TraversorW<MAP> trav(map) ;
-	for(Dart d = trav.begin(); d != trav.end(); d = trav.next())
+	std::vector<typename PFP::VEC3> bufposi(count);
+	CGoGN::Parallel::foreach_index(map, count, [&] (unsigned int i, unsigned int)
 	{
-		unsigned int degree = 0 ;
-
-		Traversor3WV<typename PFP::MAP> twv(map, d) ;
-		for(Dart it = twv.begin(); it != twv.end(); it = twv.next())
-		{
-			degree++;
-		}
-
-		if (degree == 8)
-		{
-			//CAS HEXAEDRIQUE (ordre 2 quad superposes, le premier en CW)
-			Dart e = d;
-			hexa.push_back(indices[e]);
-			e = map.phi1(e);
-			hexa.push_back(indices[e]);
-			e = map.phi1(e);
-			hexa.push_back(indices[e]);
-			e = map.phi1(e);
-			hexa.push_back(indices[e]);
+		bufposi[i] = position[vertices[i]];
+	}, nbThreads);
 
-			e = map.template phi<2112>(e);
-			hexa.push_back(indices[e]);
-			e = map.phi1(e);
-			hexa.push_back(indices[e]);
-			e = map.phi1(e);
-			hexa.push_back(indices[e]);
-			e = map.phi1(e);
-			hexa.push_back(indices[e]);
-
-		}
-
-		if (degree == 4)
-		{
-			//CAS TETRAEDRIQUE
-			Dart e = d;
-			tetra.push_back(indices[e]);
-			e = map.phi1(e);
-			tetra.push_back(indices[e]);
-			e = map.phi1(e);
-			tetra.push_back(indices[e]);
-			e = map.template phi<211>(e);
-			tetra.push_back(indices[e]);
-		}
-	}
+	std::vector<unsigned int> hexa;
+	std::vector<unsigned int> tetra;
+	gatherVolumeCells<PFP>(map, indices, hexa, tetra, false, nbThreads);
 
 	unsigned int nbhexa = uint32(hexa.size() / 8);
 	unsigned int nbtetra = uint32(tetra.size() / 4);
@@ -85,6 +85,56 @@ void filterAverageAttribute_OneRing(
 	}
 }
 
+/**
+ * same as filterAverageAttribute_OneRing, using the one rings collected once
+ * for all vertices (see Selection::CollectorCache_OneRing). The filter is
+ * applied nbIterations times on two arrays indexed by slot, attOut receives
+ * the result of the last iteration.
+ */
+template <typename PFP, typename T>
+void filterAverageAttribute_OneRing(
+	typename PFP::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP>& rings,
+	const VertexAttribute<T, typename PFP::MAP>& attIn,
+	VertexAttribute<T, typename PFP::MAP>& attOut,
+	int neigh,
+	unsigned int nbIterations = 1,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads)
+{
+	std::vector<T> bufIn;
+	std::vector<T> bufOut(rings.getNbVertices());
+	rings.gather(attIn, bufIn, nbth);
+
+	for (unsigned int iter = 0; iter < nbIterations; ++iter)
+	{
+		CGoGN::Parallel::foreach_index(map, rings.getNbVertices(), [&] (unsigned int i, unsigned int)
+		{
+			if(!rings.isBoundary(i))
+			{
+				T sum(0);
+				unsigned int count = 0;
+				if (neigh & INSIDE)
+				{
+					sum += bufIn[i];
+					++count;
+				}
+				if (neigh & BORDER)
+				{
+					for (const unsigned int* it = rings.beginNeighbors(i); it != rings.endNeighbors(i); ++it)
+						sum += bufIn[*it];
+					count += rings.getNb(i);
+				}
+				bufOut[i] = sum / typename T::DATA_TYPE(count);
+			}
+			else
+				bufOut[i] = bufIn[i];
+		}, nbth);
+		bufIn.swap(bufOut);
+	}
+
+	rings.scatter(bufIn, attOut, nbth);
+}
+
 template <typename PFP, typename T>
 void filterAverageVertexAttribute_WithinSphere(
 	typename PFP::MAP& map,
@@ -180,6 +230,132 @@ void filterAverageFaceAttribute_WithinSphere(
 	}
 }
 
+/**
+ * same as filterAverageVertexAttribute_WithinSphere, using neighborhoods
+ * collected once for all vertices (see Selection::CollectorCache_WithinSphere)
+ * position is used to compute the border ratios and may differ from the
+ * positions the cache was built with
+ */
+template <typename PFP, typename T>
+void filterAverageVertexAttribute_WithinSphere(
+	typename PFP::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_WithinSphere<PFP>& neighborhoods,
+	const VertexAttribute<T, typename PFP::MAP>& attIn,
+	VertexAttribute<T, typename PFP::MAP>& attOut,
+	int neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads)
+{
+	typedef Algo::Surface::Selection::CollectorCache_WithinSphere<PFP> CACHE;
+	assert(!(neigh & INSIDE) || neighborhoods.insideCollected() || !"inside cells have not been collected") ;
+
+	const typename PFP::REAL radius = neighborhoods.getRadius();
+
+	CGoGN::Parallel::foreach_index(map, neighborhoods.getNbVertices(), [&] (unsigned int i, unsigned int)
+	{
+		Dart d = neighborhoods.getCenterDart(i);
+		if(!map.isBoundaryVertex(d))
+		{
+			T sum(0);
+			unsigned int count = 0;
+			if (neigh & INSIDE)
+			{
+				for (const Dart* it = neighborhoods.begin(i, CACHE::INSIDE_VERTICES); it != neighborhoods.end(i, CACHE::INSIDE_VERTICES); ++it)
+					sum += attIn[*it];
+				count += neighborhoods.getNb(i, CACHE::INSIDE_VERTICES);
+			}
+			if (neigh & BORDER)
+			{
+				for (const Dart* it = neighborhoods.begin(i, CACHE::BORDER); it != neighborhoods.end(i, CACHE::BORDER); ++it)
+				{
+					typename PFP::REAL alpha = 0;
+					Geometry::intersectionSphereEdge<PFP>(map, position[d], radius, *it, position, alpha);
+					sum += (1 - alpha) * attIn[*it] + alpha * attIn[map.phi1(*it)];
+				}
+				count += neighborhoods.getNb(i, CACHE::BORDER);
+			}
+			attOut[d] = sum;
+			attOut[d] /= count;
+		}
+		else
+			attOut[d] = attIn[d] ;
+	}, nbth);
+}
+
+/**
+ * same as filterAverageEdgeAttribute_WithinSphere, using neighborhoods
+ * collected once for all vertices (see Selection::CollectorCache_WithinSphere)
+ */
+template <typename PFP, typename T>
+void filterAverageEdgeAttribute_WithinSphere(
+	typename PFP::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_WithinSphere<PFP>& neighborhoods,
+	const EdgeAttribute<T, typename PFP::MAP>& attIn,
+	EdgeAttribute<T, typename PFP::MAP>& attOut,
+	int neigh,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads)
+{
+	typedef Algo::Surface::Selection::CollectorCache_WithinSphere<PFP> CACHE;
+	assert(!(neigh & INSIDE) || neighborhoods.insideCollected() || !"inside cells have not been collected") ;
+
+	CGoGN::Parallel::foreach_cell<EDGE>(map, [&] (Edge e, unsigned int)
+	{
+		unsigned int i = neighborhoods.getSlot(Vertex(e.dart));
+		T sum(0);
+		unsigned int count = 0;
+		if (neigh & INSIDE)
+		{
+			for (const Dart* it = neighborhoods.begin(i, CACHE::INSIDE_EDGES); it != neighborhoods.end(i, CACHE::INSIDE_EDGES); ++it)
+				sum += attIn[*it];
+			count += neighborhoods.getNb(i, CACHE::INSIDE_EDGES);
+		}
+		if (neigh & BORDER)
+		{
+			for (const Dart* it = neighborhoods.begin(i, CACHE::BORDER); it != neighborhoods.end(i, CACHE::BORDER); ++it)
+				sum += attIn[*it];
+			count += neighborhoods.getNb(i, CACHE::BORDER);
+		}
+		attOut[e] = sum / typename T::DATA_TYPE(count) ;
+	}, AUTO, nbth);
+}
+
+/**
+ * same as filterAverageFaceAttribute_WithinSphere, using neighborhoods
+ * collected once for all vertices (see Selection::CollectorCache_WithinSphere)
+ */
+template <typename PFP, typename T>
+void filterAverageFaceAttribute_WithinSphere(
+	typename PFP::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_WithinSphere<PFP>& neighborhoods,
+	const FaceAttribute<T, typename PFP::MAP>& attIn,
+	FaceAttribute<T, typename PFP::MAP>& attOut,
+	int neigh,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads)
+{
+	typedef Algo::Surface::Selection::CollectorCache_WithinSphere<PFP> CACHE;
+	assert(!(neigh & INSIDE) || neighborhoods.insideCollected() || !"inside cells have not been collected") ;
+
+	CGoGN::Parallel::foreach_cell<FACE>(map, [&] (Face f, unsigned int)
+	{
+		unsigned int i = neighborhoods.getSlot(Vertex(f.dart));
+		T sum(0);
+		unsigned int count = 0;
+		if (neigh & INSIDE)
+		{
+			for (const Dart* it = neighborhoods.begin(i, CACHE::INSIDE_FACES); it != neighborhoods.end(i, CACHE::INSIDE_FACES); ++it)
+				sum += attIn[*it];
+			count += neighborhoods.getNb(i, CACHE::INSIDE_FACES);
+		}
+		if (neigh & BORDER)
+		{
+			for (const Dart* it = neighborhoods.begin(i, CACHE::BORDER); it != neighborhoods.end(i, CACHE::BORDER); ++it)
+				sum += attIn[*it];
+			count += neighborhoods.getNb(i, CACHE::BORDER);
+		}
+		attOut[f] = sum / typename T::DATA_TYPE(count) ;
+	}, AUTO, nbth);
+}
+
 } // namespace Filtering
 
 } // namespace Surface
@@ -45,11 +45,11 @@ namespace Filtering
  * compute new position of vertices from normals (normalAverage & MMSE filters)
  * @param map the map
  */
-template <typename PFP>
+template <typename PFP, typename V_ATT, typename V_ATT_OUT>
 void computeNewPositionsFromFaceNormals(
 	typename PFP::MAP& map,
-	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
-	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2,
+	const V_ATT& position,
+	V_ATT_OUT& position2,
 	const FaceAttribute<typename PFP::REAL, typename PFP::MAP>& faceArea,
 	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& faceCentroid,
 	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& faceNormal,
@@ -80,8 +80,8 @@ void computeNewPositionsFromFaceNormals(
 	}
 }
 
-template <typename PFP>
-void filterAverageNormals(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2)
+template <typename PFP, typename V_ATT, typename V_ATT_OUT>
+void filterAverageNormals(typename PFP::MAP& map, const V_ATT& position, V_ATT_OUT& position2)
 {
 	typedef typename PFP::MAP MAP ;
 	typedef typename PFP::VEC3 VEC3 ;
@@ -124,8 +124,8 @@ void filterAverageNormals(typename PFP::MAP& map, const VertexAttribute<typename
 		map, position, position2, faceArea, faceCentroid, faceNormal, faceNewNormal) ;
 }
 
-template <typename PFP>
-void filterMMSE(typename PFP::MAP& map, float sigmaN2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2)
+template <typename PFP, typename V_ATT, typename V_ATT_OUT>
+void filterMMSE(typename PFP::MAP& map, float sigmaN2, const V_ATT& position, V_ATT_OUT& position2)
 {
 	typedef typename PFP::MAP MAP ;
 	typedef typename PFP::VEC3 VEC3 ;
@@ -209,8 +209,8 @@ void filterMMSE(typename PFP::MAP& map, float sigmaN2, const VertexAttribute<typ
 		map, position, position2, faceArea, faceCentroid, faceNormal, faceNewNormal) ;
 }
 
-template <typename PFP>
-void filterTNBA(typename PFP::MAP& map, float sigmaN2, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2)
+template <typename PFP, typename V_ATT, typename V_ATT_OUT>
+void filterTNBA(typename PFP::MAP& map, float sigmaN2, float SUSANthreshold, const V_ATT& position, V_ATT_OUT& position2)
 {
 	typedef typename PFP::MAP MAP ;
 	typedef typename PFP::VEC3 VEC3 ;
@@ -328,8 +328,8 @@ void filterTNBA(typename PFP::MAP& map, float sigmaN2, float SUSANthreshold, con
 //	CGoGNout <<" adaptive rate = "<< float(nbAdapt)/float(nbTot)<<CGoGNendl;
 }
 
-template <typename PFP>
-void filterVNBA(typename PFP::MAP& map, float sigmaN2, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal)
+template <typename PFP, typename V_ATT, typename V_ATT_OUT>
+void filterVNBA(typename PFP::MAP& map, float sigmaN2, float SUSANthreshold, const V_ATT& position, V_ATT_OUT& position2, const V_ATT& normal)
 {
 	typedef typename PFP::MAP MAP ;
 	typedef typename PFP::VEC3 VEC3 ;
@@ -26,6 +26,7 @@
 #include "Topology/generic/traversor/traversorCell.h"
 #include "Topology/generic/traversor/traversor2.h"
 #include "Algo/Geometry/basic.h"
+#include "Algo/Selection/collector.h"
 
 namespace CGoGN
 {
@@ -39,8 +40,8 @@ namespace Surface
 namespace Filtering
 {
 
-template <typename PFP>
-void sigmaBilateral(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal, typename PFP::REAL& sigmaC, typename PFP::REAL& sigmaS)
+template <typename PFP, typename V_ATT>
+void sigmaBilateral(typename PFP::MAP& map, const V_ATT& position, const V_ATT& normal, typename PFP::REAL& sigmaC, typename PFP::REAL& sigmaS)
 {
 	typedef typename PFP::VEC3 VEC3 ;
 	typedef typename PFP::REAL REAL ;
@@ -69,12 +70,12 @@ void sigmaBilateral(typename PFP::MAP& map, const VertexAttribute<typename PFP::
  * \param positionOut the smoothed positions after the function call
  * \param normal the normals
  */
-template <typename PFP>
+template <typename PFP, typename V_ATT, typename V_ATT_OUT>
 void filterBilateral(
         typename PFP::MAP& map,
-        const VertexAttribute<typename PFP::VEC3,typename PFP::MAP>& positionIn,
-        VertexAttribute<typename PFP::VEC3,typename PFP::MAP>& positionOut,
-        const VertexAttribute<typename PFP::VEC3,typename PFP::MAP>& normal)
+        const V_ATT& positionIn,
+        V_ATT_OUT& positionOut,
+        const V_ATT& normal)
 {
 	typedef typename PFP::VEC3 VEC3 ;
 	typedef typename PFP::REAL REAL;
@@ -110,8 +111,8 @@ void filterBilateral(
 	}
 }
 
-template <typename PFP>
-void filterSUSAN(typename PFP::MAP& map, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal)
+template <typename PFP, typename V_ATT, typename V_ATT_OUT>
+void filterSUSAN(typename PFP::MAP& map, float SUSANthreshold, const V_ATT& position, V_ATT_OUT& position2, const V_ATT& normal)
 {
 	typedef typename PFP::VEC3 VEC3 ;
 	typedef typename PFP::REAL REAL;
@@ -168,6 +169,212 @@ void filterSUSAN(typename PFP::MAP& map, float SUSANthreshold, const VertexAttri
 //	CGoGNout <<" susan rate = "<< float(nbSusan)/float(nbTot)<<CGoGNendl;
 }
 
+/**
+ * same as sigmaBilateral, using the one rings collected once for all vertices
+ * (see Selection::CollectorCache_OneRing) : each edge is seen from its two vertices
+ */
+template <typename PFP>
+void sigmaBilateral(
+	typename PFP::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP>& rings,
+	const std::vector<typename PFP::VEC3>& position,
+	const std::vector<typename PFP::VEC3>& normal,
+	typename PFP::REAL& sigmaC,
+	typename PFP::REAL& sigmaS,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads)
+{
+	typedef typename PFP::REAL REAL ;
+
+	std::vector<REAL> sumLengths(nbth > 0 ? nbth : 1, REAL(0));
+	std::vector<REAL> sumAngles(nbth > 0 ? nbth : 1, REAL(0));
+
+	CGoGN::Parallel::foreach_index(map, rings.getNbVertices(), [&] (unsigned int i, unsigned int thr)
+	{
+		for (const unsigned int* it = rings.beginNeighbors(i); it != rings.endNeighbors(i); ++it)
+		{
+			sumLengths[thr] += (position[*it] - position[i]).norm() ;
+			sumAngles[thr] += Geom::angle(normal[i], normal[*it]) ;
+		}
+	}, nbth);
+
+	REAL sumL = 0.0f;
+	REAL sumA = 0.0f;
+	for (unsigned int t = 0; t < sumLengths.size(); ++t)
+	{
+		sumL += sumLengths[t];
+		sumA += sumAngles[t];
+	}
+
+	// update of returned values
+	REAL nbEdges = REAL(rings.getNbEdges()) ;
+	sigmaC = 1.0f * (sumL / nbEdges);
+	sigmaS = 2.5f * (sumA / nbEdges);
+}
+
+/**
+ * compute the normals of the vertices from arrays indexed by slot
+ * (sum of the cross products of the consecutive incident edges, i.e. weighted by the triangle areas)
+ */
+template <typename PFP>
+void computeNormalsOneRing(
+	typename PFP::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP>& rings,
+	const std::vector<typename PFP::VEC3>& position,
+	std::vector<typename PFP::VEC3>& normal,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads)
+{
+	typedef typename PFP::VEC3 VEC3 ;
+
+	normal.resize(rings.getNbVertices());
+	CGoGN::Parallel::foreach_index(map, rings.getNbVertices(), [&] (unsigned int i, unsigned int)
+	{
+		VEC3 N(0) ;
+		const unsigned int* first = rings.beginNeighbors(i);
+		const unsigned int* last = rings.endNeighbors(i);
+		for (const unsigned int* it = first; it != last; ++it)
+		{
+			const unsigned int* next = (it + 1 != last) ? it + 1 : first;
+			N += (position[*it] - position[i]) ^ (position[*next] - position[i]) ;
+		}
+		N.normalize() ;
+		normal[i] = N ;
+	}, nbth);
+}
+
+/**
+ * bilateral filter using the one rings collected once for all vertices
+ * (see Selection::CollectorCache_OneRing), applied nbIterations times on two arrays
+ * indexed by slot. The first iteration uses the given normals, the next ones the
+ * normals of the filtered positions. The sigmas are computed once, before the first iteration.
+ * positionOut receives the result of the last iteration.
+ */
+template <typename PFP>
+void filterBilateral(
+	typename PFP::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP>& rings,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positionIn,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positionOut,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	unsigned int nbIterations = 1,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads)
+{
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL;
+
+	std::vector<VEC3> bufIn;
+	std::vector<VEC3> bufOut(rings.getNbVertices());
+	std::vector<VEC3> bufNormal;
+	rings.gather(positionIn, bufIn, nbth);
+	rings.gather(normal, bufNormal, nbth);
+
+	REAL sigmaC, sigmaS;
+	sigmaBilateral<PFP>(map, rings, bufIn, bufNormal, sigmaC, sigmaS, nbth) ;
+	const REAL invSigmaC = 1.0f / (2.0f * sigmaC * sigmaC);
+	const REAL invSigmaS = 1.0f / (2.0f * sigmaS * sigmaS);
+
+	for (unsigned int iter = 0; iter < nbIterations; ++iter)
+	{
+		if (iter > 0)
+			computeNormalsOneRing<PFP>(map, rings, bufIn, bufNormal, nbth) ;
+
+		CGoGN::Parallel::foreach_index(map, rings.getNbVertices(), [&] (unsigned int i, unsigned int)
+		{
+			if(!rings.isBoundary(i))
+			{
+				const VEC3& normal_d = bufNormal[i] ;
+
+				// traversal of incident edges
+				REAL sum = 0.0f, normalizer = 0.0f;
+				for (const unsigned int* it = rings.beginNeighbors(i); it != rings.endNeighbors(i); ++it)
+				{
+					VEC3 vec = bufIn[*it] - bufIn[i] ;
+					REAL h = normal_d * vec;
+					REAL wcs = std::exp(-1.0f * (vec.norm2() * invSigmaC + h * h * invSigmaS));
+					sum += wcs * h ;
+					normalizer += wcs ;
+				}
+
+				bufOut[i] = bufIn[i] + ((sum / normalizer) * normal_d) ;
+			}
+			else
+				bufOut[i] = bufIn[i] ;
+		}, nbth);
+		bufIn.swap(bufOut);
+	}
+
+	rings.scatter(bufIn, positionOut, nbth);
+}
+
+/**
+ * SUSAN filter using the one rings collected once for all vertices
+ * (see filterBilateral with CollectorCache_OneRing)
+ */
+template <typename PFP>
+void filterSUSAN(
+	typename PFP::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP>& rings,
+	float SUSANthreshold,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	unsigned int nbIterations = 1,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads)
+{
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL;
+
+	std::vector<VEC3> bufIn;
+	std::vector<VEC3> bufOut(rings.getNbVertices());
+	std::vector<VEC3> bufNormal;
+	rings.gather(position, bufIn, nbth);
+	rings.gather(normal, bufNormal, nbth);
+
+	REAL sigmaC, sigmaS;
+	sigmaBilateral<PFP>(map, rings, bufIn, bufNormal, sigmaC, sigmaS, nbth) ;
+	const REAL invSigmaC = 1.0f / (2.0f * sigmaC * sigmaC);
+	const REAL invSigmaS = 1.0f / (2.0f * sigmaS * sigmaS);
+
+	for (unsigned int iter = 0; iter < nbIterations; ++iter)
+	{
+		if (iter > 0)
+			computeNormalsOneRing<PFP>(map, rings, bufIn, bufNormal, nbth) ;
+
+		CGoGN::Parallel::foreach_index(map, rings.getNbVertices(), [&] (unsigned int i, unsigned int)
+		{
+			if(!rings.isBoundary(i))
+			{
+				const VEC3& pos_d = bufIn[i] ;
+				const VEC3& normal_d = bufNormal[i] ;
+
+				// traversal of incident edges
+				REAL sum = 0.0f, normalizer = 0.0f;
+				for (const unsigned int* it = rings.beginNeighbors(i); it != rings.endNeighbors(i); ++it)
+				{
+					REAL angle = Geom::angle(normal_d, bufNormal[*it]);
+					if( angle <= SUSANthreshold )
+					{
+						VEC3 vec = bufIn[*it] - pos_d ;
+						REAL h = normal_d * vec;
+						REAL wcs = std::exp(-1.0f * (vec.norm2() * invSigmaC + h * h * invSigmaS));
+						sum += wcs * h ;
+						normalizer += wcs ;
+					}
+				}
+
+				if (normalizer != 0.0f)
+					bufOut[i] = pos_d + ((sum / normalizer) * normal_d) ;
+				else
+					bufOut[i] = pos_d ;
+			}
+			else
+				bufOut[i] = bufIn[i] ;
+		}, nbth);
+		bufIn.swap(bufOut);
+	}
+
+	rings.scatter(bufIn, position2, nbth);
+}
+
 } //namespace Filtering
 
 }
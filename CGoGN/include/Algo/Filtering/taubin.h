@@ -97,6 +97,65 @@ void filterTaubin(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, ty
 	}
 }
 
+/**
+ * same as filterTaubin, using the one rings collected once for all vertices
+ * (see Selection::CollectorCache_OneRing). The shrinking and unshrinking steps
+ * are applied nbIterations times on two arrays indexed by slot; position receives
+ * the result and position2 the last shrinking step.
+ */
+template <typename PFP>
+void filterTaubin(
+	typename PFP::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_OneRing<PFP>& rings,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2,
+	unsigned int nbIterations = 1,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads)
+{
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL;
+
+	const REAL lambda = 0.6307f;
+	const REAL mu = -0.6732f;
+
+	if (nbIterations == 0)
+		return;
+
+	std::vector<VEC3> pos;
+	std::vector<VEC3> pos2(rings.getNbVertices());
+	rings.gather(position, pos, nbth);
+
+	// one step : posOut = posIn + factor * (average of the neighbors - posIn)
+	auto step = [&] (const std::vector<VEC3>& posIn, std::vector<VEC3>& posOut, REAL factor)
+	{
+		CGoGN::Parallel::foreach_index(map, rings.getNbVertices(), [&] (unsigned int i, unsigned int)
+		{
+			const VEC3& p = posIn[i] ;
+			if(!rings.isBoundary(i))
+			{
+				VEC3 sum(0) ;
+				for (const unsigned int* it = rings.beginNeighbors(i); it != rings.endNeighbors(i); ++it)
+					sum += posIn[*it] ;
+				VEC3 displ = sum / REAL(rings.getNb(i)) - p ;
+				displ *= factor ;
+				posOut[i] = p + displ ;
+			}
+			else
+				posOut[i] = p ;
+		}, nbth);
+	};
+
+	for (unsigned int iter = 0; iter < nbIterations; ++iter)
+	{
+		step(pos, pos2, lambda) ;
+		// unshrinking step
+		step(pos2, pos, mu) ;
+	}
+
+	rings.scatter(pos, position, nbth);
+	rings.scatter(pos2, position2, nbth);
+}
+
 /**
  * Taubin filter modified as proposed by [Lav09]
  */
@@ -160,6 +219,64 @@ void filterTaubin_modified(typename PFP::MAP& map, VertexAttribute<typename PFP:
 	}
 }
 
+/**
+ * Taubin filter modified as proposed by [Lav09], using cached neighborhoods
+ * (see Selection::CollectorCache_WithinSphere, only the border is needed).
+ * The shrinking step uses neighborhoods, collected by the caller on position :
+ * the result equals filterTaubin_modified(map, position, position2, radius) only
+ * if neighborhoods was built on the current position, reusing it over several
+ * calls keeps the topology of the first collection (the border ratios follow
+ * the moving positions). The unshrinking step re-collects shrunkNeighborhoods
+ * on position2 at each call, as the uncached version does.
+ */
+template <typename PFP>
+void filterTaubin_modified(
+	typename PFP::MAP& map,
+	const Algo::Surface::Selection::CollectorCache_WithinSphere<PFP>& neighborhoods,
+	Algo::Surface::Selection::CollectorCache_WithinSphere<PFP>& shrunkNeighborhoods,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads)
+{
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL;
+	typedef Algo::Surface::Selection::CollectorCache_WithinSphere<PFP> CACHE;
+
+	const REAL lambda = 0.6307f ;
+	const REAL mu = -0.6732f ;
+	const REAL radius = neighborhoods.getRadius();
+
+	// one step : posOut = posIn + factor * (average on sphere border - posIn)
+	auto step = [&] (const CACHE& cache, const VertexAttribute<VEC3, typename PFP::MAP>& posIn, VertexAttribute<VEC3, typename PFP::MAP>& posOut, REAL factor)
+	{
+		CGoGN::Parallel::foreach_index(map, cache.getNbVertices(), [&] (unsigned int i, unsigned int)
+		{
+			Dart d = cache.getCenterDart(i);
+			const VEC3& center = posIn[d] ;
+			if(!map.isBoundaryVertex(d) && cache.getNb(i, CACHE::BORDER) > 0)
+			{
+				VEC3 sum(0) ;
+				for (const Dart* it = cache.begin(i, CACHE::BORDER); it != cache.end(i, CACHE::BORDER); ++it)
+				{
+					REAL alpha = 0;
+					Geometry::intersectionSphereEdge<PFP>(map, center, radius, *it, posIn, alpha);
+					sum += (1 - alpha) * posIn[*it] + alpha * posIn[map.phi1(*it)] ;
+				}
+				VEC3 displ = sum / REAL(cache.getNb(i, CACHE::BORDER)) - center ;
+				displ *= factor ;
+				posOut[d] = center + displ ;
+			}
+			else
+				posOut[d] = center ;
+		}, nbth);
+	};
+
+	step(neighborhoods, position, position2, lambda) ;
+	// unshrinking step, on the neighborhoods of the shrunk positions
+	shrunkNeighborhoods.build(position2, radius, false, nbth) ;
+	step(shrunkNeighborhoods, position2, position, mu) ;
+}
+
 } // namespace Filtering
 
 } // namespace Surface
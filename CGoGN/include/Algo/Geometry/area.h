@@ -44,76 +44,76 @@ namespace Geometry
 //! @param d
 //! @param position
 //! @return
-template <typename PFP>
-typename PFP::REAL triangleArea(typename PFP::MAP& map, Face f, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position) ;
+template <typename PFP, typename V_ATT>
+typename PFP::REAL triangleArea(typename PFP::MAP& map, Face f, const V_ATT& position) ;
 
 //! \brief Compute convex polygonal face area
 //! @param map
 //! @param d
 //! @param position
 //! @return
-template <typename PFP>
-typename PFP::REAL convexFaceArea(typename PFP::MAP& map, Face f, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position) ;
+template <typename PFP, typename V_ATT>
+typename PFP::REAL convexFaceArea(typename PFP::MAP& map, Face f, const V_ATT& position) ;
 
 //! \brief Compute the total area of a mesh by summing all face areas.
 //! @param map
 //! @param position
 //! @return
-template <typename PFP>
-typename PFP::REAL totalArea(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position) ;
+template <typename PFP, typename V_ATT>
+typename PFP::REAL totalArea(typename PFP::MAP& map, const V_ATT& position) ;
 
 //! \brief Compute the area of the faces around a vertex.
 //! @param map
 //! @param d
 //! @param position
 //! @return
-template <typename PFP>
-typename PFP::REAL vertexOneRingArea(typename PFP::MAP& map, Vertex v, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position) ;
+template <typename PFP, typename V_ATT>
+typename PFP::REAL vertexOneRingArea(typename PFP::MAP& map, Vertex v, const V_ATT& position) ;
 
-template <typename PFP>
-typename PFP::REAL vertexBarycentricArea(typename PFP::MAP& map, Vertex v, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position) ;
+template <typename PFP, typename V_ATT>
+typename PFP::REAL vertexBarycentricArea(typename PFP::MAP& map, Vertex v, const V_ATT& position) ;
 
-template <typename PFP>
-typename PFP::REAL vertexVoronoiArea(typename PFP::MAP& map, Vertex v, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position) ;
+template <typename PFP, typename V_ATT>
+typename PFP::REAL vertexVoronoiArea(typename PFP::MAP& map, Vertex v, const V_ATT& position) ;
 
-template <typename PFP>
-typename PFP::REAL  edgeArea(typename PFP::MAP& map, Edge e, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position);
+template <typename PFP, typename V_ATT>
+typename PFP::REAL  edgeArea(typename PFP::MAP& map, Edge e, const V_ATT& position);
 
-template <typename PFP>
-void computeAreaFaces(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, FaceAttribute<typename PFP::REAL, typename PFP::MAP>& face_area) ;
+template <typename PFP, typename V_ATT>
+void computeAreaFaces(typename PFP::MAP& map, const V_ATT& position, FaceAttribute<typename PFP::REAL, typename PFP::MAP>& face_area) ;
 
-template <typename PFP>
-void computeAreaEdges(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edge_area);
+template <typename PFP, typename V_ATT>
+void computeAreaEdges(typename PFP::MAP& map, const V_ATT& position, EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edge_area);
 
-template <typename PFP>
-void computeOneRingAreaVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertex_area) ;
+template <typename PFP, typename V_ATT>
+void computeOneRingAreaVertices(typename PFP::MAP& map, const V_ATT& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertex_area) ;
 
-template <typename PFP>
-void computeBarycentricAreaVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertex_area) ;
+template <typename PFP, typename V_ATT>
+void computeBarycentricAreaVertices(typename PFP::MAP& map, const V_ATT& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertex_area) ;
 
-template <typename PFP>
-void computeVoronoiAreaVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertex_area) ;
+template <typename PFP, typename V_ATT>
+void computeVoronoiAreaVertices(typename PFP::MAP& map, const V_ATT& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertex_area) ;
 
 namespace Parallel
 {
 
-template <typename PFP>
-typename PFP::REAL totalArea(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position) ;
+template <typename PFP, typename V_ATT>
+typename PFP::REAL totalArea(typename PFP::MAP& map, const V_ATT& position) ;
 
-template <typename PFP>
-void computeAreaFaces(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, FaceAttribute<typename PFP::REAL, typename PFP::MAP>& area);
+template <typename PFP, typename V_ATT>
+void computeAreaFaces(typename PFP::MAP& map, const V_ATT& position, FaceAttribute<typename PFP::REAL, typename PFP::MAP>& area);
 
-template <typename PFP>
-void computeAreaEdges(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& area);
+template <typename PFP, typename V_ATT>
+void computeAreaEdges(typename PFP::MAP& map, const V_ATT& position, EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& area);
 
-template <typename PFP>
-void computeOneRingAreaVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& area);
+template <typename PFP, typename V_ATT>
+void computeOneRingAreaVertices(typename PFP::MAP& map, const V_ATT& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& area);
 
-template <typename PFP>
-void computeBarycentricAreaVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertex_area);
+template <typename PFP, typename V_ATT>
+void computeBarycentricAreaVertices(typename PFP::MAP& map, const V_ATT& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertex_area);
 
-template <typename PFP>
-void computeVoronoiAreaVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& area);
+template <typename PFP, typename V_ATT>
+void computeVoronoiAreaVertices(typename PFP::MAP& map, const V_ATT& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& area);
 
 } // namespace Parallel
 
@@ -39,8 +39,8 @@ namespace Surface
 namespace Geometry
 {
 
-template <typename PFP>
-typename PFP::REAL triangleArea(typename PFP::MAP& map, Face d, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+template <typename PFP, typename V_ATT>
+typename PFP::REAL triangleArea(typename PFP::MAP& map, Face d, const V_ATT& position)
 {
 	typename PFP::VEC3 p1 = position[d.dart] ;
 	typename PFP::VEC3 p2 = position[map.phi1(d)] ;
@@ -49,8 +49,8 @@ typename PFP::REAL triangleArea(typename PFP::MAP& map, Face d, const VertexAttr
 	return Geom::triangleArea(p1, p2, p3) ;
 }
 
-template <typename PFP>
-typename PFP::REAL convexFaceArea(typename PFP::MAP& map, Face d, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+template <typename PFP, typename V_ATT>
+typename PFP::REAL convexFaceArea(typename PFP::MAP& map, Face d, const V_ATT& position)
 {
 	typedef typename PFP::VEC3 VEC3 ;
 
@@ -71,8 +71,8 @@ typename PFP::REAL convexFaceArea(typename PFP::MAP& map, Face d, const VertexAt
 	}
 }
 
-template <typename PFP>
-typename PFP::REAL totalArea(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+template <typename PFP, typename V_ATT>
+typename PFP::REAL totalArea(typename PFP::MAP& map, const V_ATT& position)
 {
 	if (CGoGN::Parallel::NumberOfThreads > 1)
 	{
@@ -89,8 +89,8 @@ typename PFP::REAL totalArea(typename PFP::MAP& map, const VertexAttribute<typen
 	return area;
 }
 
-template <typename PFP>
-typename PFP::REAL vertexOneRingArea(typename PFP::MAP& map, Vertex v, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+template <typename PFP, typename V_ATT>
+typename PFP::REAL vertexOneRingArea(typename PFP::MAP& map, Vertex v, const V_ATT& position)
 {
 	typename PFP::REAL area(0) ;
 
@@ -101,8 +101,8 @@ typename PFP::REAL vertexOneRingArea(typename PFP::MAP& map, Vertex v, const Ver
 	return area ;
 }
 
-template <typename PFP>
-typename PFP::REAL vertexBarycentricArea(typename PFP::MAP& map, Vertex v, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+template <typename PFP, typename V_ATT>
+typename PFP::REAL vertexBarycentricArea(typename PFP::MAP& map, Vertex v, const V_ATT& position)
 {
 	typename PFP::REAL area(0) ;
 
@@ -113,8 +113,8 @@ typename PFP::REAL vertexBarycentricArea(typename PFP::MAP& map, Vertex v, const
 	return area ;
 }
 
-template <typename PFP>
-typename PFP::REAL vertexVoronoiArea(typename PFP::MAP& map, Vertex v, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+template <typename PFP, typename V_ATT>
+typename PFP::REAL vertexVoronoiArea(typename PFP::MAP& map, Vertex v, const V_ATT& position)
 {
 	typename PFP::REAL area(0) ;
 	foreach_incident2<FACE>(map, v, [&] (Face it)
@@ -140,8 +140,8 @@ typename PFP::REAL vertexVoronoiArea(typename PFP::MAP& map, Vertex v, const Ver
 	return area ;
 }
 
-template <typename PFP>
-typename PFP::REAL edgeArea(typename PFP::MAP& map, Edge e, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+template <typename PFP, typename V_ATT>
+typename PFP::REAL edgeArea(typename PFP::MAP& map, Edge e, const V_ATT& position)
 {
 	typename PFP::REAL area(0) ;
 
@@ -152,8 +152,8 @@ typename PFP::REAL edgeArea(typename PFP::MAP& map, Edge e, const VertexAttribut
 	return area ;
 }
 
-template <typename PFP>
-void computeAreaFaces(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, FaceAttribute<typename PFP::REAL, typename PFP::MAP>& face_area)
+template <typename PFP, typename V_ATT>
+void computeAreaFaces(typename PFP::MAP& map, const V_ATT& position, FaceAttribute<typename PFP::REAL, typename PFP::MAP>& face_area)
 {
 	if (CGoGN::Parallel::NumberOfThreads > 1)
 	{
@@ -168,8 +168,8 @@ void computeAreaFaces(typename PFP::MAP& map, const VertexAttribute<typename PFP
 	,AUTO);
 }
 
-template <typename PFP>
-void computeAreaEdges(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edge_area)
+template <typename PFP, typename V_ATT>
+void computeAreaEdges(typename PFP::MAP& map, const V_ATT& position, EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edge_area)
 {
 	if (CGoGN::Parallel::NumberOfThreads > 1)
 	{
@@ -184,8 +184,8 @@ void computeAreaEdges(typename PFP::MAP& map, const VertexAttribute<typename PFP
 	,AUTO);
 }
 
-template <typename PFP>
-void computeOneRingAreaVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertex_area)
+template <typename PFP, typename V_ATT>
+void computeOneRingAreaVertices(typename PFP::MAP& map, const V_ATT& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertex_area)
 {
 	if (CGoGN::Parallel::NumberOfThreads > 1)
 	{
@@ -208,8 +208,8 @@ void computeOneRingAreaVertices(typename PFP::MAP& map, const VertexAttribute<ty
 }
 
 
-template <typename PFP>
-void computeBarycentricAreaVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertex_area)
+template <typename PFP, typename V_ATT>
+void computeBarycentricAreaVertices(typename PFP::MAP& map, const V_ATT& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertex_area)
 {
 	if (CGoGN::Parallel::NumberOfThreads > 1)
 	{
@@ -224,8 +224,8 @@ void computeBarycentricAreaVertices(typename PFP::MAP& map, const VertexAttribut
 	,FORCE_CELL_MARKING);
 }
 
-template <typename PFP>
-void computeVoronoiAreaVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertex_area)
+template <typename PFP, typename V_ATT>
+void computeVoronoiAreaVertices(typename PFP::MAP& map, const V_ATT& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertex_area)
 {
 	if (CGoGN::Parallel::NumberOfThreads > 1)
 	{
@@ -245,8 +245,8 @@ void computeVoronoiAreaVertices(typename PFP::MAP& map, const VertexAttribute<ty
 namespace Parallel
 {
 
-template <typename PFP>
-typename PFP::REAL totalArea(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+template <typename PFP, typename V_ATT>
+typename PFP::REAL totalArea(typename PFP::MAP& map, const V_ATT& position)
 {
 	std::vector<typename PFP::REAL> areas;
 	areas.resize(CGoGN::Parallel::NumberOfThreads);
@@ -263,8 +263,8 @@ typename PFP::REAL totalArea(typename PFP::MAP& map, const VertexAttribute<typen
 	return area;
 }
 
-template <typename PFP>
-void computeAreaFaces(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, FaceAttribute<typename PFP::REAL, typename PFP::MAP>& area)
+template <typename PFP, typename V_ATT>
+void computeAreaFaces(typename PFP::MAP& map, const V_ATT& position, FaceAttribute<typename PFP::REAL, typename PFP::MAP>& area)
 {
 //	if (map.isOrbitEmbedded<FACE>())
 //	{
@@ -287,8 +287,8 @@ void computeAreaFaces(typename PFP::MAP& map, const VertexAttribute<typename PFP
 	});
 }
 
-template <typename PFP>
-void computeAreaEdges(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& area)
+template <typename PFP, typename V_ATT>
+void computeAreaEdges(typename PFP::MAP& map, const V_ATT& position, EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& area)
 {
 	CGoGN::Parallel::foreach_cell<EDGE>(map, [&] (Edge e, unsigned int /*thr*/)
 	{
@@ -296,8 +296,8 @@ void computeAreaEdges(typename PFP::MAP& map, const VertexAttribute<typename PFP
 	});
 }
 
-template <typename PFP>
-void computeOneRingAreaVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& area)
+template <typename PFP, typename V_ATT>
+void computeOneRingAreaVertices(typename PFP::MAP& map, const V_ATT& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& area)
 {
 	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int /*thr*/)
 	{
@@ -305,8 +305,8 @@ void computeOneRingAreaVertices(typename PFP::MAP& map, const VertexAttribute<ty
 	}, FORCE_CELL_MARKING);
 }
 
-template <typename PFP>
-void computeBarycentricAreaVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertex_area)
+template <typename PFP, typename V_ATT>
+void computeBarycentricAreaVertices(typename PFP::MAP& map, const V_ATT& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertex_area)
 {
 	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int /*thr*/)
 	{
@@ -314,8 +314,8 @@ void computeBarycentricAreaVertices(typename PFP::MAP& map, const VertexAttribut
 	}, FORCE_CELL_MARKING);
 }
 
-template <typename PFP>
-void computeVoronoiAreaVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& area)
+template <typename PFP, typename V_ATT>
+void computeVoronoiAreaVertices(typename PFP::MAP& map, const V_ATT& position, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& area)
 {
 	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int /*thr*/)
 	{
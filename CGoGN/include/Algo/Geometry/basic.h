@@ -39,16 +39,16 @@ namespace Geometry
 /**
  * vectorOutOfDart return a dart from the position of vertex attribute of d to the position of vertex attribute of phi1(d)
  */
-template <typename PFP>
-inline typename PFP::VEC3 vectorOutOfDart(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+template <typename PFP, typename V_ATT>
+inline typename PFP::VEC3 vectorOutOfDart(typename PFP::MAP& map, Dart d, const V_ATT& position)
 {
 	typename PFP::VEC3 vec = position[map.phi1(d)] ;
 	vec -= position[d] ;
 	return vec ;
 }
 
-template <typename PFP>
-inline typename PFP::REAL edgeLength(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+template <typename PFP, typename V_ATT>
+inline typename PFP::REAL edgeLength(typename PFP::MAP& map, Dart d, const V_ATT& position)
 {
 	typename PFP::VEC3 v = vectorOutOfDart<PFP>(map, d, position) ;
 	return typename PFP::REAL(v.norm());
@@ -57,8 +57,8 @@ inline typename PFP::REAL edgeLength(typename PFP::MAP& map, Dart d, const Verte
 namespace Parallel
 {
 
-template <typename PFP>
-typename PFP::REAL meanEdgeLength(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+template <typename PFP, typename V_ATT>
+typename PFP::REAL meanEdgeLength(typename PFP::MAP& map, const V_ATT& position)
 {
 	std::vector<typename PFP::REAL> lengths;
 	std::vector<unsigned int> nbedges;
@@ -85,8 +85,8 @@ typename PFP::REAL meanEdgeLength(typename PFP::MAP& map, const VertexAttribute<
 
 } // namespace Parallel
 
-template <typename PFP>
-inline typename PFP::REAL meanEdgeLength(typename PFP::MAP& map,const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+template <typename PFP, typename V_ATT>
+inline typename PFP::REAL meanEdgeLength(typename PFP::MAP& map,const V_ATT& position)
 {
 	if (CGoGN::Parallel::NumberOfThreads > 1)
 	{
@@ -106,16 +106,16 @@ inline typename PFP::REAL meanEdgeLength(typename PFP::MAP& map,const VertexAttr
 	return length / nbe;
 }
 
-template <typename PFP>
-inline typename PFP::REAL angle(typename PFP::MAP& map, Dart d1, Dart d2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+template <typename PFP, typename V_ATT>
+inline typename PFP::REAL angle(typename PFP::MAP& map, Dart d1, Dart d2, const V_ATT& position)
 {
 	typename PFP::VEC3 v1 = vectorOutOfDart<PFP>(map, d1, position) ;
 	typename PFP::VEC3 v2 = vectorOutOfDart<PFP>(map, d2, position) ;
 	return Geom::angle(v1, v2) ;
 }
 
-template <typename PFP>
-bool isTriangleObtuse(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+template <typename PFP, typename V_ATT>
+bool isTriangleObtuse(typename PFP::MAP& map, Dart d, const V_ATT& position)
 {
 	return Geom::isTriangleObtuse(position[d], position[map.phi1(d)], position[map.phi_1(d)]) ;
 }
@@ -50,6 +50,7 @@ void computeCurvatureVertices_QuadraticFitting(
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin)
 {
+	CGoGN_SCOPED_TIMER("Algo::Surface::Geometry::computeCurvatureVertices_QuadraticFitting");
 	// TODO: nl not thread safe
 
 //	if (CGoGN::Parallel::NumberOfThreads > 1)
@@ -311,6 +312,7 @@ void computeCurvatureVertices_NormalCycles(
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
 {
+	CGoGN_SCOPED_TIMER("Algo::Surface::Geometry::computeCurvatureVertices_NormalCycles");
 	if (CGoGN::Parallel::NumberOfThreads > 1)
 	{
 		Parallel::computeCurvatureVertices_NormalCycles<PFP>(map, radius, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal);
@@ -374,6 +376,7 @@ void computeCurvatureVertices_NormalCycles_Projected(
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
 {
+	CGoGN_SCOPED_TIMER("Algo::Surface::Geometry::computeCurvatureVertices_NormalCycles_Projected");
 	if (CGoGN::Parallel::NumberOfThreads > 1)
 	{
 		Parallel::computeCurvatureVertices_NormalCycles_Projected<PFP>(map, radius, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal);
@@ -732,6 +735,7 @@ void computeCurvatureVertices_NormalCycles(
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
 {
+	CGoGN_SCOPED_TIMER("Algo::Surface::Geometry::Parallel::computeCurvatureVertices_NormalCycles");
 	// WAHOO BIG PROBLEM WITH LAZZY EMBEDDING !!!
 	if (!map.template isOrbitEmbedded<VERTEX>())
 		Algo::Topo::initAllOrbitsEmbedding<VERTEX>(map);
@@ -762,6 +766,7 @@ void computeCurvatureVertices_NormalCycles_Projected(
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
 {
+	CGoGN_SCOPED_TIMER("Algo::Surface::Geometry::Parallel::computeCurvatureVertices_NormalCycles_Projected");
 	// WAHOO BIG PROBLEM WITH LAZZY EMBEDDING !!!
 	if (!map.template isOrbitEmbedded<VERTEX>())
 		Algo::Topo::initAllOrbitsEmbedding<VERTEX>(map);
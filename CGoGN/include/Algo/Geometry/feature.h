@@ -25,6 +25,9 @@
 #ifndef __ALGO_GEOMETRY_FEATURE_H__
 #define __ALGO_GEOMETRY_FEATURE_H__
 
+#include <vector>
+#include <unordered_map>
+
 namespace CGoGN
 {
 
@@ -171,6 +174,23 @@ bool isEdgeInTriangle(
 	Dart edge,
 	Dart triangle) ;
 
+/**
+ * chain the segments of ridge_segments into polylines
+ * consecutive segments share a point on an edge of the mesh: the segment ends
+ * are matched through a hash table on the edge ids, so the chaining is linear
+ * in the number of segments. Open polylines are given first (from a free end),
+ * then closed ones (first point repeated at the end).
+ * @param featureOnly if true only the FEATURE segments are chained, else all non EMPTY segments
+ * @return the number of polylines
+ */
+template <typename PFP>
+unsigned int chainRidgeSegments(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const FaceAttribute<RidgeSegment<typename PFP::REAL>, typename PFP::MAP>& ridge_segments,
+	std::vector< std::vector<typename PFP::VEC3> >& polylines,
+	bool featureOnly = true) ;
+
 template <typename PFP>
 std::vector<typename PFP::VEC3> occludingContoursDetection(
 	typename PFP::MAP& map,
@@ -178,6 +198,78 @@ std::vector<typename PFP::VEC3> occludingContoursDetection(
 	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
 	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal) ;
 
+namespace Parallel
+{
+
+/**
+ * parallel versions of the full map passes: cells are gathered once, processed
+ * in contiguous ranges by nbth threads, and markers are set by a serial pass
+ * over per cell flags. Results are the same as the serial versions.
+ */
+
+template <typename PFP>
+void featureEdgeDetection(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	CellMarker<typename PFP::MAP, EDGE>& featureEdge,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+template <typename PFP>
+void computeFaceGradient(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& face_normal,
+	const VertexAttribute<typename PFP::REAL, typename PFP::MAP>& scalar,
+	const FaceAttribute<typename PFP::REAL, typename PFP::MAP>& face_area,
+	FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& face_gradient,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+template <typename PFP>
+void computeVertexGradient(
+	typename PFP::MAP& map,
+	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& face_gradient,
+	const FaceAttribute<typename PFP::REAL, typename PFP::MAP>& face_area,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& vertex_gradient,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+template <typename PFP>
+void computeTriangleType(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& K,
+	CellMarker<typename PFP::MAP, FACE>& regularMarker,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+template <typename PFP>
+void initRidgeSegments(
+	typename PFP::MAP& map,
+	FaceAttribute<RidgeSegment<typename PFP::REAL>, typename PFP::MAP>& ridge_segments,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+template <typename PFP>
+void computeRidgeLines(
+	typename PFP::MAP& map,
+	CellMarker<typename PFP::MAP, FACE>& regularMarker,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& K,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& vertex_gradient,
+	const VertexAttribute<typename PFP::REAL, typename PFP::MAP>& k,
+	const VertexAttribute<typename PFP::REAL, typename PFP::MAP>& k2,
+	FaceAttribute<RidgeSegment<typename PFP::REAL>, typename PFP::MAP>& ridge_segments,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+/**
+ * singular faces only read the segments of the regular ones, so all faces
+ * can be processed concurrently
+ */
+template <typename PFP>
+void computeSingularTriangle(
+	typename PFP::MAP& map,
+	CellMarker<typename PFP::MAP, FACE>& regularMarker,
+	FaceAttribute<RidgeSegment<typename PFP::REAL>, typename PFP::MAP>& ridge_segments,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+} // namespace Parallel
+
 } // namespace Geometry
 
 } // namespace Surface
@@ -26,6 +26,8 @@
 #include "Algo/Geometry/normal.h"
 #include "Topology/generic/traversor/traversorCell.h"
 
+#include <unordered_map>
+
 namespace CGoGN
 {
 
@@ -451,6 +453,101 @@ bool isEdgeInTriangle(typename PFP::MAP& map, Dart edge, Dart triangle)
 	return inTriangle ;
 }
 
+// private function
+template <typename MAP>
+inline unsigned int ridgeEdgeKey(MAP& map, Dart d)
+{
+	unsigned int a = d.index ;
+	unsigned int b = map.phi2(d).index ;
+	return a < b ? a : b ;
+}
+
+template <typename PFP>
+unsigned int chainRidgeSegments(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const FaceAttribute<RidgeSegment<typename PFP::REAL>, typename PFP::MAP>& ridge_segments,
+	std::vector< std::vector<typename PFP::VEC3> >& polylines,
+	bool featureOnly)
+{
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	const unsigned int NONE = 0xffffffff ;
+
+	// ends of the segments: end 2*s is the p1 point of segment s, end 2*s+1 its p2 point
+	std::vector<Dart> ends ;
+	std::vector<REAL> weights ;
+	TraversorF<MAP> t(map) ;
+	for (Dart d = t.begin(); d != t.end(); d = t.next())
+	{
+		const RidgeSegment<REAL>& rs = ridge_segments[d] ;
+		if (featureOnly ? (rs.type == FEATURE) : (rs.type != EMPTY))
+		{
+			ends.push_back(rs.p1.d) ;
+			weights.push_back(rs.p1.w) ;
+			ends.push_back(rs.p2.d) ;
+			weights.push_back(rs.p2.w) ;
+		}
+	}
+	const unsigned int nbe = uint32(ends.size()) ;
+
+	// link the two ends lying on the same edge:
+	// an end waits in the table until the next end with same edge id
+	std::vector<unsigned int> link(nbe, NONE) ;
+	std::unordered_map<unsigned int, unsigned int> waiting ;
+	waiting.reserve(nbe) ;
+	for (unsigned int i = 0; i < nbe; ++i)
+	{
+		std::pair<std::unordered_map<unsigned int, unsigned int>::iterator, bool> ins = waiting.insert(std::make_pair(ridgeEdgeKey<MAP>(map, ends[i]), i)) ;
+		if (!ins.second)
+		{
+			unsigned int j = ins.first->second ;
+			link[i] = j ;
+			link[j] = i ;
+			waiting.erase(ins.first) ;
+		}
+	}
+	waiting.clear() ;
+
+	// the point is at ratio w on the edge (d, phi1(d))
+	auto point = [&] (unsigned int i) -> VEC3
+	{
+		Dart e = ends[i] ;
+		REAL w = weights[i] ;
+		return (REAL(1) - w) * position[e] + w * position[map.phi1(e)] ;
+	} ;
+
+	// walk the chains: first from the free ends (open polylines), then the remaining cycles
+	std::vector<unsigned char> done(nbe / 2, 0) ;
+	polylines.clear() ;
+	for (unsigned int pass = 0; pass < 2; ++pass)
+	{
+		for (unsigned int i = 0; i < nbe; ++i)
+		{
+			if (done[i / 2] || (pass == 0 && link[i] != NONE))
+				continue ;
+
+			polylines.push_back(std::vector<VEC3>()) ;
+			std::vector<VEC3>& line = polylines.back() ;
+			line.push_back(point(i)) ;
+			unsigned int in = i ;
+			while (in != NONE && !done[in / 2])
+			{
+				done[in / 2] = 1 ;
+				unsigned int out = in ^ 1u ;
+				line.push_back(point(out)) ;
+				in = link[out] ;
+			}
+			if (in != NONE) // closed: same point as the first one
+				line.back() = line.front() ;
+		}
+	}
+
+	return uint32(polylines.size()) ;
+}
+
 template <typename PFP>
 std::vector<typename PFP::VEC3> occludingContoursDetection(
 	typename PFP::MAP& map,
@@ -509,6 +606,186 @@ std::vector<typename PFP::VEC3> occludingContoursDetection(
 	return occludingContours ;
 }
 
+namespace Parallel
+{
+
+// private function
+template <typename MAP, unsigned int ORBIT>
+void gatherCells(MAP& map, std::vector<Dart>& cells)
+{
+	cells.clear() ;
+	if (map.template isOrbitEmbedded<ORBIT>())
+		cells.reserve(map.template getAttributeContainer<ORBIT>().size()) ;
+	TraversorCell<MAP, ORBIT> t(map) ;
+	for (Dart d = t.begin(); d != t.end(); d = t.next())
+		cells.push_back(d) ;
+}
+
+template <typename PFP>
+void featureEdgeDetection(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	CellMarker<typename PFP::MAP, EDGE>& featureEdge,
+	unsigned int nbth)
+{
+	CGoGN_SCOPED_TIMER("Algo::Surface::Geometry::Parallel::featureEdgeDetection") ;
+
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	featureEdge.unmarkAll() ;
+
+	FaceAttribute<VEC3, MAP> fNormal = map.template getAttribute<VEC3, FACE, MAP>("normal") ;
+	if(!fNormal.isValid())
+		fNormal = map.template addAttribute<VEC3, FACE, MAP>("normal") ;
+
+	std::vector<Dart> faces ;
+	gatherCells<MAP, FACE>(map, faces) ;
+	CGoGN::Parallel::foreach_index(map, uint32(faces.size()), [&] (unsigned int i, unsigned int)
+	{
+		fNormal[faces[i]] = Algo::Surface::Geometry::faceNormal<PFP>(map, faces[i], position) ;
+	}, nbth) ;
+
+	std::vector<Dart> edges ;
+	gatherCells<MAP, EDGE>(map, edges) ;
+	std::vector<unsigned char> feature(edges.size(), 0) ;
+	CGoGN::Parallel::foreach_index(map, uint32(edges.size()), [&] (unsigned int i, unsigned int)
+	{
+		Dart d = edges[i] ;
+		if(!map.isBoundaryEdge(d) && Geom::angle(fNormal[d], fNormal[map.phi2(d)]) > M_PI / REAL(6))
+			feature[i] = 1 ;
+	}, nbth) ;
+
+	// markers are not thread safe
+	for (unsigned int i = 0; i < edges.size(); ++i)
+	{
+		if (feature[i])
+			featureEdge.mark(edges[i]) ;
+	}
+}
+
+template <typename PFP>
+void computeFaceGradient(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& face_normal,
+	const VertexAttribute<typename PFP::REAL, typename PFP::MAP>& scalar,
+	const FaceAttribute<typename PFP::REAL, typename PFP::MAP>& area,
+	FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& face_gradient,
+	unsigned int nbth)
+{
+	CGoGN_SCOPED_TIMER("Algo::Surface::Geometry::Parallel::computeFaceGradient") ;
+
+	std::vector<Dart> faces ;
+	gatherCells<typename PFP::MAP, FACE>(map, faces) ;
+	CGoGN::Parallel::foreach_index(map, uint32(faces.size()), [&] (unsigned int i, unsigned int)
+	{
+		face_gradient[faces[i]] = faceGradient<PFP>(map, faces[i], position, face_normal, scalar, area) ;
+	}, nbth) ;
+}
+
+template <typename PFP>
+void computeVertexGradient(
+	typename PFP::MAP& map,
+	const FaceAttribute<typename PFP::VEC3, typename PFP::MAP>& face_gradient,
+	const FaceAttribute<typename PFP::REAL, typename PFP::MAP>& face_area,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& vertex_gradient,
+	unsigned int nbth)
+{
+	CGoGN_SCOPED_TIMER("Algo::Surface::Geometry::Parallel::computeVertexGradient") ;
+
+	std::vector<Dart> vertices ;
+	gatherCells<typename PFP::MAP, VERTEX>(map, vertices) ;
+	CGoGN::Parallel::foreach_index(map, uint32(vertices.size()), [&] (unsigned int i, unsigned int)
+	{
+		vertex_gradient[vertices[i]] = vertexGradient<PFP>(map, vertices[i], face_gradient, face_area) ;
+	}, nbth) ;
+}
+
+template <typename PFP>
+void computeTriangleType(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& K,
+	CellMarker<typename PFP::MAP, FACE>& regularMarker,
+	unsigned int nbth)
+{
+	CGoGN_SCOPED_TIMER("Algo::Surface::Geometry::Parallel::computeTriangleType") ;
+
+	std::vector<Dart> faces ;
+	gatherCells<typename PFP::MAP, FACE>(map, faces) ;
+	std::vector<unsigned char> regular(faces.size(), 0) ;
+	CGoGN::Parallel::foreach_index(map, uint32(faces.size()), [&] (unsigned int i, unsigned int)
+	{
+		if(isTriangleRegular<PFP>(map, faces[i], K))
+			regular[i] = 1 ;
+	}, nbth) ;
+
+	// markers are not thread safe
+	for (unsigned int i = 0; i < faces.size(); ++i)
+	{
+		if (regular[i])
+			regularMarker.mark(faces[i]) ;
+	}
+}
+
+template <typename PFP>
+void initRidgeSegments(
+	typename PFP::MAP& map,
+	FaceAttribute<RidgeSegment<typename PFP::REAL>, typename PFP::MAP>& ridge_segments,
+	unsigned int nbth)
+{
+	std::vector<Dart> faces ;
+	gatherCells<typename PFP::MAP, FACE>(map, faces) ;
+	CGoGN::Parallel::foreach_index(map, uint32(faces.size()), [&] (unsigned int i, unsigned int)
+	{
+		ridge_segments[faces[i]].type = EMPTY ;
+	}, nbth) ;
+}
+
+template <typename PFP>
+void computeRidgeLines(
+	typename PFP::MAP& map,
+	CellMarker<typename PFP::MAP, FACE>& regularMarker,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& K,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& vertex_gradient,
+	const VertexAttribute<typename PFP::REAL, typename PFP::MAP>& k,
+	const VertexAttribute<typename PFP::REAL, typename PFP::MAP>& k2,
+	FaceAttribute<RidgeSegment<typename PFP::REAL>, typename PFP::MAP>& ridge_segments,
+	unsigned int nbth)
+{
+	CGoGN_SCOPED_TIMER("Algo::Surface::Geometry::Parallel::computeRidgeLines") ;
+
+	std::vector<Dart> faces ;
+	gatherCells<typename PFP::MAP, FACE>(map, faces) ;
+	CGoGN::Parallel::foreach_index(map, uint32(faces.size()), [&] (unsigned int i, unsigned int)
+	{
+		if (regularMarker.isMarked(faces[i]))
+			ridgeLines<PFP>(map, faces[i], position, K, vertex_gradient, k, k2, ridge_segments) ;
+	}, nbth) ;
+}
+
+template <typename PFP>
+void computeSingularTriangle(
+	typename PFP::MAP& map,
+	CellMarker<typename PFP::MAP, FACE>& regularMarker,
+	FaceAttribute<RidgeSegment<typename PFP::REAL>, typename PFP::MAP>& ridge_segments,
+	unsigned int nbth)
+{
+	CGoGN_SCOPED_TIMER("Algo::Surface::Geometry::Parallel::computeSingularTriangle") ;
+
+	std::vector<Dart> faces ;
+	gatherCells<typename PFP::MAP, FACE>(map, faces) ;
+	CGoGN::Parallel::foreach_index(map, uint32(faces.size()), [&] (unsigned int i, unsigned int)
+	{
+		if (! regularMarker.isMarked(faces[i]))
+			singularTriangle<PFP>(map, faces[i], regularMarker, ridge_segments) ;
+	}, nbth) ;
+}
+
+} // namespace Parallel
+
 } // namespace Geometry
 
 } // namespace Surface
@@ -0,0 +1,119 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __ALGO_GEOMETRY_MESH_STATISTICS_H__
+#define __ALGO_GEOMETRY_MESH_STATISTICS_H__
+
+#include <vector>
+
+#include "Geometry/basic.h"
+#include "Geometry/bounding_box.h"
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/traversor/traversorCell.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Geometry
+{
+
+/**
+ * Geometric statistics of a surface mesh (see computeMeshStatistics)
+ */
+template <typename PFP>
+struct MeshStatistics
+{
+	typedef typename PFP::REAL REAL ;
+	typedef typename PFP::VEC3 VEC3 ;
+
+	unsigned int nbVertices ;
+	unsigned int nbEdges ;
+	unsigned int nbFaces ;
+
+	/// bounding box of the vertices
+	Geom::BoundingBox<VEC3> bb ;
+	/// mean of the vertex positions
+	VEC3 centroid ;
+
+	/// sum of the face areas (as convexFaceArea)
+	REAL area ;
+	/// signed volume enclosed by the faces (only meaningful for closed surfaces)
+	REAL volume ;
+	/// centroid of the enclosed solid (only meaningful for closed surfaces of non null volume)
+	VEC3 volumeCentroid ;
+
+	REAL edgeLengthMin ;
+	REAL edgeLengthMax ;
+	REAL edgeLengthMean ;
+
+	/// edge lengths, nbBins regular classes of [0,edgeLengthRange]
+	REAL edgeLengthRange ;
+	std::vector<unsigned int> edgeLengthHistogram ;
+	/// angles of the face corners, nbBins regular classes of [0,pi]
+	std::vector<unsigned int> angleHistogram ;
+	/// quality of the triangles 4*sqrt(3)*area / (sum of squared edge lengths),
+	/// nbBins regular classes of [0,1] (1 for an equilateral triangle)
+	std::vector<unsigned int> qualityHistogram ;
+} ;
+
+/**
+ * Compute all the statistics of a surface mesh in one pass:
+ * the vertex container is scanned for bounding box and centroid, then the dart container
+ * for areas, volume, edges, angles and triangle qualities.
+ * Both containers are cut in fixed size blocks of indices that are summed sequentially
+ * and the block sums are reduced pairwise, so the result does not depend on the
+ * number of threads and is the same from one run to another.
+ * @param map the map
+ * @param position vertex positions
+ * @param stats the result
+ * @param nbBins number of classes of the histograms
+ * @param edgeLengthRange upper bound of the edge length histogram (0: diagonal of the bounding box)
+ * @param nbth number of threads
+ */
+template <typename PFP>
+void computeMeshStatistics(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	MeshStatistics<PFP>& stats,
+	unsigned int nbBins = 32,
+	typename PFP::REAL edgeLengthRange = 0,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+} // namespace Geometry
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Geometry/meshStatistics.hpp"
+
+#endif
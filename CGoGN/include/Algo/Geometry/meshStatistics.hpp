@@ -0,0 +1,312 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cmath>
+#include <algorithm>
+
+#include "Utils/instrumentation.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Geometry
+{
+
+// private: number of container indices summed sequentially before the pairwise reduction
+const unsigned int MESH_STATISTICS_BLOCK_SIZE = 4096 ;
+
+// private function: sum of the values in a fixed binary tree order (v is modified)
+template <typename T>
+T pairwiseSum(std::vector<T>& v)
+{
+	if (v.empty())
+		return T() ;
+	for (std::size_t step = 1; step < v.size(); step *= 2)
+		for (std::size_t i = 0; i + step < v.size(); i += 2 * step)
+			v[i] += v[i + step] ;
+	return v[0] ;
+}
+
+// private: sums of one block of darts
+template <typename REAL, typename VEC3>
+struct MeshStatisticsSums
+{
+	REAL area ;
+	REAL volume ;
+	VEC3 moment ;
+	REAL edgeLength ;
+
+	MeshStatisticsSums() : area(0), volume(0), edgeLength(0) {}
+
+	MeshStatisticsSums& operator+=(const MeshStatisticsSums& s)
+	{
+		area += s.area ;
+		volume += s.volume ;
+		moment += s.moment ;
+		edgeLength += s.edgeLength ;
+		return *this ;
+	}
+} ;
+
+// private: order independent results of one thread (counts, extrema and histograms)
+template <typename REAL, typename VEC3>
+struct MeshStatisticsThread
+{
+	unsigned int nbVertices ;
+	unsigned int nbEdges ;
+	unsigned int nbFaces ;
+	Geom::BoundingBox<VEC3> bb ;
+	REAL edgeLengthMin ;
+	REAL edgeLengthMax ;
+	std::vector<unsigned int> edgeLengthHistogram ;
+	std::vector<unsigned int> angleHistogram ;
+	std::vector<unsigned int> qualityHistogram ;
+
+	MeshStatisticsThread() : nbVertices(0), nbEdges(0), nbFaces(0), edgeLengthMin(0), edgeLengthMax(0) {}
+} ;
+
+// private function: class of value v in [0,range] with nb classes (the upper bound is in the last class)
+template <typename REAL>
+inline void addToHistogram(std::vector<unsigned int>& histo, REAL v, REAL range)
+{
+	if (!(v >= REAL(0)))	// also rejects NaN (degenerated elements)
+		return ;
+	const unsigned int nb = uint32(histo.size()) ;
+	unsigned int c = nb - 1 ;
+	if (v < range)
+		c = std::min(uint32(v / range * REAL(nb)), nb - 1) ;
+	++histo[c] ;
+}
+
+template <typename PFP>
+void computeMeshStatistics(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	MeshStatistics<PFP>& stats,
+	unsigned int nbBins,
+	typename PFP::REAL edgeLengthRange,
+	unsigned int nbth)
+{
+	CGoGN_SCOPED_TIMER("Algo::Surface::Geometry::computeMeshStatistics") ;
+
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+	typedef MeshStatisticsSums<REAL, VEC3> SUMS ;
+	typedef MeshStatisticsThread<REAL, VEC3> THREAD ;
+
+	const unsigned int B = MESH_STATISTICS_BLOCK_SIZE ;
+	if (nbth < 1)
+		nbth = 1 ;
+	if (nbBins < 1)
+		nbBins = 1 ;
+
+	std::vector<THREAD> local(nbth) ;
+
+	// vertices: bounding box & centroid (data parallel over the vertex container)
+	const AttributeContainer& vcont = map.template getAttributeContainer<VERTEX>() ;
+	const unsigned int nbVB = (vcont.realEnd() + B - 1) / B ;
+	std::vector<VEC3> posSums(nbVB) ;
+	CGoGN::Parallel::foreach_index(map, nbVB, [&] (unsigned int b, unsigned int thr)
+	{
+		THREAD& loc = local[thr] ;
+		VEC3 sum ;
+		const unsigned int end = std::min((b + 1) * B, vcont.realEnd()) ;
+		for (unsigned int i = b * B; i < end; ++i)
+		{
+			if (vcont.used(i))
+			{
+				const VEC3& p = position[i] ;
+				sum += p ;
+				loc.bb.addPoint(p) ;
+				++loc.nbVertices ;
+			}
+		}
+		posSums[b] = sum ;
+	}, nbth) ;
+
+	stats.nbVertices = 0 ;
+	stats.bb.reset() ;
+	for (unsigned int t = 0; t < nbth; ++t)
+	{
+		stats.nbVertices += local[t].nbVertices ;
+		if (!local[t].bb.isInitialized())
+			continue ;
+		if (stats.bb.isInitialized())
+			stats.bb.fusion(local[t].bb) ;
+		else
+			stats.bb = local[t].bb ;
+	}
+	stats.centroid = pairwiseSum(posSums) ;
+	if (stats.nbVertices > 0)
+		stats.centroid /= REAL(stats.nbVertices) ;
+
+	// the volume is computed relatively to the center of the bounding box (better conditioning)
+	const VEC3 ref = stats.bb.isInitialized() ? stats.bb.center() : VEC3(0) ;
+
+	stats.edgeLengthRange = edgeLengthRange ;
+	if (!(stats.edgeLengthRange > REAL(0)))
+		stats.edgeLengthRange = stats.bb.isInitialized() ? stats.bb.diagSize() : REAL(0) ;
+	if (!(stats.edgeLengthRange > REAL(0)))
+		stats.edgeLengthRange = REAL(1) ;
+
+	for (unsigned int t = 0; t < nbth; ++t)
+	{
+		local[t].edgeLengthHistogram.assign(nbBins, 0) ;
+		local[t].angleHistogram.assign(nbBins, 0) ;
+		local[t].qualityHistogram.assign(nbBins, 0) ;
+	}
+
+	// darts: faces (first dart of each face), edges (first dart of each edge)
+	const AttributeContainer& dcont = map.template getAttributeContainer<DART>() ;
+	const unsigned int nbDB = (dcont.realEnd() + B - 1) / B ;
+	std::vector<SUMS> dartSums(nbDB) ;
+	const REAL quality = REAL(4.0 * std::sqrt(3.0)) ;
+	CGoGN::Parallel::foreach_index(map, nbDB, [&] (unsigned int b, unsigned int thr)
+	{
+		THREAD& loc = local[thr] ;
+		SUMS sums ;
+		const unsigned int end = std::min((b + 1) * B, dcont.realEnd()) ;
+		for (unsigned int i = b * B; i < end; ++i)
+		{
+			if (!dcont.used(i))
+				continue ;
+			Dart d(i) ;
+
+			if (isFirstDartOfOrbit<EDGE>(map, d))
+			{
+				REAL l = (position[map.phi1(d)] - position[d]).norm() ;
+				if (loc.nbEdges == 0 || l < loc.edgeLengthMin)
+					loc.edgeLengthMin = l ;
+				if (loc.nbEdges == 0 || l > loc.edgeLengthMax)
+					loc.edgeLengthMax = l ;
+				++loc.nbEdges ;
+				sums.edgeLength += l ;
+				addToHistogram(loc.edgeLengthHistogram, l, stats.edgeLengthRange) ;
+			}
+
+			if (map.isBoundaryMarkedCurrent(d) || !isFirstDartOfOrbit<FACE>(map, d))
+				continue ;
+
+			++loc.nbFaces ;
+
+			// corners
+			unsigned int nb = 0 ;
+			VEC3 center ;
+			Dart e = d ;
+			do
+			{
+				const VEC3& p = position[e] ;
+				REAL a = Geom::angle(position[map.phi1(e)] - p, position[map.phi_1(e)] - p) ;
+				addToHistogram(loc.angleHistogram, a, REAL(M_PI)) ;
+				center += p ;
+				++nb ;
+				e = map.phi1(e) ;
+			} while (e != d) ;
+
+			if (nb == 3)
+			{
+				const VEC3 p1 = position[d] - ref ;
+				const VEC3 p2 = position[map.phi1(d)] - ref ;
+				const VEC3 p3 = position[map.phi_1(d)] - ref ;
+				REAL a = Geom::triangleArea(p1, p2, p3) ;
+				REAL v = (p1 * (p2 ^ p3)) / REAL(6) ;
+				sums.area += a ;
+				sums.volume += v ;
+				sums.moment += (p1 + p2 + p3) * (v / REAL(4)) ;
+				REAL l2 = (p2 - p1).norm2() + (p3 - p2).norm2() + (p1 - p3).norm2() ;
+				if (l2 > REAL(0))
+					addToHistogram(loc.qualityHistogram, quality * a / l2, REAL(1)) ;
+			}
+			else
+			{
+				// cut with the centroid of the face, as convexFaceArea
+				center /= REAL(nb) ;
+				center -= ref ;
+				e = d ;
+				do
+				{
+					const VEC3 p1 = position[e] - ref ;
+					const VEC3 p2 = position[map.phi1(e)] - ref ;
+					REAL v = (p1 * (p2 ^ center)) / REAL(6) ;
+					sums.area += Geom::triangleArea(p1, p2, center) ;
+					sums.volume += v ;
+					sums.moment += (p1 + p2 + center) * (v / REAL(4)) ;
+					e = map.phi1(e) ;
+				} while (e != d) ;
+			}
+		}
+		dartSums[b] = sums ;
+	}, nbth) ;
+
+	SUMS total = pairwiseSum(dartSums) ;
+
+	stats.nbEdges = 0 ;
+	stats.nbFaces = 0 ;
+	stats.edgeLengthMin = REAL(0) ;
+	stats.edgeLengthMax = REAL(0) ;
+	stats.edgeLengthHistogram.assign(nbBins, 0) ;
+	stats.angleHistogram.assign(nbBins, 0) ;
+	stats.qualityHistogram.assign(nbBins, 0) ;
+	for (unsigned int t = 0; t < nbth; ++t)
+	{
+		const THREAD& loc = local[t] ;
+		if (loc.nbEdges > 0)
+		{
+			if (stats.nbEdges == 0 || loc.edgeLengthMin < stats.edgeLengthMin)
+				stats.edgeLengthMin = loc.edgeLengthMin ;
+			if (stats.nbEdges == 0 || loc.edgeLengthMax > stats.edgeLengthMax)
+				stats.edgeLengthMax = loc.edgeLengthMax ;
+		}
+		stats.nbEdges += loc.nbEdges ;
+		stats.nbFaces += loc.nbFaces ;
+		for (unsigned int c = 0; c < nbBins; ++c)
+		{
+			stats.edgeLengthHistogram[c] += loc.edgeLengthHistogram[c] ;
+			stats.angleHistogram[c] += loc.angleHistogram[c] ;
+			stats.qualityHistogram[c] += loc.qualityHistogram[c] ;
+		}
+	}
+
+	stats.area = total.area ;
+	stats.volume = total.volume ;
+	stats.volumeCentroid = ref ;
+	if (total.volume != REAL(0))
+		stats.volumeCentroid += total.moment / total.volume ;
+	stats.edgeLengthMean = (stats.nbEdges > 0) ? total.edgeLength / REAL(stats.nbEdges) : REAL(0) ;
+}
+
+} // namespace Geometry
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
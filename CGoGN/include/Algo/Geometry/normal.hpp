@@ -175,6 +175,7 @@ void computeNormalFaces(typename PFP::MAP& map, const V_ATT& position, F_ATT& fa
 template <typename PFP, typename V_ATT>
 void computeNormalVertices(typename PFP::MAP& map, const V_ATT& position, V_ATT& normal)
 {
+	CGoGN_SCOPED_TIMER("Algo::Surface::Geometry::computeNormalVertices");
 	CHECK_ATTRIBUTEHANDLER_ORBIT(V_ATT, VERTEX);
 
 	if (CGoGN::Parallel::NumberOfThreads > 1)
@@ -249,6 +250,7 @@ namespace Parallel
 template <typename PFP, typename V_ATT>
 void computeNormalVertices(typename PFP::MAP& map, const V_ATT& position, V_ATT& normal)
 {
+	CGoGN_SCOPED_TIMER("Algo::Surface::Geometry::Parallel::computeNormalVertices");
 	CHECK_ATTRIBUTEHANDLER_ORBIT(V_ATT, VERTEX);
 
 	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int /*thr*/)
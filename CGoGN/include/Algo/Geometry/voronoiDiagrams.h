@@ -4,9 +4,13 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <atomic>
+#include <limits>
 
 //#include "Topology/map/map2.h"
 #include "Topology/generic/traversor/traversor2.h"
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Topology/generic/autoAttributeHandler.h"
 
 namespace CGoGN
 {
@@ -20,6 +24,12 @@ namespace Surface
 namespace Geometry
 {
 
+/**
+ * Voronoi diagram of a surface mesh for the graph distance given by edge costs.
+ * Regions are grown from the seeds by a Dijkstra propagation (computeDiagram)
+ * whose front is an indexed binary heap (ties popped in insertion order),
+ * or by a multi-source parallel propagation (computeDiagram_parallel)
+ */
 template <typename PFP>
 class VoronoiDiagram
 {
@@ -28,17 +38,55 @@ class VoronoiDiagram
 	typedef typename PFP::REAL REAL;
 
 protected :
-	typedef struct
+	struct VoronoiVertexInfo
 	{
-		typename std::multimap<REAL,Dart>::iterator it ;
-		bool valid ;
+		REAL dist ; // (tentative) distance from the seed
+		unsigned int heapPos ; // position in the front
+		unsigned long long stamp ; // number of the propagation that has reached the vertex
+		bool valid ; // vertex is in the front
 //		unsigned int region;
 		Dart pathOrigin;
+		VoronoiVertexInfo() : dist(0), heapPos(0), stamp(0), valid(false) {}
 		static std::string CGoGNnameOfType() { return "VoronoiVertexInfo" ; }
-	} VoronoiVertexInfo ;
+	} ;
 
 	typedef NoTypeNameAttribute<VoronoiVertexInfo> VertexInfo ;
 
+	/**
+	 * front of a propagation: binary heap of vertices ordered by (distance, insertion order)
+	 * the position of each vertex in the heap is stored in its VertexInfo
+	 */
+	class VertexFront
+	{
+		struct Elt
+		{
+			REAL dist ;
+			unsigned long long order ;
+			Dart d ;
+		} ;
+
+		VertexAttribute<VertexInfo, MAP>& info ;
+		std::vector<Elt> heap ;
+		unsigned long long counter ;
+
+		bool less(const Elt& a, const Elt& b) const { return (a.dist < b.dist) || (a.dist == b.dist && a.order < b.order) ; }
+		void place(unsigned int i, const Elt& e) { heap[i] = e ; info[e.d].heapPos = i ; }
+		void siftUp(unsigned int i) ;
+		void siftDown(unsigned int i) ;
+
+	public :
+		VertexFront(VertexAttribute<VertexInfo, MAP>& vi) : info(vi), counter(0) {}
+		bool empty() const { return heap.empty() ; }
+		void clear() { heap.clear() ; counter = 0 ; }
+		Dart top() const { return heap.front().d ; }
+		REAL topDist() const { return heap.front().dist ; }
+		REAL dist(Dart d) const { return heap[info[d].heapPos].dist ; }
+		void push(Dart d, REAL dist) ;
+		void pop() ;
+		// d must be in the front and dist lower than its current distance
+		void decrease(Dart d, REAL dist) ;
+	} ;
+
 	MAP& map;
 	const EdgeAttribute<REAL, MAP>& edgeCost; // weights on the graph edges
 	VertexAttribute<unsigned int, MAP>& regions; // region labels
@@ -46,30 +94,57 @@ protected :
 	std::vector<Dart> seeds;
 
 	VertexAttribute<VertexInfo, MAP> vertexInfo;
-	std::multimap<REAL,Dart> front ;
-	CellMarker<MAP, VERTEX> vmReached;
+	VertexFront front ;
+	std::atomic<unsigned long long> stampCounter ; // numbering of the propagations (0 : never reached)
+	unsigned int nbThreads ;
 
 public :
 	VoronoiDiagram (MAP& m, const EdgeAttribute<REAL, MAP>& c, VertexAttribute<unsigned int, MAP>& r);
-	~VoronoiDiagram ();
+	virtual ~VoronoiDiagram ();
 
 	const std::vector<Dart>& getSeeds () { return seeds; }
 	virtual void setSeeds_fromVector (const std::vector<Dart>&);
 	virtual void setSeeds_random (unsigned int nbseeds);
 	const std::vector<Dart>& getBorder () { return border; }
 
+	/**
+	 * number of threads used by computeDiagram_parallel and the per region computations
+	 * (default Parallel::NumberOfThreads)
+	 */
+	void setNbThreads (unsigned int nb) { nbThreads = nb; }
+	unsigned int getNbThreads () { return nbThreads; }
+
 //	void setCost (const EdgeAttribute<REAL,MAP>& c); // impossible to reaffect a ref TODO pointer ?
 
 	Dart computeDiagram ();
+
+	/**
+	 * compute the diagram with all regions grown together in parallel:
+	 * synchronous relaxation rounds where each vertex pulls the best (distance, region)
+	 * from the neighbors updated in previous round, until no vertex changes.
+	 * The number of rounds is the max number of edges of the shortest paths, so this is
+	 * efficient when there are many seeds. Vertices at the same distance of two seeds
+	 * go to the lower seed index (computeDiagram follows the order of propagation).
+	 * @return the vertex the farthest from the seeds
+	 */
+	Dart computeDiagram_parallel ();
+
 	virtual void computeDiagram_incremental (unsigned int nbseeds);
 	void computeDistancesWithinRegion (Dart seed);
 
 protected :
 	virtual void clear ();
-	void initFrontWithSeeds();
+	// returns the stamp of the propagation
+	unsigned long long initFrontWithSeeds();
+	unsigned long long newStamp() { return ++stampCounter; }
+	// record the vertex e popped from the front
 	virtual void collectVertexFromFront(Dart e);
-	void addVertexToFront(Dart f, REAL d);
-	void updateVertexInFront(Dart f, REAL d);
+	// record the result of computeDiagram_parallel for vertex e (called in parallel)
+	virtual void collectVertex(Dart e, REAL dist, Dart origin, unsigned int region);
+	void addVertexToFront(VertexFront& vf, Dart f, REAL d, unsigned long long stamp);
+	void updateVertexInFront(VertexFront& vf, Dart f, REAL d);
+	// Dijkstra restricted to the region of seed (can run in parallel on different regions)
+	void computeDistancesWithinRegion (Dart seed, VertexFront& vf);
 };
 
 template <typename PFP>
@@ -78,6 +153,7 @@ class CentroidalVoronoiDiagram : public VoronoiDiagram<PFP>
 	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
 	typedef typename PFP::REAL REAL;
+	typedef typename VoronoiDiagram<PFP>::VertexFront VertexFront;
 
 private :
 	double globalEnergy;
@@ -101,8 +177,10 @@ public :
 	void setSeeds_fromVector (const std::vector<Dart>&);
 	void setSeeds_random (unsigned int nbseeds);
 	void computeDiagram_incremental (unsigned int nbseeds);
+	// the regions are processed in parallel (the energy is summed in seed order)
 	void cumulateEnergy();
 	void cumulateEnergyAndGradients();
+	// the seed moves are computed in parallel over the regions
 	unsigned int moveSeedsOneEdgeNoCheck(); // returns the number of seeds that did move
 	// move each seed along one edge according to the energy gradient
 	unsigned int moveSeedsOneEdgeCheck(); // returns the number of seeds that did move
@@ -114,9 +192,10 @@ public :
 protected :
 	void clear();
 	void collectVertexFromFront(Dart e);
+	void collectVertex(Dart e, REAL dist, Dart origin, unsigned int region);
 	REAL cumulateEnergyFromRoot(Dart e);
-	void cumulateEnergyAndGradientFromSeed(unsigned int numSeed);
-	Dart selectBestNeighborFromSeed(unsigned int numSeed);
+	void cumulateEnergyAndGradientFromSeed(unsigned int numSeed, const VertexAttribute<VEC3, MAP>& pos);
+	Dart selectBestNeighborFromSeed(unsigned int numSeed, const VertexAttribute<VEC3, MAP>& pos);
 //	unsigned int moveSeed(unsigned int numSeed);
 };
 
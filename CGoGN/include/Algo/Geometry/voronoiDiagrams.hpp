@@ -10,6 +10,80 @@ namespace Surface
 namespace Geometry
 {
 
+/***********************************************************
+ * class VoronoiDiagram::VertexFront
+ ***********************************************************/
+
+template <typename PFP>
+void VoronoiDiagram<PFP>::VertexFront::siftUp(unsigned int i)
+{
+	Elt e = heap[i];
+	while (i > 0)
+	{
+		unsigned int parent = (i - 1) / 2;
+		if (!less(e, heap[parent]))
+			break;
+		place(i, heap[parent]);
+		i = parent;
+	}
+	place(i, e);
+}
+
+template <typename PFP>
+void VoronoiDiagram<PFP>::VertexFront::siftDown(unsigned int i)
+{
+	Elt e = heap[i];
+	unsigned int nb = uint32(heap.size());
+	while (true)
+	{
+		unsigned int child = 2 * i + 1;
+		if (child >= nb)
+			break;
+		if ((child + 1 < nb) && less(heap[child + 1], heap[child]))
+			++child;
+		if (!less(heap[child], e))
+			break;
+		place(i, heap[child]);
+		i = child;
+	}
+	place(i, e);
+}
+
+template <typename PFP>
+void VoronoiDiagram<PFP>::VertexFront::push(Dart d, REAL dist)
+{
+	Elt e;
+	e.dist = dist;
+	e.order = counter++;
+	e.d = d;
+	info[d].dist = dist;
+	heap.push_back(e);
+	siftUp(uint32(heap.size() - 1));
+}
+
+template <typename PFP>
+void VoronoiDiagram<PFP>::VertexFront::pop()
+{
+	Elt last = heap.back();
+	heap.pop_back();
+	if (!heap.empty())
+	{
+		place(0, last);
+		siftDown(0);
+	}
+}
+
+template <typename PFP>
+void VoronoiDiagram<PFP>::VertexFront::decrease(Dart d, REAL dist)
+{
+	// a new insertion order, as if the vertex was removed and inserted again
+	unsigned int i = info[d].heapPos;
+	heap[i].dist = dist;
+	heap[i].order = counter++;
+	info[d].dist = dist;
+	siftUp(i);
+}
+
 /***********************************************************
  * class VoronoiDiagram
  ***********************************************************/
@@ -19,7 +93,9 @@ VoronoiDiagram<PFP>::VoronoiDiagram (MAP& m, const EdgeAttribute<REAL, MAP>& p,
 	map(m),
 	edgeCost (p),
 	regions (r),
-	vmReached(m)
+	front(vertexInfo),
+	stampCounter(0),
+	nbThreads(CGoGN::Parallel::NumberOfThreads)
 {
 	vertexInfo = map.template addAttribute<VertexInfo, VERTEX, typename PFP::MAP>("vertexInfo");
 }
@@ -36,7 +112,6 @@ void VoronoiDiagram<PFP>::clear ()
 	regions.setAllValues(0);
 	border.clear();
 	front.clear();
-	vmReached.unmarkAll();
 }
 
 template <typename PFP>
@@ -86,19 +161,24 @@ void VoronoiDiagram<PFP>::setSeeds_random (unsigned int nseeds)
 }
 
 template <typename PFP>
-void VoronoiDiagram<PFP>::initFrontWithSeeds ()
+unsigned long long VoronoiDiagram<PFP>::initFrontWithSeeds ()
 {
-//	vmReached.unmarkAll();
 	clear();
+	unsigned long long stamp = newStamp();
 	for (unsigned int i = 0; i < seeds.size(); i++)
 	{
 		Dart d = seeds[i];
-		vmReached.mark(d);
-		vertexInfo[d].it = front.insert(std::pair<REAL,Dart>(0.0, d));
-		vertexInfo[d].valid = true;
+		VertexInfo& vi = vertexInfo[d];
+		if (vi.stamp != stamp) // (a vertex given twice as seed is in the front once)
+		{
+			vi.stamp = stamp;
+			front.push(d, 0.0);
+			vi.valid = true;
+		}
 		regions[d] = i;
-		vertexInfo[d].pathOrigin = d;
+		vi.pathOrigin = d;
 	}
+	return stamp;
 }
 
 //template <typename PFP>
@@ -110,30 +190,41 @@ void VoronoiDiagram<PFP>::initFrontWithSeeds ()
 template <typename PFP>
 void VoronoiDiagram<PFP>::collectVertexFromFront(Dart e)
 {
-	regions[e] = regions[vertexInfo[e].pathOrigin];
-	front.erase(vertexInfo[e].it);
+	// no write when the region is unchanged (regions may be read by other threads)
+	unsigned int r = regions[vertexInfo[e].pathOrigin];
+	if (regions[e] != r)
+		regions[e] = r;
 	vertexInfo[e].valid=false;
 }
 
 template <typename PFP>
-void VoronoiDiagram<PFP>::addVertexToFront(Dart f, REAL d)
+void VoronoiDiagram<PFP>::collectVertex(Dart e, REAL dist, Dart origin, unsigned int region)
+{
+	regions[e] = region;
+	VertexInfo& vi (vertexInfo[e]);
+	vi.dist = dist;
+	vi.pathOrigin = origin;
+	vi.valid = false;
+}
+
+template <typename PFP>
+void VoronoiDiagram<PFP>::addVertexToFront(VertexFront& vf, Dart f, REAL d, unsigned long long stamp)
 {
 	VertexInfo& vi (vertexInfo[f]);
-	vi.it = front.insert(std::pair<REAL,Dart>(d + edgeCost[f], f));
+	vi.stamp = stamp;
+	vf.push(f, d + edgeCost[f]);
 	vi.valid = true;
 	vi.pathOrigin = map.phi2(f);
-	vmReached.mark(f);
 }
 
 template <typename PFP>
-void VoronoiDiagram<PFP>::updateVertexInFront(Dart f, REAL d)
+void VoronoiDiagram<PFP>::updateVertexInFront(VertexFront& vf, Dart f, REAL d)
 {
 	VertexInfo& vi (vertexInfo[f]);
 	REAL dist = d + edgeCost[f];
-	if (dist < vi.it->first)
+	if (dist < vi.dist)
 	{
-		front.erase(vi.it);
-		vi.it = front.insert(std::pair<REAL,Dart>(dist, f));
+		vf.decrease(f, dist);
 		vi.pathOrigin = map.phi2(f);
 	}
 }
@@ -141,23 +232,25 @@ void VoronoiDiagram<PFP>::updateVertexInFront(Dart f, REAL d)
 template <typename PFP>
 Dart VoronoiDiagram<PFP>::computeDiagram ()
 {
-	initFrontWithSeeds();
+	unsigned long long stamp = initFrontWithSeeds();
 
 	Dart e;
 	while ( !front.empty() )
 	{
-		e = front.begin()->second;
-		REAL d = front.begin()->first;
+		e = front.top();
+		REAL d = front.topDist();
+		front.pop();
 
 		collectVertexFromFront(e);
 
 		Traversor2VVaE<MAP> tv (map, e);
 		for (Dart f = tv.begin(); f != tv.end(); f=tv.next())
 		{
-			if (vmReached.isMarked(f))
+			VertexInfo& vi (vertexInfo[f]);
+			if (vi.stamp == stamp)
 			{ // f has been reached
-				if (vertexInfo[f].valid) // f is in the front : update
-					updateVertexInFront(f,d);
+				if (vi.valid) // f is in the front : update
+					updateVertexInFront(front,f,d);
 				else // f is not in the front any more (already collected) : detect a border edge
 				{
 					if ( regions[f] != regions[e] )
@@ -166,13 +259,126 @@ Dart VoronoiDiagram<PFP>::computeDiagram ()
 			}
 			else
 			{ // f has not been reached : add it to the front
-				addVertexToFront(f,d);
+				addVertexToFront(front,f,d,stamp);
 			}
 		}
 	}
 	return e;
 }
 
+template <typename PFP>
+Dart VoronoiDiagram<PFP>::computeDiagram_parallel ()
+{
+	clear();
+
+	std::vector<Dart> vertices;
+	VertexAutoAttribute<unsigned int, MAP> vindex(map, "vindex");
+	TraversorV<MAP> trav(map);
+	for (Dart d = trav.begin(); d != trav.end(); d = trav.next())
+	{
+		vindex[d] = uint32(vertices.size());
+		vertices.push_back(d);
+	}
+	const unsigned int nbv = uint32(vertices.size());
+
+	// state of the vertices at previous / current round
+	const REAL inf = std::numeric_limits<REAL>::max();
+	std::vector<REAL> dist[2];
+	std::vector<unsigned int> reg[2];
+	std::vector<Dart> origin[2];
+	std::vector<unsigned char> changed[2];
+	for (unsigned int b = 0; b < 2; ++b)
+	{
+		dist[b].assign(nbv, inf);
+		reg[b].assign(nbv, 0);
+		origin[b].assign(nbv, Dart::nil());
+		changed[b].assign(nbv, 0);
+	}
+
+	for (unsigned int i = 0; i < seeds.size(); i++)
+	{
+		unsigned int k = vindex[seeds[i]];
+		dist[0][k] = 0;
+		reg[0][k] = i;
+		origin[0][k] = seeds[i];
+		changed[0][k] = 1;
+	}
+
+	unsigned int nbth = nbThreads > 0 ? nbThreads : 1;
+	unsigned int cur = 0;
+	bool active = !seeds.empty();
+	while (active)
+	{
+		unsigned int nxt = 1 - cur;
+		std::vector<unsigned char> activeThread(nbth, 0);
+		CGoGN::Parallel::foreach_index(map, nbv, [&] (unsigned int i, unsigned int t)
+		{
+			REAL bestDist = dist[cur][i];
+			unsigned int bestReg = reg[cur][i];
+			Dart bestOrigin = origin[cur][i];
+			bool ch = false;
+
+			// pull from the neighbors that have changed at previous round
+			Traversor2VVaE<MAP> tv (map, vertices[i]);
+			for (Dart f = tv.begin(); f != tv.end(); f = tv.next())
+			{
+				unsigned int j = vindex[f];
+				if (!changed[cur][j])
+					continue;
+				REAL dj = dist[cur][j] + edgeCost[f];
+				if ((dj < bestDist) || (dj == bestDist && reg[cur][j] < bestReg))
+				{
+					bestDist = dj;
+					bestReg = reg[cur][j];
+					bestOrigin = f;
+					ch = true;
+				}
+			}
+
+			dist[nxt][i] = bestDist;
+			reg[nxt][i] = bestReg;
+			origin[nxt][i] = bestOrigin;
+			changed[nxt][i] = ch;
+			if (ch)
+				activeThread[t] = 1;
+		}, nbth);
+
+		cur = nxt;
+		active = false;
+		for (unsigned int t = 0; t < nbth; ++t)
+			active |= (activeThread[t] != 0);
+	}
+
+	CGoGN::Parallel::foreach_index(map, nbv, [&] (unsigned int i, unsigned int)
+	{
+		if (dist[cur][i] != inf)
+			collectVertex(vertices[i], dist[cur][i], origin[cur][i], reg[cur][i]);
+	}, nbth);
+
+	// border edges (one dart per edge) and farthest vertex
+	Dart farthest = vertices.empty() ? Dart::nil() : vertices[0];
+	REAL maxDist = -1;
+	for (unsigned int i = 0; i < nbv; ++i)
+	{
+		if (dist[cur][i] == inf)
+			continue;
+		if (dist[cur][i] > maxDist)
+		{
+			maxDist = dist[cur][i];
+			farthest = vertices[i];
+		}
+		Traversor2VVaE<MAP> tv (map, vertices[i]);
+		for (Dart f = tv.begin(); f != tv.end(); f = tv.next())
+		{
+			unsigned int j = vindex[f];
+			if ((j < i) && (dist[cur][j] != inf) && (reg[cur][j] != reg[cur][i]))
+				border.push_back(f);
+		}
+	}
+
+	return farthest;
+}
+
 template <typename PFP>
 void VoronoiDiagram<PFP>::computeDiagram_incremental (unsigned int nseeds)
 {
@@ -203,34 +409,46 @@ void VoronoiDiagram<PFP>::computeDiagram_incremental (unsigned int nseeds)
 
 template <typename PFP>
 void VoronoiDiagram<PFP>::computeDistancesWithinRegion (Dart seed)
+{
+	computeDistancesWithinRegion(seed, front);
+}
+
+template <typename PFP>
+void VoronoiDiagram<PFP>::computeDistancesWithinRegion (Dart seed, VertexFront& vf)
 {
 	// init
-	front.clear();
-	vmReached.unmarkAll();
+	vf.clear();
+	unsigned long long stamp = newStamp();
 
-	vmReached.mark(seed);
-	vertexInfo[seed].it = front.insert(std::pair<REAL,Dart>(0.0, seed));
-	vertexInfo[seed].valid = true;
-	vertexInfo[seed].pathOrigin = seed;
+	VertexInfo& vs (vertexInfo[seed]);
+	vs.stamp = stamp;
+	vf.push(seed, 0.0);
+	vs.valid = true;
+	vs.pathOrigin = seed;
 
 	//compute
-	while ( !front.empty() )
+	while ( !vf.empty() )
 	{
-		Dart e = front.begin()->second;
-		REAL d = front.begin()->first;
+		Dart e = vf.top();
+		REAL d = vf.topDist();
+		vf.pop();
 
 		collectVertexFromFront(e);
 
 		Traversor2VVaE<MAP> tv (map, e);
 		for (Dart f = tv.begin(); f != tv.end(); f=tv.next())
 		{
-			if (vmReached.isMarked(f))
+			// only the vertices of the region are reached (other regions may be processed by other threads)
+			if ( regions[f] != regions[e] )
+				continue;
+			VertexInfo& vi (vertexInfo[f]);
+			if (vi.stamp == stamp)
 			{ // f has been reached
-				if (vertexInfo[f].valid) updateVertexInFront(f,d); // f is in the front : update
+				if (vi.valid) updateVertexInFront(vf,f,d); // f is in the front : update
 			}
 			else
 			{ // f has not been reached : add it to the front
-				if ( regions[f] == regions[e] ) addVertexToFront(f,d);
+				addVertexToFront(vf,f,d,stamp);
 			}
 		}
 	}
@@ -267,12 +485,20 @@ void CentroidalVoronoiDiagram<PFP>::clear ()
 template <typename PFP>
 void CentroidalVoronoiDiagram<PFP>::collectVertexFromFront(Dart e)
 {
-	distances[e] = this->vertexInfo[e].it->first;
+	distances[e] = this->vertexInfo[e].dist;
 	pathOrigins[e] = this->vertexInfo[e].pathOrigin;
 
 	VoronoiDiagram<PFP>::collectVertexFromFront(e);
 }
 
+template <typename PFP>
+void CentroidalVoronoiDiagram<PFP>::collectVertex(Dart e, REAL dist, Dart origin, unsigned int region)
+{
+	distances[e] = dist;
+	pathOrigins[e] = origin;
+
+	VoronoiDiagram<PFP>::collectVertex(e, dist, origin, region);
+}
 
 template <typename PFP>
 void CentroidalVoronoiDiagram<PFP>::setSeeds_fromVector (const std::vector<Dart>& s)
@@ -298,77 +524,108 @@ void CentroidalVoronoiDiagram<PFP>::computeDiagram_incremental (unsigned int nse
 template <typename PFP>
 void CentroidalVoronoiDiagram<PFP>::cumulateEnergy()
 {
-	globalEnergy = 0.0;
-	for (unsigned int i = 0; i < this->seeds.size(); i++)
+	// the regions are disjoint trees of pathOrigins
+	CGoGN::Parallel::foreach_index(this->map, uint32(this->seeds.size()), [&] (unsigned int i, unsigned int)
 	{
 		cumulateEnergyFromRoot(this->seeds[i]);
+	}, this->nbThreads);
+
+	globalEnergy = 0.0;
+	for (unsigned int i = 0; i < this->seeds.size(); i++)
 		globalEnergy += distances[this->seeds[i]];
-	}
 }
 
 template <typename PFP>
 void CentroidalVoronoiDiagram<PFP>::cumulateEnergyAndGradients()
 {
+	const VertexAttribute<VEC3, MAP>& pos = this->map.template getAttribute<VEC3, VERTEX, typename PFP::MAP>("position");
+
+	CGoGN::Parallel::foreach_index(this->map, uint32(this->seeds.size()), [&] (unsigned int i, unsigned int)
+	{
+		cumulateEnergyAndGradientFromSeed(i, pos);
+	}, this->nbThreads);
+
 	globalEnergy = 0.0;
 	for (unsigned int i = 0; i < this->seeds.size(); i++)
-	{
-		cumulateEnergyAndGradientFromSeed(i);
 		globalEnergy += distances[this->seeds[i]];
-	}
 }
 
 template <typename PFP>
 unsigned int CentroidalVoronoiDiagram<PFP>::moveSeedsOneEdgeNoCheck()
 {
-	unsigned int m = 0;
-	for (unsigned int i = 0; i < this->seeds.size(); i++)
+	const VertexAttribute<VEC3, MAP>& pos = this->map.template getAttribute<VEC3, VERTEX, typename PFP::MAP>("position");
+	const unsigned int nbSeeds = uint32(this->seeds.size());
+	std::vector<unsigned char> moved(nbSeeds, 0);
+
+	CGoGN::Parallel::foreach_index(this->map, nbSeeds, [&] (unsigned int i, unsigned int)
 	{
 		Dart oldSeed = this->seeds[i];
-		Dart newSeed = selectBestNeighborFromSeed(i);
+		Dart newSeed = selectBestNeighborFromSeed(i, pos);
 
 		// move the seed
 		if (newSeed != oldSeed)
 		{
 			this->seeds[i] = newSeed;
-			m++;
+			moved[i] = 1;
 		}
-	}
+	}, this->nbThreads);
+
+	unsigned int m = 0;
+	for (unsigned int i = 0; i < nbSeeds; i++)
+		m += moved[i];
 	return m;
 }
 
 template <typename PFP>
 unsigned int CentroidalVoronoiDiagram<PFP>::moveSeedsOneEdgeCheck()
 {
-	unsigned int m = 0;
-	for (unsigned int i = 0; i < this->seeds.size(); i++)
+	const VertexAttribute<VEC3, MAP>& pos = this->map.template getAttribute<VEC3, VERTEX, typename PFP::MAP>("position");
+	const unsigned int nbSeeds = uint32(this->seeds.size());
+	std::vector<unsigned char> moved(nbSeeds, 0);
+
+	// one front per thread, each region is processed by one thread
+	unsigned int nbth = this->nbThreads > 0 ? this->nbThreads : 1;
+	std::vector<VertexFront> fronts(nbth, VertexFront(this->vertexInfo));
+
+	CGoGN::Parallel::foreach_index(this->map, nbSeeds, [&] (unsigned int i, unsigned int t)
 	{
 		Dart oldSeed = this->seeds[i];
-		Dart newSeed = selectBestNeighborFromSeed(i);
+		Dart newSeed = selectBestNeighborFromSeed(i, pos);
 
 		// move the seed
 		if (newSeed != oldSeed)
 		{
 			REAL regionEnergy = distances[oldSeed];
 			this->seeds[i] = newSeed;
-			this->computeDistancesWithinRegion(newSeed);
-			cumulateEnergyAndGradientFromSeed(i);
+			this->computeDistancesWithinRegion(newSeed, fronts[t]);
+			cumulateEnergyAndGradientFromSeed(i, pos);
 			if (distances[newSeed] < regionEnergy)
-				m++;
+				moved[i] = 1;
 			else
 				this->seeds[i] = oldSeed;
 		}
-	}
+	}, nbth);
+
+	unsigned int m = 0;
+	for (unsigned int i = 0; i < nbSeeds; i++)
+		m += moved[i];
 	return m;
 }
 
 template <typename PFP>
 unsigned int CentroidalVoronoiDiagram<PFP>::moveSeedsToMedioid()
 {
-	unsigned int m = 0;
-	for (unsigned int i = 0; i < this->seeds.size(); i++)
+	const VertexAttribute<VEC3, MAP>& pos = this->map.template getAttribute<VEC3, VERTEX, typename PFP::MAP>("position");
+	const unsigned int nbSeeds = uint32(this->seeds.size());
+	std::vector<unsigned char> moved(nbSeeds, 0);
+
+	// one front per thread, each region is processed by one thread
+	unsigned int nbth = this->nbThreads > 0 ? this->nbThreads : 1;
+	std::vector<VertexFront> fronts(nbth, VertexFront(this->vertexInfo));
+
+	CGoGN::Parallel::foreach_index(this->map, nbSeeds, [&] (unsigned int i, unsigned int t)
 	{
 		Dart oldSeed, newSeed;
-		unsigned int seedMoved = 0;
 		REAL regionEnergy;
 
 		do
@@ -376,12 +633,12 @@ unsigned int CentroidalVoronoiDiagram<PFP>::moveSeedsToMedioid()
 			oldSeed = this->seeds[i];
 			regionEnergy = distances[oldSeed];
 
-			newSeed = selectBestNeighborFromSeed(i);
+			newSeed = selectBestNeighborFromSeed(i, pos);
 			this->seeds[i] = newSeed;
-			this->computeDistancesWithinRegion(newSeed);
-			cumulateEnergyAndGradientFromSeed(i);
+			this->computeDistancesWithinRegion(newSeed, fronts[t]);
+			cumulateEnergyAndGradientFromSeed(i, pos);
 			if (distances[newSeed] < regionEnergy)
-				seedMoved = 1;
+				moved[i] = 1;
 			else
 			{
 				this->seeds[i] = oldSeed;
@@ -389,9 +646,11 @@ unsigned int CentroidalVoronoiDiagram<PFP>::moveSeedsToMedioid()
 			}
 
 		} while (newSeed != oldSeed);
+	}, nbth);
 
-		m += seedMoved;
-	}
+	unsigned int m = 0;
+	for (unsigned int i = 0; i < nbSeeds; i++)
+		m += moved[i];
 	return m;
 }
 
@@ -404,7 +663,8 @@ typename PFP::REAL CentroidalVoronoiDiagram<PFP>::cumulateEnergyFromRoot(Dart e)
 	Traversor2VVaE<MAP> tv (this->map, e);
 	for (Dart f = tv.begin(); f != tv.end(); f=tv.next())
 	{
-		if ( pathOrigins[f] == this->map.phi2(f))
+		// (paths do not leave the region, do not read the other regions)
+		if ( this->regions[f] == this->regions[e] && pathOrigins[f] == this->map.phi2(f))
 		{
 			distArea += cumulateEnergyFromRoot(f);
 			distances[e] += distances[f];
@@ -414,7 +674,7 @@ typename PFP::REAL CentroidalVoronoiDiagram<PFP>::cumulateEnergyFromRoot(Dart e)
 }
 
 template <typename PFP>
-void CentroidalVoronoiDiagram<PFP>::cumulateEnergyAndGradientFromSeed(unsigned int numSeed)
+void CentroidalVoronoiDiagram<PFP>::cumulateEnergyAndGradientFromSeed(unsigned int numSeed, const VertexAttribute<VEC3, MAP>& pos)
 {
 	typedef typename PFP::REAL REAL;
 	// precondition : energyGrad.size() > numSeed
@@ -431,7 +691,7 @@ void CentroidalVoronoiDiagram<PFP>::cumulateEnergyAndGradientFromSeed(unsigned i
 	Traversor2VVaE<MAP> tv (this->map, e);
 	for (Dart f = tv.begin(); f != tv.end(); f=tv.next())
 	{
-		if ( pathOrigins[f] == this->map.phi2(f))
+		if ( this->regions[f] == this->regions[e] && pathOrigins[f] == this->map.phi2(f))
 		{
 			REAL distArea = cumulateEnergyFromRoot(f);
 			da.push_back(distArea);
@@ -443,7 +703,6 @@ void CentroidalVoronoiDiagram<PFP>::cumulateEnergyAndGradientFromSeed(unsigned i
 	// compute the gradient
 	// TODO : check if the computation of grad and proj is still valid for other edgeCost than geodesic distances
 	VEC3 grad (0.0);
-	const VertexAttribute<VEC3, MAP>& pos = this->map.template getAttribute<VEC3, VERTEX, typename PFP::MAP>("position");
 
 	for (unsigned int j = 0; j < v.size(); ++j)
 	{
@@ -457,19 +716,18 @@ void CentroidalVoronoiDiagram<PFP>::cumulateEnergyAndGradientFromSeed(unsigned i
 }
 
 template <typename PFP>
-Dart CentroidalVoronoiDiagram<PFP>::selectBestNeighborFromSeed(unsigned int numSeed)
+Dart CentroidalVoronoiDiagram<PFP>::selectBestNeighborFromSeed(unsigned int numSeed, const VertexAttribute<VEC3, MAP>& pos)
 {
 	typedef typename PFP::REAL REAL;
 	Dart e = this->seeds[numSeed];
 	Dart newSeed = e;
-	const VertexAttribute<VEC3, MAP>& pos = this->map.template getAttribute<VEC3,VERTEX,typename PFP::MAP>("position");
 
 	// TODO : check if the computation of grad and proj is still valid for other edgeCost than geodesic distances
 	REAL maxProj = 0;
 	Traversor2VVaE<MAP> tv (this->map, e);
 	for (Dart f = tv.begin(); f != tv.end(); f=tv.next())
 	{
-		if ( pathOrigins[f] == this->map.phi2(f))
+		if ( this->regions[f] == this->regions[e] && pathOrigins[f] == this->map.phi2(f))
 		{
 			VEC3 edgeV = pos[f] - pos[this->map.phi2(f)];
 	//		edgeV.normalize();
@@ -26,6 +26,8 @@
 #define __HISTOGRAM__
 
 #include <cmath>
+#include <vector>
+#include <thread>
 
 #include "Topology/generic/attributeHandler.h"
 #include "Topology/generic/cellmarker.h"
@@ -137,7 +139,11 @@ class CGoGN_ALGO_API Histogram
 {
 //	std::vector<double> m_data;
 
-	mutable std::vector< std::pair<double, unsigned int> > m_dataIdx;
+	/// (value, index in attribute) in attribute traversal order
+	std::vector< std::pair<double, unsigned int> > m_dataIdx;
+
+	/// position in m_dataIdx of each attribute index (for incremental update)
+	std::vector<unsigned int> m_dataPos;
 	
 	/// number of classes in attribute
 	unsigned int m_nbclasses;
@@ -157,6 +163,12 @@ class CGoGN_ALGO_API Histogram
 	/// max value
 	double m_max;
 
+	/// real min value of data
+	double m_qmin;
+
+	/// real max value of data
+	double m_qmax;
+
 	/// interval width (in regular case)
 	double m_interWidth;
 	
@@ -171,7 +183,8 @@ class CGoGN_ALGO_API Histogram
 
 	HistoColorMap& m_hcolmap;
 
-	mutable bool m_sorted;
+	/// number of threads used for the scans of the data
+	unsigned int m_nbThreads;
 
 	/// get data
 	double data(unsigned int i) const;
@@ -179,8 +192,27 @@ class CGoGN_ALGO_API Histogram
 	/// get idx of data in attribute
 	unsigned int idx(unsigned int i) const;
 
-	/// comparison function for sorting data
-	static bool dataComp( const std::pair<double, unsigned int>& a, const std::pair<double, unsigned int>& b);
+	/// call func(t, first, last) on m_nbThreads contiguous ranges of [0,nb[
+	template <typename FUNC>
+	void parallelRanges(unsigned int nb, FUNC func) const;
+
+	/// compute min / max of data (in parallel)
+	void computeDataMinMax();
+
+	/// end of initData / initDataConvert (min / max and colormap update)
+	void initDataDone();
+
+	/**
+	 * place the values of ranks given by the (sorted, unique) keys [kb,ke[ at their place in v[b,e[
+	 * (recursive selection, the two sides are processed in parallel with nbth threads)
+	 */
+	static void multiSelect(std::vector<double>& v, unsigned int b, unsigned int e, const unsigned int* kb, const unsigned int* ke, unsigned int nbth);
+
+	/// change value of data at position p, and update histogram population
+	void updateValue(unsigned int p, double val);
+
+	/// end of update: max bar, min / max of data and quantiles
+	void updateDataDone(bool rescanMinMax);
 
 	/// update quantiles height from histo area for correct superposition
 	void quantilesAreaCorrection();
@@ -205,6 +237,31 @@ public:
 	template <typename ATTR>
 	void initData(const ATTR& attr);
 
+	/**
+	 * update data after modification of some values of the attribute
+	 * Histogram populations are updated (classes are not changed, use populateHisto to refit them),
+	 * quantiles are recomputed if they have been computed
+	 * @param attr the attribute given to initData
+	 * @param changed the indices of modified elements
+	 */
+	template <typename ATTR>
+	void updateData(const ATTR& attr, const std::vector<unsigned int>& changed);
+
+	/**
+	 * update data after modification of some values (see updateData)
+	 * @param conv the attribute convertor given to initDataConvert
+	 * @param changed the indices of modified elements
+	 */
+	void updateDataConvert(const AttributeConvertGen& conv, const std::vector<unsigned int>& changed);
+
+	/**
+	 * set / get the number of threads used for the scans of the data
+	 * (default hardware concurrency)
+	 */
+	void setNbThreads(unsigned int nb);
+
+	unsigned int getNbThreads() const;
+
 	/**
 	 * get min value of attribute (perhaps modified by user)
 	 */
@@ -258,7 +315,8 @@ public:
 	void populateHisto(unsigned int nbclasses = 0);
 
 	/**
-	 * compute the histogram with given number of classes
+	 * compute the quantiles with given number of classes
+	 * (boundaries are found by selection, data are not sorted)
 	 */
 	void populateQuantiles(unsigned int nbclasses = 10);
 
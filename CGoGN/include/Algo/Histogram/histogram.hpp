@@ -34,10 +34,44 @@ namespace Histogram
 {
 
 inline Histogram::Histogram( HistoColorMap& hcm):
- m_hcolmap(hcm),m_sorted(false)
+ m_nbclasses(0),m_min(0.0),m_max(0.0),m_qmin(0.0),m_qmax(0.0),m_interWidth(0.0),m_maxBar(0),m_maxQBar(0.0),
+ m_hcolmap(hcm),m_nbThreads(std::thread::hardware_concurrency())
 {
 }
 
+inline void Histogram::setNbThreads(unsigned int nb)
+{
+	m_nbThreads = nb;
+}
+
+inline unsigned int Histogram::getNbThreads() const
+{
+	return m_nbThreads;
+}
+
+template <typename FUNC>
+void Histogram::parallelRanges(unsigned int nb, FUNC func) const
+{
+	unsigned int nbth = m_nbThreads < nb ? m_nbThreads : nb;
+	if (nbth < 2)
+	{
+		if (nb > 0)
+			func(0, 0, nb);
+		return;
+	}
+
+	std::vector<std::thread> threads;
+	threads.reserve(nbth);
+	for (unsigned int t = 0; t < nbth; ++t)
+	{
+		unsigned int first = (unsigned long long)(nb) * t / nbth;
+		unsigned int last = (unsigned long long)(nb) * (t + 1) / nbth;
+		threads.push_back(std::thread(func, t, first, last));
+	}
+	for (unsigned int t = 0; t < nbth; ++t)
+		threads[t].join();
+}
+
 inline const std::vector<unsigned int>& Histogram::getPopulation() const
 {
 	return m_populations;
@@ -70,12 +104,12 @@ inline double Histogram::getMax() const
 
 inline double Histogram::getQMin() const
 {
-	return m_dataIdx.front().first;
+	return m_qmin;
 }
 
 inline double Histogram::getQMax() const
 {
-	return m_dataIdx.back().first;
+	return m_qmax;
 }
 
 inline unsigned int Histogram::getMaxBar() const
@@ -114,26 +148,37 @@ inline void Histogram::centerOnZero()
 template <typename ATTR>
 inline void Histogram::initData(const ATTR& attr)
 {
-	unsigned int beg = attr.begin();
-	m_min = attr[beg];
-	m_max = m_min;
-
-	m_dataIdx.reserve(attr.nbElements());
 	m_dataIdx.clear();
-	for (unsigned int i = beg; i!= attr.end(); attr.next(i))
+	m_dataIdx.reserve(attr.nbElements());
+	m_dataPos.assign(attr.end(), 0xffffffff);
+	for (unsigned int i = attr.begin(); i!= attr.end(); attr.next(i))
 	{
-		double val = attr[i];
-		m_dataIdx.push_back(std::make_pair(val ,i));
-		if (val < m_min)
-			m_min = val;
-		if (val > m_max)
-			m_max = val;
+		m_dataPos[i] = uint32(m_dataIdx.size());
+		m_dataIdx.push_back(std::make_pair(0.0, i));
 	}
 
-	m_hcolmap.setMin(m_min);
-	m_hcolmap.setMax(m_max);
+	// read (and convert) the values in parallel
+	parallelRanges(uint32(m_dataIdx.size()), [&] (unsigned int, unsigned int first, unsigned int last)
+	{
+		for (unsigned int k = first; k < last; ++k)
+			m_dataIdx[k].first = attr[m_dataIdx[k].second];
+	});
 
-	m_sorted = false;
+	initDataDone();
+}
+
+template <typename ATTR>
+void Histogram::updateData(const ATTR& attr, const std::vector<unsigned int>& changed)
+{
+	bool rescan = false;
+	for (std::vector<unsigned int>::const_iterator it = changed.begin(); it != changed.end(); ++it)
+	{
+		unsigned int p = m_dataPos[*it];
+		double old = m_dataIdx[p].first;
+		rescan |= (old == m_qmin) || (old == m_qmax);
+		updateValue(p, attr[*it]);
+	}
+	updateDataDone(rescan);
 }
 
 inline unsigned int Histogram::whichClass(double val) const
@@ -148,43 +193,41 @@ inline unsigned int Histogram::whichClass(double val) const
 
 inline unsigned int Histogram::whichQuantille(double val) const
 {
-	unsigned int i=1;
-	while (val > m_interv[i])
-		++i;
-	return i-1;
+	// first interval whose upper bound is not less than val
+	std::vector<double>::const_iterator it = std::lower_bound(m_interv.begin()+1, m_interv.end(), val);
+	if (it == m_interv.end())
+		return -1;
+	return uint32(it - (m_interv.begin()+1));
 }
 
 template<typename ATTC>
 void Histogram::histoColorize(ATTC& colors)
 {
-	unsigned int nb = uint32(m_dataIdx.size());
-	for (unsigned int i = 0; i<nb; ++i)
+	parallelRanges(uint32(m_dataIdx.size()), [&] (unsigned int, unsigned int first, unsigned int last)
 	{
-		unsigned int j = idx(i);
-		unsigned int c = whichClass(data(i));
-		if (c != 0xffffffff)
-			colors[j] = m_hcolmap.colorIndex(c);
-	}
+		for (unsigned int i = first; i < last; ++i)
+		{
+			unsigned int c = whichClass(data(i));
+			if (c != 0xffffffff)
+				colors[idx(i)] = m_hcolmap.colorIndex(c);
+		}
+	});
 }
 
 template<typename ATTC>
 void Histogram::quantilesColorize(ATTC& colors, const std::vector<Geom::Vec3f>& tc)
 {
+	assert(tc.size() >= m_interv.size() - 1);
 
-	unsigned int nb = uint32(m_dataIdx.size());
-	unsigned int nbi = uint32(m_interv.size() - 1);
-
-	assert(tc.size() >= nbi);
-
-	unsigned int i=0;
-	unsigned int j=0;
-
-	while ((i<nb) && (j<nbi))
+	parallelRanges(uint32(m_dataIdx.size()), [&] (unsigned int, unsigned int first, unsigned int last)
 	{
-		while ((i<nb) && (data(i) <= m_interv[j+1]))
-			colors[ idx(i++) ] = tc[j];
-		++j;
-	}
+		for (unsigned int i = first; i < last; ++i)
+		{
+			unsigned int c = whichQuantille(data(i));
+			if (c != 0xffffffff)
+				colors[idx(i)] = tc[c];
+		}
+	});
 }
 
 /// get data
@@ -199,35 +242,21 @@ inline unsigned int Histogram::idx(unsigned int i) const
 	return m_dataIdx[i].second;
 }
 
-// comparison function for sorting data
-inline bool Histogram::dataComp( const std::pair<double, unsigned int>& a, const std::pair<double, unsigned int>& b)
-{
-	return a.first < b.first;
-}
-
 template <typename CELLMARKER>
 unsigned int Histogram::markCellsOfHistogramColumn(unsigned int c, CELLMARKER& cm) const
 {
-	if (!m_sorted)
-	{
-		std::sort(m_dataIdx.begin(),m_dataIdx.end(),dataComp);
-		m_sorted = true;
-	}
-
 	double bi = (m_max-m_min)/m_nbclasses * c + m_min;
 	double bs = (m_max-m_min)/m_nbclasses * (c+1) + m_min;
 
 	unsigned int nb = uint32(m_dataIdx.size());
-	unsigned int i=0;
-
-	while ((i<nb) && (data(i)< bi))
-		++i;
-
 	unsigned int nbc=0;
-	while ((i<nb) && (data(i)< bs))
+	for (unsigned int i = 0; i < nb; ++i)
 	{
-		cm.mark(idx(i++));
-		++nbc;
+		if ((data(i) >= bi) && (data(i) < bs))
+		{
+			cm.mark(idx(i));
+			++nbc;
+		}
 	}
 
 	return nbc;
@@ -240,16 +269,14 @@ unsigned int Histogram::markCellsOfQuantilesColumn(unsigned int c, CELLMARKER& c
 	double bs = m_interv[c+1];
 
 	unsigned int nb = uint32(m_dataIdx.size());
-	unsigned int i=0;
-
-	while ((i<nb) && (data(i)< bi))
-		++i;
-
 	unsigned int nbc=0;
-	while ((i<nb) && (data(i)< bs))
+	for (unsigned int i = 0; i < nb; ++i)
 	{
-		cm.mark(idx(i++));
-		++nbc;
+		if ((data(i) >= bi) && (data(i) < bs))
+		{
+			cm.mark(idx(i));
+			++nbc;
+		}
 	}
 
 	return nbc;
@@ -65,6 +65,12 @@ bool importMesh(typename PFP::MAP& map, const std::string& filename, std::vector
 template <typename PFP>
 bool importVoxellisation(typename PFP::MAP& map, Algo::Surface::Modelisation::Voxellisation& voxellisation, std::vector<std::string>& attrNames, bool mergeCloseVertices=false);
 
+/**
+* import the boundary extracted from a sparse voxellisation (see SparseVoxellisation::extractionBord)
+*/
+template <typename PFP>
+bool importVoxellisation(typename PFP::MAP& map, Algo::Surface::Modelisation::SparseVoxellisation& voxellisation, std::vector<std::string>& attrNames, bool mergeCloseVertices=false);
+
 /**
  * import a Choupi file
  * @param map
@@ -157,6 +157,7 @@ bool importMesh(typename PFP::MAP& map, MeshTablesSurface<PFP>& mts)
 template <typename PFP>
 bool importMesh(typename PFP::MAP& map, const std::string& filename, std::vector<std::string>& attrNames, bool mergeCloseVertices)
 {
+	CGoGN_SCOPED_TIMER("Algo::Surface::Import::importMesh");
     MeshTablesSurface<PFP> mts(map);
 
     if(!mts.importMesh(filename, attrNames))
@@ -182,6 +183,20 @@ bool importVoxellisation(typename PFP::MAP& map, Algo::Surface::Modelisation::Vo
     return importMesh<PFP>(map, mts);
 }
 
+template <typename PFP>
+bool importVoxellisation(typename PFP::MAP& map, Algo::Surface::Modelisation::SparseVoxellisation& voxellisation, std::vector<std::string>& attrNames, bool mergeCloseVertices)
+{
+    MeshTablesSurface<PFP> mts(map);
+
+    if(!mts.importVoxellisation(voxellisation, attrNames))
+        return false;
+
+    if (mergeCloseVertices)
+        mts.mergeCloseVertices();
+
+    return importMesh<PFP>(map, mts);
+}
+
 template <typename PFP2, typename PFP3>
 bool import3DMap(typename PFP2::MAP& map2, typename PFP3::MAP& map3, std::vector<std::string>& attrNames, bool mergeCloseVertices)
 {
@@ -1119,6 +1134,7 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
 template <typename PFP>
 bool importMesh(typename PFP::MAP& map, const std::string& filename, std::vector<std::string>& attrNames/* bool mergeCloseVertices*/)
 {
+	CGoGN_SCOPED_TIMER("Algo::Volume::Import::importMesh");
     MeshTablesVolume<PFP> mtv(map);
 
     if(!mtv.importMesh(filename, attrNames))
@@ -37,6 +37,7 @@
 
 #include "Algo/Import/importFileTypes.h"
 #include "Algo/Modelisation/voxellisation.h"
+#include "Algo/Modelisation/sparseVoxellisation.h"
 
 #ifdef CGOGN_WITH_ASSIMP
 #include "assimp.h"
@@ -114,6 +115,12 @@ protected:
 
 	bool importSTLBin(const std::string& filename, std::vector<std::string>& attrNames);
 
+	/**
+	 * quads of an extracted voxellisation boundary (dense or sparse)
+	 */
+	template <typename VOXELLISATION>
+	bool importVoxelQuads(VOXELLISATION& voxellisation, std::vector<std::string>& attrNames);
+
 public:
     //static ImportType getFileType(const std::string& filename);
 
@@ -131,6 +138,8 @@ public:
 
     bool importVoxellisation(Algo::Surface::Modelisation::Voxellisation& voxellisation, std::vector<std::string>& attrNames);
 
+    bool importVoxellisation(Algo::Surface::Modelisation::SparseVoxellisation& voxellisation, std::vector<std::string>& attrNames);
+
 	bool importPlySLFgenericBin(const std::string& filename, std::vector<std::string>& attrNames);
 
 	template <typename PFP3>
@@ -339,6 +339,19 @@ bool MeshTablesSurface<PFP>::importOff(const std::string& filename, std::vector<
 
 template<typename PFP>
 bool MeshTablesSurface<PFP>::importVoxellisation(Algo::Surface::Modelisation::Voxellisation& voxellisation, std::vector<std::string>& attrNames)
+{
+	return importVoxelQuads(voxellisation, attrNames);
+}
+
+template<typename PFP>
+bool MeshTablesSurface<PFP>::importVoxellisation(Algo::Surface::Modelisation::SparseVoxellisation& voxellisation, std::vector<std::string>& attrNames)
+{
+	return importVoxelQuads(voxellisation, attrNames);
+}
+
+template<typename PFP>
+template <typename VOXELLISATION>
+bool MeshTablesSurface<PFP>::importVoxelQuads(VOXELLISATION& voxellisation, std::vector<std::string>& attrNames)
 {
 	VertexAttribute<VEC3, MAP> positions = m_map.template getAttribute<VEC3, VERTEX, MAP>("position");
 
@@ -138,6 +138,7 @@ Dart  MarchingCube<DataType, Windowing, PFP>::createTriEmb(unsigned int e1, unsi
 template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
 void MarchingCube<DataType, Windowing, PFP>::simpleMeshing()
 {
+	CGoGN_SCOPED_TIMER("Algo::Surface::MC::MarchingCube::simpleMeshing");
 	// create the mesh if needed
 	if (m_map == NULL)
 	{
@@ -66,6 +66,74 @@ void planeCut2(
 	bool with_unsew
 );
 
+/**
+ * contours of the surface with a stack of parallel planes (the map is not modified)
+ * each face is visited once for all the planes that cross it, faces are processed in parallel
+ * a vertex is over plane i if normal*position >= heights[i]
+ * @param normal common normal of the planes
+ * @param heights increasing offsets of the planes (plane i: normal*P = heights[i])
+ * @param segments for each plane, the end points of its contour segments
+ *        (two consecutive points per segment, in face traversal order; faces are supposed convex)
+ * @param nbth number of threads
+ */
+template <typename PFP>
+void planeSlices(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const typename PFP::VEC3& normal,
+	const std::vector<typename PFP::REAL>& heights,
+	std::vector< std::vector<typename PFP::VEC3> >& segments,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads
+);
+
+namespace Parallel
+{
+
+/**
+ * classify the vertices by the plane (side, in parallel over the vertex container)
+ * and compute the intersection points of the crossing edges (in parallel over the edges)
+ * @param edges the crossing edges, in traversal order
+ * @param points the intersection point of each crossing edge
+ */
+template <typename PFP>
+void planeIntersections(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const Geom::Plane3D<typename PFP::REAL>& plane,
+	VertexAttribute<char, typename PFP::MAP>& side,
+	std::vector<Dart>& edges,
+	std::vector<typename PFP::VEC3>& points,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads
+);
+
+/**
+ * same result as the serial planeCut, except that a vertex on the plane is never considered over:
+ * vertex sides, edge intersections and the faces to split are computed in parallel,
+ * then edges are cut and faces split serially from these lists
+ */
+template <typename PFP>
+void planeCut(
+	typename PFP::MAP& map,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const Geom::Plane3D<typename PFP::REAL>& plane,
+	CellMarker<typename PFP::MAP, FACE>& cmf_over,
+	bool keepTriangles = false,
+	bool with_unsew = true,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads
+);
+
+template <typename PFP>
+void planeCut2(
+	typename PFP::MAP& map,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const Geom::Plane3D<typename PFP::REAL>& plane,
+	CellMarker<typename PFP::MAP, FACE>& cmf_over,
+	bool with_unsew,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads
+);
+
+} // namespace Parallel
+
 } // namespace Modelisation
 
 } // namespace Surface
@@ -86,6 +154,26 @@ void planeCut(
 	bool with_unsew = true
 );
 
+namespace Parallel
+{
+
+/**
+ * like the serial version, only cuts the edges crossing the plane
+ * (intersections computed in parallel, edges cut serially)
+ */
+template <typename PFP>
+void planeCut(
+	typename PFP::MAP& map,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const Geom::Plane3D<typename PFP::REAL>& plane,
+	CellMarker<typename PFP::MAP, FACE>& cmv_over,
+	bool keepTetrahedra = false,
+	bool with_unsew = true,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads
+);
+
+} // namespace Parallel
+
 } // namespace Modelisation
 
 } // namespace Volume
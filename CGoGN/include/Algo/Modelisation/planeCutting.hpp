@@ -26,6 +26,9 @@
 #include "Topology/generic/cellmarker.h"
 #include "Topology/generic/traversor/traversorCell.h"
 #include "Algo/Modelisation/triangulation.h"
+#include "Utils/instrumentation.h"
+
+#include <algorithm>
 
 
 namespace CGoGN
@@ -422,6 +425,395 @@ void planeCut2(
 
 }
 
+template <typename PFP>
+void planeSlices(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const typename PFP::VEC3& normal,
+	const std::vector<typename PFP::REAL>& heights,
+	std::vector< std::vector<typename PFP::VEC3> >& segments,
+	unsigned int nbth)
+{
+	typedef typename PFP::MAP MAP;
+	typedef typename PFP::VEC3 VEC3;
+	typedef typename PFP::REAL REAL;
+
+	const unsigned int nbPlanes = (unsigned int)(heights.size());
+	segments.clear();
+	segments.resize(nbPlanes);
+	if (nbPlanes == 0)
+		return;
+	if (nbth < 1)
+		nbth = 1;
+
+	// height of the vertices (data parallel over the vertex container)
+	VertexAutoAttribute<REAL, MAP> height(map, "planeSlices_height");
+	const AttributeContainer& vcont = map.template getAttributeContainer<VERTEX>();
+	CGoGN::Parallel::foreach_index(map, vcont.realEnd(), [&] (unsigned int i, unsigned int /*thr*/)
+	{
+		if (vcont.used(i))
+			height[i] = normal * position[i];
+	}, nbth);
+
+	std::vector<Dart> faces;
+	foreach_cell<FACE>(map, [&] (Face f) { faces.push_back(f.dart); });
+
+	// each thread handles a contiguous range of faces, partial results are merged in thread order
+	std::vector< std::vector< std::vector<VEC3> > > local(nbth, std::vector< std::vector<VEC3> >(nbPlanes));
+
+	CGoGN::Parallel::foreach_index(map, (unsigned int)(faces.size()), [&] (unsigned int i, unsigned int thr)
+	{
+		const Dart d = faces[i];
+		REAL hmin = height[d];
+		REAL hmax = hmin;
+		for (Dart e = map.phi1(d); e != d; e = map.phi1(e))
+		{
+			hmin = std::min(hmin, height[e]);
+			hmax = std::max(hmax, height[e]);
+		}
+
+		// planes with hmin < h <= hmax
+		const unsigned int first = (unsigned int)(std::upper_bound(heights.begin(), heights.end(), hmin) - heights.begin());
+		const unsigned int last = (unsigned int)(std::upper_bound(heights.begin(), heights.end(), hmax) - heights.begin());
+		for (unsigned int k = first; k < last; ++k)
+		{
+			const REAL h = heights[k];
+			std::vector<VEC3>& out = local[thr][k];
+			const std::size_t start = out.size();
+			Dart e = d;
+			do
+			{
+				const Dart f = map.phi1(e);
+				const REAL h1 = height[e];
+				const REAL h2 = height[f];
+				if ((h1 >= h) != (h2 >= h))
+				{
+					const REAL t = (h - h1) / (h2 - h1);
+					out.push_back(position[e] + (position[f] - position[e]) * t);
+				}
+				e = f;
+			} while (e != d);
+			// keep an even number of points
+			if ((out.size() - start) % 2 == 1)
+				out.pop_back();
+		}
+	}, nbth);
+
+	for (unsigned int k = 0; k < nbPlanes; ++k)
+	{
+		std::size_t n = 0;
+		for (unsigned int t = 0; t < nbth; ++t)
+			n += local[t][k].size();
+		segments[k].reserve(n);
+		for (unsigned int t = 0; t < nbth; ++t)
+			segments[k].insert(segments[k].end(), local[t][k].begin(), local[t][k].end());
+	}
+}
+
+namespace Parallel
+{
+
+template <typename PFP>
+void planeIntersections(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const Geom::Plane3D<typename PFP::REAL>& plane,
+	VertexAttribute<char, typename PFP::MAP>& side,
+	std::vector<Dart>& edges,
+	std::vector<typename PFP::VEC3>& points,
+	unsigned int nbth)
+{
+	typedef typename PFP::VEC3 VEC3;
+	typedef typename PFP::REAL REAL;
+
+	if (nbth < 1)
+		nbth = 1;
+
+	const AttributeContainer& vcont = map.template getAttributeContainer<VERTEX>();
+	CGoGN::Parallel::foreach_index(map, vcont.realEnd(), [&] (unsigned int i, unsigned int /*thr*/)
+	{
+		if (vcont.used(i))
+			side[i] = char(plane.orient(position[i]));
+	}, nbth);
+
+	std::vector<Dart> allEdges;
+	foreach_cell<EDGE>(map, [&] (Edge e) { allEdges.push_back(e.dart); });
+
+	std::vector< std::vector<Dart> > localEdges(nbth);
+	std::vector< std::vector<VEC3> > localPoints(nbth);
+
+	CGoGN::Parallel::foreach_index(map, (unsigned int)(allEdges.size()), [&] (unsigned int i, unsigned int thr)
+	{
+		const Dart d = allEdges[i];
+		const Dart dd = map.phi1(d);
+		const char or1 = side[d];
+		const char or2 = side[dd];
+		if (or1 != Geom::ON && or2 != Geom::ON && or1 != or2)
+		{
+			REAL dist1 = plane.distance(position[d]);
+			REAL dist2 = plane.distance(position[dd]);
+			if (dist1 < 0.0)
+				dist1 = -dist1;
+			if (dist2 < 0.0)
+				dist2 = -dist2;
+			localEdges[thr].push_back(d);
+			localPoints[thr].push_back((position[d] * dist2 + position[dd] * dist1) / (dist1 + dist2));
+		}
+	}, nbth);
+
+	edges.clear();
+	points.clear();
+	for (unsigned int t = 0; t < nbth; ++t)
+	{
+		edges.insert(edges.end(), localEdges[t].begin(), localEdges[t].end());
+		points.insert(points.end(), localPoints[t].begin(), localPoints[t].end());
+	}
+}
+
+template <typename PFP>
+void planeCut(
+	typename PFP::MAP& map,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const Geom::Plane3D<typename PFP::REAL>& plane,
+	CellMarker<typename PFP::MAP, FACE>& cmf_over,
+	bool keepTriangles,
+	bool with_unsew,
+	unsigned int nbth)
+{
+	CGoGN_SCOPED_TIMER("Algo::Surface::Modelisation::Parallel::planeCut");
+
+	typedef typename PFP::MAP MAP;
+	typedef typename PFP::VEC3 VEC3;
+
+	if (nbth < 1)
+		nbth = 1;
+
+	VertexAutoAttribute<char, MAP> side(map, "planeCut_side");
+
+	// 1. sides and intersections (parallel), edge cuts (serial)
+	std::vector<Dart> edges;
+	std::vector<VEC3> points;
+	planeIntersections<PFP>(map, position, plane, side, edges, points, nbth);
+
+	for (unsigned int i = 0; i < edges.size(); ++i)
+	{
+		Dart x = map.cutEdge(edges[i]);
+		position[x] = points[i];
+		side[x] = char(Geom::ON);
+	}
+
+	// 2. faces to split / faces over the plane (parallel)
+	struct Split
+	{
+		Dart v1, v2;
+		bool over1, over2;
+	};
+
+	std::vector<Dart> faces;
+	foreach_cell<FACE>(map, [&] (Face f) { faces.push_back(f.dart); });
+
+	std::vector< std::vector<Split> > localSplits(nbth);
+	std::vector< std::vector<Dart> > localOver(nbth);
+
+	CGoGN::Parallel::foreach_index(map, (unsigned int)(faces.size()), [&] (unsigned int i, unsigned int thr)
+	{
+		const Dart d = faces[i];
+
+		// the 2 first vertices of the face on the plane
+		Dart V1 = NIL;
+		Dart V2 = NIL;
+		Dart e = d;
+		do
+		{
+			if (side[e] == Geom::ON)
+			{
+				if (V1 == NIL)
+					V1 = e;
+				else
+				{
+					V2 = e;
+					break;
+				}
+			}
+			e = map.phi1(e);
+		} while (e != d);
+
+		// are there 2 vertices in the plane (but not consecutive)
+		if ((V1 != NIL) && (V2 != NIL) && (V2 != map.phi1(V1)) && (V1 != map.phi1(V2)))
+		{
+			Split s;
+			s.v1 = V1;
+			s.v2 = V2;
+			s.over1 = side[map.phi1(V1)] == Geom::OVER;
+			s.over2 = side[map.phi1(V2)] == Geom::OVER;
+			localSplits[thr].push_back(s);
+		}
+		else
+		{
+			// face is all on the same side than its first vertex not on the plane
+			e = d;
+			while (side[e] == Geom::ON && map.phi1(e) != d)
+				e = map.phi1(e);
+			if (side[e] == Geom::OVER)
+				localOver[thr].push_back(e);
+		}
+	}, nbth);
+
+	// 3. topological modifications (serial, in traversal order)
+	Algo::Surface::Modelisation::EarTriangulation<PFP>* triangulator = NULL;
+	if (keepTriangles)
+		triangulator = new Algo::Surface::Modelisation::EarTriangulation<PFP>(map);
+
+	for (unsigned int t = 0; t < nbth; ++t)
+	{
+		for (typename std::vector<Split>::const_iterator it = localSplits[t].begin(); it != localSplits[t].end(); ++it)
+		{
+			map.splitFace(it->v1, it->v2);
+			if (with_unsew)
+				map.unsewFaces(map.phi_1(it->v1));
+			if (it->over1)
+				cmf_over.mark(it->v1);
+			if (it->over2)
+				cmf_over.mark(it->v2);
+			if (keepTriangles)
+			{
+				triangulator->trianguleFace(it->v1);
+				triangulator->trianguleFace(it->v2);
+			}
+		}
+		for (std::vector<Dart>::const_iterator it = localOver[t].begin(); it != localOver[t].end(); ++it)
+			cmf_over.mark(*it);
+	}
+
+	if (triangulator != NULL)
+		delete triangulator;
+}
+
+template <typename PFP>
+void planeCut2(
+	typename PFP::MAP& map,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const Geom::Plane3D<typename PFP::REAL>& plane,
+	CellMarker<typename PFP::MAP, FACE>& cmf_over,
+	bool with_unsew,
+	unsigned int nbth)
+{
+	CGoGN_SCOPED_TIMER("Algo::Surface::Modelisation::Parallel::planeCut2");
+
+	typedef typename PFP::MAP MAP;
+	typedef typename PFP::VEC3 VEC3;
+
+	if (nbth < 1)
+		nbth = 1;
+
+	VertexAutoAttribute<char, MAP> side(map, "planeCut2_side");
+	EdgeAutoAttribute<VEC3, MAP> positionEdge(map);
+	CellMarker<MAP, EDGE> cme(map);
+
+	// 1. sides and intersections (parallel)
+	std::vector<Dart> edges;
+	std::vector<VEC3> points;
+	planeIntersections<PFP>(map, position, plane, side, edges, points, nbth);
+
+	for (unsigned int i = 0; i < edges.size(); ++i)
+	{
+		positionEdge[edges[i]] = points[i];
+		cme.mark(edges[i]);
+	}
+
+	// 2. faces crossed by the plane / faces over the plane (parallel)
+	struct Cross
+	{
+		Dart e1, e2;
+		bool over1, over2;
+	};
+
+	std::vector<Dart> faces;
+	foreach_cell<FACE>(map, [&] (Face f) { faces.push_back(f.dart); });
+
+	std::vector< std::vector<Cross> > localCross(nbth);
+	std::vector< std::vector<Dart> > localOver(nbth);
+
+	CGoGN::Parallel::foreach_index(map, (unsigned int)(faces.size()), [&] (unsigned int i, unsigned int thr)
+	{
+		const Dart d = faces[i];
+
+		// the 2 first edges of the face intersecting the plane
+		Dart E1 = NIL;
+		Dart E2 = NIL;
+		Dart e = d;
+		do
+		{
+			if (cme.isMarked(e))
+			{
+				if (E1 == NIL)
+					E1 = e;
+				else
+				{
+					E2 = e;
+					break;
+				}
+			}
+			e = map.phi1(e);
+		} while (e != d);
+
+		if ((E1 != NIL) && (E2 != NIL))
+		{
+			Cross c;
+			c.e1 = E1;
+			c.e2 = E2;
+			c.over1 = side[E1] == Geom::OVER;
+			c.over2 = side[E2] == Geom::OVER;
+			localCross[thr].push_back(c);
+		}
+		else
+		{
+			e = d;
+			while (side[e] == Geom::ON && map.phi1(e) != d)
+				e = map.phi1(e);
+			if (side[e] == Geom::OVER)
+				localOver[thr].push_back(e);
+		}
+	}, nbth);
+
+	// 3. topological modifications (serial, in traversal order)
+	for (unsigned int t = 0; t < nbth; ++t)
+	{
+		for (typename std::vector<Cross>::const_iterator it = localCross[t].begin(); it != localCross[t].end(); ++it)
+		{
+			Dart x = Algo::Surface::Modelisation::trianguleFace<PFP>(map, it->e1);
+			position[x] = (positionEdge[it->e1] + positionEdge[it->e2]) * 0.5;
+			side[x] = char(Geom::ON);
+
+			if (it->over1)
+				cmf_over.mark(map.phi2(map.phi_1(it->e1)));
+			if (it->over2)
+				cmf_over.mark(map.phi2(map.phi_1(it->e2)));
+		}
+		for (std::vector<Dart>::const_iterator it = localOver[t].begin(); it != localOver[t].end(); ++it)
+			cmf_over.mark(*it);
+	}
+
+	for (std::vector<Dart>::const_iterator it = edges.begin(); it != edges.end(); ++it)
+	{
+		Dart d = *it;
+		map.flipBackEdge(d);
+		if (with_unsew)
+		{
+			Dart d2 = map.phi2(d);
+			map.unsewFaces(d);
+
+			if (side[map.phi_1(d)] == Geom::OVER)
+				cmf_over.mark(d);
+
+			if (side[map.phi_1(d2)] == Geom::OVER)
+				cmf_over.mark(d2);
+		}
+	}
+}
+
+} // namespace Parallel
+
 } // namespace Modelisation
 
 } // namespace Surface
@@ -505,6 +897,37 @@ void planeCut(
 	}
 }
 
+namespace Parallel
+{
+
+template <typename PFP>
+void planeCut(
+	typename PFP::MAP& map,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const Geom::Plane3D<typename PFP::REAL>& plane,
+	CellMarker<typename PFP::MAP, FACE>& /*cmv_over*/,
+	bool /*keepTetrahedra*/,
+	bool /*with_unsew*/,
+	unsigned int nbth)
+{
+	typedef typename PFP::MAP MAP;
+	typedef typename PFP::VEC3 VEC3;
+
+	VertexAutoAttribute<char, MAP> side(map, "planeCut_side");
+
+	std::vector<Dart> edges;
+	std::vector<VEC3> points;
+	Algo::Surface::Modelisation::Parallel::planeIntersections<PFP>(map, position, plane, side, edges, points, nbth);
+
+	for (unsigned int i = 0; i < edges.size(); ++i)
+	{
+		Dart x = map.cutEdge(edges[i]);
+		position[x] = points[i];
+	}
+}
+
+} // namespace Parallel
+
 } // namespace Modelisation
 
 } // namespace Volume
@@ -0,0 +1,296 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef _SPARSE_VOXELLISATION_H_
+#define _SPARSE_VOXELLISATION_H_
+
+#include "Algo/Modelisation/voxellisation.h"
+
+#include <vector>
+#include <unordered_map>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Modelisation
+{
+
+/**
+ * Sparse version of Voxellisation, for high resolutions.
+ * Voxel states and coordinates are the same (0: empty, 1: surface or inside,
+ * 2: exterior, with a one voxel border around the resolution), but voxels are
+ * stored in 8x8x8 bricks of two bit planes, only where the state is not uniform.
+ * A coarse table gives for each brick either its index in the brick pool or its
+ * uniform state, so that empty, exterior and filled regions cost 4 bytes per brick.
+ */
+class SparseVoxellisation
+{
+public:
+	/**
+	 * one z slice of a brick (bit x + 8*y)
+	 */
+	typedef unsigned long long Word;
+
+	struct Brick
+	{
+		Word surface[8];
+		Word exterior[8];
+	};
+
+	SparseVoxellisation(
+		Geom::Vec3i resolutions = Geom::Vec3i(),
+		Geom::BoundingBox<Geom::Vec3f> bb = Geom::BoundingBox<Geom::Vec3f>(Geom::Vec3f())
+	);
+
+	void clear();
+
+	/**************************************
+	 *           VOXEL ACCESS             *
+	 **************************************/
+
+	/**
+	 * voxel coordinates as in Voxellisation: x in [-1, resolution]
+	 */
+	void addVoxel(int x, int y, int z, int type = 1);
+
+	void addVoxel(Geom::Vec3i a, int type = 1) { addVoxel(a[0], a[1], a[2], type); }
+
+	void removeVoxel(int x, int y, int z);
+
+	int getVoxel(int x, int y, int z) const;
+
+	int getVoxel(Geom::Vec3i a) const { return getVoxel(a[0], a[1], a[2]); }
+
+	/**
+	 * raw coordinates (border included): x in [0, taille)
+	 */
+	void addVoxelRaw(int x, int y, int z, int type = 1) { addVoxel(x - 1, y - 1, z - 1, type); }
+
+	int getVoxelRaw(int x, int y, int z) const;
+
+	int getTailleX() const { return m_taille[0]; }
+	int getTailleY() const { return m_taille[1]; }
+	int getTailleZ() const { return m_taille[2]; }
+
+	int getResolutionX() const { return m_taille[0] - 2; }
+	int getResolutionY() const { return m_taille[1] - 2; }
+	int getResolutionZ() const { return m_taille[2] - 2; }
+
+	int getResolution(int resolution) const;
+
+	/**
+	 * number of surface / inside voxels
+	 */
+	unsigned long long size() const { return m_size; }
+
+	/**
+	 * number of allocated (non uniform) bricks
+	 */
+	unsigned int getNbBricks() const { return (unsigned int)(m_bricks.size()); }
+
+	/**
+	 * memory used by the coarse table and the bricks (in bytes)
+	 */
+	unsigned long long memoryUsage() const;
+
+	/**************************************
+	 *           RASTERIZATION            *
+	 **************************************/
+
+	/**
+	 * same discrete fan filling as Voxellisation::voxellisePolygone
+	 */
+	void voxellisePolygone(const std::vector<Geom::Vec3i>& polygone);
+
+	void voxelliseLine(Geom::Vec3i a, Geom::Vec3i b);
+
+	/**
+	 * rasterize a set of polygons with nbThreads threads (0: hardware concurrency)
+	 * each thread fills its own sparse bricks, which are merged in thread order
+	 */
+	void voxellisePolygones(const std::vector< std::vector<Geom::Vec3i> >& polygones, unsigned int nbThreads = 0);
+
+	/**************************************
+	 *            PROCESSING              *
+	 **************************************/
+
+	/**
+	 * mark the empty voxels connected to the corner (0,0,0) of the border as exterior
+	 * the fill works brick by brick: uniform bricks are filled at once,
+	 * the others with 6-connected dilations of their bit planes
+	 */
+	void marqueVoxelsExterieurs();
+
+	/**
+	 * mark the remaining empty voxels (inside) as surface
+	 */
+	void remplit();
+
+	/**
+	 * grow the grid by one voxel on each side, then add to the surface
+	 * the exterior voxels 26-adjacent to the surface, iterations times
+	 * (the grid grows in place: no copy of the voxels)
+	 */
+	void dilate(unsigned int iterations = 1, unsigned int nbThreads = 0);
+
+	/**
+	 * extract the quads separating surface voxels from exterior voxels
+	 * into m_sommets / m_faces (same layout as Voxellisation)
+	 */
+	void extractionBord();
+
+	int getNbSommets() const { return int(m_sommets.size()); }
+
+	int getNbFaces() const { return int(m_faces.size() / 4); }
+
+private:
+	/**
+	 * uniform states of a cell of the coarse table (other values are indices in m_bricks)
+	 */
+	enum : unsigned int
+	{
+		BRICK_EMPTY = 0xFFFFFFFFu,
+		BRICK_EXTERIOR = 0xFFFFFFFEu,
+		BRICK_FILLED = 0xFFFFFFFDu
+	};
+
+	static unsigned int popcount(Word w);
+
+	static unsigned int lowestBit(Word w);
+
+	static bool isZero(const Word* w);
+
+	/**
+	 * bits of brick (bx,by,bz) that lie in the raw box [lo, hi)
+	 */
+	void boxMask(int bx, int by, int bz, const int* lo, const int* hi, Word* mask) const;
+
+	/**
+	 * bits of the grid (border included)
+	 */
+	void gridMask(int bx, int by, int bz, Word* mask) const;
+
+	/**
+	 * bits of the grid without its border
+	 */
+	void interiorMask(int bx, int by, int bz, Word* mask) const;
+
+	bool validCell(int bx, int by, int bz) const;
+
+	unsigned int cellIndex(int bx, int by, int bz) const { return bx + m_nbBricks[0] * (by + m_nbBricks[1] * bz); }
+
+	void cellCoords(unsigned int cell, int& bx, int& by, int& bz) const;
+
+	/**
+	 * raw coordinates to cell, slice and bit in slice
+	 */
+	bool locate(int x, int y, int z, unsigned int& cell, unsigned int& slice, unsigned int& bit) const;
+
+	int voxelState(unsigned int cell, unsigned int slice, unsigned int bit) const;
+
+	/**
+	 * get the brick of a cell, converting its uniform state into bit planes if needed
+	 * (invalidates references to other bricks)
+	 */
+	Brick& materialize(unsigned int cell);
+
+	/**
+	 * rebuild the coarse table for the current sizes plus extra voxels on the high side,
+	 * moving old cells by shift bricks
+	 */
+	void resizeTable(int shift, int extra);
+
+	/**
+	 * 6-connected fill of the exterior bits of a brick inside the free bits
+	 */
+	static void closeExterior(Word* exterior, const Word* free);
+
+	/**
+	 * add exterior seed bits to cell (bx,by,bz)
+	 * @return true if new exterior voxels appeared
+	 */
+	bool seedExterior(int bx, int by, int bz, const Word* seed);
+
+	/**
+	 * exterior bits of a cell (zero outside of the table)
+	 */
+	void exteriorBits(int bx, int by, int bz, Word* ext) const;
+
+	/**
+	 * surface bits of a cell that are not on the border (zero outside of the table)
+	 */
+	void surfaceBits(int bx, int by, int bz, Word* surf) const;
+
+	/**
+	 * set the given bits of a cell as surface
+	 */
+	void addSurfaceBits(unsigned int cell, const Word* bits);
+
+	void ajouteSommet(int x, int y, int z);
+
+	unsigned long long m_size;
+
+	int m_taille[3];
+
+	/**
+	 * storage coordinate = raw coordinate + m_pad (lets the grid grow on the low side without moving bricks)
+	 */
+	int m_pad;
+
+	int m_nbBricks[3];
+
+	std::vector<unsigned int> m_table;
+
+	std::vector<Brick> m_bricks;
+
+	Geom::Vec3f m_bb_min;
+	Geom::Vec3f m_bb_max;
+
+	std::unordered_map<unsigned long long, int> m_indexes;
+
+public:
+	std::vector<Geom::Vec3f> m_sommets;
+	std::vector<int> m_faces;
+
+	Geom::Vec3f m_transfo;
+};
+
+} // namespace Modelisation
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Modelisation/sparseVoxellisation.hpp"
+
+#endif // _SPARSE_VOXELLISATION_H_
@@ -0,0 +1,922 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <algorithm>
+#include <thread>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Modelisation
+{
+
+namespace SparseVoxellisationBits
+{
+// bit x + 8*y of a slice
+const SparseVoxellisation::Word COL0 = 0x0101010101010101ULL;
+const SparseVoxellisation::Word COL7 = 0x8080808080808080ULL;
+const SparseVoxellisation::Word ROW0 = 0x00000000000000FFULL;
+const SparseVoxellisation::Word ROW7 = 0xFF00000000000000ULL;
+}
+
+inline SparseVoxellisation::SparseVoxellisation(Geom::Vec3i resolutions, Geom::BoundingBox<Geom::Vec3f> bb) :
+	m_size(0),
+	m_pad(0),
+	m_bb_min(bb.min()),
+	m_bb_max(bb.max())
+{
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		m_taille[i] = resolutions[i] + 2;
+		m_nbBricks[i] = 0;
+		m_transfo[i] = (m_bb_max[i] - m_bb_min[i]) / (m_taille[i] - 2);
+	}
+	swapVectorMax(m_bb_min, m_bb_max);
+	resizeTable(0, 0);
+}
+
+inline void SparseVoxellisation::clear()
+{
+	m_size = 0;
+	std::fill(m_table.begin(), m_table.end(), BRICK_EMPTY);
+	std::vector<Brick>().swap(m_bricks);
+	m_indexes.clear();
+	m_sommets.clear();
+	m_faces.clear();
+}
+
+/**************************************
+ *           BIT UTILITIES            *
+ **************************************/
+
+inline unsigned int SparseVoxellisation::popcount(Word w)
+{
+#if defined(__GNUC__)
+	return (unsigned int)(__builtin_popcountll(w));
+#else
+	w = w - ((w >> 1) & 0x5555555555555555ULL);
+	w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+	w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (unsigned int)((w * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+inline unsigned int SparseVoxellisation::lowestBit(Word w)
+{
+#if defined(__GNUC__)
+	return (unsigned int)(__builtin_ctzll(w));
+#else
+	unsigned int b = 0;
+	while (!(w & 1ULL))
+	{
+		w >>= 1;
+		++b;
+	}
+	return b;
+#endif
+}
+
+inline bool SparseVoxellisation::isZero(const Word* w)
+{
+	return (w[0] | w[1] | w[2] | w[3] | w[4] | w[5] | w[6] | w[7]) == 0;
+}
+
+inline void SparseVoxellisation::boxMask(int bx, int by, int bz, const int* lo, const int* hi, Word* mask) const
+{
+	const int b[3] = { bx, by, bz };
+	int l[3], h[3];
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		l[i] = std::max(0, lo[i] + m_pad - 8 * b[i]);
+		h[i] = std::min(8, hi[i] + m_pad - 8 * b[i]);
+		if (l[i] >= h[i])
+		{
+			for (unsigned int z = 0; z < 8; ++z)
+				mask[z] = 0;
+			return;
+		}
+	}
+
+	const Word row = ((Word(1) << (h[0] - l[0])) - 1) << l[0];
+	Word slice = 0;
+	for (int y = l[1]; y < h[1]; ++y)
+		slice |= row << (8 * y);
+	for (int z = 0; z < 8; ++z)
+		mask[z] = (z >= l[2] && z < h[2]) ? slice : 0;
+}
+
+inline void SparseVoxellisation::gridMask(int bx, int by, int bz, Word* mask) const
+{
+	const int lo[3] = { 0, 0, 0 };
+	boxMask(bx, by, bz, lo, m_taille, mask);
+}
+
+inline void SparseVoxellisation::interiorMask(int bx, int by, int bz, Word* mask) const
+{
+	const int lo[3] = { 1, 1, 1 };
+	const int hi[3] = { m_taille[0] - 1, m_taille[1] - 1, m_taille[2] - 1 };
+	boxMask(bx, by, bz, lo, hi, mask);
+}
+
+/**************************************
+ *           COARSE TABLE             *
+ **************************************/
+
+inline bool SparseVoxellisation::validCell(int bx, int by, int bz) const
+{
+	return bx >= 0 && by >= 0 && bz >= 0 && bx < m_nbBricks[0] && by < m_nbBricks[1] && bz < m_nbBricks[2];
+}
+
+inline void SparseVoxellisation::cellCoords(unsigned int cell, int& bx, int& by, int& bz) const
+{
+	bx = int(cell % m_nbBricks[0]);
+	cell /= m_nbBricks[0];
+	by = int(cell % m_nbBricks[1]);
+	bz = int(cell / m_nbBricks[1]);
+}
+
+inline bool SparseVoxellisation::locate(int x, int y, int z, unsigned int& cell, unsigned int& slice, unsigned int& bit) const
+{
+	if (x < 0 || y < 0 || z < 0 || x >= m_taille[0] || y >= m_taille[1] || z >= m_taille[2])
+		return false;
+	x += m_pad;
+	y += m_pad;
+	z += m_pad;
+	cell = cellIndex(x >> 3, y >> 3, z >> 3);
+	slice = z & 7;
+	bit = (x & 7) + 8 * (y & 7);
+	return true;
+}
+
+inline int SparseVoxellisation::voxelState(unsigned int cell, unsigned int slice, unsigned int bit) const
+{
+	const unsigned int s = m_table[cell];
+	switch (s)
+	{
+		case BRICK_EMPTY:
+			return 0;
+		case BRICK_EXTERIOR:
+			return 2;
+		case BRICK_FILLED:
+			return 1;
+		default:
+		{
+			const Word m = Word(1) << bit;
+			if (m_bricks[s].surface[slice] & m)
+				return 1;
+			if (m_bricks[s].exterior[slice] & m)
+				return 2;
+			return 0;
+		}
+	}
+}
+
+inline SparseVoxellisation::Brick& SparseVoxellisation::materialize(unsigned int cell)
+{
+	const unsigned int s = m_table[cell];
+	if (s < BRICK_FILLED)
+		return m_bricks[s];
+
+	Brick b;
+	for (unsigned int z = 0; z < 8; ++z)
+	{
+		b.surface[z] = 0;
+		b.exterior[z] = 0;
+	}
+	int bx, by, bz;
+	cellCoords(cell, bx, by, bz);
+	if (s == BRICK_EXTERIOR)
+		gridMask(bx, by, bz, b.exterior);
+	else if (s == BRICK_FILLED)
+		gridMask(bx, by, bz, b.surface);
+
+	m_table[cell] = (unsigned int)(m_bricks.size());
+	m_bricks.push_back(b);
+	return m_bricks.back();
+}
+
+inline void SparseVoxellisation::resizeTable(int shift, int extra)
+{
+	int nb[3];
+	for (unsigned int i = 0; i < 3; ++i)
+		nb[i] = std::max(1, (m_pad + m_taille[i] + extra + 7) / 8);
+
+	if (nb[0] == m_nbBricks[0] && nb[1] == m_nbBricks[1] && nb[2] == m_nbBricks[2] && shift == 0)
+		return;
+
+	std::vector<unsigned int> table((std::size_t)(nb[0]) * nb[1] * nb[2], BRICK_EMPTY);
+	for (int bz = 0; bz < m_nbBricks[2]; ++bz)
+		for (int by = 0; by < m_nbBricks[1]; ++by)
+			for (int bx = 0; bx < m_nbBricks[0]; ++bx)
+			{
+				const int nx = bx + shift, ny = by + shift, nz = bz + shift;
+				if (nx < nb[0] && ny < nb[1] && nz < nb[2])
+					table[nx + nb[0] * (ny + nb[1] * nz)] = m_table[cellIndex(bx, by, bz)];
+			}
+
+	m_table.swap(table);
+	for (unsigned int i = 0; i < 3; ++i)
+		m_nbBricks[i] = nb[i];
+}
+
+inline unsigned long long SparseVoxellisation::memoryUsage() const
+{
+	return (unsigned long long)(m_table.capacity()) * sizeof(unsigned int) + (unsigned long long)(m_bricks.capacity()) * sizeof(Brick);
+}
+
+/**************************************
+ *           VOXEL ACCESS             *
+ **************************************/
+
+inline void SparseVoxellisation::addVoxel(int x, int y, int z, int type)
+{
+	unsigned int cell, slice, bit;
+	if (!locate(x + 1, y + 1, z + 1, cell, slice, bit))
+		return;
+
+	const int state = type == 0 || type == 2 ? type : 1;
+	const int old = voxelState(cell, slice, bit);
+	if (old == state)
+		return;
+
+	Brick& b = materialize(cell);
+	const Word m = Word(1) << bit;
+	b.surface[slice] &= ~m;
+	b.exterior[slice] &= ~m;
+	if (state == 1)
+		b.surface[slice] |= m;
+	else if (state == 2)
+		b.exterior[slice] |= m;
+
+	if (old == 1)
+		--m_size;
+	if (state == 1)
+		++m_size;
+}
+
+inline void SparseVoxellisation::removeVoxel(int x, int y, int z)
+{
+	if (x >= 0 && y >= 0 && z >= 0)
+		addVoxel(x, y, z, 0);
+}
+
+inline int SparseVoxellisation::getVoxel(int x, int y, int z) const
+{
+	unsigned int cell, slice, bit;
+	if (!locate(x + 1, y + 1, z + 1, cell, slice, bit))
+		return 0;
+	return voxelState(cell, slice, bit);
+}
+
+inline int SparseVoxellisation::getVoxelRaw(int x, int y, int z) const
+{
+	unsigned int cell, slice, bit;
+	if (!locate(x, y, z, cell, slice, bit))
+		return -1;
+	return voxelState(cell, slice, bit);
+}
+
+inline int SparseVoxellisation::getResolution(int resolution) const
+{
+	if (resolution >= 0 && resolution < 3)
+		return m_taille[resolution] - 2;
+	return -1;
+}
+
+/**************************************
+ *           RASTERIZATION            *
+ **************************************/
+
+inline void SparseVoxellisation::voxellisePolygone(const std::vector<Geom::Vec3i>& polygone)
+{
+	auto add = [this] (int x, int y, int z) { addVoxel(x, y, z); };
+	rasterisePolygone(polygone, add);
+}
+
+inline void SparseVoxellisation::voxelliseLine(Geom::Vec3i a, Geom::Vec3i b)
+{
+	auto add = [this] (int x, int y, int z) { addVoxel(x, y, z); };
+	rasteriseLine(a, b, add);
+}
+
+inline void SparseVoxellisation::addSurfaceBits(unsigned int cell, const Word* bits)
+{
+	if (m_table[cell] == BRICK_FILLED)
+		return;
+
+	Brick& b = materialize(cell);
+	for (unsigned int z = 0; z < 8; ++z)
+	{
+		m_size += popcount(bits[z] & ~b.surface[z]);
+		b.surface[z] |= bits[z];
+		b.exterior[z] &= ~bits[z];
+	}
+}
+
+inline void SparseVoxellisation::voxellisePolygones(const std::vector< std::vector<Geom::Vec3i> >& polygones, unsigned int nbThreads)
+{
+	const unsigned int nbP = (unsigned int)(polygones.size());
+	unsigned int nbth = nbThreads > 0 ? nbThreads : std::thread::hardware_concurrency();
+	if (nbth > nbP)
+		nbth = nbP;
+	if (nbth <= 1)
+	{
+		for (unsigned int i = 0; i < nbP; ++i)
+			voxellisePolygone(polygones[i]);
+		return;
+	}
+
+	// thread local sparse bricks: cell -> offset of its 8 slices
+	std::vector< std::unordered_map<unsigned int, unsigned int> > localCells(nbth);
+	std::vector< std::vector<Word> > localBits(nbth);
+
+	auto rasterRange = [&] (unsigned int t)
+	{
+		std::unordered_map<unsigned int, unsigned int>& cells = localCells[t];
+		std::vector<Word>& bits = localBits[t];
+		unsigned int lastCell = BRICK_EMPTY;
+		unsigned int lastOffset = 0;
+
+		auto add = [&] (int x, int y, int z)
+		{
+			unsigned int cell, slice, bit;
+			if (!locate(x + 1, y + 1, z + 1, cell, slice, bit))
+				return;
+			if (cell != lastCell)
+			{
+				std::unordered_map<unsigned int, unsigned int>::const_iterator it = cells.find(cell);
+				if (it == cells.end())
+				{
+					lastOffset = (unsigned int)(bits.size());
+					cells[cell] = lastOffset;
+					bits.resize(bits.size() + 8, 0);
+				}
+				else
+					lastOffset = it->second;
+				lastCell = cell;
+			}
+			bits[lastOffset + slice] |= Word(1) << bit;
+		};
+
+		const unsigned int first = (unsigned long long)(nbP) * t / nbth;
+		const unsigned int last = (unsigned long long)(nbP) * (t + 1) / nbth;
+		for (unsigned int i = first; i < last; ++i)
+			rasterisePolygone(polygones[i], add);
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(nbth);
+	for (unsigned int t = 0; t < nbth; ++t)
+		threads.push_back(std::thread(rasterRange, t));
+	for (unsigned int t = 0; t < nbth; ++t)
+		threads[t].join();
+
+	for (unsigned int t = 0; t < nbth; ++t)
+	{
+		for (std::unordered_map<unsigned int, unsigned int>::const_iterator it = localCells[t].begin(); it != localCells[t].end(); ++it)
+			addSurfaceBits(it->first, &localBits[t][it->second]);
+		std::unordered_map<unsigned int, unsigned int>().swap(localCells[t]);
+		std::vector<Word>().swap(localBits[t]);
+	}
+}
+
+/**************************************
+ *            PROCESSING              *
+ **************************************/
+
+inline void SparseVoxellisation::closeExterior(Word* exterior, const Word* free)
+{
+	using namespace SparseVoxellisationBits;
+
+	bool changed = true;
+	bool forward = true;
+	while (changed)
+	{
+		changed = false;
+		for (int n = 0; n < 8; ++n)
+		{
+			const int z = forward ? n : 7 - n;
+			const Word w = exterior[z];
+			Word d = w;
+			if (z > 0)
+				d |= exterior[z - 1] & free[z];
+			if (z < 7)
+				d |= exterior[z + 1] & free[z];
+			Word p;
+			do
+			{
+				p = d;
+				d |= (((d << 1) & ~COL0) | ((d >> 1) & ~COL7) | (d << 8) | (d >> 8)) & free[z];
+			} while (d != p);
+			if (d != w)
+			{
+				exterior[z] = d;
+				changed = true;
+			}
+		}
+		forward = !forward;
+	}
+}
+
+inline bool SparseVoxellisation::seedExterior(int bx, int by, int bz, const Word* seed)
+{
+	if (!validCell(bx, by, bz) || isZero(seed))
+		return false;
+
+	const unsigned int cell = cellIndex(bx, by, bz);
+	const unsigned int s = m_table[cell];
+	if (s == BRICK_EXTERIOR || s == BRICK_FILLED)
+		return false;
+
+	Word g[8];
+	gridMask(bx, by, bz, g);
+
+	if (s == BRICK_EMPTY)
+	{
+		// the grid part of a brick is a box: empty and reached means fully exterior
+		for (unsigned int z = 0; z < 8; ++z)
+		{
+			if (seed[z] & g[z])
+			{
+				m_table[cell] = BRICK_EXTERIOR;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	Brick& b = m_bricks[s];
+	bool added = false;
+	for (unsigned int z = 0; z < 8; ++z)
+	{
+		const Word n = seed[z] & g[z] & ~b.surface[z] & ~b.exterior[z];
+		if (n)
+		{
+			b.exterior[z] |= n;
+			added = true;
+		}
+	}
+	return added;
+}
+
+inline void SparseVoxellisation::marqueVoxelsExterieurs()
+{
+	using namespace SparseVoxellisationBits;
+
+	CGoGNout << "Marquage des voxels extérieurs.." << CGoGNflush;
+
+	std::vector<unsigned char> queued(m_table.size(), 0);
+	std::vector<unsigned int> pile;
+
+	auto seed = [&] (int bx, int by, int bz, const Word* bits)
+	{
+		if (seedExterior(bx, by, bz, bits))
+		{
+			const unsigned int cell = cellIndex(bx, by, bz);
+			if (!queued[cell])
+			{
+				queued[cell] = 1;
+				pile.push_back(cell);
+			}
+		}
+	};
+
+	unsigned int cell, slice, bit;
+	if (locate(0, 0, 0, cell, slice, bit))
+	{
+		Word bits[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+		bits[slice] = Word(1) << bit;
+		int bx, by, bz;
+		cellCoords(cell, bx, by, bz);
+		seed(bx, by, bz, bits);
+	}
+
+	Word e[8];
+	Word f[8];
+	Word s[8];
+	while (!pile.empty())
+	{
+		cell = pile.back();
+		pile.pop_back();
+		queued[cell] = 0;
+
+		int bx, by, bz;
+		cellCoords(cell, bx, by, bz);
+
+		const unsigned int state = m_table[cell];
+		if (state == BRICK_EXTERIOR)
+			gridMask(bx, by, bz, e);
+		else
+		{
+			Brick& b = m_bricks[state];
+			gridMask(bx, by, bz, f);
+			for (unsigned int z = 0; z < 8; ++z)
+				f[z] &= ~b.surface[z];
+			closeExterior(b.exterior, f);
+			std::copy(b.exterior, b.exterior + 8, e);
+		}
+
+		// propagate the faces to the 6 neighbor bricks
+		for (unsigned int z = 0; z < 8; ++z)
+			s[z] = (e[z] & COL0) << 7;
+		seed(bx - 1, by, bz, s);
+		for (unsigned int z = 0; z < 8; ++z)
+			s[z] = (e[z] & COL7) >> 7;
+		seed(bx + 1, by, bz, s);
+		for (unsigned int z = 0; z < 8; ++z)
+			s[z] = (e[z] & ROW0) << 56;
+		seed(bx, by - 1, bz, s);
+		for (unsigned int z = 0; z < 8; ++z)
+			s[z] = (e[z] & ROW7) >> 56;
+		seed(bx, by + 1, bz, s);
+		for (unsigned int z = 0; z < 8; ++z)
+			s[z] = 0;
+		s[7] = e[0];
+		seed(bx, by, bz - 1, s);
+		s[7] = 0;
+		s[0] = e[7];
+		seed(bx, by, bz + 1, s);
+	}
+
+	CGoGNout << ".. fait." << CGoGNendl;
+}
+
+inline void SparseVoxellisation::remplit()
+{
+	Word in[8];
+	Word g[8];
+	for (int bz = 0; bz < m_nbBricks[2]; ++bz)
+		for (int by = 0; by < m_nbBricks[1]; ++by)
+			for (int bx = 0; bx < m_nbBricks[0]; ++bx)
+			{
+				const unsigned int cell = cellIndex(bx, by, bz);
+				const unsigned int s = m_table[cell];
+				if (s == BRICK_EXTERIOR || s == BRICK_FILLED)
+					continue;
+
+				interiorMask(bx, by, bz, in);
+				if (isZero(in))
+					continue;
+
+				if (s == BRICK_EMPTY)
+				{
+					gridMask(bx, by, bz, g);
+					if (std::equal(in, in + 8, g))
+					{
+						m_table[cell] = BRICK_FILLED;
+						for (unsigned int z = 0; z < 8; ++z)
+							m_size += popcount(g[z]);
+						continue;
+					}
+				}
+
+				Brick& b = materialize(cell);
+				for (unsigned int z = 0; z < 8; ++z)
+				{
+					const Word n = in[z] & ~b.surface[z] & ~b.exterior[z];
+					b.surface[z] |= n;
+					m_size += popcount(n);
+				}
+			}
+}
+
+inline void SparseVoxellisation::exteriorBits(int bx, int by, int bz, Word* ext) const
+{
+	const unsigned int s = validCell(bx, by, bz) ? m_table[cellIndex(bx, by, bz)] : BRICK_EMPTY;
+	if (s == BRICK_EXTERIOR)
+		gridMask(bx, by, bz, ext);
+	else if (s < BRICK_FILLED)
+		std::copy(m_bricks[s].exterior, m_bricks[s].exterior + 8, ext);
+	else
+		std::fill(ext, ext + 8, Word(0));
+}
+
+inline void SparseVoxellisation::surfaceBits(int bx, int by, int bz, Word* surf) const
+{
+	const unsigned int s = validCell(bx, by, bz) ? m_table[cellIndex(bx, by, bz)] : BRICK_EMPTY;
+	if (s == BRICK_EMPTY || s == BRICK_EXTERIOR)
+	{
+		std::fill(surf, surf + 8, Word(0));
+		return;
+	}
+	interiorMask(bx, by, bz, surf);
+	if (s != BRICK_FILLED)
+	{
+		for (unsigned int z = 0; z < 8; ++z)
+			surf[z] &= m_bricks[s].surface[z];
+	}
+}
+
+inline void SparseVoxellisation::dilate(unsigned int iterations, unsigned int nbThreads)
+{
+	using namespace SparseVoxellisationBits;
+
+	// grow the grid by one voxel on each side: the padding decreases instead of moving the bricks
+	if (m_pad == 0)
+	{
+		m_pad = 8;
+		resizeTable(1, 1);
+	}
+	else
+		resizeTable(0, 1);
+
+	// the new border is exterior
+	const int lo[3] = { -1, -1, -1 };
+	const int hi[3] = { m_taille[0] + 1, m_taille[1] + 1, m_taille[2] + 1 };
+	Word gOld[8];
+	Word ring[8];
+	for (int bz = 0; bz < m_nbBricks[2]; ++bz)
+		for (int by = 0; by < m_nbBricks[1]; ++by)
+			for (int bx = 0; bx < m_nbBricks[0]; ++bx)
+			{
+				boxMask(bx, by, bz, lo, hi, ring);
+				gridMask(bx, by, bz, gOld);
+				for (unsigned int z = 0; z < 8; ++z)
+					ring[z] &= ~gOld[z];
+				if (isZero(ring))
+					continue;
+
+				const unsigned int cell = cellIndex(bx, by, bz);
+				const unsigned int s = m_table[cell];
+				if (s == BRICK_EXTERIOR)
+					continue;
+				if (s == BRICK_EMPTY && isZero(gOld))
+				{
+					m_table[cell] = BRICK_EXTERIOR;
+					continue;
+				}
+				Brick& b = materialize(cell);
+				for (unsigned int z = 0; z < 8; ++z)
+					b.exterior[z] |= ring[z];
+			}
+
+	--m_pad;
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		m_taille[i] += 2;
+		m_bb_min[i] -= m_transfo[i];
+		m_bb_max[i] += m_transfo[i];
+	}
+
+	const unsigned int nbCells = (unsigned int)(m_table.size());
+	unsigned int nbth = nbThreads > 0 ? nbThreads : std::thread::hardware_concurrency();
+	if (nbth > nbCells)
+		nbth = nbCells;
+	if (nbth < 1)
+		nbth = 1;
+
+	std::vector< std::vector<unsigned int> > addedCells(nbth);
+	std::vector< std::vector<Word> > addedBits(nbth);
+
+	// exterior voxels 26-adjacent to the surface (separable box dilation over the 27 neighbor bricks)
+	auto dilateRange = [&] (unsigned int t)
+	{
+		Word target[8];
+		Word src[3][3][3][8];
+		Word dx[3][3][8];
+		Word dy[3][8];
+		Word add[8];
+
+		const unsigned int first = (unsigned long long)(nbCells) * t / nbth;
+		const unsigned int last = (unsigned long long)(nbCells) * (t + 1) / nbth;
+		for (unsigned int cell = first; cell < last; ++cell)
+		{
+			const unsigned int s = m_table[cell];
+			if (s == BRICK_EMPTY || s == BRICK_FILLED)
+				continue;
+			int bx, by, bz;
+			cellCoords(cell, bx, by, bz);
+			exteriorBits(bx, by, bz, target);
+			if (isZero(target))
+				continue;
+
+			bool any = false;
+			for (int k = 0; k < 3; ++k)
+				for (int j = 0; j < 3; ++j)
+					for (int i = 0; i < 3; ++i)
+					{
+						surfaceBits(bx + i - 1, by + j - 1, bz + k - 1, src[k][j][i]);
+						any = any || !isZero(src[k][j][i]);
+					}
+			if (!any)
+				continue;
+
+			for (int k = 0; k < 3; ++k)
+				for (int j = 0; j < 3; ++j)
+					for (int z = 0; z < 8; ++z)
+					{
+						const Word c = src[k][j][1][z];
+						dx[k][j][z] = c | ((c << 1) & ~COL0) | ((c >> 1) & ~COL7)
+							| ((src[k][j][0][z] & COL7) >> 7) | ((src[k][j][2][z] & COL0) << 7);
+					}
+			for (int k = 0; k < 3; ++k)
+				for (int z = 0; z < 8; ++z)
+				{
+					const Word c = dx[k][1][z];
+					dy[k][z] = c | (c << 8) | (c >> 8) | ((dx[k][0][z] & ROW7) >> 56) | ((dx[k][2][z] & ROW0) << 56);
+				}
+			for (int z = 0; z < 8; ++z)
+			{
+				const Word d = dy[1][z] | (z > 0 ? dy[1][z - 1] : dy[0][7]) | (z < 7 ? dy[1][z + 1] : dy[2][0]);
+				add[z] = d & target[z];
+			}
+
+			if (!isZero(add))
+			{
+				addedCells[t].push_back(cell);
+				addedBits[t].insert(addedBits[t].end(), add, add + 8);
+			}
+		}
+	};
+
+	while (iterations > 0)
+	{
+		if (nbth == 1)
+			dilateRange(0);
+		else
+		{
+			std::vector<std::thread> threads;
+			threads.reserve(nbth);
+			for (unsigned int t = 0; t < nbth; ++t)
+				threads.push_back(std::thread(dilateRange, t));
+			for (unsigned int t = 0; t < nbth; ++t)
+				threads[t].join();
+		}
+
+		// all the additions are computed from the same state, then applied
+		for (unsigned int t = 0; t < nbth; ++t)
+		{
+			for (unsigned int i = 0; i < addedCells[t].size(); ++i)
+				addSurfaceBits(addedCells[t][i], &addedBits[t][8 * i]);
+			addedCells[t].clear();
+			addedBits[t].clear();
+		}
+		--iterations;
+	}
+}
+
+/**************************************
+ *          BOUNDARY EXTRACTION       *
+ **************************************/
+
+inline void SparseVoxellisation::ajouteSommet(int x, int y, int z)
+{
+	const unsigned long long key = (unsigned long long)(x) + (unsigned long long)(m_taille[0] + 1) * ((unsigned long long)(y) + (unsigned long long)(m_taille[1] + 1) * (unsigned long long)(z));
+	std::unordered_map<unsigned long long, int>::const_iterator it = m_indexes.find(key);
+	if (it == m_indexes.end())
+	{
+		const int index = int(m_sommets.size());
+		m_indexes[key] = index;
+		m_sommets.push_back(Geom::Vec3f(m_bb_min[0] + x * m_transfo[0], m_bb_min[1] + y * m_transfo[1], m_bb_min[2] + z * m_transfo[2]));
+		m_faces.push_back(index);
+	}
+	else
+		m_faces.push_back(it->second);
+}
+
+inline void SparseVoxellisation::extractionBord()
+{
+	using namespace SparseVoxellisationBits;
+
+	CGoGNout << "Extraction du bord.." << CGoGNflush;
+
+	m_indexes.clear();
+	m_faces.clear();
+	m_sommets.clear();
+
+	Word surf[8];
+	Word e[8], xm[8], xp[8], ym[8], yp[8], zm[8], zp[8];
+	Word side[6][8];
+
+	for (int bz = 0; bz < m_nbBricks[2]; ++bz)
+		for (int by = 0; by < m_nbBricks[1]; ++by)
+			for (int bx = 0; bx < m_nbBricks[0]; ++bx)
+			{
+				surfaceBits(bx, by, bz, surf);
+				if (isZero(surf))
+					continue;
+
+				exteriorBits(bx, by, bz, e);
+				exteriorBits(bx - 1, by, bz, xm);
+				exteriorBits(bx + 1, by, bz, xp);
+				exteriorBits(bx, by - 1, bz, ym);
+				exteriorBits(bx, by + 1, bz, yp);
+				exteriorBits(bx, by, bz - 1, zm);
+				exteriorBits(bx, by, bz + 1, zp);
+
+				// side[d]: surface voxels whose neighbor in direction d is exterior
+				for (int z = 0; z < 8; ++z)
+				{
+					side[0][z] = surf[z] & (((e[z] << 1) & ~COL0) | ((xm[z] & COL7) >> 7));
+					side[1][z] = surf[z] & (((e[z] >> 1) & ~COL7) | ((xp[z] & COL0) << 7));
+					side[2][z] = surf[z] & ((e[z] << 8) | ((ym[z] & ROW7) >> 56));
+					side[3][z] = surf[z] & ((e[z] >> 8) | ((yp[z] & ROW0) << 56));
+					side[4][z] = surf[z] & (z > 0 ? e[z - 1] : zm[7]);
+					side[5][z] = surf[z] & (z < 7 ? e[z + 1] : zp[0]);
+				}
+
+				for (int z = 0; z < 8; ++z)
+				{
+					Word w = side[0][z] | side[1][z] | side[2][z] | side[3][z] | side[4][z] | side[5][z];
+					while (w)
+					{
+						const unsigned int b = lowestBit(w);
+						const Word m = Word(1) << b;
+						w &= w - 1;
+
+						// voxel coordinates (as in Voxellisation::getVoxel)
+						const int i = 8 * bx + int(b & 7) - m_pad - 1;
+						const int j = 8 * by + int(b >> 3) - m_pad - 1;
+						const int k = 8 * bz + z - m_pad - 1;
+						int x, y, zz;
+
+						if (side[0][z] & m)
+						{
+							x = i - 1; y = j; zz = k;
+							ajouteSommet(++x, y, zz);
+							ajouteSommet(x, y, ++zz);
+							ajouteSommet(x, ++y, zz);
+							ajouteSommet(x, y, --zz);
+						}
+						if (side[1][z] & m)
+						{
+							x = i + 1; y = j; zz = k;
+							ajouteSommet(x, y, zz);
+							ajouteSommet(x, ++y, zz);
+							ajouteSommet(x, y, ++zz);
+							ajouteSommet(x, --y, zz);
+						}
+						if (side[2][z] & m)
+						{
+							x = i; y = j - 1; zz = k;
+							ajouteSommet(x, ++y, zz);
+							ajouteSommet(++x, y, zz);
+							ajouteSommet(x, y, ++zz);
+							ajouteSommet(--x, y, zz);
+						}
+						if (side[3][z] & m)
+						{
+							x = i; y = j + 1; zz = k;
+							ajouteSommet(x, y, zz);
+							ajouteSommet(x, y, ++zz);
+							ajouteSommet(++x, y, zz);
+							ajouteSommet(x, y, --zz);
+						}
+						if (side[4][z] & m)
+						{
+							x = i; y = j; zz = k - 1;
+							ajouteSommet(x, y, ++zz);
+							ajouteSommet(x, ++y, zz);
+							ajouteSommet(++x, y, zz);
+							ajouteSommet(x, --y, zz);
+						}
+						if (side[5][z] & m)
+						{
+							x = i; y = j; zz = k + 1;
+							ajouteSommet(x, y, zz);
+							ajouteSommet(++x, y, zz);
+							ajouteSommet(x, ++y, zz);
+							ajouteSommet(--x, y, zz);
+						}
+					}
+				}
+			}
+
+	CGoGNout << ".. fait. " << CGoGNendl;
+}
+
+} // namespace Modelisation
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
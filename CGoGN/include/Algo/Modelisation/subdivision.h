@@ -205,6 +205,33 @@ void computeBoundaryConstraintDual(typename PFP::MAP& map, VertexAttribute<typen
 template <typename PFP>
 void computeBoundaryConstraintKeepingOldVerticesDual(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position);
 
+
+namespace Parallel
+{
+
+/**
+ * Catmull-Clark subdivision scheme, in two phases at each level:
+ * - all face, edge and vertex points are computed in parallel from the unmodified mesh
+ * - the edges are cut and the faces quadrangulated from the lists of darts gathered before
+ * (no marker driven traversal), and the new points are affected
+ * Boundary vertices use the original positions of their boundary neighbors.
+ * @param nbLevels number of successive subdivisions
+ * @param nbThreads number of threads used for the computation of the points
+ */
+template <typename PFP, typename EMBV>
+void CatmullClarkSubdivision(typename PFP::MAP& map, EMBV& attributs, unsigned int nbLevels = 1, unsigned int nbThreads = CGoGN::Parallel::NumberOfThreads) ;
+
+/**
+ * Loop subdivision scheme, in two phases at each level (see CatmullClarkSubdivision).
+ * The new positions of the vertices only depend on the original positions of their neighbors.
+ * @param nbLevels number of successive subdivisions
+ * @param nbThreads number of threads used for the computation of the points
+ */
+template <typename PFP, typename EMBV>
+void LoopSubdivision(typename PFP::MAP& map, EMBV& attributs, unsigned int nbLevels = 1, unsigned int nbThreads = CGoGN::Parallel::NumberOfThreads) ;
+
+} // namespace Parallel
+
 } // namespace Modelisation
 
 } // namespace Surface
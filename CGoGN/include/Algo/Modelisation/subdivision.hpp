@@ -315,6 +315,7 @@ void quadranguleFaces(typename PFP::MAP& map, EMBV& attributs)
 template <typename PFP, typename EMBV>
 void CatmullClarkSubdivision(typename PFP::MAP& map, EMBV& attributs)
 {
+	CGoGN_SCOPED_TIMER("Algo::Surface::Modelisation::CatmullClarkSubdivision");
 
 	typedef typename PFP::MAP MAP;
 	typedef typename EMBV::DATA_TYPE EMB;
@@ -618,6 +619,7 @@ inline double betaF(unsigned int n)
 template <typename PFP, typename EMBV>
 void LoopSubdivision(typename PFP::MAP& map, EMBV& attributs)
 {
+	CGoGN_SCOPED_TIMER("Algo::Surface::Modelisation::LoopSubdivision");
 	typedef typename PFP::MAP MAP;
 	typedef typename EMBV::DATA_TYPE EMB;
 
@@ -1180,6 +1182,254 @@ void computeBoundaryConstraintKeepingOldVerticesDual(typename PFP::MAP& map, Ver
 	}
 }
 
+
+namespace Parallel
+{
+
+/**
+ * cells of a surface before a subdivision step:
+ * one dart per vertex, per edge (not boundary) and per face (not boundary)
+ * and for each dart the index of its edge and of its face (0xffffffff for boundary)
+ */
+template <typename MAP>
+class SubdivisionCells
+{
+public:
+	std::vector<Dart> vertices;
+	std::vector<Dart> edges;
+	std::vector<Dart> faces;
+	DartAutoAttribute<unsigned int, MAP> edgeIndex;
+	DartAutoAttribute<unsigned int, MAP> faceIndex;
+
+	SubdivisionCells(MAP& map) :
+		edgeIndex(map, "subdivEdgeIndex"),
+		faceIndex(map, "subdivFaceIndex")
+	{
+		edgeIndex.setAllValues(0xffffffff);
+		faceIndex.setAllValues(0xffffffff);
+
+		TraversorV<MAP> tv(map);
+		for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+			vertices.push_back(d);
+
+		for (Dart d = map.begin(); d != map.end(); map.next(d))
+		{
+			if (edgeIndex[d] == 0xffffffff)
+			{
+				Dart d2 = map.phi2(d);
+				unsigned int ie = uint32(edges.size());
+				edgeIndex[d] = ie;
+				edgeIndex[d2] = ie;
+				edges.push_back(map.template isBoundaryMarked<2>(d) ? d2 : d);
+			}
+			if (faceIndex[d] == 0xffffffff && !map.template isBoundaryMarked<2>(d))
+			{
+				unsigned int iface = uint32(faces.size());
+				Dart it = d;
+				do
+				{
+					faceIndex[it] = iface;
+					it = map.phi1(it);
+				} while (it != d);
+				faces.push_back(d);
+			}
+		}
+	}
+};
+
+template <typename PFP, typename EMBV>
+void CatmullClarkSubdivision(typename PFP::MAP& map, EMBV& attributs, unsigned int nbLevels, unsigned int nbThreads)
+{
+	CGoGN_SCOPED_TIMER("Algo::Surface::Modelisation::Parallel::CatmullClarkSubdivision");
+
+	typedef typename PFP::MAP MAP;
+	typedef typename EMBV::DATA_TYPE EMB;
+
+	for (unsigned int level = 0; level < nbLevels; ++level)
+	{
+		SubdivisionCells<MAP> cells(map);
+		const unsigned int nbv = uint32(cells.vertices.size());
+		const unsigned int nbe = uint32(cells.edges.size());
+		const unsigned int nbf = uint32(cells.faces.size());
+
+		std::vector<EMB> facePoints(nbf);
+		std::vector<EMB> edgePoints(nbe);
+		std::vector<EMB> vertexPoints(nbv);
+
+		// first phase: compute the points on the unmodified mesh
+		CGoGN::Parallel::foreach_index(map, nbf, [&] (unsigned int i, unsigned int)
+		{
+			EMB center(0.0);
+			unsigned int count = 0 ;
+			Dart it = cells.faces[i];
+			do
+			{
+				center += attributs[it];
+				++count ;
+				it = map.phi1(it) ;
+			} while(it != cells.faces[i]) ;
+			center /= float(count);
+			facePoints[i] = center;
+		}, nbThreads);
+
+		CGoGN::Parallel::foreach_index(map, nbe, [&] (unsigned int i, unsigned int)
+		{
+			Dart d = cells.edges[i];
+			EMB mid = attributs[d];
+			mid += attributs[map.phi1(d)];
+			mid *= 0.5;
+			// E' = (V0+V1+F1+F2)/4, already in the middle of segment on boundary
+			if (!map.isBoundaryEdge(d))
+				mid += (facePoints[cells.faceIndex[d]] + facePoints[cells.faceIndex[map.phi2(d)]]) / 4.0 - (mid / 2.0);
+			edgePoints[i] = mid;
+		}, nbThreads);
+
+		CGoGN::Parallel::foreach_index(map, nbv, [&] (unsigned int i, unsigned int)
+		{
+			EMB sumFace(0.0); // Sum_F
+			EMB sumEdge(0.0); // Sum_E
+
+			int n = 0;
+			Dart v = cells.vertices[i];
+			Dart x = v;
+			do
+			{
+				unsigned int iface = cells.faceIndex[x];
+				if (iface != 0xffffffff)
+					sumFace += facePoints[iface];
+				else // boundary face is not subdivided: its next vertex is used
+					sumFace += attributs[map.phi1(x)];
+				sumEdge += edgePoints[cells.edgeIndex[x]];
+				++n;
+				x = map.phi2_1(x);
+			} while (x != v);
+
+			EMB deltaV = attributs[v] * float(-3*n);	// (-3 * attributs[v]
+			deltaV += sumFace;							// + sumFace/n
+			deltaV += 2.0*sumEdge;						// + sumEdge/n)
+			deltaV /= float(n*n);						// /n
+
+			vertexPoints[i] = attributs[v] + deltaV;
+		}, nbThreads);
+
+		// second phase: topological refinement
+		for (unsigned int i = 0; i < nbe; ++i)
+		{
+			Dart e = map.cutEdge(cells.edges[i]);
+			attributs[e] = edgePoints[i];
+		}
+
+		for (unsigned int i = 0; i < nbf; ++i)
+		{
+			Dart cf = quadranguleFace<PFP>(map, cells.faces[i]);
+			attributs[cf] = facePoints[i];
+		}
+
+		CGoGN::Parallel::foreach_index(map, nbv, [&] (unsigned int i, unsigned int)
+		{
+			attributs[cells.vertices[i]] = vertexPoints[i];
+		}, nbThreads);
+	}
+}
+
+template <typename PFP, typename EMBV>
+void LoopSubdivision(typename PFP::MAP& map, EMBV& attributs, unsigned int nbLevels, unsigned int nbThreads)
+{
+	CGoGN_SCOPED_TIMER("Algo::Surface::Modelisation::Parallel::LoopSubdivision");
+
+	typedef typename PFP::MAP MAP;
+	typedef typename EMBV::DATA_TYPE EMB;
+
+	for (unsigned int level = 0; level < nbLevels; ++level)
+	{
+		SubdivisionCells<MAP> cells(map);
+		const unsigned int nbv = uint32(cells.vertices.size());
+		const unsigned int nbe = uint32(cells.edges.size());
+		const unsigned int nbf = uint32(cells.faces.size());
+
+		std::vector<EMB> edgePoints(nbe);
+		std::vector<EMB> vertexPoints(nbv);
+
+		// first phase: compute the points on the unmodified mesh
+		CGoGN::Parallel::foreach_index(map, nbe, [&] (unsigned int i, unsigned int)
+		{
+			Dart d = cells.edges[i];
+			EMB mid = attributs[d];
+			mid += attributs[map.phi1(d)];
+			mid *= 0.5;
+			// already in the middle of segment on boundary
+			if (!map.isBoundaryEdge(d))
+			{
+				mid *= 0.75;
+				EMB temp = attributs[map.template phi<11>(d)];
+				temp += attributs[map.phi_1(map.phi2(d))];
+				temp *= 1.0 / 8.0;
+				mid += temp;
+			}
+			edgePoints[i] = mid;
+		}, nbThreads);
+
+		CGoGN::Parallel::foreach_index(map, nbv, [&] (unsigned int i, unsigned int)
+		{
+			EMB temp(0.0);
+			int n = 0;
+			Dart v = cells.vertices[i];
+			Dart x = v;
+			do
+			{
+				temp += attributs[map.phi1(x)];
+				++n;
+				x = map.phi2_1(x);
+			} while (x != v);
+			EMB emcp = attributs[v];
+			if (n == 6)
+			{
+				temp /= 16.0;
+				emcp *= 10.0/16.0;
+				emcp += temp;
+			}
+			else
+			{
+				double beta = betaF(n) ;
+				temp *= (beta / double(n));
+				emcp *= (1.0f - beta);
+				emcp += temp;
+			}
+			vertexPoints[i] = emcp;
+		}, nbThreads);
+
+		// second phase: topological refinement
+		for (unsigned int i = 0; i < nbe; ++i)
+		{
+			Dart e = map.cutEdge(cells.edges[i]);
+			attributs[e] = edgePoints[i];
+		}
+
+		// cut the corners of the faces (darts of faces start at an old vertex)
+		for (unsigned int i = 0; i < nbf; ++i)
+		{
+			Dart dd = map.phi1(cells.faces[i]);
+			Dart e = map.template phi<11>(dd) ;
+			map.splitFace(dd, e);
+
+			dd = e;
+			e = map.template phi<11>(dd) ;
+			map.splitFace(dd, e);
+
+			dd = e;
+			e = map.template phi<11>(dd) ;
+			map.splitFace(dd, e);
+		}
+
+		CGoGN::Parallel::foreach_index(map, nbv, [&] (unsigned int i, unsigned int)
+		{
+			attributs[cells.vertices[i]] = vertexPoints[i];
+		}, nbThreads);
+	}
+}
+
+} // namespace Parallel
+
 } // namespace Modelisation
 
 } // namespace Surface
@@ -57,6 +57,173 @@ void swapVectorMax(Geom::Vector<DIM, T>& min, Geom::Vector<DIM, T>& max)
 	}
 }
 
+/*
+  * Tracé de droite discrète 3D du voxel 'a' au voxel 'b' (Bresenham adapté à la 3D, ligne 6-connexe)
+  * f(x, y, z) est appelée pour chaque voxel de la droite
+  */
+template <typename FUNC>
+void rasteriseLine(Geom::Vec3i a, Geom::Vec3i b, FUNC& f)
+{
+	int x, y, z, dx, dy, dz, swap, ddy, ddz, sx, sy, sz;
+
+	if(a==b)
+		f(a[0], a[1], a[2]);
+	else
+	{
+		x = a[0], y = a[1], z = a[2];
+		dx = abs(b[0]-a[0]);
+		dy = abs(b[1]-a[1]);
+		dz = abs(b[2]-a[2]);
+		swap=0;
+
+		if(dy > dx)
+		{
+			if(dy > dz)
+			{
+				std::swap(dx,dy);
+				swap=1;
+			}
+			else
+			{
+				std::swap(dx,dz);
+				swap=2;
+			}
+		}
+		else
+		{
+			if(dx < dz)
+			{
+				std::swap(dx,dz);
+				swap=2;
+			}
+		}
+
+		sx = sign(b[0]-a[0]);
+		sy = sign(b[1]-a[1]);
+		sz = sign(b[2]-a[2]);
+
+		ddy = (dy<<1)-dx;
+		ddz = (dz<<1)-dx;
+		f(x, y, z);
+		for(int i=0; i<dx; ++i)
+		{
+			while(ddy>=0)
+			{
+				ddy -= dx<<1;
+				if(swap==1)
+					x+=sx;
+				else
+					y+=sy;
+			}
+			f(x, y, z); //On affiche les points intermdiaires -> ligne 6-connexe
+			while(ddz>=0)
+			{
+				ddz -= dx<<1;
+				if(swap==2)
+					x+=sx;
+				else
+					z+=sz;
+			}
+			f(x, y, z); //On affiche les points intermdiaires -> ligne 6-connexe
+			ddy += dy<<1;
+			ddz += dz<<1;
+			if(swap==1)
+				y+=sy;
+			else if(swap==2)
+				z+=sz;
+			else
+				x+=sx;
+			f(x, y, z);
+		}
+	}
+}
+
+/*
+  * Remplissage d'un polygone convexe : droites du dernier sommet vers chaque point des arêtes
+  */
+template <typename FUNC>
+void rasterisePolygone(const std::vector<Geom::Vec3i>& polygone, FUNC& f)
+{
+	Geom::Vec3i a, b, c = polygone.back();
+	int x, y, z, dx, dy, dz, swap, ddy, ddz, sx, sy, sz;
+	for(unsigned int i=0; i<polygone.size()-1;++i)
+	{
+		a = polygone[i];
+		b = polygone[i+1];
+
+		if(a==b)
+			rasteriseLine(a, c, f);
+		else
+		{
+			x = a[0], y = a[1], z = a[2];
+			dx = abs(b[0]-a[0]);
+			dy = abs(b[1]-a[1]);
+			dz = abs(b[2]-a[2]);
+			swap=0;
+
+			if(dy > dx)
+			{
+				if(dy > dz)
+				{
+					std::swap(dx,dy);
+					swap=1;
+				}
+				else
+				{
+					std::swap(dx,dz);
+					swap=2;
+				}
+			}
+			else
+			{
+				if(dx < dz)
+				{
+					std::swap(dx,dz);
+					swap=2;
+				}
+			}
+
+			sx = sign(b[0]-a[0]);
+			sy = sign(b[1]-a[1]);
+			sz = sign(b[2]-a[2]);
+
+			ddy = (dy<<1)-dx;
+			ddz = (dz<<1)-dx;
+			rasteriseLine(Geom::Vec3i(x, y, z), c, f);
+			for(int i=0; i<dx; ++i)
+			{
+				while(ddy>=0)
+				{
+					ddy -= dx<<1;
+					if(swap==1)
+						x+=sx;
+					else
+						y+=sy;
+				}
+				rasteriseLine(Geom::Vec3i(x, y, z), c, f);
+				while(ddz>=0)
+				{
+					ddz -= dx<<1;
+					if(swap==2)
+						x+=sx;
+					else
+						z+=sz;
+				}
+				rasteriseLine(Geom::Vec3i(x, y, z), c, f);
+				ddy += dy<<1;
+				ddz += dz<<1;
+				if(swap==1)
+					y+=sy;
+				else if(swap==2)
+					z+=sz;
+				else
+					x+=sx;
+				rasteriseLine(Geom::Vec3i(x, y, z), c, f);
+			}
+		}
+	}
+}
+
 class Voxellisation
 {
    public:
@@ -229,164 +396,17 @@ class Voxellisation
 	  */
 	void voxellisePolygone(std::vector<Geom::Vec3i>& polygone)
 	{
-		Geom::Vec3i a, b, c = polygone.back();
-		int x, y, z, dx, dy, dz, swap, ddy, ddz, sx, sy, sz;
-		for(unsigned int i=0; i<polygone.size()-1;++i)
-		{
-			a = polygone[i];
-			b = polygone[i+1];
-
-			if(a==b)
-				voxelliseLine(a, c);
-			else
-			{
-				x = a[0], y = a[1], z = a[2];
-				dx = abs(b[0]-a[0]);
-				dy = abs(b[1]-a[1]);
-				dz = abs(b[2]-a[2]);
-				swap=0;
-
-				if(dy > dx)
-				{
-					if(dy > dz)
-					{
-						std::swap(dx,dy);
-						swap=1;
-					}
-					else
-					{
-						std::swap(dx,dz);
-						swap=2;
-					}
-				}
-				else
-				{
-					if(dx < dz)
-					{
-						std::swap(dx,dz);
-						swap=2;
-					}
-				}
-
-				sx = sign(b[0]-a[0]);
-				sy = sign(b[1]-a[1]);
-				sz = sign(b[2]-a[2]);
-
-				ddy = (dy<<1)-dx;
-				ddz = (dz<<1)-dx;
-				voxelliseLine(Geom::Vec3i(x, y, z), c);
-				for(int i=0; i<dx; ++i)
-				{
-					while(ddy>=0)
-					{
-						ddy -= dx<<1;
-						if(swap==1)
-							x+=sx;
-						else
-							y+=sy;
-					}
-					voxelliseLine(Geom::Vec3i(x, y, z), c);
-					while(ddz>=0)
-					{
-						ddz -= dx<<1;
-						if(swap==2)
-							x+=sx;
-						else
-							z+=sz;
-					}
-					voxelliseLine(Geom::Vec3i(x, y, z), c);
-					ddy += dy<<1;
-					ddz += dz<<1;
-					if(swap==1)
-						y+=sy;
-					else if(swap==2)
-						z+=sz;
-					else
-						x+=sx;
-					voxelliseLine(Geom::Vec3i(x, y, z), c);
-				}
-			}
-		}
+		auto add = [this] (int x, int y, int z) { addVoxel(x, y, z); };
+		rasterisePolygone(polygone, add);
 	}
 
 	/*
-	  * Fonction qui réalise un trac de droite discrte en 3D du voxel 'a' au voxel 'b'
-	  * L'algorithme utilis est celui de Bresenham, adapt  la 3D
+	  * Fonction qui réalise un tracé de droite discrète en 3D du voxel 'a' au voxel 'b'
 	  */
 	void voxelliseLine(Geom::Vec3i a, Geom::Vec3i b)
 	{
-		int x, y, z, dx, dy, dz, swap, ddy, ddz, sx, sy, sz;
-
-		if(a==b)
-			addVoxel(a);
-		else
-		{
-			x = a[0], y = a[1], z = a[2];
-			dx = abs(b[0]-a[0]);
-			dy = abs(b[1]-a[1]);
-			dz = abs(b[2]-a[2]);
-			swap=0;
-
-			if(dy > dx)
-			{
-				if(dy > dz)
-				{
-					std::swap(dx,dy);
-					swap=1;
-				}
-				else
-				{
-					std::swap(dx,dz);
-					swap=2;
-				}
-			}
-			else
-			{
-				if(dx < dz)
-				{
-					std::swap(dx,dz);
-					swap=2;
-				}
-			}
-
-			sx = sign(b[0]-a[0]);
-			sy = sign(b[1]-a[1]);
-			sz = sign(b[2]-a[2]);
-
-			ddy = (dy<<1)-dx;
-			ddz = (dz<<1)-dx;
-			addVoxel(x, y, z);
-			for(int i=0; i<dx; ++i)
-			{
-				while(ddy>=0)
-				{
-					ddy -= dx<<1;
-					if(swap==1)
-						x+=sx;
-					else
-						y+=sy;
-				}
-				addVoxel(x, y, z); //On affiche les points intermdiaires -> ligne 6-connexe
-				while(ddz>=0)
-				{
-					ddz -= dx<<1;
-					if(swap==2)
-						x+=sx;
-					else
-						z+=sz;
-				}
-				addVoxel(x, y, z); //On affiche les points intermdiaires -> ligne 6-connexe
-				ddy += dy<<1;
-				ddz += dz<<1;
-				if(swap==1)
-					y+=sy;
-				else if(swap==2)
-					z+=sz;
-				else
-					x+=sx;
-				addVoxel(x, y, z);
-			}
-		}
+		auto add = [this] (int x, int y, int z) { addVoxel(x, y, z); };
+		rasteriseLine(a, b, add);
 	}
 
 	/*
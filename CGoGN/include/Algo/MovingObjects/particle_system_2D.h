@@ -0,0 +1,212 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef PARTSYSTEM2D_H
+#define PARTSYSTEM2D_H
+
+#include <vector>
+#include <utility>
+
+#include "Algo/MovingObjects/particle_cell_2D.h"
+#include "Topology/generic/traversor/traversorCell.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace MovingObjects
+{
+
+/**
+ * Batch of particles moving in a planar 2-map.
+ * It follows the same vertex / edge / face state machine as ParticleCell2D,
+ * but the particles are stored in structure of arrays buffers (position,
+ * cell, state, last crossed edge) and the transitions are plain (non virtual)
+ * functions working on a local copy of the particle.
+ *
+ * Each particle only reads the map, so the particles of a move are processed
+ * in parallel on contiguous ranges. The edge crossings found by each thread
+ * are concatenated in thread order: the result does not depend on the number
+ * of threads.
+ *
+ * groupByFace reorders the particles so that those in the same face are
+ * contiguous (stable counting sort on the face of their cell). The slot of a
+ * particle may change, its id (returned by addParticle) does not.
+ */
+template <typename PFP>
+class ParticleSystem2D
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+	typedef VertexAttribute<VEC3, MAP> TAB_POS ;
+
+protected:
+	/**
+	 * local copy of a particle during a move
+	 */
+	struct Particle
+	{
+		VEC3 pos ;
+		Dart d ;
+		unsigned int state ;
+		unsigned int crossCell ;
+		Dart lastCrossed ;
+	} ;
+
+	MAP& m_map ;
+
+	const TAB_POS& m_positions ;
+
+	// particles
+	std::vector<unsigned int> m_id ;
+	std::vector<REAL> m_x, m_y, m_z ;
+	std::vector<Dart> m_cell ;
+	std::vector<unsigned char> m_state ;
+	std::vector<unsigned char> m_crossCell ;
+	std::vector<Dart> m_lastCrossed ;
+
+	// face index of each dart (indexed by dart index), used for grouping
+	std::vector<unsigned int> m_faceOfDart ;
+	unsigned int m_nbFaces ;
+
+	// cell changes of the last move (slot, new cell), per thread then merged
+	std::vector< std::vector< std::pair<unsigned int, Dart> > > m_threadCrossings ;
+	std::vector< std::pair<unsigned int, Dart> > m_crossings ;
+
+	unsigned int m_nbThreads ;
+
+	void load(unsigned int i, Particle& p) const ;
+
+	void store(unsigned int i, const Particle& p) ;
+
+	Geom::Orientation2D getOrientationEdge(const VEC3& point, Dart d) const ;
+
+	Geom::Orientation2D getOrientationFace(const Particle& p, const VEC3& goal, Dart d) const ;
+
+	VEC3 intersectLineEdge(const VEC3& pA, const VEC3& pB, Dart d) const ;
+
+	void vertexState(Particle& p, const VEC3& goal) const ;
+
+	void edgeState(Particle& p, const VEC3& goal, Geom::Orientation2D sideOfEdge = Geom::ALIGNED) const ;
+
+	void faceState(Particle& p, const VEC3& goal) const ;
+
+	void moveParticle(Particle& p, const VEC3& goal) const ;
+
+	unsigned int faceOfSlot(unsigned int i) const ;
+
+	template <typename FUNC>
+	void moveRange(unsigned int begin, unsigned int end, unsigned int thread, FUNC& goal) ;
+
+public:
+	/**
+	 * @param map the (planar) map
+	 * @param positions vertex positions (only x and y are used for orientation tests)
+	 * @param nbth number of threads used by move
+	 */
+	ParticleSystem2D(MAP& map, const TAB_POS& positions, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+	/**
+	 * add a particle in the face of dart d (state FACE)
+	 * @return the id of the particle
+	 */
+	unsigned int addParticle(Dart d, const VEC3& pos) ;
+
+	void clear() ;
+
+	void reserve(unsigned int nb) ;
+
+	unsigned int size() const { return (unsigned int)(m_id.size()) ; }
+
+	void setNbThreads(unsigned int nbth) { m_nbThreads = nbth ; }
+
+	/**
+	 * accessors by slot
+	 */
+	unsigned int getId(unsigned int i) const { return m_id[i] ; }
+
+	VEC3 getPosition(unsigned int i) const { return VEC3(m_x[i], m_y[i], m_z[i]) ; }
+
+	Dart getCell(unsigned int i) const { return m_cell[i] ; }
+
+	unsigned int getState(unsigned int i) const { return m_state[i] ; }
+
+	unsigned int getCrossCell(unsigned int i) const { return m_crossCell[i] ; }
+
+	Dart getLastCrossed(unsigned int i) const { return m_lastCrossed[i] ; }
+
+	/**
+	 * move all particles toward their goal
+	 * @param goals goal of each particle, indexed by slot
+	 */
+	void move(const std::vector<VEC3>& goals) ;
+
+	/**
+	 * move all particles, the goal of a particle is given by goal(slot, position)
+	 * goal is called concurrently
+	 */
+	template <typename FUNC>
+	void advect(FUNC goal) ;
+
+	/**
+	 * particles that left their cell during the last move, as (slot, new cell) sorted by slot
+	 */
+	const std::vector< std::pair<unsigned int, Dart> >& getCrossings() const { return m_crossings ; }
+
+	/**
+	 * compute the face index of the darts (to call when the map has changed)
+	 */
+	void updateFaces() ;
+
+	/**
+	 * reorder the particles so that those of a same face are contiguous
+	 */
+	void groupByFace() ;
+
+	/**
+	 * after groupByFace, the particles of face f are in slots faceStart[f] .. faceStart[f+1][
+	 * (particles in a boundary or unknown face come last)
+	 */
+	void getFaceRanges(std::vector<unsigned int>& faceStart) const ;
+} ;
+
+} // namespace MovingObjects
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/MovingObjects/particle_system_2D.hpp"
+
+#endif
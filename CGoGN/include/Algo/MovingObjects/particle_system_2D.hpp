@@ -0,0 +1,519 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace MovingObjects
+{
+
+template <typename PFP>
+ParticleSystem2D<PFP>::ParticleSystem2D(MAP& map, const TAB_POS& positions, unsigned int nbth) :
+	m_map(map),
+	m_positions(positions),
+	m_nbFaces(0),
+	m_nbThreads(nbth)
+{
+	updateFaces() ;
+}
+
+template <typename PFP>
+unsigned int ParticleSystem2D<PFP>::addParticle(Dart d, const VEC3& pos)
+{
+	unsigned int id = (unsigned int)(m_id.size()) ;
+	m_id.push_back(id) ;
+	m_x.push_back(pos[0]) ;
+	m_y.push_back(pos[1]) ;
+	m_z.push_back(pos[2]) ;
+	m_cell.push_back(d) ;
+	m_state.push_back(FACE) ;
+	m_crossCell.push_back(NO_CROSS) ;
+	m_lastCrossed.push_back(d) ;
+	return id ;
+}
+
+template <typename PFP>
+void ParticleSystem2D<PFP>::clear()
+{
+	m_id.clear() ;
+	m_x.clear() ; m_y.clear() ; m_z.clear() ;
+	m_cell.clear() ;
+	m_state.clear() ;
+	m_crossCell.clear() ;
+	m_lastCrossed.clear() ;
+	m_crossings.clear() ;
+}
+
+template <typename PFP>
+void ParticleSystem2D<PFP>::reserve(unsigned int nb)
+{
+	m_id.reserve(nb) ;
+	m_x.reserve(nb) ; m_y.reserve(nb) ; m_z.reserve(nb) ;
+	m_cell.reserve(nb) ;
+	m_state.reserve(nb) ;
+	m_crossCell.reserve(nb) ;
+	m_lastCrossed.reserve(nb) ;
+}
+
+template <typename PFP>
+inline void ParticleSystem2D<PFP>::load(unsigned int i, Particle& p) const
+{
+	p.pos = VEC3(m_x[i], m_y[i], m_z[i]) ;
+	p.d = m_cell[i] ;
+	p.state = m_state[i] ;
+	p.crossCell = m_crossCell[i] ;
+	p.lastCrossed = m_lastCrossed[i] ;
+}
+
+template <typename PFP>
+inline void ParticleSystem2D<PFP>::store(unsigned int i, const Particle& p)
+{
+	m_x[i] = p.pos[0] ;
+	m_y[i] = p.pos[1] ;
+	m_z[i] = p.pos[2] ;
+	m_cell[i] = p.d ;
+	m_state[i] = (unsigned char)(p.state) ;
+	m_crossCell[i] = (unsigned char)(p.crossCell) ;
+	m_lastCrossed[i] = p.lastCrossed ;
+}
+
+template <typename PFP>
+inline Geom::Orientation2D ParticleSystem2D<PFP>::getOrientationEdge(const VEC3& point, Dart d) const
+{
+	return Geom::testOrientation2D(point, m_positions[d], m_positions[m_map.phi2(d)]) ;
+}
+
+template <typename PFP>
+inline Geom::Orientation2D ParticleSystem2D<PFP>::getOrientationFace(const Particle& p, const VEC3& goal, Dart d) const
+{
+	return Geom::testOrientation2D(goal, p.pos, m_positions[d]) ;
+}
+
+template <typename PFP>
+inline typename PFP::VEC3 ParticleSystem2D<PFP>::intersectLineEdge(const VEC3& pA, const VEC3& pB, Dart d) const
+{
+	VEC3 Inter ;
+	Geom::intersection2DSegmentSegment(pA, pB, m_positions[d], m_positions[m_map.phi2(d)], Inter) ;
+	return Inter ;
+}
+
+template <typename PFP>
+void ParticleSystem2D<PFP>::vertexState(Particle& p, const VEC3& goal) const
+{
+	assert(Geom::isFinite(goal)) ;
+
+	MAP& m = m_map ;
+	const TAB_POS& pos = m_positions ;
+	Dart& d = p.d ;
+
+	p.crossCell = CROSS_OTHER ;
+
+	if (Geometry::isPointOnVertex<PFP>(m, d, pos, goal))
+	{
+		p.state = VERTEX ;
+		p.pos = goal ;
+		return ;
+	}
+
+	//orientation step
+	if (pos[d][0] == pos[m.phi1(d)][0] && pos[d][1] == pos[m.phi1(d)][1])
+		d = m.phi2_1(d) ;
+	if (getOrientationEdge(goal, m.phi2_1(d)) != Geom::RIGHT)
+	{
+		Dart dd_vert = d ;
+		do
+		{
+			d = m.phi2_1(d) ;
+			if (pos[d][0] == pos[m.phi1(d)][0] && pos[d][1] == pos[m.phi1(d)][1])
+				d = m.phi2_1(d) ;
+		} while (getOrientationEdge(goal, m.phi2_1(d)) != Geom::RIGHT && dd_vert != d) ;
+
+		if (dd_vert == d)
+		{
+			//orbit with 2 edges : point on one edge
+			if (m.phi2_1(m.phi2_1(d)) == d)
+			{
+				if (!Geometry::isPointOnHalfEdge<PFP>(m, d, pos, goal))
+					d = m.phi2_1(d) ;
+			}
+			else
+			{
+				//checking : case with 3 orthogonal darts and point on an edge
+				do
+				{
+					if (Geometry::isPointOnHalfEdge<PFP>(m, d, pos, goal) && Geometry::isPointOnHalfEdge<PFP>(m, m.phi2(d), pos, goal))
+					{
+						edgeState(p, goal) ;
+						return ;
+					}
+					d = m.phi2_1(d) ;
+				} while (getOrientationEdge(goal, m.phi2_1(d)) != Geom::RIGHT && dd_vert != d) ;
+
+				p.state = VERTEX ;
+				p.pos = goal ;
+				return ;
+			}
+		}
+	}
+	else
+	{
+		Dart dd_vert = m.phi2_1(d) ;
+		while (getOrientationEdge(goal, d) == Geom::RIGHT && dd_vert != d)
+		{
+			d = m.phi12(d) ;
+			if (pos[d][0] == pos[m.phi1(d)][0] && pos[d][1] == pos[m.phi1(d)][1])
+				d = m.phi12(d) ;
+		}
+	}
+
+	//displacement step
+	if (getOrientationEdge(goal, d) == Geom::ALIGNED && Geometry::isPointOnHalfEdge<PFP>(m, d, pos, goal))
+		edgeState(p, goal) ;
+	else
+	{
+		d = m.phi1(d) ;
+		faceState(p, goal) ;
+	}
+}
+
+template <typename PFP>
+void ParticleSystem2D<PFP>::edgeState(Particle& p, const VEC3& goal, Geom::Orientation2D sideOfEdge) const
+{
+	assert(Geom::isFinite(goal)) ;
+
+	MAP& m = m_map ;
+	Dart& d = p.d ;
+
+	if (p.crossCell == NO_CROSS)
+	{
+		p.crossCell = CROSS_EDGE ;
+		p.lastCrossed = d ;
+	}
+	else
+		p.crossCell = CROSS_OTHER ;
+
+	if (sideOfEdge == Geom::ALIGNED)
+		sideOfEdge = getOrientationEdge(goal, d) ;
+
+	switch (sideOfEdge)
+	{
+		case Geom::LEFT :
+			d = m.phi1(d) ;
+			faceState(p, goal) ;
+			return ;
+		case Geom::RIGHT :
+			d = m.phi1(m.phi2(d)) ;
+			faceState(p, goal) ;
+			return ;
+		default :
+			p.state = EDGE ;
+			break ;
+	}
+
+	if (!Geometry::isPointOnHalfEdge<PFP>(m, d, m_positions, goal))
+	{
+		p.pos = m_positions[d] ;
+		vertexState(p, goal) ;
+		return ;
+	}
+	else if (!Geometry::isPointOnHalfEdge<PFP>(m, m.phi2(d), m_positions, goal))
+	{
+		d = m.phi2(d) ;
+		p.pos = m_positions[d] ;
+		vertexState(p, goal) ;
+		return ;
+	}
+
+	p.pos = goal ;
+}
+
+template <typename PFP>
+void ParticleSystem2D<PFP>::faceState(Particle& p, const VEC3& goal) const
+{
+	assert(Geom::isFinite(p.pos)) ;
+	assert(Geom::isFinite(goal)) ;
+
+	MAP& m = m_map ;
+	Dart& d = p.d ;
+
+	Dart dd = d ;
+	Geom::Orientation2D wsoe = getOrientationFace(p, goal, m.phi1(d)) ;
+
+	// orientation step
+	if (wsoe != Geom::RIGHT)
+	{
+		d = m.phi1(d) ;
+		wsoe = getOrientationFace(p, goal, m.phi1(d)) ;
+		while (wsoe != Geom::RIGHT && dd != d)
+		{
+			d = m.phi1(d) ;
+			wsoe = getOrientationFace(p, goal, m.phi1(d)) ;
+		}
+
+		// source and position to reach are the same : verify if no edge is crossed due to numerical approximation
+		if (dd == d)
+		{
+			do
+			{
+				switch (getOrientationEdge(goal, d))
+				{
+					case Geom::LEFT :
+						d = m.phi1(d) ;
+						break ;
+					case Geom::ALIGNED :
+						p.pos = goal ;
+						edgeState(p, goal) ;
+						return ;
+					case Geom::RIGHT :
+						p.pos = intersectLineEdge(goal, p.pos, d) ;
+						edgeState(p, goal, Geom::RIGHT) ;
+						return ;
+				}
+			} while (d != dd) ;
+			p.pos = goal ;
+			p.state = FACE ;
+			return ;
+		}
+		// take the orientation with d1 : in case we are going through a vertex
+		wsoe = getOrientationFace(p, goal, d) ;
+	}
+	else
+	{
+		wsoe = getOrientationFace(p, goal, d) ;
+		while (wsoe == Geom::RIGHT && m.phi_1(d) != dd)
+		{
+			d = m.phi_1(d) ;
+			wsoe = getOrientationFace(p, goal, d) ;
+		}
+
+		// in case of numerical incoherence
+		if (m.phi_1(d) == dd && wsoe == Geom::RIGHT)
+		{
+			d = m.phi_1(d) ;
+			do
+			{
+				switch (getOrientationEdge(goal, d))
+				{
+					case Geom::LEFT :
+						d = m.phi1(d) ;
+						break ;
+					case Geom::ALIGNED :
+						p.pos = goal ;
+						edgeState(p, goal) ;
+						return ;
+					case Geom::RIGHT :
+						p.pos = intersectLineEdge(goal, p.pos, d) ;
+						edgeState(p, goal, Geom::RIGHT) ;
+						return ;
+				}
+			} while (d != dd) ;
+
+			p.pos = goal ;
+			p.state = FACE ;
+			return ;
+		}
+	}
+
+	//displacement step
+	switch (getOrientationEdge(goal, d))
+	{
+		case Geom::LEFT :
+			p.pos = goal ;
+			p.state = FACE ;
+			break ;
+		default :
+			if (wsoe == Geom::ALIGNED)
+			{
+				d = m.phi1(d) ;
+				p.pos = m_positions[d] ;
+				vertexState(p, goal) ;
+			}
+			else
+			{
+				p.pos = intersectLineEdge(goal, p.pos, d) ;
+				edgeState(p, goal, Geom::RIGHT) ;
+			}
+			break ;
+	}
+}
+
+template <typename PFP>
+inline void ParticleSystem2D<PFP>::moveParticle(Particle& p, const VEC3& goal) const
+{
+	p.crossCell = NO_CROSS ;
+	if (!Geom::arePointsEquals(goal, p.pos))
+	{
+		switch (p.state)
+		{
+			case VERTEX :
+				vertexState(p, goal) ;
+				break ;
+			case EDGE :
+				edgeState(p, goal) ;
+				break ;
+			case FACE :
+				faceState(p, goal) ;
+				break ;
+		}
+	}
+	else
+		p.pos = goal ;
+}
+
+template <typename PFP>
+template <typename FUNC>
+void ParticleSystem2D<PFP>::moveRange(unsigned int begin, unsigned int end, unsigned int thread, FUNC& goal)
+{
+	std::vector< std::pair<unsigned int, Dart> >& crossings = m_threadCrossings[thread] ;
+	crossings.clear() ;
+
+	Particle p ;
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		load(i, p) ;
+		moveParticle(p, goal(i, p.pos)) ;
+		store(i, p) ;
+		if (p.crossCell != NO_CROSS)
+			crossings.push_back(std::make_pair(i, p.d)) ;
+	}
+}
+
+template <typename PFP>
+template <typename FUNC>
+void ParticleSystem2D<PFP>::advect(FUNC goal)
+{
+	unsigned int n = size() ;
+	unsigned int nbth = m_nbThreads ;
+	if (nbth > n)
+		nbth = n ;
+	if (nbth < 1)
+		nbth = 1 ;
+
+	m_threadCrossings.resize(nbth) ;
+
+	if (nbth == 1)
+		moveRange(0, n, 0, goal) ;
+	else
+	{
+		CGoGN::Parallel::foreach_index(m_map, nbth, [&] (unsigned int i, unsigned int)
+		{
+			moveRange((unsigned long long)(n) * i / nbth, (unsigned long long)(n) * (i + 1) / nbth, i, goal) ;
+		}, nbth) ;
+	}
+
+	// merge in thread order (threads have contiguous increasing ranges)
+	m_crossings.clear() ;
+	for (unsigned int t = 0; t < nbth; ++t)
+		m_crossings.insert(m_crossings.end(), m_threadCrossings[t].begin(), m_threadCrossings[t].end()) ;
+}
+
+template <typename PFP>
+void ParticleSystem2D<PFP>::move(const std::vector<VEC3>& goals)
+{
+	assert(goals.size() >= m_id.size()) ;
+	advect([&] (unsigned int i, const VEC3&) -> const VEC3& { return goals[i] ; }) ;
+}
+
+template <typename PFP>
+void ParticleSystem2D<PFP>::updateFaces()
+{
+	m_faceOfDart.assign(m_map.getDartContainer().realEnd(), 0xffffffff) ;
+	m_nbFaces = 0 ;
+	foreach_cell<FACE>(m_map, [&] (Face f)
+	{
+		m_map.foreach_dart_of_orbit(f, [&] (Dart d) { m_faceOfDart[d.index] = m_nbFaces ; }) ;
+		++m_nbFaces ;
+	}) ;
+}
+
+template <typename PFP>
+inline unsigned int ParticleSystem2D<PFP>::faceOfSlot(unsigned int i) const
+{
+	unsigned int index = m_cell[i].index ;
+	if (index < m_faceOfDart.size() && m_faceOfDart[index] < m_nbFaces)
+		return m_faceOfDart[index] ;
+	return m_nbFaces ;
+}
+
+template <typename PFP>
+void ParticleSystem2D<PFP>::getFaceRanges(std::vector<unsigned int>& faceStart) const
+{
+	unsigned int n = size() ;
+	faceStart.assign(m_nbFaces + 2, 0) ;
+	for (unsigned int i = 0; i < n; ++i)
+		++faceStart[faceOfSlot(i) + 1] ;
+	for (unsigned int f = 0; f <= m_nbFaces; ++f)
+		faceStart[f + 1] += faceStart[f] ;
+}
+
+template <typename PFP>
+void ParticleSystem2D<PFP>::groupByFace()
+{
+	unsigned int n = size() ;
+
+	// stable counting sort on the face of the cell of the particles
+	std::vector<unsigned int> next ;
+	getFaceRanges(next) ;
+	std::vector<unsigned int> perm(n) ;
+	for (unsigned int i = 0; i < n; ++i)
+		perm[next[faceOfSlot(i)]++] = i ;
+
+	std::vector<unsigned int> id(n) ;
+	std::vector<REAL> x(n), y(n), z(n) ;
+	std::vector<Dart> cell(n), lastCrossed(n) ;
+	std::vector<unsigned char> state(n), crossCell(n) ;
+	for (unsigned int j = 0; j < n; ++j)
+	{
+		unsigned int i = perm[j] ;
+		id[j] = m_id[i] ;
+		x[j] = m_x[i] ; y[j] = m_y[i] ; z[j] = m_z[i] ;
+		cell[j] = m_cell[i] ;
+		lastCrossed[j] = m_lastCrossed[i] ;
+		state[j] = m_state[i] ;
+		crossCell[j] = m_crossCell[i] ;
+	}
+	m_id.swap(id) ;
+	m_x.swap(x) ; m_y.swap(y) ; m_z.swap(z) ;
+	m_cell.swap(cell) ;
+	m_lastCrossed.swap(lastCrossed) ;
+	m_state.swap(state) ;
+	m_crossCell.swap(crossCell) ;
+
+	// slots have changed
+	m_crossings.clear() ;
+}
+
+} // namespace MovingObjects
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -130,31 +130,28 @@ public:
 } ;
 
 template <typename PFP>
-class CCEdgeSynthesisFilter : public Algo::MR::Filter
+class CCEdgeSynthesisFilter : public Algo::MR::LiftingFilter<typename PFP::MAP, EDGE, typename PFP::VEC3>
 {
 	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
+	typedef Algo::MR::LiftingFilter<MAP, EDGE, VEC3> PARENT;
 
 protected:
-	MAP& m_map ;
 	VertexAttribute<VEC3, MAP>& m_position ;
 
-public:
-	CCEdgeSynthesisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : m_map(m), m_position(p)
-	{}
-
-	void operator() ()
+	void pass(unsigned int p, Dart d, VEC3& value)
 	{
-		TraversorE<MAP> trav(m_map) ;
-		for (Dart d = trav.begin(); d != trav.end(); d = trav.next())
-		{
-			VEC3 ei =  (m_position[d] + m_position[m_map.phi1(d)]) * typename PFP::REAL(0.5);
+		if(p == 0)
+			value = (m_position[d] + m_position[this->m_map.phi1(d)]) * typename PFP::REAL(0.5) ;
+		else
+			m_position[this->m_map.phi1(d)] += value ;
+	}
 
-			m_map.incCurrentLevel() ;
-			Dart midV = m_map.phi1(d) ;
-			m_position[midV] += ei ;
-			m_map.decCurrentLevel() ;
-		}
+public:
+	CCEdgeSynthesisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : PARENT(m), m_position(p)
+	{
+		this->addPass(0, PARENT::READ_PASS) ;
+		this->addPass(1, PARENT::WRITE_PASS) ;
 	}
 } ;
 
@@ -265,131 +262,126 @@ public:
 } ;
 
 template <typename PFP>
-class CCScalingSynthesisFilter : public Algo::MR::Filter
+class CCScalingSynthesisFilter : public Algo::MR::LiftingFilter<typename PFP::MAP, EDGE, typename PFP::VEC3>
 {
 	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
+	typedef Algo::MR::LiftingFilter<MAP, EDGE, VEC3> PARENT;
 
 protected:
-	MAP& m_map ;
 	VertexAttribute<VEC3, MAP>& m_position ;
 
-public:
-	CCScalingSynthesisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : m_map(m), m_position(p)
-	{}
-
-	void operator() ()
+	void pass(unsigned int /*p*/, Dart d, VEC3& /*value*/)
 	{
-		TraversorE<MAP> trav(m_map) ;
-		for (Dart d = trav.begin(); d != trav.end(); d = trav.next())
-		{
-			m_map.incCurrentLevel() ;
+		MAP& map = this->m_map ;
 
-			VEC3 ei = m_position[m_map.phi1(d)];
+		VEC3 ei = m_position[map.phi1(d)];
 
-			VEC3 f = m_position[m_map.phi2(m_map.phi1(d))];
-			f += m_position[m_map.phi_1(m_map.phi2(d))];
-			f *= 1.0 / 2.0;
+		VEC3 f = m_position[map.phi2(map.phi1(d))];
+		f += m_position[map.phi_1(map.phi2(d))];
+		f *= 1.0 / 2.0;
 
-			ei += f;
-			ei *= 1.0 / 2.0;
+		ei += f;
+		ei *= 1.0 / 2.0;
 
-			m_position[m_map.phi1(d)] = ei;
-			m_map.decCurrentLevel() ;
-		}
+		m_position[map.phi1(d)] = ei;
+	}
+
+public:
+	CCScalingSynthesisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : PARENT(m), m_position(p)
+	{
+		this->addPass(1, PARENT::WRITE_PASS) ;
 	}
 } ;
 
 template <typename PFP>
-class CCScalingAnalysisFilter : public Algo::MR::Filter
+class CCScalingAnalysisFilter : public Algo::MR::LiftingFilter<typename PFP::MAP, EDGE, typename PFP::VEC3>
 {
 	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
+	typedef Algo::MR::LiftingFilter<MAP, EDGE, VEC3> PARENT;
 
 protected:
-	MAP& m_map ;
 	VertexAttribute<VEC3, MAP>& m_position ;
 
-public:
-	CCScalingAnalysisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : m_map(m), m_position(p)
-	{}
-
-	void operator() ()
+	void pass(unsigned int /*p*/, Dart d, VEC3& /*value*/)
 	{
-		TraversorE<MAP> trav(m_map) ;
-		for (Dart d = trav.begin(); d != trav.end(); d = trav.next())
-		{
-			m_map.incCurrentLevel() ;
+		MAP& map = this->m_map ;
 
-			VEC3 ei = m_position[m_map.phi1(d)];
+		VEC3 ei = m_position[map.phi1(d)];
 
-			VEC3 f = m_position[m_map.phi2(m_map.phi1(d))];
-			f += m_position[m_map.phi_1(m_map.phi2(d))];
-			f *= 1.0 / 2.0;
+		VEC3 f = m_position[map.phi2(map.phi1(d))];
+		f += m_position[map.phi_1(map.phi2(d))];
+		f *= 1.0 / 2.0;
 
-			ei *= 2.0;
-			ei -= f;
+		ei *= 2.0;
+		ei -= f;
 
-			m_position[m_map.phi1(d)] = ei;
-			m_map.decCurrentLevel() ;
-		}
+		m_position[map.phi1(d)] = ei;
+	}
+
+public:
+	CCScalingAnalysisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : PARENT(m), m_position(p)
+	{
+		this->addPass(1, PARENT::WRITE_PASS) ;
 	}
 } ;
 
 template <typename PFP>
-class CCVertexAnalysisFilter : public Algo::MR::Filter
+class CCVertexAnalysisFilter : public Algo::MR::LiftingFilter<typename PFP::MAP, VERTEX, typename PFP::VEC3>
 {
 	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
+	typedef Algo::MR::LiftingFilter<MAP, VERTEX, VEC3> PARENT;
 
 protected:
-	MAP& m_map ;
 	VertexAttribute<VEC3, MAP>& m_position ;
 
-public:
-	CCVertexAnalysisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : m_map(m), m_position(p)
-	{}
-
-	void operator() ()
+	void pass(unsigned int p, Dart d, VEC3& value)
 	{
-		TraversorV<MAP> trav(m_map) ;
-		for (Dart d = trav.begin(); d != trav.end(); d = trav.next())
+		MAP& map = this->m_map ;
+
+		if(p == 1)
 		{
-			m_map.incCurrentLevel() ;
-			VEC3 np1(0) ;
-			VEC3 np2(0) ;
-			unsigned int degree1 = 0 ;
-			unsigned int degree2 = 0 ;
-			Dart it = d ;
+			m_position[d] = value ;
+			return ;
+		}
+
+		VEC3 np1(0) ;
+		VEC3 np2(0) ;
+		unsigned int degree1 = 0 ;
+		unsigned int degree2 = 0 ;
+		Dart it = d ;
+		do
+		{
+			++degree1 ;
+			Dart dd = map.phi1(it) ;
+			np1 += m_position[dd] ;
+			Dart end = map.phi_1(it) ;
+			dd = map.phi1(dd) ;
 			do
 			{
-				++degree1 ;
-				Dart dd = m_map.phi1(it) ;
-				np1 += m_position[dd] ;
-				Dart end = m_map.phi_1(it) ;
-				dd = m_map.phi1(dd) ;
-				do
-				{
-					++degree2 ;
-					np2 += m_position[dd] ;
-					dd = m_map.phi1(dd) ;
-				} while(dd != end) ;
-				it = m_map.alpha1(it) ;
-			} while(it != d) ;
-
-			float beta = 3.0 / (2.0 * degree1) ;
-			float gamma = 1.0 / (4.0 * degree2) ;
-			np1 *= beta / degree1 ;
-			np2 *= gamma / degree2 ;
-
-			VEC3 vd = m_position[d] ;
-
-			m_map.decCurrentLevel() ;
-
-			m_position[d] = vd - np1 - np2;
-			m_position[d] /= 1.0 - beta - gamma ;
+				++degree2 ;
+				np2 += m_position[dd] ;
+				dd = map.phi1(dd) ;
+			} while(dd != end) ;
+			it = map.alpha1(it) ;
+		} while(it != d) ;
+
+		float beta = 3.0 / (2.0 * degree1) ;
+		float gamma = 1.0 / (4.0 * degree2) ;
+		np1 *= beta / degree1 ;
+		np2 *= gamma / degree2 ;
+
+		value = m_position[d] - np1 - np2 ;
+		value /= 1.0 - beta - gamma ;
+	}
 
-		}
+public:
+	CCVertexAnalysisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : PARENT(m), m_position(p)
+	{
+		this->addPass(1, PARENT::READ_PASS) ;
+		this->addPass(0, PARENT::WRITE_PASS) ;
 	}
 } ;
 
@@ -445,31 +437,28 @@ public:
 } ;
 
 template <typename PFP>
-class CCEdgeAnalysisFilter : public Algo::MR::Filter
+class CCEdgeAnalysisFilter : public Algo::MR::LiftingFilter<typename PFP::MAP, EDGE, typename PFP::VEC3>
 {
 	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
+	typedef Algo::MR::LiftingFilter<MAP, EDGE, VEC3> PARENT;
 
 protected:
-	MAP& m_map ;
 	VertexAttribute<VEC3, MAP>& m_position ;
 
-public:
-	CCEdgeAnalysisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : m_map(m), m_position(p)
-	{}
-
-	void operator() ()
+	void pass(unsigned int p, Dart d, VEC3& value)
 	{
-		TraversorE<MAP> trav(m_map) ;
-		for (Dart d = trav.begin(); d != trav.end(); d = trav.next())
-		{
-			VEC3 ei =  (m_position[d] + m_position[m_map.phi1(d)]) * typename PFP::REAL(0.5);
+		if(p == 0)
+			value = (m_position[d] + m_position[this->m_map.phi1(d)]) * typename PFP::REAL(0.5) ;
+		else
+			m_position[this->m_map.phi1(d)] -= value ;
+	}
 
-			m_map.incCurrentLevel() ;
-			Dart midV = m_map.phi1(d) ;
-			m_position[midV] -= ei ;
-			m_map.decCurrentLevel() ;
-		}
+public:
+	CCEdgeAnalysisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : PARENT(m), m_position(p)
+	{
+		this->addPass(0, PARENT::READ_PASS) ;
+		this->addPass(1, PARENT::WRITE_PASS) ;
 	}
 } ;
 
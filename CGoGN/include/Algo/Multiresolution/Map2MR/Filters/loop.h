@@ -74,14 +74,15 @@ typename PFP::VEC3 loopOddVertex(
 	return p1 + p2 + p3 + p4 ;
 }
 
+/**
+ * even vertex mask, the map being at the level of the odd vertices
+ */
 template <typename PFP>
-typename PFP::VEC3 loopEvenVertex(
+typename PFP::VEC3 loopEvenVertexFine(
 	typename PFP::MAP& map,
 	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
 	Dart d)
 {
-	map.incCurrentLevel() ;
-
 	typename PFP::VEC3 np(0) ;
 	unsigned int degree = 0 ;
 	Traversor2VVaE<typename PFP::MAP> trav(map, d) ;
@@ -91,8 +92,6 @@ typename PFP::VEC3 loopEvenVertex(
 		np += position[it] ;
 	}
 
-	map.decCurrentLevel() ;
-
 	float mu = 3.0/8.0 + 1.0/4.0 * cos(2.0 * M_PI / degree) ;
 	mu = (5.0/8.0 - (mu * mu)) / degree ;
 	np *= 8.0/5.0 * mu ;
@@ -100,91 +99,102 @@ typename PFP::VEC3 loopEvenVertex(
 	return np ;
 }
 
+template <typename PFP>
+typename PFP::VEC3 loopEvenVertex(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	Dart d)
+{
+	map.incCurrentLevel() ;
+	typename PFP::VEC3 np = loopEvenVertexFine<PFP>(map, position, d) ;
+	map.decCurrentLevel() ;
+
+	return np ;
+}
+
+template <typename PFP>
+float loopNormalisation(typename PFP::MAP& map, Dart d)
+{
+	unsigned int degree = map.vertexDegree(d) ;
+	float n = 3.0/8.0 + 1.0/4.0 * cos(2.0 * M_PI / degree) ;
+	return 8.0/5.0 * (n * n) ;
+}
+
 /*********************************************************************************
  *                           ANALYSIS FILTERS
  *********************************************************************************/
 
 template <typename PFP>
-class LoopOddAnalysisFilter : public Algo::MR::Filter
+class LoopOddAnalysisFilter : public Algo::MR::LiftingFilter<typename PFP::MAP, EDGE, typename PFP::VEC3>
 {
 	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
+	typedef Algo::MR::LiftingFilter<MAP, EDGE, VEC3> PARENT;
 
 protected:
-	MAP& m_map ;
 	VertexAttribute<VEC3, MAP>& m_position ;
 
-public:
-	LoopOddAnalysisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : m_map(m), m_position(p)
-	{}
-
-	void operator() ()
+	void pass(unsigned int p, Dart d, VEC3& value)
 	{
-		TraversorE<MAP> trav(m_map) ;
-		for (Dart d = trav.begin(); d != trav.end(); d = trav.next())
-		{
-			VEC3 p = loopOddVertex<PFP>(m_map, m_position, d) ;
-
-			m_map.incCurrentLevel() ;
-
-			Dart oddV = m_map.phi2(d) ;
-			m_position[oddV] -= p ;
+		if(p == 0)
+			value = loopOddVertex<PFP>(this->m_map, m_position, d) ;
+		else
+			m_position[this->m_map.phi2(d)] -= value ;
+	}
 
-			m_map.decCurrentLevel() ;
-		}
+public:
+	LoopOddAnalysisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : PARENT(m), m_position(p)
+	{
+		this->addPass(0, PARENT::READ_PASS) ;
+		this->addPass(1, PARENT::WRITE_PASS) ;
 	}
 } ;
 
 template <typename PFP>
-class LoopEvenAnalysisFilter : public Algo::MR::Filter
+class LoopEvenAnalysisFilter : public Algo::MR::LiftingFilter<typename PFP::MAP, VERTEX, typename PFP::VEC3>
 {
 	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
+	typedef Algo::MR::LiftingFilter<MAP, VERTEX, VEC3> PARENT;
 
 protected:
-	MAP& m_map ;
 	VertexAttribute<VEC3, MAP>& m_position;
 
-public:
-	LoopEvenAnalysisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : m_map(m), m_position(p)
-	{}
+	void pass(unsigned int p, Dart d, VEC3& value)
+	{
+		if(p == 0)
+			value = loopEvenVertexFine<PFP>(this->m_map, m_position, d) ;
+		else
+			m_position[d] -= value ;
+	}
 
-	void operator() ()
+public:
+	LoopEvenAnalysisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : PARENT(m), m_position(p)
 	{
-		TraversorV<MAP> trav(m_map) ;
-		for (Dart d = trav.begin(); d != trav.end(); d = trav.next())
-		{
-			VEC3 p = loopEvenVertex<PFP>(m_map, m_position, d) ;
-			m_position[d] -= p ;
-		}
+		this->addPass(1, PARENT::READ_PASS) ;
+		this->addPass(0, PARENT::WRITE_PASS) ;
 	}
 } ;
 
 template <typename PFP>
-class LoopNormalisationAnalysisFilter : public Algo::MR::Filter
+class LoopNormalisationAnalysisFilter : public Algo::MR::LiftingFilter<typename PFP::MAP, VERTEX, typename PFP::VEC3>
 {
 	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
+	typedef Algo::MR::LiftingFilter<MAP, VERTEX, VEC3> PARENT;
 
 protected:
-	MAP& m_map ;
 	VertexAttribute<VEC3, MAP>& m_position;
 
-public:
-	LoopNormalisationAnalysisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : m_map(m), m_position(p)
-	{}
+	void pass(unsigned int /*p*/, Dart d, VEC3& /*value*/)
+	{
+		m_position[d] /= loopNormalisation<PFP>(this->m_map, d) ;
+	}
 
-	void operator() ()
+public:
+	LoopNormalisationAnalysisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : PARENT(m), m_position(p)
 	{
-		TraversorV<MAP> trav(m_map) ;
-		for (Dart d = trav.begin(); d != trav.end(); d = trav.next())
-		{
-			unsigned int degree = m_map.vertexDegree(d) ;
-			float n = 3.0/8.0 + 1.0/4.0 * cos(2.0 * M_PI / degree) ;
-			n = 8.0/5.0 * (n * n) ;
-
-			m_position[d] /= n ;
-		}
+		this->addPass(0, PARENT::WRITE_PASS) ;
 	}
 } ;
 
@@ -193,86 +203,76 @@ public:
  *********************************************************************************/
 
 template <typename PFP>
-class LoopOddSynthesisFilter : public Algo::MR::Filter
+class LoopOddSynthesisFilter : public Algo::MR::LiftingFilter<typename PFP::MAP, EDGE, typename PFP::VEC3>
 {
 	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
+	typedef Algo::MR::LiftingFilter<MAP, EDGE, VEC3> PARENT;
 
 protected:
-	MAP& m_map ;
 	VertexAttribute<VEC3, MAP>& m_position;
 
-public:
-	LoopOddSynthesisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : m_map(m), m_position(p)
-	{}
-
-	void operator() ()
+	void pass(unsigned int p, Dart d, VEC3& value)
 	{
-		TraversorE<MAP> trav(m_map) ;
-		for (Dart d = trav.begin(); d != trav.end(); d = trav.next())
-		{
-			VEC3 p = loopOddVertex<PFP>(m_map, m_position, d) ;
-
-			m_map.incCurrentLevel() ;
-
-			Dart oddV = m_map.phi2(d) ;
-			m_position[oddV] += p ;
+		if(p == 0)
+			value = loopOddVertex<PFP>(this->m_map, m_position, d) ;
+		else
+			m_position[this->m_map.phi2(d)] += value ;
+	}
 
-			m_map.decCurrentLevel() ;
-		}
+public:
+	LoopOddSynthesisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : PARENT(m), m_position(p)
+	{
+		this->addPass(0, PARENT::READ_PASS) ;
+		this->addPass(1, PARENT::WRITE_PASS) ;
 	}
 } ;
 
 template <typename PFP>
-class LoopEvenSynthesisFilter : public Algo::MR::Filter
+class LoopEvenSynthesisFilter : public Algo::MR::LiftingFilter<typename PFP::MAP, VERTEX, typename PFP::VEC3>
 {
 	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
+	typedef Algo::MR::LiftingFilter<MAP, VERTEX, VEC3> PARENT;
 
 protected:
-	MAP& m_map ;
 	VertexAttribute<VEC3, MAP>& m_position ;
 
-public:
-	LoopEvenSynthesisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : m_map(m), m_position(p)
-	{}
+	void pass(unsigned int p, Dart d, VEC3& value)
+	{
+		if(p == 0)
+			value = loopEvenVertexFine<PFP>(this->m_map, m_position, d) ;
+		else
+			m_position[d] += value ;
+	}
 
-	void operator() ()
+public:
+	LoopEvenSynthesisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : PARENT(m), m_position(p)
 	{
-		TraversorV<MAP> trav(m_map) ;
-		for (Dart d = trav.begin(); d != trav.end(); d = trav.next())
-		{
-			VEC3 p = loopEvenVertex<PFP>(m_map, m_position, d) ;
-			m_position[d] += p ;
-		}
+		this->addPass(1, PARENT::READ_PASS) ;
+		this->addPass(0, PARENT::WRITE_PASS) ;
 	}
 } ;
 
 template <typename PFP>
-class LoopNormalisationSynthesisFilter : public Algo::MR::Filter
+class LoopNormalisationSynthesisFilter : public Algo::MR::LiftingFilter<typename PFP::MAP, VERTEX, typename PFP::VEC3>
 {
 	typedef typename PFP::MAP MAP;
 	typedef typename PFP::VEC3 VEC3;
+	typedef Algo::MR::LiftingFilter<MAP, VERTEX, VEC3> PARENT;
 
 protected:
-	MAP& m_map ;
 	VertexAttribute<VEC3, MAP>& m_position ;
 
-public:
-	LoopNormalisationSynthesisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : m_map(m), m_position(p)
-	{}
+	void pass(unsigned int /*p*/, Dart d, VEC3& /*value*/)
+	{
+		m_position[d] *= loopNormalisation<PFP>(this->m_map, d) ;
+	}
 
-	void operator() ()
+public:
+	LoopNormalisationSynthesisFilter(MAP& m, VertexAttribute<VEC3, MAP>& p) : PARENT(m), m_position(p)
 	{
-		TraversorV<MAP> trav(m_map) ;
-		for (Dart d = trav.begin(); d != trav.end(); d = trav.next())
-		{
-			unsigned int degree = m_map.vertexDegree(d) ;
-			float n = 3.0/8.0 + 1.0/4.0 * cos(2.0 * M_PI / degree) ;
-			n = 8.0/5.0 * (n * n) ;
-
-			m_position[d] *= n ;
-		}
+		this->addPass(0, PARENT::WRITE_PASS) ;
 	}
 } ;
 
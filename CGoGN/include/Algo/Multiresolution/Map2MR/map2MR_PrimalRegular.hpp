@@ -261,7 +261,12 @@ void Map2MR<PFP>::analysis()
 	m_map.decCurrentLevel() ;
 
 	for(unsigned int i = 0; i < analysisFilters.size(); ++i)
-		(*analysisFilters[i])() ;
+	{
+		if (CGoGN::Parallel::NumberOfThreads > 1)
+			analysisFilters[i]->parallel(CGoGN::Parallel::NumberOfThreads) ;
+		else
+			(*analysisFilters[i])() ;
+	}
 }
 
 template <typename PFP>
@@ -270,7 +275,12 @@ void Map2MR<PFP>::synthesis()
 	assert(m_map.getCurrentLevel() < m_map.getMaxLevel() || !"synthesis : called on max level") ;
 
 	for(unsigned int i = 0; i < synthesisFilters.size(); ++i)
-		(*synthesisFilters[i])() ;
+	{
+		if (CGoGN::Parallel::NumberOfThreads > 1)
+			synthesisFilters[i]->parallel(CGoGN::Parallel::NumberOfThreads) ;
+		else
+			(*synthesisFilters[i])() ;
+	}
 
 	m_map.incCurrentLevel() ;
 }
@@ -1672,7 +1672,12 @@ void Map3MR<PFP>::analysis()
 	m_map.decCurrentLevel() ;
 
 	for(unsigned int i = 0; i < analysisFilters.size(); ++i)
-		(*analysisFilters[i])() ;
+	{
+		if (CGoGN::Parallel::NumberOfThreads > 1)
+			analysisFilters[i]->parallel(CGoGN::Parallel::NumberOfThreads) ;
+		else
+			(*analysisFilters[i])() ;
+	}
 }
 
 template <typename PFP>
@@ -1681,7 +1686,12 @@ void Map3MR<PFP>::synthesis()
 	assert(m_map.getCurrentLevel() < m_map.getMaxLevel() || !"synthesis : called on max level") ;
 
 	for(unsigned int i = 0; i < synthesisFilters.size(); ++i)
-		(*synthesisFilters[i])() ;
+	{
+		if (CGoGN::Parallel::NumberOfThreads > 1)
+			synthesisFilters[i]->parallel(CGoGN::Parallel::NumberOfThreads) ;
+		else
+			(*synthesisFilters[i])() ;
+	}
 
 	m_map.incCurrentLevel() ;
 }
@@ -26,6 +26,9 @@
 #define __MR_FILTERS__
 
 #include <cmath>
+#include <vector>
+
+#include "Topology/generic/traversor/traversorCell.h"
 
 namespace CGoGN
 {
@@ -42,6 +45,94 @@ public:
 	Filter() {}
 	virtual ~Filter() {}
 	virtual void operator() () = 0 ;
+
+	/**
+	 * apply the filter using nbth threads
+	 * filters that do not declare their data accesses (see LiftingFilter) are applied serially
+	 */
+	virtual void parallel(unsigned int /*nbth*/) { (*this)() ; }
+} ;
+
+/**
+ * Filter that declares its read/write sets per level.
+ * The cells of ORBIT are collected at the current level, then the declared passes
+ * are applied in order on all of them. A pass is executed at the level
+ * (current level + level offset) and the level of the map is only changed
+ * between passes, so that a pass can be run with a parallel traversal:
+ *  - READ_PASS : reads the map and writes only in the value of the cell
+ *  - WRITE_PASS : writes the attribute only on cells owned by the traversed cell,
+ *    that are not read by the other cells of the pass
+ *  - SHARED_WRITE_PASS : writes cells shared with other cells (always serial)
+ * Values are initialized with T(0) before the first pass.
+ */
+template <typename MAP, unsigned int ORBIT, typename T>
+class LiftingFilter : public Filter
+{
+public:
+	enum PassAccess { READ_PASS, WRITE_PASS, SHARED_WRITE_PASS } ;
+
+protected:
+	struct Pass
+	{
+		int level ;
+		PassAccess access ;
+	} ;
+
+	MAP& m_map ;
+	std::vector<Pass> m_passes ;
+
+	void addPass(int level, PassAccess access)
+	{
+		Pass p ;
+		p.level = level ;
+		p.access = access ;
+		m_passes.push_back(p) ;
+	}
+
+	/**
+	 * apply pass p on the cell d (the map is at the level declared for p)
+	 */
+	virtual void pass(unsigned int p, Dart d, T& value) = 0 ;
+
+	void run(unsigned int nbth)
+	{
+		std::vector<Dart> cells ;
+		cells.reserve(m_map.template getAttributeContainer<ORBIT>().size()) ;
+		TraversorCell<MAP, ORBIT> trav(m_map) ;
+		for (Dart d = trav.begin(); d != trav.end(); d = trav.next())
+			cells.push_back(d) ;
+
+		std::vector<T> values(cells.size(), T(0)) ;
+
+		unsigned int cur = m_map.getCurrentLevel() ;
+		for (unsigned int p = 0; p < m_passes.size(); ++p)
+		{
+			assert(int(cur) + m_passes[p].level >= 0 && int(cur) + m_passes[p].level <= int(m_map.getMaxLevel())) ;
+			m_map.setCurrentLevel(cur + m_passes[p].level) ;
+
+			if (nbth > 1 && m_passes[p].access != SHARED_WRITE_PASS)
+			{
+				CGoGN::Parallel::foreach_index(m_map, (unsigned int)(cells.size()), [&] (unsigned int i, unsigned int /*thr*/)
+				{
+					pass(p, cells[i], values[i]) ;
+				}, nbth) ;
+			}
+			else
+			{
+				for (unsigned int i = 0; i < cells.size(); ++i)
+					pass(p, cells[i], values[i]) ;
+			}
+		}
+		m_map.setCurrentLevel(cur) ;
+	}
+
+public:
+	LiftingFilter(MAP& m) : m_map(m)
+	{}
+
+	void operator() () { run(1) ; }
+
+	void parallel(unsigned int nbth) { run(nbth) ; }
 } ;
 
 template <typename PFP>
@@ -35,6 +35,10 @@
 
 #include "Utils/quantization.h"
 
+#include "Topology/generic/traversor/traversorCell.h"
+
+#include <fstream>
+
 namespace CGoGN
 {
 
@@ -64,9 +68,22 @@ private:
 	Algo::Surface::Decimation::Selector<PFP>* m_selector ;
 	std::vector<Algo::Surface::Decimation::ApproximatorGen<PFP>*> m_approximators ;
 	std::vector<Algo::Surface::Decimation::PredictorGen<PFP>*> m_predictors ;
-	std::vector<VSplit<PFP>*> m_splits ;
+	std::vector<VSplit<PFP> > m_splits ;
 	unsigned int m_cur ;
 
+	// batches of independent splits (see gotoLevel) : batch id of each split,
+	// ids grow in refinement order (from the last split to the first one)
+	std::vector<unsigned int> m_batch ;
+	std::vector<unsigned int> m_batchStamp ; // for each vertex line : 1 + id of the last batch touching it
+	unsigned int m_nbBatches ;
+
+	// streamed progressive mesh : only the m_nbLoaded last splits are available,
+	// with two position detail vectors each (relative to the approximated vertex)
+	unsigned int m_nbLoaded ;
+	std::vector<VEC3> m_details ;
+	std::ifstream* m_stream ;
+	std::vector<VEC3> m_codebook ;
+
 	Algo::Surface::Decimation::Approximator<PFP, VEC3, EDGE>* m_positionApproximator ;
 
 	bool m_initOk ;
@@ -90,27 +107,67 @@ public:
             MAP& map, DartMarker<MAP>& inactive,
 			Algo::Surface::Decimation::Selector<PFP>* selector, std::vector<Algo::Surface::Decimation::ApproximatorGen<PFP>*>& approximators,
             VertexAttribute<VEC3, MAP>& position) ;
+	/**
+	 * progressive mesh without approximators, to be loaded from a stream (see openStream)
+	 */
+	ProgressiveMesh(MAP& map, DartMarker<MAP>& inactive, VertexAttribute<VEC3, MAP>& position) ;
 	~ProgressiveMesh() ;
 
 	bool initOk() { return m_initOk ; }
 
 	void createPM(unsigned int percentWantedVertices) ;
 
-	std::vector<VSplit<PFP>*>& splits() { return m_splits ; }
+	std::vector<VSplit<PFP> >& splits() { return m_splits ; }
 	Algo::Surface::Decimation::Selector<PFP>* selector() { return m_selector ; }
 	std::vector<Algo::Surface::Decimation::ApproximatorGen<PFP>*>& approximators() { return m_approximators ; }
 	std::vector<Algo::Surface::Decimation::PredictorGen<PFP>*>& predictors() { return m_predictors ; }
 
-	void edgeCollapse(VSplit<PFP>* vs) ;
-	void vertexSplit(VSplit<PFP>* vs) ;
+	void edgeCollapse(const VSplit<PFP>& vs) ;
+	void vertexSplit(const VSplit<PFP>& vs) ;
 
 	void coarsen() ;
 	void refine() ;
 
+	/**
+	 * go to level goal (0 is the finest level, nbSplits() the coarsest one)
+	 * Without predictors nor local frame detail vectors, the splits are replayed
+	 * by batches of independent splits (disjoint sets of vertices),
+	 * large batches being processed in parallel.
+	 */
 	void gotoLevel(unsigned int goal) ;
 	unsigned int& currentLevel() { return m_cur ; }
 	unsigned int nbSplits() { return (unsigned int)(m_splits.size()) ; }
 
+	/**
+	 * finest level that can be reached with the loaded splits
+	 */
+	unsigned int finestLevel() { return nbSplits() - m_nbLoaded ; }
+
+	/**
+	 * Save the progressive mesh in a stream file (the map must be at the coarsest level,
+	 * and be saved with its inactive darts : the stream only stores indices into its containers).
+	 * Records are stored in refinement order with 2 position detail vectors each,
+	 * quantized on a codebook of nbCodeVectors vectors if nbCodeVectors > 0.
+	 */
+	bool saveStream(const std::string& filename, unsigned int nbCodeVectors = 0) ;
+
+	/**
+	 * Open a stream file saved by saveStream (the map must be the saved coarsest map)
+	 * The splits are then loaded with loadStream.
+	 * @return false if the file is not a stream or its length does not match its header
+	 */
+	bool openStream(const std::string& filename) ;
+
+	/**
+	 * Load (at most) nb more splits from the opened stream
+	 * A record referencing an unused dart, vertex or edge of the map is rejected :
+	 * the stream is then closed, the splits loaded before it are kept.
+	 * @return the number of loaded splits
+	 */
+	unsigned int loadStream(unsigned int nb) ;
+
+	unsigned int nbLoadedSplits() { return m_nbLoaded ; }
+
 	void recomputeApproxAndDetails() ;
 
 	double detailAmount() { return m_detailAmount ; }
@@ -130,6 +187,15 @@ public:
 
 private:
 	void initQuantization() ;
+
+	// refinement of m_splits[i] without predictors : topology and embeddings only
+	// (no marker update, thread safe between independent splits)
+	void refineSplit(unsigned int i) ;
+	void coarsenSplit(unsigned int i) ;
+
+	// add m_splits[i] (the next one in refinement order) to the batches (map at the coarsest level)
+	void addToBatch(unsigned int i) ;
+	void computeBatches() ;
 } ;
 
 } //namespace PMesh
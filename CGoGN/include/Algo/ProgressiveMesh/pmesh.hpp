@@ -136,6 +136,11 @@ ProgressiveMesh<PFP>::ProgressiveMesh(
 	m_localFrameDetailVectors = false ;
 	quantizationInitialized = false ;
 	quantizationApplied = false ;
+
+	m_cur = 0 ;
+	m_nbBatches = 0 ;
+	m_nbLoaded = 0 ;
+	m_stream = NULL ;
 }
 
 template <typename PFP>
@@ -170,13 +175,36 @@ ProgressiveMesh<PFP>::ProgressiveMesh(
 	m_localFrameDetailVectors = false ;
 	quantizationInitialized = false ;
 	quantizationApplied = false ;
+
+	m_cur = 0 ;
+	m_nbBatches = 0 ;
+	m_nbLoaded = 0 ;
+	m_stream = NULL ;
+}
+
+template <typename PFP>
+ProgressiveMesh<PFP>::ProgressiveMesh(MAP& map, DartMarker<MAP>& inactive, VertexAttribute<VEC3, MAP>& pos) :
+	m_map(map), position(pos), inactiveMarker(inactive), m_selector(NULL), m_positionApproximator(NULL)
+{
+	m_initOk = true ;
+	m_detailAmount = REAL(1) ;
+	m_localFrameDetailVectors = false ;
+	quantizationInitialized = false ;
+	quantizationApplied = false ;
+
+	m_cur = 0 ;
+	m_nbBatches = 0 ;
+	m_nbLoaded = 0 ;
+	m_stream = NULL ;
 }
 
 template <typename PFP>
 ProgressiveMesh<PFP>::~ProgressiveMesh()
 {
-	for(unsigned int i = 0; i < m_splits.size(); ++i)
-		delete m_splits[i] ;
+	for(unsigned int i = finestLevel(); i < m_splits.size(); ++i)
+		m_splits[i].unref(m_map) ;
+	if(m_stream)
+		delete m_stream ;
 	if(m_selector)
 		delete m_selector ;
 	for(typename std::vector<Algo::Surface::Decimation::ApproximatorGen<PFP>*>::iterator it = m_approximators.begin(); it != m_approximators.end(); ++it)
@@ -205,8 +233,7 @@ void ProgressiveMesh<PFP>::createPM(unsigned int percentWantedVertices)
 		Dart d2 = m_map.phi2(m_map.phi_1(d)) ;
 		Dart dd2 = m_map.phi2(m_map.phi_1(m_map.phi2(d))) ;
 
-		VSplit<PFP>* vs = new VSplit<PFP>(m_map, d, dd2, d2) ;	// create new VSplit node
-		m_splits.push_back(vs) ;								// and store it
+		m_splits.push_back(VSplit<PFP>(d, dd2, d2)) ;	// create new VSplit node and store it
 
 		for(typename std::vector<Algo::Surface::Decimation::ApproximatorGen<PFP>*>::iterator it = m_approximators.begin(); it != m_approximators.end(); ++it)
 		{
@@ -216,14 +243,16 @@ void ProgressiveMesh<PFP>::createPM(unsigned int percentWantedVertices)
 
 		m_selector->updateBeforeCollapse(d) ;		// update selector
 
+		VSplit<PFP>& vs = m_splits.back() ;
 		edgeCollapse(vs) ;							// collapse edge
 
 		unsigned int newV = Algo::Topo::setOrbitEmbeddingOnNewCell<VERTEX>(m_map,d2);
 		unsigned int newE1 = Algo::Topo::setOrbitEmbeddingOnNewCell<EDGE>(m_map,d2);
 		unsigned int newE2 = Algo::Topo::setOrbitEmbeddingOnNewCell<EDGE>(m_map,dd2);
-		vs->setApproxV(newV) ;
-		vs->setApproxE1(newE1) ;
-		vs->setApproxE2(newE2) ;
+		vs.setApproxV(newV) ;
+		vs.setApproxE1(newE1) ;
+		vs.setApproxE2(newE2) ;
+		vs.ref(m_map) ;
 
 		for(typename std::vector<Algo::Surface::Decimation::ApproximatorGen<PFP>*>::iterator it = m_approximators.begin(); it != m_approximators.end(); ++it)
 			(*it)->affectApprox(d2);				// affect data to the resulting vertex
@@ -237,15 +266,18 @@ void ProgressiveMesh<PFP>::createPM(unsigned int percentWantedVertices)
 	m_selector = NULL ;
 
 	m_cur = m_splits.size() ;
+	m_nbLoaded = m_splits.size() ;
 	CGoGNout << "..done (" << nbVertices << " vertices)" << CGoGNendl ;
 
+	computeBatches() ;
+
 	initQuantization() ;
 }
 
 template <typename PFP>
-void ProgressiveMesh<PFP>::edgeCollapse(VSplit<PFP>* vs)
+void ProgressiveMesh<PFP>::edgeCollapse(const VSplit<PFP>& vs)
 {
-	Dart d = vs->getEdge() ;
+	Dart d = vs.getEdge() ;
 	Dart dd = m_map.phi2(d) ;
 
 	inactiveMarker.template markOrbit<FACE>(d) ;
@@ -255,12 +287,12 @@ void ProgressiveMesh<PFP>::edgeCollapse(VSplit<PFP>* vs)
 }
 
 template <typename PFP>
-void ProgressiveMesh<PFP>::vertexSplit(VSplit<PFP>* vs)
+void ProgressiveMesh<PFP>::vertexSplit(const VSplit<PFP>& vs)
 {
-	Dart d = vs->getEdge() ;
+	Dart d = vs.getEdge() ;
 	Dart dd = m_map.phi2(d) ;
-	Dart d2 = vs->getLeftEdge() ;
-	Dart dd2 = vs->getRightEdge() ;
+	Dart d2 = vs.getLeftEdge() ;
+	Dart dd2 = vs.getRightEdge() ;
 
 	m_map.insertTrianglePair(d, d2, dd2) ;
 
@@ -269,40 +301,29 @@ void ProgressiveMesh<PFP>::vertexSplit(VSplit<PFP>* vs)
 }
 
 template <typename PFP>
-void ProgressiveMesh<PFP>::coarsen()
+void ProgressiveMesh<PFP>::coarsenSplit(unsigned int i)
 {
-	if(m_cur == m_splits.size())
-		return ;
-
-	VSplit<PFP>* vs = m_splits[m_cur] ; // get the split node
-	++m_cur ;
+	const VSplit<PFP>& vs = m_splits[i] ;
 
-	// Dart d = vs->getEdge() ;
-	// Dart dd = m_map.phi2(d) ;		// get some darts
-	Dart d2 = vs->getLeftEdge() ;
-	Dart dd2 = vs->getRightEdge() ;
+	Dart d2 = vs.getLeftEdge() ;
+	Dart dd2 = vs.getRightEdge() ;
 
-	edgeCollapse(vs) ;	// collapse edge
-
-    Algo::Topo::setOrbitEmbedding<VERTEX>(m_map, d2, vs->getApproxV()) ;
-	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, d2, vs->getApproxE1()) ;
-	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, dd2, vs->getApproxE2()) ;
+	m_map.extractTrianglePair(vs.getEdge()) ;	// collapse edge
 
+	Algo::Topo::setOrbitEmbedding<VERTEX>(m_map, d2, vs.getApproxV()) ;
+	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, d2, vs.getApproxE1()) ;
+	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, dd2, vs.getApproxE2()) ;
 }
 
 template <typename PFP>
-void ProgressiveMesh<PFP>::refine()
+void ProgressiveMesh<PFP>::refineSplit(unsigned int i)
 {
-	if(m_cur == 0)
-		return ;
-
-	--m_cur ;
-	VSplit<PFP>* vs = m_splits[m_cur] ; // get the split node
+	const VSplit<PFP>& vs = m_splits[i] ;
 
-	Dart d = vs->getEdge() ;
+	Dart d = vs.getEdge() ;
 	Dart dd = m_map.phi2(d) ; 		// get some darts
-	Dart dd2 = vs->getRightEdge() ;
-	Dart d2 = vs->getLeftEdge() ;
+	Dart dd2 = vs.getRightEdge() ;
+	Dart d2 = vs.getLeftEdge() ;
 	Dart d1 = m_map.phi2(d2) ;
 	Dart dd1 = m_map.phi2(dd2) ;
 
@@ -313,6 +334,51 @@ void ProgressiveMesh<PFP>::refine()
 	unsigned int e3 = m_map.template getEmbedding<EDGE>(m_map.phi1(dd)) ;
 	unsigned int e4 = m_map.template getEmbedding<EDGE>(m_map.phi_1(dd)) ;
 
+	m_map.insertTrianglePair(d, d2, dd2) ; // split vertex
+
+	Algo::Topo::setOrbitEmbedding<VERTEX>(m_map, d, v1) ;	// embed the
+	Algo::Topo::setOrbitEmbedding<VERTEX>(m_map, dd, v2) ;	// new vertices
+	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, d1, e1) ;
+	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, d2, e2) ;	// and new edges
+	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, dd1, e3) ;
+	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, dd2, e4) ;
+
+	if(!m_details.empty())	// streamed progressive mesh : positions from the detail vectors
+	{
+		const VEC3& p = position[vs.getApproxV()] ;
+		position[v1] = p + m_details[2*i] ;
+		position[v2] = p + m_details[2*i+1] ;
+	}
+}
+
+template <typename PFP>
+void ProgressiveMesh<PFP>::coarsen()
+{
+	if(m_cur == m_splits.size())
+		return ;
+
+	Dart d = m_splits[m_cur].getEdge() ;
+	inactiveMarker.template markOrbit<FACE>(d) ;
+	inactiveMarker.template markOrbit<FACE>(m_map.phi2(d)) ;
+
+	coarsenSplit(m_cur) ;
+	++m_cur ;
+}
+
+template <typename PFP>
+void ProgressiveMesh<PFP>::refine()
+{
+	if(m_cur == finestLevel())
+		return ;
+
+	--m_cur ;
+	const VSplit<PFP>& vs = m_splits[m_cur] ; // get the split node
+
+	Dart d = vs.getEdge() ;
+	Dart dd = m_map.phi2(d) ;
+	Dart dd2 = vs.getRightEdge() ;
+	Dart d2 = vs.getLeftEdge() ;
+
 	if(!m_predictors.empty())
 	{
 		for(typename std::vector<Algo::Surface::Decimation::PredictorGen<PFP>*>::iterator pit = m_predictors.begin();
@@ -330,14 +396,10 @@ void ProgressiveMesh<PFP>::refine()
 		localFrame.invert(invLocalFrame) ;
 	}
 
-	vertexSplit(vs) ; // split vertex
+	inactiveMarker.template unmarkOrbit<FACE>(d) ;
+	inactiveMarker.template unmarkOrbit<FACE>(dd) ;
 
-	Algo::Topo::setOrbitEmbedding<VERTEX>(m_map, d, v1) ;	// embed the
-	Algo::Topo::setOrbitEmbedding<VERTEX>(m_map, dd, v2) ;	// new vertices
-	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, d1, e1) ;
-	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, d2, e2) ;	// and new edges
-	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, dd1, e3) ;
-	Algo::Topo::setOrbitEmbedding<EDGE>(m_map, dd2, e4) ;
+	refineSplit(m_cur) ; // split vertex
 
 //	if(!m_predictors.empty())
 //	{
@@ -368,15 +430,326 @@ void ProgressiveMesh<PFP>::refine()
 template <typename PFP>
 void ProgressiveMesh<PFP>::gotoLevel(unsigned int l)
 {
-	if(l == m_cur || l > m_splits.size())
+	if(l > m_splits.size())
+		return ;
+	if(l < finestLevel())
+		l = finestLevel() ;
+	if(l == m_cur)
 		return ;
 
-	if(l > m_cur)
-		while(m_cur != l)
-			coarsen() ;
-	else
-		while(m_cur != l)
-			refine() ;
+	// predictors and local frames need the neighborhood of each split as it was when it was collapsed
+	if(!m_predictors.empty() || m_localFrameDetailVectors)
+	{
+		if(l > m_cur)
+			while(m_cur != l)
+				coarsen() ;
+		else
+			while(m_cur != l)
+				refine() ;
+		return ;
+	}
+
+	// the splits of a batch touch disjoint sets of vertices : they are replayed in any order
+	// (the inactive marker is updated sequentially, the topology and embeddings in parallel)
+	const unsigned int minParallelBatch = 1024 ;
+
+	while(m_cur > l)
+	{
+		unsigned int b = m_batch[m_cur - 1] ;
+		unsigned int first = m_cur - 1 ;
+		while(first > l && m_batch[first - 1] == b)
+			--first ;
+
+		for(unsigned int i = first; i < m_cur; ++i)
+		{
+			Dart d = m_splits[i].getEdge() ;
+			inactiveMarker.template unmarkOrbit<FACE>(d) ;
+			inactiveMarker.template unmarkOrbit<FACE>(m_map.phi2(d)) ;
+		}
+
+		unsigned int nb = m_cur - first ;
+		CGoGN::Parallel::foreach_index(m_map, nb, [&] (unsigned int i, unsigned int)
+		{
+			refineSplit(first + i) ;
+		}, nb < minParallelBatch ? 1 : CGoGN::Parallel::NumberOfThreads) ;
+
+		m_cur = first ;
+	}
+
+	while(m_cur < l)
+	{
+		unsigned int b = m_batch[m_cur] ;
+		unsigned int last = m_cur + 1 ;
+		while(last < l && m_batch[last] == b)
+			++last ;
+
+		for(unsigned int i = m_cur; i < last; ++i)
+		{
+			Dart d = m_splits[i].getEdge() ;
+			inactiveMarker.template markOrbit<FACE>(d) ;
+			inactiveMarker.template markOrbit<FACE>(m_map.phi2(d)) ;
+		}
+
+		unsigned int first = m_cur ;
+		unsigned int nb = last - first ;
+		CGoGN::Parallel::foreach_index(m_map, nb, [&] (unsigned int i, unsigned int)
+		{
+			coarsenSplit(first + i) ;
+		}, nb < minParallelBatch ? 1 : CGoGN::Parallel::NumberOfThreads) ;
+
+		m_cur = last ;
+	}
+}
+
+template <typename PFP>
+void ProgressiveMesh<PFP>::addToBatch(unsigned int i)
+{
+	const VSplit<PFP>& vs = m_splits[i] ;
+	Dart d = vs.getEdge() ;
+	Dart dd = m_map.phi2(d) ;
+
+	// vertices touched by the split : the approximated vertex, the two split vertices
+	// and the opposite vertices of the two triangles (embeddings of the extracted darts)
+	unsigned int v[5] ;
+	v[0] = vs.getApproxV() ;
+	v[1] = m_map.template getEmbedding<VERTEX>(d) ;
+	v[2] = m_map.template getEmbedding<VERTEX>(dd) ;
+	v[3] = m_map.template getEmbedding<VERTEX>(m_map.phi_1(d)) ;
+	v[4] = m_map.template getEmbedding<VERTEX>(m_map.phi_1(dd)) ;
+
+	// greedy : the split joins the last batch if it does not share any vertex with it
+	bool independent = m_nbBatches > 0 ;
+	for(unsigned int k = 0; k < 5; ++k)
+	{
+		if(v[k] >= m_batchStamp.size())
+			m_batchStamp.resize(v[k] + 1, 0) ;
+		if(m_batchStamp[v[k]] == m_nbBatches)
+			independent = false ;
+	}
+	if(!independent)
+		++m_nbBatches ;
+	for(unsigned int k = 0; k < 5; ++k)
+		m_batchStamp[v[k]] = m_nbBatches ;
+
+	m_batch[i] = m_nbBatches - 1 ;
+}
+
+template <typename PFP>
+void ProgressiveMesh<PFP>::computeBatches()
+{
+	m_batch.resize(m_splits.size()) ;
+	m_batchStamp.assign(m_map.template getAttributeContainer<VERTEX>().end(), 0) ;
+	m_nbBatches = 0 ;
+	for(unsigned int i = m_splits.size(); i > finestLevel(); --i)
+		addToBatch(i - 1) ;
+}
+
+template <typename PFP>
+bool ProgressiveMesh<PFP>::saveStream(const std::string& filename, unsigned int nbCodeVectors)
+{
+	if(m_nbLoaded != nbSplits())
+	{
+		CGoGNerr << "saveStream: progressive mesh not fully loaded" << CGoGNendl ;
+		return false ;
+	}
+
+	std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary) ;
+	if(!out.good())
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl ;
+		return false ;
+	}
+
+	gotoLevel(nbSplits()) ;
+
+	// detail vectors of the split vertices, relative to the approximated vertex
+	unsigned int n = nbSplits() ;
+	std::vector<VEC3> details(2 * n) ;
+	for(unsigned int i = 0; i < n; ++i)
+	{
+		Dart d = m_splits[i].getEdge() ;
+		const VEC3& p = position[m_splits[i].getApproxV()] ;
+		details[2*i] = position[m_map.template getEmbedding<VERTEX>(d)] - p ;
+		details[2*i+1] = position[m_map.template getEmbedding<VERTEX>(m_map.phi2(d))] - p ;
+	}
+
+	std::vector<VEC3> codebook ;
+	std::vector<unsigned int> codes ;
+	if(nbCodeVectors > 0 && n > 0)
+	{
+		Utils::Quantization<VEC3> quant(details) ;
+		std::vector<VEC3> result ;
+		quant.vectorQuantizationNbRegions(nbCodeVectors, result) ;
+		quant.getCodebook(codebook, codes) ;
+	}
+
+	// header : magic, version, number of splits, size of REAL, size of codebook
+	out.write("CPMS", 4) ;
+	unsigned int header[4] = { 1, n, (unsigned int)(sizeof(REAL)), (unsigned int)(codebook.size()) } ;
+	out.write(reinterpret_cast<const char*>(header), 4 * sizeof(unsigned int)) ;
+
+	for(unsigned int i = 0; i < codebook.size(); ++i)
+		out.write(reinterpret_cast<const char*>(codebook[i].data()), 3 * sizeof(REAL)) ;
+
+	// records in refinement order
+	for(unsigned int i = n; i > 0; --i)
+	{
+		const VSplit<PFP>& vs = m_splits[i - 1] ;
+		unsigned int rec[6] = {
+			vs.getEdge().index, vs.getRightEdge().index, vs.getLeftEdge().index,
+			vs.getApproxV(), vs.getApproxE1(), vs.getApproxE2()
+		} ;
+		out.write(reinterpret_cast<const char*>(rec), 6 * sizeof(unsigned int)) ;
+
+		if(codebook.empty())
+		{
+			out.write(reinterpret_cast<const char*>(details[2*(i-1)].data()), 3 * sizeof(REAL)) ;
+			out.write(reinterpret_cast<const char*>(details[2*(i-1)+1].data()), 3 * sizeof(REAL)) ;
+		}
+		else
+			out.write(reinterpret_cast<const char*>(&codes[2*(i-1)]), 2 * sizeof(unsigned int)) ;
+	}
+
+	return out.good() ;
+}
+
+template <typename PFP>
+bool ProgressiveMesh<PFP>::openStream(const std::string& filename)
+{
+	if(!m_splits.empty())
+	{
+		CGoGNerr << "openStream: progressive mesh not empty" << CGoGNendl ;
+		return false ;
+	}
+
+	std::ifstream* in = new std::ifstream(filename.c_str(), std::ios::in | std::ios::binary) ;
+	char magic[4] ;
+	unsigned int header[4] ;
+	in->read(magic, 4) ;
+	in->read(reinterpret_cast<char*>(header), 4 * sizeof(unsigned int)) ;
+	if(!in->good() || std::string(magic, 4) != "CPMS" || header[0] != 1 || header[2] != sizeof(REAL))
+	{
+		CGoGNerr << "openStream: " << filename << " is not a valid progressive mesh stream" << CGoGNendl ;
+		delete in ;
+		return false ;
+	}
+
+	unsigned int n = header[1] ;
+
+	// the header counts must match the length of the stream before anything is allocated
+	std::streampos dataBegin = in->tellg() ;
+	in->seekg(0, std::ios::end) ;
+	unsigned long long available = (unsigned long long)(in->tellg() - dataBegin) ;
+	in->seekg(dataBegin) ;
+	unsigned long long recordSize = 6 * sizeof(unsigned int) + (header[3] == 0 ? 6 * sizeof(REAL) : 2 * sizeof(unsigned int)) ;
+	unsigned long long expected = (unsigned long long)(header[3]) * 3 * sizeof(REAL) + (unsigned long long)(n) * recordSize ;
+	if(!in->good() || expected != available)
+	{
+		CGoGNerr << "openStream: " << filename << " is truncated or corrupted (" << n << " splits announced)" << CGoGNendl ;
+		delete in ;
+		return false ;
+	}
+
+	m_codebook.resize(header[3]) ;
+	for(unsigned int i = 0; i < m_codebook.size(); ++i)
+		in->read(reinterpret_cast<char*>(m_codebook[i].data()), 3 * sizeof(REAL)) ;
+
+	// the saved map is at the coarsest level : the darts of the extracted triangle pairs
+	// (the only ones that are not sewn by phi2) are inactive
+	for(Dart d = m_map.begin(); d != m_map.end(); m_map.next(d))
+	{
+		if(m_map.phi2(d) == d && !inactiveMarker.isMarked(d))
+			inactiveMarker.template markOrbit<FACE>(d) ;
+	}
+
+	m_splits.assign(n, VSplit<PFP>()) ;
+	m_details.assign(2 * n, VEC3(0)) ;
+	m_batch.assign(n, 0) ;
+	m_batchStamp.assign(m_map.template getAttributeContainer<VERTEX>().end(), 0) ;
+	m_nbBatches = 0 ;
+	m_nbLoaded = 0 ;
+	m_cur = n ;
+	m_stream = in ;
+
+	return true ;
+}
+
+template <typename PFP>
+unsigned int ProgressiveMesh<PFP>::loadStream(unsigned int nb)
+{
+	if(!m_stream)
+		return 0 ;
+
+	// the references held on the approximated cells by the progressive mesh
+	// were saved with the map : they are released by the destructor for the loaded splits
+	// a record may only reference used lines of the containers of the map
+	const AttributeContainer& dartCont = m_map.template getAttributeContainer<DART>() ;
+	const AttributeContainer& vertexCont = m_map.template getAttributeContainer<VERTEX>() ;
+	const AttributeContainer& edgeCont = m_map.template getAttributeContainer<EDGE>() ;
+	auto isUsed = [] (const AttributeContainer& cont, unsigned int index) -> bool
+	{
+		return index < cont.end() && cont.used(index) ;
+	} ;
+
+	unsigned int n = nbSplits() ;
+	unsigned int loaded = 0 ;
+	while(loaded < nb && m_nbLoaded < n)
+	{
+		unsigned int rec[6] ;
+		m_stream->read(reinterpret_cast<char*>(rec), 6 * sizeof(unsigned int)) ;
+
+		VEC3 det[2] ;
+		if(m_codebook.empty())
+		{
+			m_stream->read(reinterpret_cast<char*>(det[0].data()), 3 * sizeof(REAL)) ;
+			m_stream->read(reinterpret_cast<char*>(det[1].data()), 3 * sizeof(REAL)) ;
+		}
+		else
+		{
+			unsigned int codes[2] ;
+			m_stream->read(reinterpret_cast<char*>(codes), 2 * sizeof(unsigned int)) ;
+			if(codes[0] >= m_codebook.size() || codes[1] >= m_codebook.size())
+				m_stream->setstate(std::ios::failbit) ;
+			else
+			{
+				det[0] = m_codebook[codes[0]] ;
+				det[1] = m_codebook[codes[1]] ;
+			}
+		}
+
+		if(!isUsed(dartCont, rec[0]) || !isUsed(dartCont, rec[1]) || !isUsed(dartCont, rec[2])
+			|| !isUsed(vertexCont, rec[3]) || !isUsed(edgeCont, rec[4]) || !isUsed(edgeCont, rec[5]))
+			m_stream->setstate(std::ios::failbit) ;
+
+		if(!m_stream->good())
+		{
+			CGoGNerr << "loadStream: corrupted stream (" << m_nbLoaded << " splits loaded)" << CGoGNendl ;
+			delete m_stream ;
+			m_stream = NULL ;
+			return loaded ;
+		}
+
+		unsigned int i = n - 1 - m_nbLoaded ;
+		VSplit<PFP>& vs = m_splits[i] ;
+		vs = VSplit<PFP>(Dart(rec[0]), Dart(rec[1]), Dart(rec[2])) ;
+		vs.setApproxV(rec[3]) ;
+		vs.setApproxE1(rec[4]) ;
+		vs.setApproxE2(rec[5]) ;
+		m_details[2*i] = det[0] ;
+		m_details[2*i+1] = det[1] ;
+
+		addToBatch(i) ;
+		++m_nbLoaded ;
+		++loaded ;
+	}
+
+	if(m_nbLoaded == n)
+	{
+		delete m_stream ;
+		m_stream = NULL ;
+	}
+
+	return loaded ;
 }
 
 template <typename PFP>
@@ -421,8 +794,8 @@ void ProgressiveMesh<PFP>::localizeDetailVectors()
 		gotoLevel(nbSplits()) ;
 		while(m_cur > 0)
 		{
-			Dart d = m_splits[m_cur-1]->getEdge() ;
-			Dart dd2 = m_splits[m_cur-1]->getRightEdge() ;
+			Dart d = m_splits[m_cur-1].getEdge() ;
+			Dart dd2 = m_splits[m_cur-1].getRightEdge() ;
 			typename PFP::MATRIX33 localFrame = Algo::Geometry::vertexLocalFrame<PFP>(m_map, dd2, position) ;
 			VEC3 det = m_positionApproximator->getDetail(d) ;
 			det = localFrame * det ;
@@ -452,8 +825,8 @@ void ProgressiveMesh<PFP>::globalizeDetailVectors()
 		gotoLevel(nbSplits()) ;
 		while(m_cur > 0)
 		{
-			Dart d = m_splits[m_cur-1]->getEdge() ;
-			Dart dd2 = m_splits[m_cur-1]->getRightEdge() ;
+			Dart d = m_splits[m_cur-1].getEdge() ;
+			Dart dd2 = m_splits[m_cur-1].getRightEdge() ;
 			typename PFP::MATRIX33 localFrame = Algo::Geometry::vertexLocalFrame<PFP>(m_map, dd2, position) ;
 			typename PFP::MATRIX33 invLocalFrame ;
 			localFrame.invert(invLocalFrame) ;
@@ -494,7 +867,7 @@ void ProgressiveMesh<PFP>::quantizeDetailVectors(unsigned int nbClasses)
 		std::vector<VEC3> resultat;
 		q->vectorQuantizationNbRegions(nbClasses, resultat) ;
 		for(unsigned int i = 0; i < m_splits.size(); ++i)
-			m_positionApproximator->setDetail(m_splits[i]->getEdge(), 0, resultat[i]) ;
+			m_positionApproximator->setDetail(m_splits[i].getEdge(), resultat[i]) ;
 		quantizationApplied = true ;
 		gotoLevel(0) ;
 		CGoGNout << "Discrete Entropy -> " << q->getDiscreteEntropy() << " (codebook size : " << q->getNbCodeVectors() << ")" << CGoGNendl ;
@@ -518,7 +891,7 @@ void ProgressiveMesh<PFP>::quantizeDetailVectors(float distortion)
 		std::vector<typename PFP::VEC3> resultat;
 		q->vectorQuantizationDistortion(distortion, resultat) ;
 		for(unsigned int i = 0; i < m_splits.size(); ++i)
-			m_positionApproximator->setDetail(m_splits[i]->getEdge(), resultat[i]) ;
+			m_positionApproximator->setDetail(m_splits[i].getEdge(), resultat[i]) ;
 		quantizationApplied = true ;
 		gotoLevel(0) ;
 		CGoGNout << "Discrete Entropy -> " << q->getDiscreteEntropy() << " (codebook size : " << q->getNbCodeVectors() << ")" << CGoGNendl ;
@@ -532,7 +905,7 @@ void ProgressiveMesh<PFP>::resetDetailVectors()
 	{
 		gotoLevel(nbSplits()) ;
 		for(unsigned int i = 0; i < m_splits.size(); ++i)
-			m_positionApproximator->setDetail(m_splits[i]->getEdge(), originalDetailVectors[i]) ;
+			m_positionApproximator->setDetail(m_splits[i].getEdge(), originalDetailVectors[i]) ;
 		delete q ;
 		quantizationInitialized = false ;
 		quantizationApplied = false ;
@@ -37,6 +37,14 @@ namespace Surface
 namespace PMesh
 {
 
+/**
+ * Vertex split record of a progressive mesh: the collapsed edge, the two edges
+ * that were sewn by the collapse and the embeddings of the cells created by the
+ * collapse (approximated vertex and edges).
+ * The record is a plain value (no link to the map) so that the records of a
+ * progressive mesh are stored contiguously and can be written as is in a stream.
+ * The progressive mesh holds a reference on the approximated cells (see ref / unref).
+ */
 template <typename PFP>
 class VSplit 
 {
@@ -45,7 +53,6 @@ public:
 	typedef typename PFP::VEC3 VEC3 ;
 
 private:
-	MAP& map ;
 	Dart edge ;
 	Dart right_edge ;
 	Dart left_edge ;
@@ -53,50 +60,46 @@ private:
 	unsigned int approxEdgeId1, approxEdgeId2 ;
 
 public:
-	VSplit(MAP& m, Dart e, Dart r, Dart l)
-		: map(m), edge(e), right_edge(r), left_edge(l), approxVertexId(EMBNULL), approxEdgeId1(EMBNULL), approxEdgeId2(EMBNULL)
+	VSplit()
+		: approxVertexId(EMBNULL), approxEdgeId1(EMBNULL), approxEdgeId2(EMBNULL)
 	{}
-	~VSplit()
-	{
-		AttributeContainer& cont = map.template getAttributeContainer<VERTEX>() ;
-		if(approxVertexId != EMBNULL) cont.unrefLine(approxVertexId) ;
-	}
 
-	Dart getEdge() { return edge ; }
-	Dart getLeftEdge() { return left_edge ; }
-	Dart getRightEdge() { return right_edge ; }
+	VSplit(Dart e, Dart r, Dart l)
+		: edge(e), right_edge(r), left_edge(l), approxVertexId(EMBNULL), approxEdgeId1(EMBNULL), approxEdgeId2(EMBNULL)
+	{}
 
-	unsigned int getApproxV() { return approxVertexId ; }
-	void setApproxV(unsigned int id)
-	{
-		if(approxVertexId == id) return ;
-		AttributeContainer& cont = map.template getAttributeContainer<VERTEX>() ;
-		if(approxVertexId != EMBNULL)
-			cont.unrefLine(approxVertexId) ;
-		if(id != EMBNULL) cont.refLine(id) ;
-		approxVertexId = id ;
-	}
+	Dart getEdge() const { return edge ; }
+	Dart getLeftEdge() const { return left_edge ; }
+	Dart getRightEdge() const { return right_edge ; }
+
+	unsigned int getApproxV() const { return approxVertexId ; }
+	void setApproxV(unsigned int id) { approxVertexId = id ; }
+
+	unsigned int getApproxE1() const { return approxEdgeId1 ; }
+	void setApproxE1(unsigned int id) { approxEdgeId1 = id ; }
+
+	unsigned int getApproxE2() const { return approxEdgeId2 ; }
+	void setApproxE2(unsigned int id) { approxEdgeId2 = id ; }
 
-	unsigned int getApproxE1() { return approxEdgeId1 ; }
-	void setApproxE1(unsigned int id)
+	/**
+	 * reference the approximated cells in the containers of the map
+	 * (they must not be deleted when no dart is embedded on them)
+	 */
+	void ref(MAP& map) const
 	{
-		if(approxEdgeId1 == id) return ;
-		AttributeContainer& cont = map.template getAttributeContainer<EDGE>() ;
-		if(approxEdgeId1 != EMBNULL)
-			cont.unrefLine(approxEdgeId1) ;
-		if(id != EMBNULL) cont.refLine(id) ;
-		approxEdgeId1 = id ;
+		if(approxVertexId != EMBNULL) map.template getAttributeContainer<VERTEX>().refLine(approxVertexId) ;
+		if(approxEdgeId1 != EMBNULL) map.template getAttributeContainer<EDGE>().refLine(approxEdgeId1) ;
+		if(approxEdgeId2 != EMBNULL) map.template getAttributeContainer<EDGE>().refLine(approxEdgeId2) ;
 	}
 
-	unsigned int getApproxE2() { return approxEdgeId2 ; }
-	void setApproxE2(unsigned int id)
+	/**
+	 * release the references taken by ref
+	 */
+	void unref(MAP& map) const
 	{
-		if(approxEdgeId2 == id) return ;
-		AttributeContainer& cont = map.template getAttributeContainer<EDGE>() ;
-		if(approxEdgeId2 != EMBNULL)
-			cont.unrefLine(approxEdgeId2) ;
-		if(id != EMBNULL) cont.refLine(id) ;
-		approxEdgeId2 = id ;
+		if(approxVertexId != EMBNULL) map.template getAttributeContainer<VERTEX>().unrefLine(approxVertexId) ;
+		if(approxEdgeId1 != EMBNULL) map.template getAttributeContainer<EDGE>().unrefLine(approxEdgeId1) ;
+		if(approxEdgeId2 != EMBNULL) map.template getAttributeContainer<EDGE>().unrefLine(approxEdgeId2) ;
 	}
 } ;
 
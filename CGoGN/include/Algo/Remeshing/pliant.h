@@ -43,6 +43,28 @@ void pliantRemeshing(
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal) ;
 
+/**
+ * isotropic remeshing of a triangulated surface driven by work queues:
+ * each iteration splits the edges longer than 4/3 of their target length,
+ * collapses the edges shorter than 3/4 of their target length, equalizes
+ * the valences with edge flips and applies a parallel tangential relaxation.
+ * The candidates are selected in parallel at the beginning of each iteration,
+ * then only the edges around a modified neighborhood are queued again.
+ * Feature edges (dihedral angle > 30 degrees) and boundary edges are kept.
+ * @param targetLength target edge length around each vertex (the target of an edge
+ * is the mean of the targets of its vertices, new vertices get the mean of the edge)
+ * @param nbIterations number of iterations
+ * @param nbThreads number of threads used for the selection and the relaxation
+ */
+template <typename PFP>
+void isotropicRemeshing(
+	typename PFP::MAP& map,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& targetLength,
+	unsigned int nbIterations,
+	unsigned int nbThreads = CGoGN::Parallel::NumberOfThreads) ;
+
 } // namespace Remeshing
 
 } // namespace Surface
@@ -24,6 +24,9 @@
 
 #include "Algo/Geometry/basic.h"
 #include "Algo/Geometry/feature.h"
+#include "Algo/Geometry/normal.h"
+#include "Algo/Geometry/centroid.h"
+#include "Utils/instrumentation.h"
 
 namespace CGoGN
 {
@@ -207,6 +210,386 @@ void pliantRemeshing(
 	map.removeAttribute(centroid) ;
 }
 
+/**
+ * FIFO queue of edges used by isotropicRemeshing: an edge is queued at most once,
+ * an edge must be removed before one of its darts is deleted
+ * (edges created by an operation are processed after the edges already queued)
+ */
+template <typename MAP>
+class EdgeQueue
+{
+	std::vector<Dart> m_darts ;
+	unsigned int m_head ;
+	DartMarker<MAP> m_queued ;
+
+public:
+	EdgeQueue(MAP& map) : m_head(0), m_queued(map)
+	{}
+
+	void push(Dart d)
+	{
+		if(!m_queued.isMarked(d))
+		{
+			m_queued.template markOrbit<EDGE>(d) ;
+			m_darts.push_back(d) ;
+		}
+	}
+
+	void remove(Dart d)
+	{
+		m_queued.template unmarkOrbit<EDGE>(d) ;
+	}
+
+	bool pop(Dart& d)
+	{
+		while(m_head < m_darts.size())
+		{
+			d = m_darts[m_head++] ;
+			if(m_queued.isMarked(d)) // otherwise already processed or deleted
+			{
+				m_queued.template unmarkOrbit<EDGE>(d) ;
+				return true ;
+			}
+		}
+		m_darts.clear() ;
+		m_head = 0 ;
+		return false ;
+	}
+} ;
+
+template <typename PFP>
+void isotropicRemeshing(
+	typename PFP::MAP& map,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& targetLength,
+	unsigned int nbIterations,
+	unsigned int nbThreads)
+{
+	CGoGN_SCOPED_TIMER("Algo::Surface::Remeshing::isotropicRemeshing");
+
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+	const REAL edgeLengthInf = REAL(3) / REAL(4) ;
+	const REAL edgeLengthSup = REAL(4) / REAL(3) ;
+
+	enum { SPLIT = 1, COLLAPSE = 2, FLIP = 4 } ;
+
+	// edges of the map (one not boundary dart per edge) and vertices of the map
+	std::vector<Dart> edges ;
+	std::vector<Dart> vertices ;
+	std::vector<unsigned char> candidates ;
+
+	auto gatherEdges = [&] ()
+	{
+		edges.clear() ;
+		TraversorE<MAP> te(map) ;
+		for(Dart d = te.begin(); d != te.end(); d = te.next())
+			edges.push_back(map.template isBoundaryMarked<2>(d) ? map.phi2(d) : d) ;
+	} ;
+
+	auto edgeTarget = [&] (Dart d) -> REAL
+	{
+		return REAL(0.5) * (targetLength[d] + targetLength[map.phi1(d)]) ;
+	} ;
+
+	auto edgeSqLength = [&] (Dart d) -> REAL
+	{
+		return (position[map.phi1(d)] - position[d]).norm2() ;
+	} ;
+
+	// feature edges: sharp edges and boundary edges
+	DartMarker<MAP> featureEdge(map) ;
+	gatherEdges() ;
+	candidates.assign(edges.size(), 0) ;
+	CGoGN::Parallel::foreach_index(map, uint32(edges.size()), [&] (unsigned int i, unsigned int)
+	{
+		Dart d = edges[i] ;
+		if(map.isBoundaryEdge(d))
+			candidates[i] = 1 ;
+		else
+		{
+			VEC3 n1 = Surface::Geometry::faceNormal<PFP>(map, d, position) ;
+			VEC3 n2 = Surface::Geometry::faceNormal<PFP>(map, map.phi2(d), position) ;
+			if(Geom::angle(n1, n2) > M_PI / REAL(6))
+				candidates[i] = 1 ;
+		}
+	}, nbThreads) ;
+	for(unsigned int i = 0; i < edges.size(); ++i)
+	{
+		if(candidates[i])
+			featureEdge.template markOrbit<EDGE>(edges[i]) ;
+	}
+
+	// number of feature edges around a vertex (2: feature vertex, other non zero: corner)
+	auto featureDegree = [&] (Dart d) -> unsigned int
+	{
+		unsigned int nb = 0 ;
+		Dart vit = d ;
+		do
+		{
+			if(featureEdge.isMarked(vit))
+				++nb ;
+			vit = map.phi2_1(vit) ;
+		} while(vit != d) ;
+		return nb ;
+	} ;
+
+	// valence of the vertex of d and its target (4 on boundary, 6 inside)
+	auto valence = [&] (Dart d, int& target) -> int
+	{
+		int nb = 0 ;
+		target = 6 ;
+		Dart vit = d ;
+		do
+		{
+			if(map.template isBoundaryMarked<2>(vit))
+				target = 4 ;
+			++nb ;
+			vit = map.phi2_1(vit) ;
+		} while(vit != d) ;
+		return nb ;
+	} ;
+
+	// does the flip of d strictly decrease the deviation of the valences
+	auto flipImproves = [&] (Dart d) -> bool
+	{
+		if(map.isBoundaryEdge(d) || featureEdge.isMarked(d))
+			return false ;
+		Dart e = map.phi2(d) ;
+		Dart c = map.phi_1(d) ;
+		Dart f = map.phi_1(e) ;
+		int tw, tx, ty, tz ;
+		int w = valence(d, tw) ;
+		int x = valence(e, tx) ;
+		if(w <= 3 || x <= 3)
+			return false ;
+		int y = valence(c, ty) ;
+		int z = valence(f, tz) ;
+		int before = std::abs(w - tw) + std::abs(x - tx) + std::abs(y - ty) + std::abs(z - tz) ;
+		int after = std::abs(w - 1 - tw) + std::abs(x - 1 - tx) + std::abs(y + 1 - ty) + std::abs(z + 1 - tz) ;
+		if(after >= before)
+			return false ;
+		// the new edge must not exist yet
+		unsigned int emb = map.template getEmbedding<VERTEX>(f) ;
+		Dart vit = c ;
+		do
+		{
+			if(map.template getEmbedding<VERTEX>(map.phi1(vit)) == emb)
+				return false ;
+			vit = map.phi2_1(vit) ;
+		} while(vit != c) ;
+		return true ;
+	} ;
+
+	VertexAttribute<VEC3, MAP> relaxed = map.template addAttribute<VEC3, VERTEX, MAP>("relaxed") ;
+
+	for(unsigned int iter = 0; iter < nbIterations; ++iter)
+	{
+		EdgeQueue<MAP> splitQueue(map) ;
+		EdgeQueue<MAP> collapseQueue(map) ;
+		EdgeQueue<MAP> flipQueue(map) ;
+
+		// queue the spokes (and the link edges for the flips) of the vertex of d
+		auto queueNeighborhood = [&] (Dart d, EdgeQueue<MAP>* q)
+		{
+			Dart vit = d ;
+			do
+			{
+				if(q)
+					q->push(vit) ;
+				flipQueue.push(vit) ;
+				flipQueue.push(map.phi1(vit)) ;
+				vit = map.phi2_1(vit) ;
+			} while(vit != d) ;
+		} ;
+
+		// select the candidates in parallel
+		gatherEdges() ;
+		candidates.assign(edges.size(), 0) ;
+		CGoGN::Parallel::foreach_index(map, uint32(edges.size()), [&] (unsigned int i, unsigned int)
+		{
+			Dart d = edges[i] ;
+			REAL l2 = edgeSqLength(d) ;
+			REAL t = edgeTarget(d) ;
+			unsigned char c = 0 ;
+			if(l2 > edgeLengthSup * edgeLengthSup * t * t)
+				c |= SPLIT ;
+			else if(l2 < edgeLengthInf * edgeLengthInf * t * t)
+				c |= COLLAPSE ;
+			if(flipImproves(d))
+				c |= FLIP ;
+			candidates[i] = c ;
+		}, nbThreads) ;
+		for(unsigned int i = 0; i < edges.size(); ++i)
+		{
+			if(candidates[i] & SPLIT)
+				splitQueue.push(edges[i]) ;
+			if(candidates[i] & COLLAPSE)
+				collapseQueue.push(edges[i]) ;
+			if(candidates[i] & FLIP)
+				flipQueue.push(edges[i]) ;
+		}
+
+		// split long edges
+		Dart d ;
+		while(splitQueue.pop(d))
+		{
+			if(map.template isBoundaryMarked<2>(d))
+				d = map.phi2(d) ;
+			REAL t = edgeTarget(d) ;
+			if(edgeSqLength(d) <= edgeLengthSup * edgeLengthSup * t * t)
+				continue ;
+
+			bool feature = featureEdge.isMarked(d) ;
+			Dart dd = map.phi2(d) ;
+			VEC3 p = REAL(0.5) * (position[d] + position[dd]) ;
+			map.cutEdge(d) ;
+			Dart v = map.phi1(d) ;
+			position[v] = p ;
+			targetLength[v] = t ;
+			map.splitFace(v, map.phi_1(d)) ;
+			if(!map.template isBoundaryMarked<2>(dd))
+				map.splitFace(map.phi1(dd), map.phi_1(dd)) ;
+			if(feature)
+			{
+				featureEdge.template markOrbit<EDGE>(d) ;
+				featureEdge.template markOrbit<EDGE>(v) ;
+			}
+			queueNeighborhood(v, &splitQueue) ;
+		}
+
+		// collapse short edges
+		while(collapseQueue.pop(d))
+		{
+			if(map.template isBoundaryMarked<2>(d))
+				d = map.phi2(d) ;
+			REAL t = edgeTarget(d) ;
+			if(edgeSqLength(d) >= edgeLengthInf * edgeLengthInf * t * t)
+				continue ;
+
+			// corners are kept, feature vertices only move along feature edges
+			Dart d1 = map.phi1(d) ;
+			unsigned int f0 = featureDegree(d) ;
+			unsigned int f1 = featureDegree(d1) ;
+			if((f0 != 0 && f0 != 2) || (f1 != 0 && f1 != 2))
+				continue ;
+			if(f0 == 2 && f1 == 2 && !featureEdge.isMarked(d))
+				continue ;
+			if(!map.edgeCanCollapse(d))
+				continue ;
+
+			// the kept vertex is the feature one (or the vertex of d1)
+			Dart removed = d ;
+			Dart kept = d1 ;
+			if(f0 == 2 && f1 == 0)
+			{
+				removed = d1 ;
+				kept = d ;
+			}
+			VEC3 p = position[kept] ;
+			REAL tk = targetLength[kept] ;
+
+			// the collapse must not create long edges
+			bool collapse = true ;
+			Dart vit = map.phi2_1(removed) ;
+			do
+			{
+				REAL tv = REAL(0.5) * (tk + targetLength[map.phi1(vit)]) ;
+				if((p - position[map.phi1(vit)]).norm2() > edgeLengthSup * edgeLengthSup * tv * tv)
+					collapse = false ;
+				vit = map.phi2_1(vit) ;
+			} while(vit != removed && collapse) ;
+			if(!collapse)
+				continue ;
+
+			// the darts of the two faces of the edge may be deleted
+			Dart e = map.phi2(d) ;
+			for(unsigned int k = 0; k < 3; ++k)
+			{
+				splitQueue.remove(d) ;
+				collapseQueue.remove(d) ;
+				flipQueue.remove(d) ;
+				splitQueue.remove(e) ;
+				collapseQueue.remove(e) ;
+				flipQueue.remove(e) ;
+				d = map.phi1(d) ;
+				e = map.phi1(e) ;
+			}
+
+			Dart v = map.collapseEdge(d) ;
+			if(v == NIL)
+				continue ;
+			position[v] = p ;
+			targetLength[v] = tk ;
+
+			// merged edges are feature if one of them was
+			vit = v ;
+			do
+			{
+				if(featureEdge.isMarked(vit) != featureEdge.isMarked(map.phi2(vit)))
+					featureEdge.template markOrbit<EDGE>(vit) ;
+				vit = map.phi2_1(vit) ;
+			} while(vit != v) ;
+
+			queueNeighborhood(v, &collapseQueue) ;
+		}
+
+		// equalize valences with edge flips
+		while(flipQueue.pop(d))
+		{
+			if(map.template isBoundaryMarked<2>(d))
+				d = map.phi2(d) ;
+			if(!flipImproves(d))
+				continue ;
+			Dart e = map.phi2(d) ;
+			map.flipEdge(d) ;
+			flipQueue.push(map.phi1(d)) ;
+			flipQueue.push(map.phi_1(d)) ;
+			flipQueue.push(map.phi1(e)) ;
+			flipQueue.push(map.phi_1(e)) ;
+		}
+
+		// tangential relaxation of the vertices that are not on a feature
+		vertices.clear() ;
+		TraversorV<MAP> tv(map) ;
+		for(Dart v = tv.begin(); v != tv.end(); v = tv.next())
+			vertices.push_back(v) ;
+
+		CGoGN::Parallel::foreach_index(map, uint32(vertices.size()), [&] (unsigned int i, unsigned int)
+		{
+			Dart v = vertices[i] ;
+			VEC3 p = position[v] ;
+			if(featureDegree(v) == 0)
+			{
+				VEC3 c = Surface::Geometry::vertexNeighborhoodCentroid<PFP>(map, v, position) ;
+				VEC3 n = Surface::Geometry::vertexNormal<PFP>(map, v, position) ;
+				p = c + ((p - c) * n) * n ;
+			}
+			relaxed[v] = p ;
+		}, nbThreads) ;
+
+		CGoGN::Parallel::foreach_index(map, uint32(vertices.size()), [&] (unsigned int i, unsigned int)
+		{
+			position[vertices[i]] = relaxed[vertices[i]] ;
+		}, nbThreads) ;
+	}
+
+	map.removeAttribute(relaxed) ;
+
+	// update vertices normals
+	vertices.clear() ;
+	TraversorV<MAP> tv(map) ;
+	for(Dart v = tv.begin(); v != tv.end(); v = tv.next())
+		vertices.push_back(v) ;
+	CGoGN::Parallel::foreach_index(map, uint32(vertices.size()), [&] (unsigned int i, unsigned int)
+	{
+		normal[vertices[i]] = Surface::Geometry::vertexNormal<PFP>(map, vertices[i], position) ;
+	}, nbThreads) ;
+}
+
 } // namespace Remeshing
 
 } // namespace Surface
@@ -93,27 +93,46 @@ protected:
 	 */
 	float m_explodeV;
 	
-//	template<typename PFP>
-//	void computeFace(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& positions,
-//									 const typename PFP::VEC3& centerFace, const typename PFP::VEC3& centerNormalFace,
-//									 std::vector<typename PFP::VEC3>& vertices, std::vector<typename PFP::VEC3>& normals);
+	/**
+	 * layout of the buffers built by the last full update:
+	 * - rank of each volume, 0xffffffff if none (indexed by volume embedding if the map
+	 *   has one, else by dart index : the map is never given a volume embedding)
+	 * - for each rank, first triangle and first line of the volume (one more for the total)
+	 */
+	std::vector<unsigned int> m_volumeRank;
 
-	template<typename PFP, typename EMBV>
-	void computeFace(typename PFP::MAP& map, Dart d, const EMBV& positions,
-                                          const typename PFP::VEC3& centerFace, const typename PFP::VEC3& centerNormalFace,
-                                          std::vector<typename PFP::VEC3>& vertices, std::vector<typename PFP::VEC3>& normals);
+	bool m_rankPerDart;
 
-//	template<typename PFP>
-//	void updateSmooth(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& positions, const VolumeAttribute<typename PFP::VEC3>& colorPerFace) ;
+	std::vector<unsigned int> m_volumeFirstTri;
 
-	template<typename PFP, typename V_ATT, typename W_ATT>
-	void updateSmooth(typename PFP::MAP& map, const V_ATT& positions, const W_ATT& colorPerFace) ;
+	std::vector<unsigned int> m_volumeFirstLine;
 
-//	template<typename PFP>
-//	void updateSmooth(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& positions) ;
+	/**
+	 * count the triangles (of 4 points) and lines (of 3 points) generated for a volume
+	 */
+	template<typename PFP>
+	void countVolume(typename PFP::MAP& map, Dart v, unsigned int& nbTris, unsigned int& nbLines);
 
-	template<typename PFP, typename EMBV>
-    void updateSmooth(typename PFP::MAP& map, const EMBV& positions) ;
+	/**
+	 * write the points of the triangles and lines of a volume in given buffers
+	 * @param colorOf function that give the color of the face of a dart (called once per face)
+	 * @param bufNormals NULL if not smooth
+	 */
+	template<typename PFP, typename V_ATT, typename COLFUNC>
+	void computeVolume(typename PFP::MAP& map, Dart v, const V_ATT& positions, const COLFUNC& colorOf,
+					   Geom::Vec3f* bufPos, Geom::Vec3f* bufColors, Geom::Vec3f* bufNormals, Geom::Vec3f* bufLines);
+
+	/**
+	 * two pass (count then fill) parallel generation of all buffers
+	 */
+	template<typename PFP, typename V_ATT, typename COLFUNC>
+	void updateAll(typename PFP::MAP& map, const V_ATT& positions, const COLFUNC& colorOf);
+
+	/**
+	 * parallel rewriting of the parts of the buffers of some volumes
+	 */
+	template<typename PFP, typename V_ATT, typename COLFUNC>
+	void updatePart(typename PFP::MAP& map, const V_ATT& positions, const COLFUNC& colorOf, const std::vector<Dart>& volumes);
 
 public:
 	/**
@@ -162,6 +181,27 @@ public:
 	template<typename PFP, typename V_ATT, typename W_ATT>
 	void updateData(typename PFP::MAP& map, const V_ATT& positions, const W_ATT& colorPerFace) ;
 
+	/**
+	* update the drawing buffers of some volumes only (after positions changed)
+	* the topology must not have changed since the last updateData
+	* @param map the map
+	* @param positions attribute of position vertices
+	* @param volumes one dart per volume to update (volumes incident to the moved vertices)
+	*/
+	template<typename PFP, typename EMBV>
+	void updateVolumes(typename PFP::MAP& map, const EMBV& positions, const std::vector<Dart>& volumes) ;
+
+	/**
+	* update the drawing buffers of some volumes only (after positions or colors changed)
+	* the topology must not have changed since the last updateData
+	* @param map the map
+	* @param positions attribute of position vertices
+	* @param colorPerFace attribute of color (per face)
+	* @param volumes one dart per volume to update
+	*/
+	template<typename PFP, typename V_ATT, typename W_ATT>
+	void updateVolumes(typename PFP::MAP& map, const V_ATT& positions, const W_ATT& colorPerFace, const std::vector<Dart>& volumes) ;
+
 	/**
 	 * draw edges
 	 */
@@ -30,6 +30,10 @@
 #include "Topology/generic/autoAttributeHandler.h"
 #include "Algo/Geometry/normal.h"
 #include "Algo/Geometry/basic.h"
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Utils/instrumentation.h"
+
+#include <algorithm>
 
 namespace CGoGN
 {
@@ -45,7 +49,8 @@ namespace GL2
 
 inline ExplodeVolumeRender::ExplodeVolumeRender(bool withColorPerFace, bool withExplodeFace, bool withSmoothFaces):
 		m_cpf(withColorPerFace),m_ef(withExplodeFace),m_smooth(withSmoothFaces),
-        m_nbTris(0), m_nbLines(0), m_globalColor(0.9f,0.5f,0.0f)//m_globalColor(0.7f,0.7f,0.7f)
+        m_nbTris(0), m_nbLines(0), m_globalColor(0.9f,0.5f,0.0f),//m_globalColor(0.7f,0.7f,0.7f)
+        m_rankPerDart(false)
 {
 	m_vboPos = new Utils::VBO();
 	m_vboPos->setDataSize(3);
@@ -91,547 +96,351 @@ inline ExplodeVolumeRender::~ExplodeVolumeRender()
 }
 
 
-//template<typename PFP>
-//void ExplodeVolumeRender::computeFace(typename PFP::MAP& map, Dart d, const VertexAttribute<typename PFP::VEC3>& positions,
-//                                     const typename PFP::VEC3& centerFace, const typename PFP::VEC3& centerNormalFace,
-//									 std::vector<typename PFP::VEC3>& vertices, std::vector<typename PFP::VEC3>& normals)
-//{
-//    computeFaceGen<PFP, VertexAttribute<typename PFP::VEC3>, typename PFP::VEC3>(map,d,positions,centerFace, centerNormalFace, vertices, normals);
-//}
-
-
-template<typename PFP, typename EMBV>
-void ExplodeVolumeRender::computeFace(typename PFP::MAP& map, Dart d, const EMBV& positions,
-									  const typename PFP::VEC3& centerFace, const typename PFP::VEC3& /*centerNormalFace*/,
-                                      std::vector<typename PFP::VEC3>& vertices, std::vector<typename PFP::VEC3>& normals)
+template<typename PFP>
+void ExplodeVolumeRender::countVolume(typename PFP::MAP& map, Dart v, unsigned int& nbTris, unsigned int& nbLines)
 {
-    //typedef typename PFP::VEC3 VEC3;
-	typedef typename EMBV::DATA_TYPE VEC3;
-	typedef typename PFP::REAL REAL;
-
-	normals.clear();
-	vertices.clear();
-	Dart a = d;
-	do
-	{
-		VEC3 v1 = positions[a] - centerFace;
-		v1.normalize();
-		Dart e = map.phi1(a);
-		VEC3 v2 = positions[e] - centerFace;
-		v2.normalize();
-		VEC3 N = v1^v2;
-		normals.push_back(N);
-		vertices.push_back(positions[a]);
-		a = e;
-	} while (a != d);
-	
-	unsigned int nb = uint32(normals.size());
-	VEC3 Ntemp = normals[0];
-	normals[0] += normals[nb-1];
-	normals[0].normalize();
-	for (unsigned int i=1; i!=nb ; ++i)
+	typedef typename PFP::MAP MAP;
+
+	nbTris = 0;
+	nbLines = 0;
+	map.template foreach_dart_of_orbit<VOLUME>(v, [&] (Dart d)
 	{
-		VEC3 Ntemp2 = normals[i];
-		normals[i] += Ntemp;
-		normals[i].normalize();
-		Ntemp = Ntemp2;
-	}
+		if (isFirstDartOfOrbit<MAP::EDGE_OF_PARENT>(map, d))
+			++nbLines;
+		if (isFirstDartOfOrbit<MAP::FACE_OF_PARENT>(map, d))
+		{
+			unsigned int nbs = 0;
+			Dart e = d;
+			do
+			{
+				++nbs;
+				e = map.phi1(e);
+			} while (e != d);
+			// triangles are drawn directly, other faces are cut with their center
+			nbTris += (nbs == 3) ? 1 : nbs;
+		}
+	});
 }
 
-//template<typename PFP>
-//void ExplodeVolumeRender::updateSmooth(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& positions, const VolumeAttribute<typename PFP::VEC3>& colorPerXXX)
-//{
-//    updateSmoothGen<PFP, VertexAttribute<typename PFP::VEC3>, typename PFP::VEC3>(map,positions,colorPerXXX);
-//}
-
-template<typename PFP, typename V_ATT, typename W_ATT>
-void ExplodeVolumeRender::updateSmooth(typename PFP::MAP& map, const V_ATT& positions, const W_ATT& colorPerXXX)
+template<typename PFP, typename V_ATT, typename COLFUNC>
+void ExplodeVolumeRender::computeVolume(typename PFP::MAP& map, Dart v, const V_ATT& positions, const COLFUNC& colorOf,
+										Geom::Vec3f* bufPos, Geom::Vec3f* bufColors, Geom::Vec3f* bufNormals, Geom::Vec3f* bufLines)
 {
 	typedef typename V_ATT::DATA_TYPE VEC3;
-	typedef typename W_ATT::DATA_TYPE COL3;
 	typedef typename PFP::MAP MAP;
-	typedef typename PFP::REAL REAL;
 	typedef Geom::Vec3f VEC3F;
 
-	VolumeAutoAttribute<VEC3, MAP> centerVolumes(map, "centerVolumes");
-	Algo::Volume::Geometry::Parallel::computeCentroidELWVolumes<PFP>(map, positions, centerVolumes);
-
-	std::vector<VEC3F> buffer;
-	buffer.reserve(16384);
+	VEC3F centerVolume = PFP::toVec3f(Algo::Surface::Geometry::volumeCentroidELW<PFP>(map, v, positions));
 
-	std::vector<VEC3F> bufferColors;
-	bufferColors.reserve(16384);
-	std::vector<VEC3F> bufferNormals;
-	bufferNormals.reserve(16384);
-	
-	std::vector<VEC3> normals;
-	normals.reserve(20);
-	std::vector<VEC3> vertices;
-	vertices.reserve(20);
-
-//	TraversorCell<MAP, MAP::FACE_OF_PARENT> traFace(map);
-	foreach_cell<MAP::FACE_OF_PARENT>(map, [&] (Cell<MAP::FACE_OF_PARENT> d)
+	map.template foreach_dart_of_orbit<VOLUME>(v, [&] (Dart d)
 	{
-		// compute normals
-		VEC3 centerFace = Algo::Surface::Geometry::faceCentroidELW<PFP>(map, d.dart, positions);
-		VEC3 centerNormalFace = Algo::Surface::Geometry::newellNormal<PFP>(map, d.dart, positions);
-		
-		computeFace<PFP>(map,d,positions,centerFace,centerNormalFace,vertices,normals);
-		
-		VEC3F volCol = PFP::toVec3f(colorPerXXX[d.dart]);
-
-		unsigned int nbs = uint32(vertices.size());
-		// just to have more easy algo further
-		vertices.push_back(vertices.front());
-		normals.push_back(normals.front());
-		
-		typename std::vector<VEC3>::iterator iv  = vertices.begin();
-		typename std::vector<VEC3>::iterator in  = normals.begin();
-		
-		if (nbs == 3)
-		{
-			buffer.push_back(PFP::toVec3f(centerVolumes[d.dart]));
-			bufferColors.push_back(PFP::toVec3f(centerFace));
-			bufferNormals.push_back(PFP::toVec3f(centerNormalFace)); // unsused just for fill
-			
-			buffer.push_back(PFP::toVec3f(*iv++));
-			bufferNormals.push_back(PFP::toVec3f(*in++));
-			bufferColors.push_back(volCol);
-			
-			buffer.push_back(PFP::toVec3f(*iv++));
-			bufferNormals.push_back(PFP::toVec3f(*in++));
-			bufferColors.push_back(volCol);
-
-			buffer.push_back(PFP::toVec3f(*iv++));
-			bufferNormals.push_back(PFP::toVec3f(*in++));
-			bufferColors.push_back(volCol);
-		}
-		else
+		if (isFirstDartOfOrbit<MAP::EDGE_OF_PARENT>(map, d))
 		{
-			for (unsigned int i=0; i<nbs; ++i)
-			{
-				buffer.push_back(PFP::toVec3f(centerVolumes[d.dart]));
-				bufferColors.push_back(PFP::toVec3f(centerFace));
-				bufferNormals.push_back(PFP::toVec3f(centerNormalFace)); // unsused just for fill
-
-				buffer.push_back(PFP::toVec3f(centerFace));
-				bufferColors.push_back(volCol);
-				bufferNormals.push_back(PFP::toVec3f(centerNormalFace));
-				
-				buffer.push_back(PFP::toVec3f(*iv++));
-				bufferNormals.push_back(PFP::toVec3f(*in++));
-				bufferColors.push_back(volCol);
-				
-				buffer.push_back(PFP::toVec3f(*iv));
-				bufferNormals.push_back(PFP::toVec3f(*in));
-				bufferColors.push_back(volCol);
-			}
+			*bufLines++ = centerVolume;
+			*bufLines++ = PFP::toVec3f(positions[d]);
+			*bufLines++ = PFP::toVec3f(positions[map.phi1(d)]);
 		}
-	});
-//	,false); ????
 
-	m_nbTris = GLuint(buffer.size()/4);
+		if (!isFirstDartOfOrbit<MAP::FACE_OF_PARENT>(map, d))
+			return;
 
-	m_vboPos->allocate(uint32(buffer.size()));
-	VEC3F* ptrPos = reinterpret_cast<VEC3F*>(m_vboPos->lockPtr());
-	memcpy(ptrPos,&buffer[0],buffer.size()*sizeof(VEC3F));
-	m_vboPos->releasePtr();
-	m_shaderS->setAttributePosition(m_vboPos);
-
-	m_vboColors->allocate(uint32(bufferColors.size()));
-	VEC3F* ptrCol = reinterpret_cast<VEC3F*>(m_vboColors->lockPtr());
-	memcpy(ptrCol,&bufferColors[0],bufferColors.size()*sizeof(VEC3F));
-	m_vboColors->releasePtr();
-	m_shaderS->setAttributeColor(m_vboColors);
-
-	m_vboNormals->allocate(uint32(bufferNormals.size()));
-	VEC3F* ptrNorm = reinterpret_cast<VEC3F*>(m_vboNormals->lockPtr());
-	memcpy(ptrNorm,&bufferNormals[0],bufferNormals.size()*sizeof(VEC3F));
-	m_vboNormals->releasePtr();
-	m_shaderS->setAttributeNormal(m_vboNormals);
-
-	buffer.clear();
-
-//	TraversorCell<typename PFP::MAP, PFP::MAP::EDGE_OF_PARENT> traEdge(map);
-	foreach_cell<PFP::MAP::EDGE_OF_PARENT>(map, [&] (Cell<PFP::MAP::EDGE_OF_PARENT> c)
-	{
-			buffer.push_back(PFP::toVec3f(centerVolumes[c.dart]));
-			buffer.push_back(PFP::toVec3f(positions[c.dart]));
-			buffer.push_back(PFP::toVec3f(positions[map.phi1(c)]));
-	});
-	//	,false); ????
-
-	m_nbLines = GLuint(buffer.size()/3);
-
-	m_vboPosLine->allocate(uint32(buffer.size()));
-
-	ptrPos = reinterpret_cast<VEC3F*>(m_vboPosLine->lockPtr());
-	memcpy(ptrPos,&buffer[0],buffer.size()*sizeof(VEC3F));
+		// color read on a dart of the face: works with volume or face attributes
+		VEC3F faceColor = colorOf(d);
+		VEC3 centerFace = Algo::Surface::Geometry::faceCentroidELW<PFP>(map, d, positions);
+		VEC3F centerFaceF = PFP::toVec3f(centerFace);
 
-	m_vboPosLine->releasePtr();
-	m_shaderL->setAttributePosition(m_vboPosLine);
-}
+		Dart b = d;
+		Dart c = map.phi1(b);
+		bool triangle = (map.phi1(map.phi1(c)) == d);
 
+		if (bufNormals == NULL)
+		{
+			if (triangle)
+			{
+				*bufPos++ = centerVolume;
+				*bufColors++ = centerFaceF;
+				*bufPos++ = PFP::toVec3f(positions[b]);
+				*bufColors++ = faceColor;
+				*bufPos++ = PFP::toVec3f(positions[c]);
+				*bufColors++ = faceColor;
+				*bufPos++ = PFP::toVec3f(positions[map.phi1(c)]);
+				*bufColors++ = faceColor;
+			}
+			else
+			{
+				// loop to cut a polygon in triangle on the fly (center point method)
+				do
+				{
+					*bufPos++ = centerVolume;
+					*bufColors++ = centerFaceF;
+					*bufPos++ = centerFaceF;
+					*bufColors++ = faceColor;
+					*bufPos++ = PFP::toVec3f(positions[b]);
+					*bufColors++ = faceColor;
+					*bufPos++ = PFP::toVec3f(positions[c]);
+					*bufColors++ = faceColor;
+					b = c;
+					c = map.phi1(b);
+				} while (b != d);
+			}
+			return;
+		}
 
-//template<typename PFP>
-//void ExplodeVolumeRender::updateSmooth(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& positions)
-//{
-//    updateSmoothGen<PFP, VertexAttribute<typename PFP::VEC3>, typename PFP::VEC3>(map, positions);
-//}
+		// smooth: normal of a corner is the sum of the normals of its two triangles (center of face method)
+		VEC3F centerNormalFace = PFP::toVec3f(Algo::Surface::Geometry::newellNormal<PFP>(map, d, positions));
+		auto triNormal = [&] (Dart a) -> VEC3
+		{
+			VEC3 v1 = positions[a] - centerFace;
+			v1.normalize();
+			VEC3 v2 = positions[map.phi1(a)] - centerFace;
+			v2.normalize();
+			return v1 ^ v2;
+		};
+		auto cornerNormal = [&] (Dart a) -> VEC3F
+		{
+			VEC3 N = triNormal(a);
+			N += triNormal(map.phi_1(a));
+			N.normalize();
+			return PFP::toVec3f(N);
+		};
 
-template<typename PFP, typename EMBV>
-void ExplodeVolumeRender::updateSmooth(typename PFP::MAP& map, const EMBV& positions)
-{
-	typedef typename EMBV::DATA_TYPE VEC3;
-	typedef typename PFP::MAP MAP;
-	typedef typename PFP::REAL REAL;
-	typedef typename Geom::Vec3f VEC3F;
-
-	VolumeAutoAttribute<VEC3, MAP> centerVolumes(map, "centerVolumes");
-	Algo::Volume::Geometry::Parallel::computeCentroidELWVolumes<PFP>(map, positions, centerVolumes);
-
-	std::vector<VEC3F> buffer;
-	buffer.reserve(16384);
-
-	std::vector<VEC3F> bufferColors;
-	bufferColors.reserve(16384);
-	std::vector<VEC3F> bufferNormals;
-	bufferNormals.reserve(16384);
-	
-	std::vector<VEC3> normals;
-	bufferNormals.reserve(20);
-	std::vector<VEC3> vertices;
-	bufferNormals.reserve(20);
-
-//	TraversorCell<MAP, MAP::FACE_OF_PARENT> traFace(map);
-//	for (Dart d = traFace.begin(); d != traFace.end(); d = traFace.next())
-	foreach_cell<MAP::FACE_OF_PARENT>(map, [&] (Cell<MAP::FACE_OF_PARENT> fop)
-	{
-		Dart d = fop.dart;
-		// compute normals
-		VEC3 centerFace = Algo::Surface::Geometry::faceCentroidELW<PFP>(map, d, positions);
-		VEC3 centerNormalFace = Algo::Surface::Geometry::newellNormal<PFP>(map, d, positions);
-
-		computeFace<PFP>(map,d,positions,centerFace,centerNormalFace,vertices,normals);
-		
-		unsigned int nbs = uint32(vertices.size());
-		// just to have more easy algo further
-		vertices.push_back(vertices.front());
-		normals.push_back(normals.front());
-		
-		typename std::vector<VEC3>::iterator iv  = vertices.begin();
-		typename std::vector<VEC3>::iterator in  = normals.begin();
-		
-		if (nbs == 3)
+		if (triangle)
 		{
-			buffer.push_back(PFP::toVec3f(centerVolumes[d]));
-			bufferColors.push_back(PFP::toVec3f(centerFace));
-			bufferNormals.push_back(PFP::toVec3f(centerNormalFace)); // unsused just for fill
-
-			buffer.push_back(PFP::toVec3f(*iv++));
-			bufferNormals.push_back(PFP::toVec3f(*in++));
-			bufferColors.push_back(m_globalColor);
-			
-			buffer.push_back(PFP::toVec3f(*iv++));
-			bufferNormals.push_back(PFP::toVec3f(*in++));
-			bufferColors.push_back(m_globalColor);
-
-			buffer.push_back(PFP::toVec3f(*iv++));
-			bufferNormals.push_back(PFP::toVec3f(*in++));
-			bufferColors.push_back(m_globalColor);
+			*bufPos++ = centerVolume;
+			*bufColors++ = centerFaceF;
+			*bufNormals++ = centerNormalFace; // unused just for fill
+			do
+			{
+				*bufPos++ = PFP::toVec3f(positions[b]);
+				*bufColors++ = faceColor;
+				*bufNormals++ = cornerNormal(b);
+				b = map.phi1(b);
+			} while (b != d);
 		}
 		else
 		{
-			for (unsigned int i=0; i<nbs; ++i)
+			VEC3F nb = cornerNormal(b);
+			do
 			{
-				buffer.push_back(PFP::toVec3f(centerVolumes[d]));
-				bufferColors.push_back(PFP::toVec3f(centerFace));
-				bufferNormals.push_back(PFP::toVec3f(centerNormalFace)); // unsused just for fill
-
-				buffer.push_back(PFP::toVec3f(centerFace));
-				bufferColors.push_back(m_globalColor);
-				bufferNormals.push_back(PFP::toVec3f(centerNormalFace));
-				
-				buffer.push_back(PFP::toVec3f(*iv++));
-				bufferNormals.push_back(PFP::toVec3f(*in++));
-				bufferColors.push_back(m_globalColor);
-				
-				buffer.push_back(PFP::toVec3f(*iv));
-				bufferNormals.push_back(PFP::toVec3f(*in));
-				bufferColors.push_back(m_globalColor);
-			}
+				VEC3F nc = cornerNormal(c);
+				*bufPos++ = centerVolume;
+				*bufColors++ = centerFaceF;
+				*bufNormals++ = centerNormalFace; // unused just for fill
+				*bufPos++ = centerFaceF;
+				*bufColors++ = faceColor;
+				*bufNormals++ = centerNormalFace;
+				*bufPos++ = PFP::toVec3f(positions[b]);
+				*bufColors++ = faceColor;
+				*bufNormals++ = nb;
+				*bufPos++ = PFP::toVec3f(positions[c]);
+				*bufColors++ = faceColor;
+				*bufNormals++ = nc;
+				nb = nc;
+				b = c;
+				c = map.phi1(b);
+			} while (b != d);
 		}
-	}); // false) ???
-	
-	m_nbTris = uint32(buffer.size()/4);
-
-	m_vboPos->allocate(uint32(buffer.size()));
-	VEC3F* ptrPos = reinterpret_cast<VEC3F*>(m_vboPos->lockPtr());
-	memcpy(ptrPos,&buffer[0],buffer.size()*sizeof(VEC3F));
-	m_vboPos->releasePtr();
-	m_shaderS->setAttributePosition(m_vboPos);
-
-	m_vboColors->allocate(uint32(bufferColors.size()));
-	VEC3F* ptrCol = reinterpret_cast<VEC3F*>(m_vboColors->lockPtr());
-	memcpy(ptrCol,&bufferColors[0],bufferColors.size()*sizeof(VEC3F));
-	m_vboColors->releasePtr();
-	m_shaderS->setAttributeColor(m_vboColors);
+	});
+}
 
-	m_vboNormals->allocate(uint32(bufferNormals.size()));
-	VEC3F* ptrNorm = reinterpret_cast<VEC3F*>(m_vboNormals->lockPtr());
-	memcpy(ptrNorm,&bufferNormals[0],bufferNormals.size()*sizeof(VEC3F));
-	m_vboNormals->releasePtr();
-	m_shaderS->setAttributeNormal(m_vboNormals);
+template<typename PFP, typename V_ATT, typename COLFUNC>
+void ExplodeVolumeRender::updateAll(typename PFP::MAP& map, const V_ATT& positions, const COLFUNC& colorOf)
+{
+	CGoGN_SCOPED_TIMER("Algo::Render::GL2::ExplodeVolumeRender::updateData");
 
-	buffer.clear();
+	typedef typename PFP::MAP MAP;
+	typedef Geom::Vec3f VEC3F;
 
-//	TraversorCell<typename PFP::MAP, PFP::MAP::EDGE_OF_PARENT> traEdge(map);
-//	for (Dart d = traEdge.begin(); d != traEdge.end(); d = traEdge.next())
-	foreach_cell<MAP::EDGE_OF_PARENT>(map, [&] (Cell<MAP::EDGE_OF_PARENT> c)
+	// ranks are needed by updateVolumes to find the part of the buffers of a volume
+	m_rankPerDart = !map.template isOrbitEmbedded<VOLUME>();
+	if (m_rankPerDart)
+		m_volumeRank.assign(map.template getAttributeContainer<DART>().end(), 0xffffffff);
+	else
+		m_volumeRank.assign(map.template getAttributeContainer<VOLUME>().end(), 0xffffffff);
+
+	std::vector<Dart> volumes;
+	TraversorCell<MAP, VOLUME> traVol(map);
+	for (Dart d = traVol.begin(); d != traVol.end(); d = traVol.next())
+		volumes.push_back(d);
+	const unsigned int nbv = uint32(volumes.size());
+
+	// first pass: count the primitives of each volume, then prefix sums
+	m_volumeFirstTri.assign(nbv + 1, 0);
+	m_volumeFirstLine.assign(nbv + 1, 0);
+	CGoGN::Parallel::foreach_index(map, nbv, [&] (unsigned int i, unsigned int)
 	{
-			buffer.push_back(PFP::toVec3f(centerVolumes[c.dart]));
-			buffer.push_back(PFP::toVec3f(positions[c.dart]));
-			buffer.push_back(PFP::toVec3f(positions[map.phi1(c.dart)]));
+		countVolume<PFP>(map, volumes[i], m_volumeFirstTri[i+1], m_volumeFirstLine[i+1]);
+		if (m_rankPerDart)
+			map.template foreach_dart_of_orbit<VOLUME>(volumes[i], [&] (Dart d) { m_volumeRank[map.dartIndex(d)] = i; });
+		else
+			m_volumeRank[map.template getEmbedding<VOLUME>(volumes[i])] = i;
 	});
+	for (unsigned int i = 0; i < nbv; ++i)
+	{
+		m_volumeFirstTri[i+1] += m_volumeFirstTri[i];
+		m_volumeFirstLine[i+1] += m_volumeFirstLine[i];
+	}
+
+	m_nbTris = m_volumeFirstTri[nbv];
+	m_nbLines = m_volumeFirstLine[nbv];
 
-	m_nbLines = GLuint(buffer.size()/3);
+	m_vboPos->allocate(4*m_nbTris);
+	m_vboColors->allocate(4*m_nbTris);
+	if (m_smooth)
+		m_vboNormals->allocate(4*m_nbTris);
+	m_vboPosLine->allocate(3*m_nbLines);
 
-	m_vboPosLine->allocate(uint32(buffer.size()));
+	// second pass: each volume writes its part of the mapped buffers
+	if (m_nbTris > 0)
+	{
+		VEC3F* ptrPos = reinterpret_cast<VEC3F*>(m_vboPos->lockPtr());
+		VEC3F* ptrCol = reinterpret_cast<VEC3F*>(m_vboColors->lockPtr());
+		VEC3F* ptrNorm = m_smooth ? reinterpret_cast<VEC3F*>(m_vboNormals->lockPtr()) : NULL;
+		VEC3F* ptrLine = reinterpret_cast<VEC3F*>(m_vboPosLine->lockPtr());
 
-	ptrPos = reinterpret_cast<VEC3F*>(m_vboPosLine->lockPtr());
-	memcpy(ptrPos,&buffer[0],buffer.size()*sizeof(VEC3F));
+		CGoGN::Parallel::foreach_index(map, nbv, [&] (unsigned int i, unsigned int)
+		{
+			unsigned int t = 4*m_volumeFirstTri[i];
+			computeVolume<PFP>(map, volumes[i], positions, colorOf,
+							   ptrPos + t, ptrCol + t, ptrNorm != NULL ? ptrNorm + t : NULL, ptrLine + 3*m_volumeFirstLine[i]);
+		});
+
+		m_vboPos->releasePtr();
+		m_vboColors->releasePtr();
+		if (m_smooth)
+			m_vboNormals->releasePtr();
+		m_vboPosLine->releasePtr();
+	}
 
-	m_vboPosLine->releasePtr();
+	if (m_smooth)
+	{
+		m_shaderS->setAttributePosition(m_vboPos);
+		m_shaderS->setAttributeColor(m_vboColors);
+		m_shaderS->setAttributeNormal(m_vboNormals);
+	}
+	else
+	{
+		m_shader->setAttributePosition(m_vboPos);
+		m_shader->setAttributeColor(m_vboColors);
+	}
 	m_shaderL->setAttributePosition(m_vboPosLine);
 }
 
-
-
-//template<typename PFP>
-//void ExplodeVolumeRender::updateData(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& positions, const VolumeAttribute<typename PFP::VEC3>& colorPerXXX)
-//{
-//    updateDataGen<PFP,  const VertexAttribute<typename PFP::VEC3>, typename PFP::VEC3>(map, positions, colorPerXXX);
-//}
-
-template<typename PFP, typename V_ATT, typename W_ATT>
-void ExplodeVolumeRender::updateData(typename PFP::MAP& map, const V_ATT& positions, const W_ATT& colorPerXXX)
+template<typename PFP, typename V_ATT, typename COLFUNC>
+void ExplodeVolumeRender::updatePart(typename PFP::MAP& map, const V_ATT& positions, const COLFUNC& colorOf, const std::vector<Dart>& volumes)
 {
-	if (!m_cpf)
+	typedef Geom::Vec3f VEC3F;
+
+	if (m_volumeFirstTri.empty() || (!m_rankPerDart && !map.template isOrbitEmbedded<VOLUME>()))
 	{
-		CGoGNerr<< "ExplodeVolumeRender: problem wrong update fonction use the other (without VolumeAttribute parameter)" << CGoGNendl;
+		CGoGNerr << "ExplodeVolumeRender::updateVolumes: call updateData first" << CGoGNendl;
 		return;
 	}
 
-	if (m_smooth)
+	// ranks of the volumes to update (with one of their darts), each one once
+	std::vector< std::pair<unsigned int, Dart> > ranks;
+	ranks.reserve(volumes.size());
+	for (std::vector<Dart>::const_iterator it = volumes.begin(); it != volumes.end(); ++it)
 	{
-		updateSmooth<PFP>(map,positions,colorPerXXX);
-		return;
+		unsigned int idx = m_rankPerDart ? map.dartIndex(*it) : map.template getEmbedding<VOLUME>(*it);
+		if (idx >= m_volumeRank.size() || m_volumeRank[idx] == 0xffffffff)
+		{
+			CGoGNerr << "ExplodeVolumeRender::updateVolumes: unknown volume, topology changed since last updateData" << CGoGNendl;
+			return;
+		}
+		ranks.push_back(std::make_pair(m_volumeRank[idx], *it));
 	}
+	std::sort(ranks.begin(), ranks.end(), [] (const std::pair<unsigned int, Dart>& a, const std::pair<unsigned int, Dart>& b)
+	{
+		return a.first < b.first;
+	});
+	ranks.erase(std::unique(ranks.begin(), ranks.end(), [] (const std::pair<unsigned int, Dart>& a, const std::pair<unsigned int, Dart>& b)
+	{
+		return a.first == b.first;
+	}), ranks.end());
+	const unsigned int nbr = uint32(ranks.size());
+	if (nbr == 0 || m_nbTris == 0)
+		return;
 
-    //typedef typename PFP::VEC3 VEC3;
-	typedef typename V_ATT::DATA_TYPE VEC3;
-	typedef typename PFP::MAP MAP;
-	typedef typename PFP::REAL REAL;
-	typedef Geom::Vec3f VEC3F;
-
-	VolumeAutoAttribute<VEC3, MAP> centerVolumes(map, "centerVolumes");
-	Algo::Volume::Geometry::Parallel::computeCentroidELWVolumes<PFP>(map, positions, centerVolumes);
-
-	std::vector<VEC3F> buffer;
-	buffer.reserve(16384);
-
-	std::vector<VEC3F> bufferColors;
-
-	bufferColors.reserve(16384);
+	VEC3F* ptrPos = reinterpret_cast<VEC3F*>(m_vboPos->lockPtr());
+	VEC3F* ptrCol = reinterpret_cast<VEC3F*>(m_vboColors->lockPtr());
+	VEC3F* ptrNorm = m_smooth ? reinterpret_cast<VEC3F*>(m_vboNormals->lockPtr()) : NULL;
+	VEC3F* ptrLine = reinterpret_cast<VEC3F*>(m_vboPosLine->lockPtr());
 
-//	TraversorCell<MAP, MAP::FACE_OF_PARENT> traFace(map);
-	foreach_cell<MAP::FACE_OF_PARENT>(map, [&] (Cell<MAP::FACE_OF_PARENT> d)
+	std::vector<unsigned char> changed(nbr, 0);
+	CGoGN::Parallel::foreach_index(map, nbr, [&] (unsigned int i, unsigned int)
 	{
-		VEC3F centerFace = PFP::toVec3f(Algo::Surface::Geometry::faceCentroidELW<PFP>(map, d.dart, positions));
-		VEC3F volColor = PFP::toVec3f(colorPerXXX[d.dart]);
-		
-		Dart b = d;
-		Dart c = map.phi1(b);
-		Dart a = map.phi1(c);
-		
-		if (map.phi1(a) == d)
+		unsigned int r = ranks[i].first;
+		Dart v = ranks[i].second;
+		unsigned int nbTris;
+		unsigned int nbLines;
+		countVolume<PFP>(map, v, nbTris, nbLines);
+		if (nbTris != m_volumeFirstTri[r+1] - m_volumeFirstTri[r] || nbLines != m_volumeFirstLine[r+1] - m_volumeFirstLine[r])
 		{
-			buffer.push_back(PFP::toVec3f(centerVolumes[d.dart]));
-			bufferColors.push_back(centerFace);
-			
-			buffer.push_back(PFP::toVec3f(positions[b]));
-			bufferColors.push_back(volColor);
-			buffer.push_back(PFP::toVec3f(positions[c]));
-			bufferColors.push_back(volColor);
-			c = map.phi1(c);
-			buffer.push_back(PFP::toVec3f(positions[c]));
-			bufferColors.push_back(volColor);
-		}
-		else
-		{
-	
-			// loop to cut a polygon in triangle on the fly (ceter point method)
-			do
-			{
-				buffer.push_back(PFP::toVec3f(centerVolumes[d.dart]));
-				bufferColors.push_back(centerFace);
-				
-				buffer.push_back(centerFace);
-				bufferColors.push_back(volColor);
-				
-				buffer.push_back(PFP::toVec3f(positions[b]));
-				bufferColors.push_back(volColor);
-				buffer.push_back(PFP::toVec3f(positions[c]));
-				bufferColors.push_back(volColor);
-				b = c;
-				c = map.phi1(b);
-			} while (b != d);
+			changed[i] = 1;
+			return;
 		}
+		unsigned int t = 4*m_volumeFirstTri[r];
+		computeVolume<PFP>(map, v, positions, colorOf,
+						   ptrPos + t, ptrCol + t, ptrNorm != NULL ? ptrNorm + t : NULL, ptrLine + 3*m_volumeFirstLine[r]);
 	});
 
-	m_nbTris = GLuint(buffer.size()/4);
-
-	m_vboPos->allocate(uint32(buffer.size()));
-	VEC3F* ptrPos = reinterpret_cast<VEC3F*>(m_vboPos->lockPtr());
-	memcpy(ptrPos,&buffer[0],buffer.size()*sizeof(VEC3F));
 	m_vboPos->releasePtr();
-	m_shader->setAttributePosition(m_vboPos);
-
-	m_vboColors->allocate(uint32(bufferColors.size()));
-	VEC3F* ptrCol = reinterpret_cast<VEC3F*>(m_vboColors->lockPtr());
-	memcpy(ptrCol,&bufferColors[0],bufferColors.size()*sizeof(VEC3F));
 	m_vboColors->releasePtr();
-	m_shader->setAttributeColor(m_vboColors);
-
-	buffer.clear();
-
-//	TraversorCell<typename PFP::MAP, PFP::MAP::EDGE_OF_PARENT> traEdge(map);
-//	for (Dart d = traEdge.begin(); d != traEdge.end(); d = traEdge.next())
-	foreach_cell<MAP::EDGE_OF_PARENT>(map, [&] (Cell<MAP::EDGE_OF_PARENT> c)
-	{			buffer.push_back(PFP::toVec3f(centerVolumes[c.dart]));
-			buffer.push_back(PFP::toVec3f(positions[c.dart]));
-			buffer.push_back(PFP::toVec3f(positions[map.phi1(c)]));
-	}); // false ???
-
-	m_nbLines = GLuint(buffer.size()/3);
-
-	m_vboPosLine->allocate(uint32(buffer.size()));
-
-	ptrPos = reinterpret_cast<VEC3F*>(m_vboPosLine->lockPtr());
-	memcpy(ptrPos,&buffer[0],buffer.size()*sizeof(VEC3F));
-
+	if (m_smooth)
+		m_vboNormals->releasePtr();
 	m_vboPosLine->releasePtr();
-	m_shaderL->setAttributePosition(m_vboPosLine);
-}
 
-//template<typename PFP>
-//void ExplodeVolumeRender::updateData(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& positions)
-//{
-//    updateDataGen<PFP, VertexAttribute<typename PFP::VEC3>, typename PFP::VEC3>(map, positions);
-//}
+	if (std::find(changed.begin(), changed.end(), 1) != changed.end())
+		CGoGNerr << "ExplodeVolumeRender::updateVolumes: topology of some volumes changed since last updateData, they are not updated" << CGoGNendl;
+}
 
-template<typename PFP, typename EMBV>
-void ExplodeVolumeRender::updateData(typename PFP::MAP& map, const EMBV& positions)
+template<typename PFP, typename V_ATT, typename W_ATT>
+void ExplodeVolumeRender::updateData(typename PFP::MAP& map, const V_ATT& positions, const W_ATT& colorPerXXX)
 {
-	if (m_smooth)
+	if (!m_cpf)
 	{
-		updateSmooth<PFP, EMBV>(map,positions);
+		CGoGNerr<< "ExplodeVolumeRender: problem wrong update fonction use the other (without VolumeAttribute parameter)" << CGoGNendl;
 		return;
 	}
 
-	typedef typename EMBV::DATA_TYPE VEC3;
-	typedef typename PFP::MAP MAP;
-	typedef typename PFP::REAL REAL;
-	typedef Geom::Vec3f VEC3F;
-
-	VolumeAutoAttribute<VEC3, MAP> centerVolumes(map, "centerVolumes");
-	Algo::Volume::Geometry::Parallel::computeCentroidELWVolumes<PFP>(map, positions, centerVolumes);
-
-	std::vector<VEC3F> buffer;
-	buffer.reserve(16384);
-
-	std::vector<VEC3F> bufferColors;
-	bufferColors.reserve(16384);
-
-//	TraversorCell<MAP, MAP::FACE_OF_PARENT> traFace(map);
-	foreach_cell<MAP::FACE_OF_PARENT>(map, [&] (Cell<MAP::FACE_OF_PARENT> fop)
+	updateAll<PFP>(map, positions, [&] (Dart d) -> Geom::Vec3f
 	{
-		Dart d = fop.dart;
-		VEC3F centerFace = PFP::toVec3f(Algo::Surface::Geometry::faceCentroidELW<PFP>(map, d, positions));
-
-		Dart b = d;
-		Dart c = map.phi1(b);
-		Dart a = map.phi1(c);
-		
-		if (map.phi1(a) == d)
-		{
-			buffer.push_back(PFP::toVec3f(centerVolumes[d]));
-			bufferColors.push_back(centerFace);
-			
-			buffer.push_back(PFP::toVec3f(positions[b]));
-			bufferColors.push_back(m_globalColor);
-			buffer.push_back(PFP::toVec3f(positions[c]));
-			bufferColors.push_back(m_globalColor);
-			c = map.phi1(c);
-			buffer.push_back(PFP::toVec3f(positions[c]));
-			bufferColors.push_back(m_globalColor);	
-		}
-		else
-		{
-	
-			// loop to cut a polygon in triangle on the fly (ceter point method)
-			do
-			{
-				buffer.push_back(PFP::toVec3f(centerVolumes[d]));
-				bufferColors.push_back(centerFace);
-				
-				buffer.push_back(centerFace);
-				bufferColors.push_back(m_globalColor);
-				
-				buffer.push_back(PFP::toVec3f(positions[b]));
-				bufferColors.push_back(m_globalColor);
-				buffer.push_back(PFP::toVec3f(positions[c]));
-				bufferColors.push_back(m_globalColor);
-				b = c;
-				c = map.phi1(b);
-			} while (b != d);
-		}
+		return PFP::toVec3f(colorPerXXX[d]);
 	});
+}
 
-
-	m_nbTris = uint32(buffer.size()/4);
-
-	m_vboPos->allocate(uint32(buffer.size()));
-	VEC3F* ptrPos = reinterpret_cast<VEC3F*>(m_vboPos->lockPtr());
-	memcpy(ptrPos,&buffer[0],buffer.size()*sizeof(VEC3F));
-	m_vboPos->releasePtr();
-	m_shader->setAttributePosition(m_vboPos);
-
-	m_vboColors->allocate(uint32(bufferColors.size()));
-	VEC3F* ptrCol = reinterpret_cast<VEC3F*>(m_vboColors->lockPtr());
-	memcpy(ptrCol,&bufferColors[0],bufferColors.size()*sizeof(VEC3F));
-	m_vboColors->releasePtr();
-	m_shader->setAttributeColor(m_vboColors);
-
-	buffer.clear();
-
-//	TraversorCell<typename PFP::MAP, PFP::MAP::EDGE_OF_PARENT> traEdge(map);
-	foreach_cell<MAP::EDGE_OF_PARENT>(map, [&] (Cell<MAP::EDGE_OF_PARENT> c)
+template<typename PFP, typename EMBV>
+void ExplodeVolumeRender::updateData(typename PFP::MAP& map, const EMBV& positions)
+{
+	updateAll<PFP>(map, positions, [&] (Dart) -> Geom::Vec3f
 	{
-			buffer.push_back(PFP::toVec3f(centerVolumes[c.dart]));
-			buffer.push_back(PFP::toVec3f(positions[c.dart]));
-			buffer.push_back(PFP::toVec3f(positions[map.phi1(c)]));
+		return m_globalColor;
 	});
+}
 
-	m_nbLines = GLuint(buffer.size()/3);
-
-	m_vboPosLine->allocate(uint32(buffer.size()));
+template<typename PFP, typename V_ATT, typename W_ATT>
+void ExplodeVolumeRender::updateVolumes(typename PFP::MAP& map, const V_ATT& positions, const W_ATT& colorPerXXX, const std::vector<Dart>& volumes)
+{
+	if (!m_cpf)
+	{
+		CGoGNerr<< "ExplodeVolumeRender: problem wrong update fonction use the other (without VolumeAttribute parameter)" << CGoGNendl;
+		return;
+	}
 
-	ptrPos = reinterpret_cast<VEC3F*>(m_vboPosLine->lockPtr());
-	memcpy(ptrPos,&buffer[0],buffer.size()*sizeof(VEC3F));
+	updatePart<PFP>(map, positions, [&] (Dart d) -> Geom::Vec3f
+	{
+		return PFP::toVec3f(colorPerXXX[d]);
+	}, volumes);
+}
 
-	m_vboPosLine->releasePtr();
-	m_shaderL->setAttributePosition(m_vboPosLine);
+template<typename PFP, typename EMBV>
+void ExplodeVolumeRender::updateVolumes(typename PFP::MAP& map, const EMBV& positions, const std::vector<Dart>& volumes)
+{
+	updatePart<PFP>(map, positions, [&] (Dart) -> Geom::Vec3f
+	{
+		return m_globalColor;
+	}, volumes);
 }
 
 
@@ -34,6 +34,7 @@
 #include "Algo/Geometry/centroid.h"
 
 #include "Geometry/distances.h"
+#include "Utils/instrumentation.h"
 
 namespace CGoGN
 {
@@ -541,20 +542,14 @@ Dart Topo3Render<PFP>::picking(MAP& map, int x, int y)
 template<typename PFP>
 void Topo3RenderMap<PFP>::updateData(MAP& mapx, const VertexAttribute<VEC3, MAP>& positions, float ke, float kf, float kv)
 {
+	CGoGN_SCOPED_TIMER("Algo::Render::GL2::Topo3RenderMap::updateData");
+
 	this->m_attIndex = mapx.template getAttribute<unsigned int, DART, MAP>("dart_index3");
 
 	if (!this->m_attIndex.isValid())
 		this->m_attIndex  = mapx.template addAttribute<unsigned int, DART, MAP>("dart_index3");
 
-	this->m_nbDarts = 0;
-	for (Dart d = mapx.begin(); d != mapx.end(); mapx.next(d))
-	{
-		if (!mapx.template isBoundaryMarked<3>(d)) // in the following code Traversor do not traverse boundary
-			this->m_nbDarts++;
-	}
-
 	// compute center of each volumes
-	CellMarker<MAP, VOLUME> cmv(mapx);
 	VolumeAutoAttribute<VEC3, MAP> centerVolumes(mapx, "centerVolumes");
 
 	Algo::Volume::Geometry::Parallel::computeCentroidELWVolumes<PFP>(mapx, positions, centerVolumes);
@@ -568,73 +563,105 @@ void Topo3RenderMap<PFP>::updateData(MAP& mapx, const VertexAttribute<VEC3, MAP>
 	DartAutoAttribute<VEC3, MAP> fv2(mapx);
 	DartAutoAttribute<VEC3, MAP> fv2x(mapx);
 
+	// each face of each volume (Traversor do not traverse boundary)
+	std::vector<Dart> vecDartFaces;
+	TraversorCell<MAP, PFP::MAP::FACE_OF_PARENT> traFace(mapx);
+	for (Dart d = traFace.begin(); d != traFace.end(); d = traFace.next())
+		vecDartFaces.push_back(d);
+	const unsigned int nbf = uint32(vecDartFaces.size());
+
+	// first pass: count darts and relations of each face, prefix sums give where each face writes
+	std::vector<unsigned int> firstDart(nbf+1, 0);
+	std::vector<unsigned int> firstRel2(nbf+1, 0);
+	std::vector<unsigned int> firstRel3(nbf+1, 0);
+	CGoGN::Parallel::foreach_index(mapx, nbf, [&] (unsigned int i, unsigned int)
+	{
+		Dart d = vecDartFaces[i];
+		do
+		{
+			++firstDart[i+1];
+			Dart e = mapx.phi2(d);
+			if (d < e)
+				++firstRel2[i+1];
+			e = mapx.phi3(d);
+			if (!mapx.template isBoundaryMarked<3>(e) && (d < e))
+				++firstRel3[i+1];
+			d = mapx.phi1(d);
+		} while (d != vecDartFaces[i]);
+	});
+	for (unsigned int i = 0; i < nbf; ++i)
+	{
+		firstDart[i+1] += firstDart[i];
+		firstRel2[i+1] += firstRel2[i];
+		firstRel3[i+1] += firstRel3[i];
+	}
+
+	this->m_nbDarts = firstDart[nbf];
+	this->m_nbRel1 = firstDart[nbf];
+	this->m_nbRel2 = firstRel2[nbf];
+	this->m_nbRel3 = firstRel3[nbf];
+
 	this->m_vbo4->bind();
-	glBufferData(GL_ARRAY_BUFFER, 2*this->m_nbDarts*sizeof(VEC3), 0, GL_STREAM_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, 2*this->m_nbDarts*sizeof(Geom::Vec3f), 0, GL_STREAM_DRAW);
 	GLvoid* ColorDartsBuffer = glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
 	Geom::Vec3f* colorDartBuf = reinterpret_cast<Geom::Vec3f*>(ColorDartsBuffer);
 
 	this->m_vbo0->bind();
-	glBufferData(GL_ARRAY_BUFFER, 2*this->m_nbDarts*sizeof(VEC3), 0, GL_STREAM_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, 2*this->m_nbDarts*sizeof(Geom::Vec3f), 0, GL_STREAM_DRAW);
 	GLvoid* PositionDartsBuffer = glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
 	Geom::Vec3f* positionDartBuf = reinterpret_cast<Geom::Vec3f*>(PositionDartsBuffer);
 
-	std::vector<Dart> vecDartFaces;
-	vecDartFaces.reserve(this->m_nbDarts/3);
-	unsigned int posDBI = 0;
-
-	// traverse each face of each volume
-	TraversorCell<MAP, PFP::MAP::FACE_OF_PARENT> traFace(mapx);
-	for (Dart d = traFace.begin(); d != traFace.end(); d = traFace.next())
+	// second pass: darts of each face
+	CGoGN::Parallel::foreach_index(mapx, nbf, [&] (unsigned int i, unsigned int)
 	{
-		vecDartFaces.push_back(d);
-
-		std::vector<VEC3> vecPos;
-		vecPos.reserve(16);
+		Dart f = vecDartFaces[i];
 
 		// store the face & center
 		float okv = 1.0f - kv;
 
-		VEC3 vc = centerVolumes[d];
+		VEC3 vc = centerVolumes[f];
 
-		VEC3 centerFace = Algo::Surface::Geometry::faceCentroidELW<PFP>(mapx,d,positions)*kv +vc*okv;
+		VEC3 centerFace = Algo::Surface::Geometry::faceCentroidELW<PFP>(mapx,f,positions)*kv +vc*okv;
 
 		//shrink the face
 		float okf = 1.0f - kf;
-		Dart dd = d;
-		do
+		auto shrink = [&] (Dart dd) -> VEC3
 		{
-			VEC3 P = centerFace*okf + (vc*okv + positions[dd]*kv)*kf;
-			vecPos.push_back(P);
-			dd = mapx.phi1(dd);
-		} while (dd != d);
-
-		unsigned int nb = uint32(vecPos.size());
-
-		vecPos.push_back(vecPos.front()); // copy the first for easy computation on next loop
+			return centerFace*okf + (vc*okv + positions[dd]*kv)*kf;
+		};
 
 		// compute position of points to use for drawing topo
 		float oke = 1.0f - ke;
-		for (unsigned int i = 0; i < nb; ++i)
+		unsigned int posDBI = 2*firstDart[i];
+		VEC3 first = shrink(f);
+		VEC3 cur = first;
+		Dart d = f;
+		do
 		{
-			VEC3 P = vecPos[i]*ke + vecPos[i+1]*oke;
-			VEC3 Q = vecPos[i+1]*ke + vecPos[i]*oke;
+			Dart e = mapx.phi1(d);
+			VEC3 next = (e == f) ? first : shrink(e);
+
+			VEC3 P = cur*ke + next*oke;
+			VEC3 Q = next*ke + cur*oke;
 
 			this->m_attIndex[d] = posDBI;
-			posDBI+=2;
 
-			*positionDartBuf++ = PFP::toVec3f(P);
-			*positionDartBuf++ = PFP::toVec3f(Q);
-			*colorDartBuf++ = this->m_dartsColor;
-			*colorDartBuf++ = this->m_dartsColor;
+			positionDartBuf[posDBI] = PFP::toVec3f(P);
+			positionDartBuf[posDBI+1] = PFP::toVec3f(Q);
+			colorDartBuf[posDBI] = this->m_dartsColor;
+			colorDartBuf[posDBI+1] = this->m_dartsColor;
+			posDBI += 2;
 
 			fv1[d] = P*0.1f + Q*0.9f;
 			fv11[d] = P*0.9f + Q*0.1f;
 
 			fv2[d] = P*0.52f + Q*0.48f;
 			fv2x[d] = P*0.48f + Q*0.52f;
-			d = mapx.phi1(d);
-		}
-	}
+
+			cur = next;
+			d = e;
+		} while (d != f);
+	});
 
 	this->m_vbo0->bind();
 	glUnmapBuffer(GL_ARRAY_BUFFER);
@@ -642,62 +669,56 @@ void Topo3RenderMap<PFP>::updateData(MAP& mapx, const VertexAttribute<VEC3, MAP>
 	this->m_vbo4->bind();
 	glUnmapBuffer(GL_ARRAY_BUFFER);
 
-	Geom::Vec3f* positioniF1 = new Geom::Vec3f[ 2*this->m_nbDarts];
-	Geom::Vec3f* positioniF2 = new Geom::Vec3f[ 2*this->m_nbDarts];
-	Geom::Vec3f* positioniF3 = new Geom::Vec3f[ 2*this->m_nbDarts];
+	this->m_vbo1->bind();
+	glBufferData(GL_ARRAY_BUFFER, 2*this->m_nbRel1*sizeof(Geom::Vec3f), 0, GL_STREAM_DRAW);
+	Geom::Vec3f* positionF1 = reinterpret_cast<Geom::Vec3f*>(glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE));
 
-	Geom::Vec3f* positionF1 = positioniF1;
-	Geom::Vec3f* positionF2 = positioniF2;
-	Geom::Vec3f* positionF3 = positioniF3;
+	this->m_vbo2->bind();
+	glBufferData(GL_ARRAY_BUFFER, 2*this->m_nbRel2*sizeof(Geom::Vec3f), 0, GL_STREAM_DRAW);
+	Geom::Vec3f* positionF2 = reinterpret_cast<Geom::Vec3f*>(glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE));
 
-	this->m_nbRel1 = 0;
-	this->m_nbRel2 = 0;
-	this->m_nbRel3 = 0;
+	this->m_vbo3->bind();
+	glBufferData(GL_ARRAY_BUFFER, 2*this->m_nbRel3*sizeof(Geom::Vec3f), 0, GL_STREAM_DRAW);
+	Geom::Vec3f* positionF3 = reinterpret_cast<Geom::Vec3f*>(glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE));
 
-	for(std::vector<Dart>::iterator face = vecDartFaces.begin(); face != vecDartFaces.end(); ++face)
+	// third pass: relations (read the points of the neighbor darts computed in second pass)
+	CGoGN::Parallel::foreach_index(mapx, nbf, [&] (unsigned int i, unsigned int)
 	{
-		Dart d = *face;
+		Geom::Vec3f* pF1 = positionF1 + 2*firstDart[i];
+		Geom::Vec3f* pF2 = positionF2 + 2*firstRel2[i];
+		Geom::Vec3f* pF3 = positionF3 + 2*firstRel3[i];
+
+		Dart d = vecDartFaces[i];
 		do
 		{
 			Dart e = mapx.phi2(d);
 			if ((d < e))
 			{
-				*positionF2++ = PFP::toVec3f(fv2[d]);
-//				*positionF2++ = PFP::toVec3f(fv2x[e]);
-				*positionF2++ = PFP::toVec3f(fv2[e]);
-//				*positionF2++ = PFP::toVec3f(fv2x[d]);
-				this->m_nbRel2++;
+				*pF2++ = PFP::toVec3f(fv2[d]);
+				*pF2++ = PFP::toVec3f(fv2[e]);
 			}
 			e = mapx.phi3(d);
 			if (!mapx.template isBoundaryMarked<3>(e) && (d < e) )
 			{
-//				*positionF3++ = PFP::toVec3f(fv2[d]);
-				*positionF3++ = PFP::toVec3f(fv2x[e]);
-//				*positionF3++ = PFP::toVec3f(fv2[e]);
-				*positionF3++ = PFP::toVec3f(fv2x[d]);
-				this->m_nbRel3++;
+				*pF3++ = PFP::toVec3f(fv2x[e]);
+				*pF3++ = PFP::toVec3f(fv2x[d]);
 			}
 			e = mapx.phi1(d);
-			*positionF1++ = PFP::toVec3f(fv1[d]);
-			*positionF1++ = PFP::toVec3f(fv11[e]);
-			this->m_nbRel1++;
+			*pF1++ = PFP::toVec3f(fv1[d]);
+			*pF1++ = PFP::toVec3f(fv11[e]);
 
 			d = mapx.phi1(d);
-		} while (d != *face );
-	}
+		} while (d != vecDartFaces[i]);
+	});
 
 	this->m_vbo3->bind();
-	glBufferData(GL_ARRAY_BUFFER, 2*this->m_nbRel3*sizeof(Geom::Vec3f), positioniF3, GL_STREAM_DRAW);
+	glUnmapBuffer(GL_ARRAY_BUFFER);
 
 	this->m_vbo2->bind();
-	glBufferData(GL_ARRAY_BUFFER, 2*this->m_nbRel2*sizeof(Geom::Vec3f), positioniF2, GL_STREAM_DRAW);
+	glUnmapBuffer(GL_ARRAY_BUFFER);
 
 	this->m_vbo1->bind();
-	glBufferData(GL_ARRAY_BUFFER, 2*this->m_nbRel1*sizeof(Geom::Vec3f), positioniF1, GL_STREAM_DRAW);
-
-	delete[] positioniF1;
-	delete[] positioniF2;
-	delete[] positioniF3;
+	glUnmapBuffer(GL_ARRAY_BUFFER);
 }
 
 
@@ -705,9 +726,12 @@ void Topo3RenderMap<PFP>::updateData(MAP& mapx, const VertexAttribute<VEC3, MAP>
 
 
 
+
 template<typename PFP>
 void Topo3RenderGMap<PFP>::updateData(MAP& mapx, const VertexAttribute<VEC3, MAP>& positions, float ke, float kf, float kv)
 {
+	CGoGN_SCOPED_TIMER("Algo::Render::GL2::Topo3RenderGMap::updateData");
+
 //	GMap3& map = dynamic_cast<GMap3&>(mapx);	// TODO reflechir comment virer ce warning quand on compile avec PFP::MAP=Map3
 
 	if (this->m_attIndex.map() != &mapx)
@@ -715,13 +739,6 @@ void Topo3RenderGMap<PFP>::updateData(MAP& mapx, const VertexAttribute<VEC3, MAP
 	if (!this->m_attIndex.isValid())
 		this->m_attIndex = mapx.template addAttribute<unsigned int, DART, MAP>("dart_index3");
 
-	this->m_nbDarts = 0;
-	for (Dart d = mapx.begin(); d != mapx.end(); mapx.next(d))
-	{
-		if (!mapx.template isBoundaryMarked<3>(d)) // in the following code Traversor do not traverse boundary
-			this->m_nbDarts++;
-	}
-
 	// compute center of each volumes
 	VolumeAutoAttribute<VEC3, MAP> centerVolumes(mapx, "centerVolumes");
 	Algo::Volume::Geometry::Parallel::computeCentroidELWVolumes<PFP>(mapx, positions, centerVolumes);
@@ -732,73 +749,103 @@ void Topo3RenderGMap<PFP>::updateData(MAP& mapx, const VertexAttribute<VEC3, MAP
 	DartAutoAttribute<VEC3, MAP> fv2(mapx);
 	DartAutoAttribute<VEC3, MAP> fv2x(mapx);
 
+	//traverse each face of each volume (Traversor do not traverse boundary)
+	std::vector<Dart> vecDartFaces;
+	TraversorCell<MAP, PFP::MAP::FACE_OF_PARENT> traFace(mapx);
+	for (Dart d = traFace.begin(); d != traFace.end(); d = traFace.next())
+		vecDartFaces.push_back(d);
+	const unsigned int nbf = uint32(vecDartFaces.size());
+
+	// first pass: count edges (2 darts each) and relations of each face, prefix sums give where each face writes
+	std::vector<unsigned int> firstEdge(nbf+1, 0);
+	std::vector<unsigned int> firstRel2(nbf+1, 0);
+	std::vector<unsigned int> firstRel3(nbf+1, 0);
+	CGoGN::Parallel::foreach_index(mapx, nbf, [&] (unsigned int i, unsigned int)
+	{
+		Dart d = vecDartFaces[i];
+		do
+		{
+			++firstEdge[i+1];
+			Dart dx = mapx.beta0(d);
+			if (d < mapx.beta2(d))
+				++firstRel2[i+1];
+			if (dx < mapx.beta2(dx))
+				++firstRel2[i+1];
+			Dart e = mapx.beta3(d);
+			if (!mapx.template isBoundaryMarked<3>(e) && (d < e))
+				++firstRel3[i+1];
+			e = mapx.beta3(dx);
+			if (!mapx.template isBoundaryMarked<3>(e) && (dx < e))
+				++firstRel3[i+1];
+			d = mapx.phi1(d);
+		} while (d != vecDartFaces[i]);
+	});
+	for (unsigned int i = 0; i < nbf; ++i)
+	{
+		firstEdge[i+1] += firstEdge[i];
+		firstRel2[i+1] += firstRel2[i];
+		firstRel3[i+1] += firstRel3[i];
+	}
+
+	this->m_nbDarts = 2*firstEdge[nbf];
+	this->m_nbRel1 = firstEdge[nbf];
+	this->m_nbRel2 = firstRel2[nbf];
+	this->m_nbRel3 = firstRel3[nbf];
+
 	this->m_vbo4->bind();
 	glBufferData(GL_ARRAY_BUFFER, 2*this->m_nbDarts*sizeof(Geom::Vec3f), 0, GL_STREAM_DRAW);
 	GLvoid* ColorDartsBuffer = glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
 	Geom::Vec3f* colorDartBuf = reinterpret_cast<Geom::Vec3f*>(ColorDartsBuffer);
 
 	if (this->m_bufferDartPosition != NULL)
-		delete this->m_bufferDartPosition;
+		delete[] this->m_bufferDartPosition;
 	this->m_bufferDartPosition = new Geom::Vec3f[2*this->m_nbDarts];
 	Geom::Vec3f* positionDartBuf = reinterpret_cast<Geom::Vec3f*>(this->m_bufferDartPosition);
 
-
-
-	std::vector<Dart> vecDartFaces;
-	vecDartFaces.reserve(this->m_nbDarts/6);
-	unsigned int posDBI = 0;
-
-	//traverse each face of each volume
-	TraversorCell<MAP, PFP::MAP::FACE_OF_PARENT> traFace(mapx);
-	for (Dart d = traFace.begin(); d != traFace.end(); d = traFace.next())
+	// second pass: darts of each face
+	CGoGN::Parallel::foreach_index(mapx, nbf, [&] (unsigned int i, unsigned int)
 	{
-		vecDartFaces.push_back(d);
-
-		std::vector<VEC3> vecPos;
-		vecPos.reserve(16);
+		Dart f = vecDartFaces[i];
 
 		// store the face & center
 		float okv = 1.0f - kv;
 
-		VEC3 vc = centerVolumes[d];
-		
-		VEC3 centerFace = Algo::Surface::Geometry::faceCentroidELW<PFP>(mapx, d, positions)*kv +vc*okv;
+		VEC3 vc = centerVolumes[f];
+
+		VEC3 centerFace = Algo::Surface::Geometry::faceCentroidELW<PFP>(mapx, f, positions)*kv +vc*okv;
 
 		//shrink the face
 		float okf = 1.0f - kf;
-		Dart dd = d;
-		do
+		auto shrink = [&] (Dart dd) -> VEC3
 		{
-			VEC3 P = centerFace*okf + (vc*okv + positions[dd]*kv)*kf;
-			vecPos.push_back(P);
-			dd = mapx.phi1(dd);
-		} while (dd != d);
-		
-		unsigned int nb = uint32(vecPos.size());
-		
-		vecPos.push_back(vecPos.front()); // copy the first for easy computation on next loop
+			return centerFace*okf + (vc*okv + positions[dd]*kv)*kf;
+		};
 
 		// compute position of points to use for drawing topo
 		float oke = 1.0f - ke;
-		for (unsigned int i = 0; i < nb; ++i)
+		unsigned int posDBI = 4*firstEdge[i];
+		VEC3 first = shrink(f);
+		VEC3 cur = first;
+		Dart d = f;
+		do
 		{
-			VEC3 P = vecPos[i]*ke + vecPos[i+1]*oke;
-			VEC3 Q = vecPos[i+1]*ke + vecPos[i]*oke;
+			Dart e = mapx.phi1(d);
+			VEC3 next = (e == f) ? first : shrink(e);
+
+			VEC3 P = cur*ke + next*oke;
+			VEC3 Q = next*ke + cur*oke;
 
 			VEC3 PP = 0.52f*P + 0.48f*Q;
 			VEC3 QQ = 0.52f*Q + 0.48f*P;
 
-			*positionDartBuf++ = PFP::toVec3f(P);
-			*positionDartBuf++ = PFP::toVec3f(PP);
-			*positionDartBuf++ = PFP::toVec3f(Q);
-			*positionDartBuf++ = PFP::toVec3f(QQ);
-			*colorDartBuf++ = this->m_dartsColor;
-			*colorDartBuf++ = this->m_dartsColor;
-			*colorDartBuf++ = this->m_dartsColor;
-			*colorDartBuf++ = this->m_dartsColor;
+			positionDartBuf[posDBI] = PFP::toVec3f(P);
+			positionDartBuf[posDBI+1] = PFP::toVec3f(PP);
+			positionDartBuf[posDBI+2] = PFP::toVec3f(Q);
+			positionDartBuf[posDBI+3] = PFP::toVec3f(QQ);
+			for (unsigned int k = 0; k < 4; ++k)
+				colorDartBuf[posDBI+k] = this->m_dartsColor;
 
 			this->m_attIndex[d] = posDBI;
-			posDBI+=2;
 
 			fv1[d] = P*0.9f + PP*0.1f;
 			fv2x[d] = P*0.52f + PP*0.48f;
@@ -808,91 +855,69 @@ void Topo3RenderGMap<PFP>::updateData(MAP& mapx, const VertexAttribute<VEC3, MAP
 			fv2[dx] = Q*0.52f + QQ*0.48f;
 			fv2x[dx] = Q*0.48f + QQ*0.52f;
 
-			this->m_attIndex[dx] = posDBI;
-			posDBI+=2;
+			this->m_attIndex[dx] = posDBI+2;
+			posDBI += 4;
 
-			d = mapx.phi1(d);
-		}
-	}
+			cur = next;
+			d = e;
+		} while (d != f);
+	});
 
 	this->m_vbo0->bind();
 	glBufferData(GL_ARRAY_BUFFER, 2*this->m_nbDarts*sizeof(Geom::Vec3f), this->m_bufferDartPosition, GL_STREAM_DRAW);
-//	m_vbo0->bind();
-//	glUnmapBuffer(GL_ARRAY_BUFFER);
 
 	this->m_vbo4->bind();
 	glUnmapBuffer(GL_ARRAY_BUFFER);
 
-	// beta3
+	// beta1
 	this->m_vbo1->bind();
-	glBufferData(GL_ARRAY_BUFFER, 2*this->m_nbDarts*sizeof(Geom::Vec3f), 0, GL_STREAM_DRAW);
-	GLvoid* PositionBuffer1 = glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
+	glBufferData(GL_ARRAY_BUFFER, 2*this->m_nbRel1*sizeof(Geom::Vec3f), 0, GL_STREAM_DRAW);
+	Geom::Vec3f* positionF1 = reinterpret_cast<Geom::Vec3f*>(glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE));
 
-	// beta3
+	// beta2
 	this->m_vbo2->bind();
-	glBufferData(GL_ARRAY_BUFFER, 2*this->m_nbDarts*sizeof(Geom::Vec3f), 0, GL_STREAM_DRAW);
-	GLvoid* PositionBuffer2 = glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
+	glBufferData(GL_ARRAY_BUFFER, 4*this->m_nbRel2*sizeof(Geom::Vec3f), 0, GL_STREAM_DRAW);
+	Geom::Vec3f* positionF2 = reinterpret_cast<Geom::Vec3f*>(glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE));
 
 	// beta3
 	this->m_vbo3->bind();
-	glBufferData(GL_ARRAY_BUFFER, 2*this->m_nbDarts*sizeof(Geom::Vec3f), 0, GL_STREAM_DRAW);
-	GLvoid* PositionBuffer3 = glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
+	glBufferData(GL_ARRAY_BUFFER, 4*this->m_nbRel3*sizeof(Geom::Vec3f), 0, GL_STREAM_DRAW);
+	Geom::Vec3f* positionF3 = reinterpret_cast<Geom::Vec3f*>(glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE));
 
-	Geom::Vec3f* positionF1 = reinterpret_cast<Geom::Vec3f*>(PositionBuffer1);
-	Geom::Vec3f* positionF2 = reinterpret_cast<Geom::Vec3f*>(PositionBuffer2);
-	Geom::Vec3f* positionF3 = reinterpret_cast<Geom::Vec3f*>(PositionBuffer3);
+	// third pass: relations (read the points of the neighbor darts computed in second pass)
+	CGoGN::Parallel::foreach_index(mapx, nbf, [&] (unsigned int i, unsigned int)
+	{
+		Geom::Vec3f* pF1 = positionF1 + 2*firstEdge[i];
+		Geom::Vec3f* pF2 = positionF2 + 4*firstRel2[i];
+		Geom::Vec3f* pF3 = positionF3 + 4*firstRel3[i];
 
-	this->m_nbRel2 = 0;
-	this->m_nbRel3 = 0;
+		auto relation = [&] (Dart x, Dart y, Geom::Vec3f*& buf)
+		{
+			*buf++ = PFP::toVec3f(fv2[x]);
+			*buf++ = PFP::toVec3f(fv2x[y]);
+			*buf++ = PFP::toVec3f(fv2[y]);
+			*buf++ = PFP::toVec3f(fv2x[x]);
+		};
 
-	for(std::vector<Dart>::iterator face = vecDartFaces.begin(); face != vecDartFaces.end(); ++face)
-	{
-		Dart d = *face;
+		Dart d = vecDartFaces[i];
 		do
 		{
-			Dart e = mapx.beta2(d);
-			if (d < e)
+			for (unsigned int k = 0; k < 2; ++k)	// d then beta0(d)
 			{
-				*positionF2++ = PFP::toVec3f(fv2[d]);
-				*positionF2++ = PFP::toVec3f(fv2x[e]);
-				*positionF2++ = PFP::toVec3f(fv2[e]);
-				*positionF2++ = PFP::toVec3f(fv2x[d]);
-				this->m_nbRel2++;
+				Dart e = mapx.beta2(d);
+				if (d < e)
+					relation(d, e, pF2);
+				e = mapx.beta3(d);
+				if (!mapx.template isBoundaryMarked<3>(e) && (d < e))
+					relation(d, e, pF3);
+				if (k == 0)
+					d = mapx.beta0(d);
 			}
-			e = mapx.beta3(d);
-			if (!mapx.template isBoundaryMarked<3>(e) && (d < e))
-			{
-				*positionF3++ = PFP::toVec3f(fv2[d]);
-				*positionF3++ = PFP::toVec3f(fv2x[e]);
-				*positionF3++ = PFP::toVec3f(fv2[e]);
-				*positionF3++ = PFP::toVec3f(fv2x[d]);
-				this->m_nbRel3++;
-			}
-			d = mapx.beta0(d);
-			e = mapx.beta2(d);
-			if (d < e)
-			{
-				*positionF2++ = PFP::toVec3f(fv2[d]);
-				*positionF2++ = PFP::toVec3f(fv2x[e]);
-				*positionF2++ = PFP::toVec3f(fv2[e]);
-				*positionF2++ = PFP::toVec3f(fv2x[d]);
-				this->m_nbRel2++;
-			}
-			e = mapx.beta3(d);
-			if (!mapx.template isBoundaryMarked<3>(e) && (d < e))
-			{
-				*positionF3++ = PFP::toVec3f(fv2[d]);
-				*positionF3++ = PFP::toVec3f(fv2x[e]);
-				*positionF3++ = PFP::toVec3f(fv2[e]);
-				*positionF3++ = PFP::toVec3f(fv2x[d]);
-				this->m_nbRel3++;
-			}
-			*positionF1++ = PFP::toVec3f(fv1[d]);
+			*pF1++ = PFP::toVec3f(fv1[d]);
 			d = mapx.beta1(d);
-			*positionF1++ = PFP::toVec3f(fv1[d]);
-			this->m_nbRel1++;
-		} while (d != *face );
-	}
+			*pF1++ = PFP::toVec3f(fv1[d]);
+		} while (d != vecDartFaces[i]);
+	});
 
 	this->m_vbo3->bind();
 	glUnmapBuffer(GL_ARRAY_BUFFER);
@@ -902,9 +927,6 @@ void Topo3RenderGMap<PFP>::updateData(MAP& mapx, const VertexAttribute<VEC3, MAP
 
 	this->m_vbo1->bind();
 	glUnmapBuffer(GL_ARRAY_BUFFER);
-
-	this->m_vbo4->bind();
-	glUnmapBuffer(GL_ARRAY_BUFFER);
 }
 
 template<typename PFP>
@@ -29,6 +29,7 @@
 #include "Geometry/basic.h"
 
 #include "Topology/generic/traversor/traversor2.h"
+#include "Topology/generic/traversor/traversorCell.h"
 
 #include <algorithm>
 
@@ -37,6 +38,8 @@
  * Collector (virtual)
  * - Collector_WithinSphere
  * - Collector_OneRing
+ *
+ * CollectorCache_WithinSphere : neighborhoods of all vertices
  ****************************************/
 
 namespace CGoGN
@@ -244,6 +247,162 @@ public:
 	REAL borderEdgeRatio(Dart d, const VertexAttribute<VEC3, MAP>& pos);
 };
 
+/*********************************************************
+ * Collector Within Sphere cache (all vertices)
+ *********************************************************/
+
+/*
+ * stores the cells collected by Collector_WithinSphere around every vertex
+ * in flat arrays, so that several filtering passes and attributes reuse
+ * them instead of walking the mesh again for each vertex.
+ * The cache is built in parallel; it stays valid while the connectivity is
+ * unchanged. When positions move (iterated smoothing), the collected cells
+ * are kept and only the border ratios have to be computed again.
+ */
+template <typename PFP>
+class CollectorCache_WithinSphere
+{
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+public:
+	enum CellSet { INSIDE_VERTICES = 0, INSIDE_EDGES, INSIDE_FACES, BORDER, NB_CELLSETS };
+
+protected:
+	MAP& map;
+	REAL radius;
+	bool isInsideCollected;
+
+	std::vector<unsigned int> vertexSlot;			// vertex embedding -> slot
+	std::vector<Dart> centers;						// slot -> center dart
+	std::vector<unsigned int> offsets[NB_CELLSETS];	// slot -> first cell of the set
+	std::vector<Dart> cells[NB_CELLSETS];
+
+public:
+	CollectorCache_WithinSphere(MAP& m) : map(m), radius(0), isInsideCollected(false)
+	{}
+
+	/**
+	 * collect the neighborhoods of all the vertices
+	 * @param position positions used to collect
+	 * @param r radius of the spheres
+	 * @param inside collect the inside cells (collectAll) or only the border (collectBorder)
+	 * @param nbth number of threads
+	 */
+	void build(const VertexAttribute<VEC3, MAP>& position, REAL r, bool inside = true, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+	void clear();
+
+	inline MAP& getMap() const { return map; }
+	inline REAL getRadius() const { return radius; }
+	inline bool insideCollected() const { return isInsideCollected; }
+
+	inline unsigned int getNbVertices() const { return uint32(centers.size()); }
+	inline Dart getCenterDart(unsigned int slot) const { return centers[slot]; }
+
+	/**
+	 * slot of the neighborhood of vertex v
+	 */
+	inline unsigned int getSlot(Vertex v) const { return vertexSlot[map.getEmbedding(v)]; }
+
+	inline unsigned int getNb(unsigned int slot, CellSet s) const { return offsets[s][slot+1] - offsets[s][slot]; }
+
+	/**
+	 * cells of the set s collected around vertex slot : [begin, end)
+	 */
+	inline const Dart* begin(unsigned int slot, CellSet s) const { return cells[s].data() + offsets[s][slot]; }
+	inline const Dart* end(unsigned int slot, CellSet s) const { return cells[s].data() + offsets[s][slot+1]; }
+};
+
+/*********************************************************
+ * Collector One Ring cache (all vertices)
+ *********************************************************/
+
+/*
+ * stores the one ring of every vertex in compressed rows : the darts of the
+ * incident edges (in the order of Collector_OneRing::collectAll) and the slots
+ * of the adjacent vertices. Iterated filters can then work on arrays indexed
+ * by slot instead of walking the mesh for each vertex and each iteration.
+ * The cache is built in parallel; it stays valid while the connectivity is
+ * unchanged.
+ */
+template <typename PFP>
+class CollectorCache_OneRing
+{
+	typedef typename PFP::MAP MAP ;
+
+protected:
+	MAP& map;
+
+	std::vector<unsigned int> vertexSlot;	// vertex embedding -> slot
+	std::vector<Dart> centers;				// slot -> center dart
+	std::vector<unsigned char> boundary;	// slot -> is a boundary vertex
+	std::vector<unsigned int> offsets;		// slot -> first incident edge
+	std::vector<Dart> edges;				// darts of the incident edges (out of the center)
+	std::vector<unsigned int> neighbors;	// slots of the adjacent vertices
+
+public:
+	CollectorCache_OneRing(MAP& m) : map(m)
+	{}
+
+	/**
+	 * collect the one rings of all the vertices
+	 * @param nbth number of threads
+	 */
+	void build(unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+	void clear();
+
+	inline MAP& getMap() const { return map; }
+
+	inline unsigned int getNbVertices() const { return uint32(centers.size()); }
+	inline Dart getCenterDart(unsigned int slot) const { return centers[slot]; }
+	inline bool isBoundary(unsigned int slot) const { return boundary[slot] != 0; }
+
+	/**
+	 * slot of vertex v
+	 */
+	inline unsigned int getSlot(Vertex v) const { return vertexSlot[map.getEmbedding(v)]; }
+
+	/**
+	 * total number of incident edges (each edge appears once per vertex)
+	 */
+	inline unsigned int getNbEdges() const { return uint32(edges.size()); }
+
+	/**
+	 * position of the first incident edge of vertex slot in the rows
+	 * (per edge data of the cache users can be stored at the same positions)
+	 */
+	inline unsigned int getOffset(unsigned int slot) const { return offsets[slot]; }
+
+	inline unsigned int getNb(unsigned int slot) const { return offsets[slot+1] - offsets[slot]; }
+
+	/**
+	 * darts of the edges incident to vertex slot : [begin, end)
+	 */
+	inline const Dart* beginEdges(unsigned int slot) const { return edges.data() + offsets[slot]; }
+	inline const Dart* endEdges(unsigned int slot) const { return edges.data() + offsets[slot+1]; }
+
+	/**
+	 * slots of the vertices adjacent to vertex slot : [begin, end)
+	 */
+	inline const unsigned int* beginNeighbors(unsigned int slot) const { return neighbors.data() + offsets[slot]; }
+	inline const unsigned int* endNeighbors(unsigned int slot) const { return neighbors.data() + offsets[slot+1]; }
+
+	/**
+	 * copy the values of a vertex attribute in an array indexed by slot
+	 */
+	template <typename T>
+	void gather(const VertexAttribute<T, MAP>& att, std::vector<T>& values, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) const;
+
+	/**
+	 * copy an array indexed by slot in a vertex attribute
+	 */
+	template <typename T>
+	void scatter(const std::vector<T>& values, VertexAttribute<T, MAP>& att, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) const;
+};
+
 /*********************************************************
  * Collector Normal Angle (Vertices)
  *********************************************************/
@@ -438,6 +438,169 @@ typename PFP::REAL Collector_WithinSphere<PFP>::borderEdgeRatio(Dart d, const Ve
 	return alpha;
 }
 
+/*********************************************************
+ * Collector Within Sphere cache (all vertices)
+ *********************************************************/
+
+template <typename PFP>
+void CollectorCache_WithinSphere<PFP>::build(const VertexAttribute<VEC3, MAP>& position, REAL r, bool inside, unsigned int nbth)
+{
+	clear();
+	radius = r;
+	isInsideCollected = inside;
+
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		centers.push_back(v.dart);
+	});
+	const unsigned int nbv = uint32(centers.size());
+
+	vertexSlot.assign(position.end(), EMBNULL);
+	for (unsigned int i = 0; i < nbv; ++i)
+		vertexSlot[map.getEmbedding(Vertex(centers[i]))] = i;
+
+	if (nbth == 0)
+		nbth = 1;
+	if (nbth > nbv)
+		nbth = nbv > 0 ? nbv : 1;
+
+	// each thread handles a contiguous range of slots and appends its cells
+	// in slot order : concatenating the thread buffers gives the final arrays
+	std::vector< std::vector<Dart> > buffers[NB_CELLSETS];
+	for (unsigned int s = 0; s < NB_CELLSETS; ++s)
+	{
+		buffers[s].resize(nbth);
+		offsets[s].assign(nbv + 1, 0);
+	}
+
+	std::vector< Collector_WithinSphere<PFP> > collectors(nbth, Collector_WithinSphere<PFP>(map, position, r));
+
+	CGoGN::Parallel::foreach_index(map, nbv, [&] (unsigned int i, unsigned int t)
+	{
+		Collector_WithinSphere<PFP>& col = collectors[t];
+		if (inside)
+		{
+			col.collectAll(centers[i]);
+			for (Vertex v : col.getInsideVertices())
+				buffers[INSIDE_VERTICES][t].push_back(v.dart);
+			for (Edge e : col.getInsideEdges())
+				buffers[INSIDE_EDGES][t].push_back(e.dart);
+			for (Face f : col.getInsideFaces())
+				buffers[INSIDE_FACES][t].push_back(f.dart);
+			offsets[INSIDE_VERTICES][i+1] = col.getNbInsideVertices();
+			offsets[INSIDE_EDGES][i+1] = col.getNbInsideEdges();
+			offsets[INSIDE_FACES][i+1] = col.getNbInsideFaces();
+		}
+		else
+			col.collectBorder(centers[i]);
+
+		const std::vector<Dart>& border = col.getBorder();
+		buffers[BORDER][t].insert(buffers[BORDER][t].end(), border.begin(), border.end());
+		offsets[BORDER][i+1] = uint32(border.size());
+	}, nbth);
+
+	for (unsigned int s = 0; s < NB_CELLSETS; ++s)
+	{
+		for (unsigned int i = 0; i < nbv; ++i)
+			offsets[s][i+1] += offsets[s][i];
+		cells[s].reserve(offsets[s][nbv]);
+		for (unsigned int t = 0; t < nbth; ++t)
+			cells[s].insert(cells[s].end(), buffers[s][t].begin(), buffers[s][t].end());
+	}
+}
+
+template <typename PFP>
+void CollectorCache_WithinSphere<PFP>::clear()
+{
+	vertexSlot.clear();
+	centers.clear();
+	for (unsigned int s = 0; s < NB_CELLSETS; ++s)
+	{
+		offsets[s].clear();
+		cells[s].clear();
+	}
+	isInsideCollected = false;
+}
+
+/*********************************************************
+ * Collector One Ring cache (all vertices)
+ *********************************************************/
+
+template <typename PFP>
+void CollectorCache_OneRing<PFP>::build(unsigned int nbth)
+{
+	clear();
+
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		centers.push_back(v.dart);
+	});
+	const unsigned int nbv = uint32(centers.size());
+
+	vertexSlot.assign(map.getAttributeContainer(VERTEX).end(), EMBNULL);
+	for (unsigned int i = 0; i < nbv; ++i)
+		vertexSlot[map.getEmbedding(Vertex(centers[i]))] = i;
+
+	boundary.assign(nbv, 0);
+	offsets.assign(nbv + 1, 0);
+
+	// degrees, then rows filled at their final position
+	CGoGN::Parallel::foreach_index(map, nbv, [&] (unsigned int i, unsigned int)
+	{
+		Vertex v(centers[i]);
+		offsets[i+1] = map.vertexDegree(v);
+		boundary[i] = map.isBoundaryVertex(v) ? 1 : 0;
+	}, nbth);
+
+	for (unsigned int i = 0; i < nbv; ++i)
+		offsets[i+1] += offsets[i];
+	edges.resize(offsets[nbv]);
+	neighbors.resize(offsets[nbv]);
+
+	CGoGN::Parallel::foreach_index(map, nbv, [&] (unsigned int i, unsigned int)
+	{
+		unsigned int k = offsets[i];
+		foreach_incident2<EDGE>(map, Vertex(centers[i]), [&] (Edge e)
+		{
+			edges[k] = e.dart;
+			neighbors[k] = vertexSlot[map.getEmbedding(Vertex(map.phi1(e.dart)))];
+			++k;
+		});
+	}, nbth);
+}
+
+template <typename PFP>
+void CollectorCache_OneRing<PFP>::clear()
+{
+	vertexSlot.clear();
+	centers.clear();
+	boundary.clear();
+	offsets.clear();
+	edges.clear();
+	neighbors.clear();
+}
+
+template <typename PFP>
+template <typename T>
+void CollectorCache_OneRing<PFP>::gather(const VertexAttribute<T, MAP>& att, std::vector<T>& values, unsigned int nbth) const
+{
+	values.resize(centers.size());
+	CGoGN::Parallel::foreach_index(map, uint32(centers.size()), [&] (unsigned int i, unsigned int)
+	{
+		values[i] = att[centers[i]];
+	}, nbth);
+}
+
+template <typename PFP>
+template <typename T>
+void CollectorCache_OneRing<PFP>::scatter(const std::vector<T>& values, VertexAttribute<T, MAP>& att, unsigned int nbth) const
+{
+	CGoGN::Parallel::foreach_index(map, uint32(centers.size()), [&] (unsigned int i, unsigned int)
+	{
+		att[centers[i]] = values[i];
+	}, nbth);
+}
+
 /*********************************************************
  * Collector Normal Angle (Vertices)
  *********************************************************/
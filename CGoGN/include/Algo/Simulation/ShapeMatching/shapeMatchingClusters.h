@@ -0,0 +1,217 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef _SHAPE_MATCHING_CLUSTERS_H_
+#define _SHAPE_MATCHING_CLUSTERS_H_
+
+#include <vector>
+
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Topology/generic/traversor/traversor2.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Simulation
+{
+
+namespace ShapeMatching
+{
+
+/**
+ * Cluster based shape matching (lattice shape matching).
+ * The object is covered by overlapping clusters of vertices. Each cluster is
+ * matched independently to its rest shape and the goal position of a vertex
+ * is the average of the goals given by the clusters that contain it.
+ *
+ * The simulation state is stored in structure of arrays buffers indexed by
+ * particle (one particle per vertex), the clusters are stored in compressed
+ * rows. Clusters are matched in parallel, each one writes the goals of its
+ * members in its own rows, then the goals are gathered per particle: there
+ * is no concurrent write and results do not depend on the number of threads.
+ *
+ * The position attribute is read by initialize and written by updatePositions.
+ */
+template <typename PFP>
+class ShapeMatchingClusters
+{
+public:
+	typedef typename PFP::MAP MAP;
+	typedef typename PFP::VEC3 VEC3;
+	typedef typename PFP::REAL REAL;
+
+protected:
+	MAP& m_map;
+	VertexAttribute<VEC3, MAP>& m_position;
+	VertexAttribute<REAL, MAP>& m_mass;
+	VertexAttribute<VEC3, MAP>* m_fext;
+
+	// particles: vertex index, position, velocity, goal and mass
+	std::vector<unsigned int> m_index;
+	std::vector<REAL> m_x, m_y, m_z;
+	std::vector<REAL> m_vx, m_vy, m_vz;
+	std::vector<REAL> m_gx, m_gy, m_gz;
+	std::vector<REAL> m_m;
+
+	// clusters: members of cluster c are m_members[m_clusterStart[c] .. m_clusterStart[c+1][
+	std::vector<unsigned int> m_clusterStart;
+	std::vector<unsigned int> m_members;
+	// rest offsets q of members (from the rest mass center of their cluster)
+	std::vector<REAL> m_qx, m_qy, m_qz;
+	// goals computed by the cluster for each of its members
+	std::vector<REAL> m_cgx, m_cgy, m_cgz;
+	std::vector<REAL> m_clusterMass;
+	std::vector<Eigen::Matrix3d> m_aqqInv;
+	// rotation of the previous step, used as first guess of the polar decomposition
+	std::vector<Eigen::Quaterniond> m_rotation;
+
+	// transposed rows: memberships of particle p are m_memberships[m_particleStart[p] .. m_particleStart[p+1][
+	std::vector<unsigned int> m_particleStart;
+	std::vector<unsigned int> m_memberships;
+
+	REAL m_alpha;
+	REAL m_beta;
+	REAL m_damping;
+	VEC3 m_gravity;
+
+	REAL m_timeStep;
+	REAL m_accumulator;
+	unsigned int m_maxSubSteps;
+	unsigned int m_rotationIterations;
+	unsigned int m_nbThreads;
+
+	/**
+	 * apply f(begin, end) on nbth contiguous ranges of [0,n[ in parallel
+	 */
+	template <typename FUNC>
+	void parallelRanges(unsigned int n, FUNC f);
+
+	void initializeParticles();
+
+	void initializeClusters();
+
+	void extractRotation(const Eigen::Matrix3d& A, Eigen::Quaterniond& q) const;
+
+public:
+	ShapeMatchingClusters(MAP& map, VertexAttribute<VEC3, MAP>& position, VertexAttribute<REAL, MAP>& mass, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+	~ShapeMatchingClusters();
+
+	/**
+	 * initialize the rest shape with one cluster per vertex, made of its
+	 * nbRings first rings of neighbours (adjacent through edges)
+	 */
+	void initialize(unsigned int nbRings = 1);
+
+	/**
+	 * initialize the rest shape with user defined (possibly overlapping) clusters
+	 * vertices that belong to no cluster are only moved by external forces
+	 */
+	void initialize(const std::vector< std::vector<Vertex> >& clusters);
+
+	unsigned int getNbParticles() const { return (unsigned int)(m_index.size()); }
+
+	unsigned int getNbClusters() const { return m_clusterStart.empty() ? 0 : (unsigned int)(m_clusterStart.size() - 1); }
+
+	/**
+	 * stiffness in [0,1]: fraction of the way to the goal done in one step
+	 */
+	void setStiffness(REAL alpha) { m_alpha = alpha; }
+
+	/**
+	 * blend between rotation (0) and linear (1) deformation of the clusters
+	 */
+	void setLinearBlend(REAL beta) { m_beta = beta; }
+
+	/**
+	 * fraction of the velocity removed at each step
+	 */
+	void setDamping(REAL d) { m_damping = d; }
+
+	void setGravity(const VEC3& g) { m_gravity = g; }
+
+	/**
+	 * per vertex external forces added to gravity (null to disable)
+	 */
+	void setExternalForces(VertexAttribute<VEC3, MAP>* fext) { m_fext = fext; }
+
+	/**
+	 * set the fixed time step and the maximum number of steps done by one call to advance
+	 */
+	void setTimeStep(REAL h, unsigned int maxSubSteps = 4) { m_timeStep = h; m_maxSubSteps = maxSubSteps; }
+
+	void setNbRotationIterations(unsigned int n) { m_rotationIterations = n; }
+
+	void setNbThreads(unsigned int nbth) { m_nbThreads = nbth; }
+
+	/**
+	 * compute the goal positions of the particles from their current positions
+	 */
+	void shapeMatch();
+
+	/**
+	 * one step of length h: shape matching, velocity update and position integration
+	 */
+	void step(REAL h);
+
+	/**
+	 * fixed time step driver: accumulate dt and do as many steps as needed
+	 * (at most maxSubSteps, the late time is dropped), then update the positions
+	 * @return the number of steps done
+	 */
+	unsigned int advance(REAL dt);
+
+	/**
+	 * write the particles positions in the position attribute
+	 */
+	void updatePositions();
+
+	/**
+	 * set the velocity of all particles to zero
+	 */
+	void resetVelocities();
+};
+
+} // namespace ShapeMatching
+
+} // namespace Simulation
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "shapeMatchingClusters.hpp"
+
+#endif
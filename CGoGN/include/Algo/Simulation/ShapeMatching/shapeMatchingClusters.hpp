@@ -0,0 +1,456 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cmath>
+
+#include "Utils/instrumentation.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Simulation
+{
+
+namespace ShapeMatching
+{
+
+template <typename PFP>
+ShapeMatchingClusters<PFP>::ShapeMatchingClusters(MAP& map, VertexAttribute<VEC3, MAP>& position, VertexAttribute<REAL, MAP>& mass, unsigned int nbth) :
+	m_map(map),
+	m_position(position),
+	m_mass(mass),
+	m_fext(NULL),
+	m_alpha(1),
+	m_beta(0),
+	m_damping(0),
+	m_gravity(0, 0, 0),
+	m_timeStep(REAL(1) / REAL(60)),
+	m_accumulator(0),
+	m_maxSubSteps(4),
+	m_rotationIterations(4),
+	m_nbThreads(nbth)
+{}
+
+template <typename PFP>
+ShapeMatchingClusters<PFP>::~ShapeMatchingClusters()
+{}
+
+template <typename PFP>
+template <typename FUNC>
+void ShapeMatchingClusters<PFP>::parallelRanges(unsigned int n, FUNC f)
+{
+	unsigned int nbth = m_nbThreads;
+	if (nbth > n)
+		nbth = n;
+	if (nbth < 2)
+	{
+		f(0, n);
+		return;
+	}
+	CGoGN::Parallel::foreach_index(m_map, nbth, [&] (unsigned int i, unsigned int)
+	{
+		f((unsigned long long)(n) * i / nbth, (unsigned long long)(n) * (i + 1) / nbth);
+	}, nbth);
+}
+
+template <typename PFP>
+void ShapeMatchingClusters<PFP>::initializeParticles()
+{
+	m_index.clear();
+	for (unsigned int i = m_position.begin(); i != m_position.end(); m_position.next(i))
+		m_index.push_back(i);
+
+	unsigned int nbp = getNbParticles();
+	m_x.resize(nbp); m_y.resize(nbp); m_z.resize(nbp);
+	m_vx.assign(nbp, REAL(0)); m_vy.assign(nbp, REAL(0)); m_vz.assign(nbp, REAL(0));
+	m_gx.resize(nbp); m_gy.resize(nbp); m_gz.resize(nbp);
+	m_m.resize(nbp);
+
+	for (unsigned int p = 0; p < nbp; ++p)
+	{
+		const VEC3& x = m_position[m_index[p]];
+		m_x[p] = x[0]; m_y[p] = x[1]; m_z[p] = x[2];
+		m_m[p] = m_mass[m_index[p]];
+	}
+	m_accumulator = 0;
+}
+
+template <typename PFP>
+void ShapeMatchingClusters<PFP>::initializeClusters()
+{
+	unsigned int nbc = getNbClusters();
+	unsigned int nbm = (unsigned int)(m_members.size());
+	unsigned int nbp = getNbParticles();
+
+	m_qx.resize(nbm); m_qy.resize(nbm); m_qz.resize(nbm);
+	m_cgx.resize(nbm); m_cgy.resize(nbm); m_cgz.resize(nbm);
+	m_clusterMass.resize(nbc);
+	m_aqqInv.resize(nbc);
+	m_rotation.assign(nbc, Eigen::Quaterniond::Identity());
+
+	// rest mass centers, offsets and Aqq^-1
+	parallelRanges(nbc, [&] (unsigned int first, unsigned int last)
+	{
+		for (unsigned int c = first; c < last; ++c)
+		{
+			double M = 0;
+			Eigen::Vector3d cm(0, 0, 0);
+			for (unsigned int k = m_clusterStart[c]; k < m_clusterStart[c+1]; ++k)
+			{
+				unsigned int p = m_members[k];
+				M += m_m[p];
+				cm += m_m[p] * Eigen::Vector3d(m_x[p], m_y[p], m_z[p]);
+			}
+			if (M > 0)
+				cm /= M;
+			m_clusterMass[c] = REAL(M);
+
+			Eigen::Matrix3d aqq = Eigen::Matrix3d::Zero();
+			for (unsigned int k = m_clusterStart[c]; k < m_clusterStart[c+1]; ++k)
+			{
+				unsigned int p = m_members[k];
+				Eigen::Vector3d q = Eigen::Vector3d(m_x[p], m_y[p], m_z[p]) - cm;
+				m_qx[k] = REAL(q[0]); m_qy[k] = REAL(q[1]); m_qz[k] = REAL(q[2]);
+				aqq += m_m[p] * q * q.transpose();
+			}
+
+			// flat or degenerated clusters have no linear deformation
+			Eigen::FullPivLU<Eigen::Matrix3d> lu(aqq);
+			if (lu.isInvertible())
+				m_aqqInv[c] = lu.inverse();
+			else
+				m_aqqInv[c].setZero();
+		}
+	});
+
+	// transposed rows (serial counting sort keeps memberships ordered by cluster)
+	m_particleStart.assign(nbp + 1, 0);
+	for (unsigned int k = 0; k < nbm; ++k)
+		++m_particleStart[m_members[k] + 1];
+	for (unsigned int p = 0; p < nbp; ++p)
+		m_particleStart[p+1] += m_particleStart[p];
+	m_memberships.resize(nbm);
+	std::vector<unsigned int> fill(m_particleStart.begin(), m_particleStart.end() - 1);
+	for (unsigned int k = 0; k < nbm; ++k)
+		m_memberships[fill[m_members[k]]++] = k;
+}
+
+template <typename PFP>
+void ShapeMatchingClusters<PFP>::initialize(unsigned int nbRings)
+{
+	CGoGN_SCOPED_TIMER("Algo::Surface::Simulation::ShapeMatching::ShapeMatchingClusters::initialize");
+
+	initializeParticles();
+	unsigned int nbp = getNbParticles();
+
+	std::vector<Vertex> vertices(nbp);
+	std::vector<unsigned int> particle(m_map.template getAttributeContainer<VERTEX>().realEnd(), 0xffffffff);
+	for (unsigned int p = 0; p < nbp; ++p)
+		particle[m_index[p]] = p;
+	foreach_cell<VERTEX>(m_map, [&] (Vertex v)
+	{
+		unsigned int p = particle[m_map.getEmbedding(v)];
+		if (p != 0xffffffff)
+			vertices[p] = v;
+	});
+
+	// one cluster per particle: nbRings breadth first layers of neighbours
+	std::vector< std::vector<unsigned int> > clusters(nbp);
+	parallelRanges(nbp, [&] (unsigned int first, unsigned int last)
+	{
+		std::vector<unsigned int> stamp(nbp, 0xffffffff);
+		for (unsigned int c = first; c < last; ++c)
+		{
+			std::vector<unsigned int>& cluster = clusters[c];
+			cluster.push_back(c);
+			stamp[c] = c;
+			unsigned int layerBegin = 0;
+			for (unsigned int r = 0; r < nbRings; ++r)
+			{
+				unsigned int layerEnd = (unsigned int)(cluster.size());
+				for (unsigned int j = layerBegin; j < layerEnd; ++j)
+				{
+					foreach_adjacent2<EDGE>(m_map, vertices[cluster[j]], [&] (Vertex u)
+					{
+						unsigned int pu = particle[m_map.getEmbedding(u)];
+						if (pu != 0xffffffff && stamp[pu] != c)
+						{
+							stamp[pu] = c;
+							cluster.push_back(pu);
+						}
+					});
+				}
+				layerBegin = layerEnd;
+			}
+		}
+	});
+
+	m_clusterStart.resize(nbp + 1);
+	m_clusterStart[0] = 0;
+	for (unsigned int c = 0; c < nbp; ++c)
+		m_clusterStart[c+1] = m_clusterStart[c] + (unsigned int)(clusters[c].size());
+	m_members.resize(m_clusterStart[nbp]);
+	for (unsigned int c = 0; c < nbp; ++c)
+	{
+		std::copy(clusters[c].begin(), clusters[c].end(), m_members.begin() + m_clusterStart[c]);
+		std::vector<unsigned int>().swap(clusters[c]);
+	}
+
+	initializeClusters();
+}
+
+template <typename PFP>
+void ShapeMatchingClusters<PFP>::initialize(const std::vector< std::vector<Vertex> >& clusters)
+{
+	CGoGN_SCOPED_TIMER("Algo::Surface::Simulation::ShapeMatching::ShapeMatchingClusters::initialize");
+
+	initializeParticles();
+
+	std::vector<unsigned int> particle(m_map.template getAttributeContainer<VERTEX>().realEnd(), 0xffffffff);
+	for (unsigned int p = 0; p < getNbParticles(); ++p)
+		particle[m_index[p]] = p;
+
+	m_clusterStart.clear();
+	m_members.clear();
+	m_clusterStart.push_back(0);
+	for (unsigned int c = 0; c < clusters.size(); ++c)
+	{
+		for (unsigned int j = 0; j < clusters[c].size(); ++j)
+		{
+			unsigned int p = particle[m_map.getEmbedding(clusters[c][j])];
+			if (p != 0xffffffff)
+				m_members.push_back(p);
+		}
+		m_clusterStart.push_back((unsigned int)(m_members.size()));
+	}
+
+	initializeClusters();
+}
+
+/**
+ * rotation of the polar decomposition of A, by iterative refinement of q
+ * (M. Mueller et al., A Robust Method to Extract the Rotational Part of Deformations, 2016)
+ */
+template <typename PFP>
+void ShapeMatchingClusters<PFP>::extractRotation(const Eigen::Matrix3d& A, Eigen::Quaterniond& q) const
+{
+	for (unsigned int it = 0; it < m_rotationIterations; ++it)
+	{
+		Eigen::Matrix3d R = q.matrix();
+		Eigen::Vector3d omega =
+			(R.col(0).cross(A.col(0)) + R.col(1).cross(A.col(1)) + R.col(2).cross(A.col(2))) *
+			(1.0 / (std::fabs(R.col(0).dot(A.col(0)) + R.col(1).dot(A.col(1)) + R.col(2).dot(A.col(2))) + 1.0e-9));
+		double w = omega.norm();
+		if (w < 1.0e-9)
+			break;
+		q = Eigen::Quaterniond(Eigen::AngleAxisd(w, omega / w)) * q;
+		q.normalize();
+	}
+}
+
+template <typename PFP>
+void ShapeMatchingClusters<PFP>::shapeMatch()
+{
+	CGoGN_SCOPED_TIMER("Algo::Surface::Simulation::ShapeMatching::ShapeMatchingClusters::shapeMatch");
+
+	// per cluster: mass center, Apq, rotation and goals of the members
+	parallelRanges(getNbClusters(), [&] (unsigned int first, unsigned int last)
+	{
+		for (unsigned int c = first; c < last; ++c)
+		{
+			unsigned int kb = m_clusterStart[c];
+			unsigned int ke = m_clusterStart[c+1];
+			if (m_clusterMass[c] <= 0)
+			{
+				for (unsigned int k = kb; k < ke; ++k)
+				{
+					m_cgx[k] = m_x[m_members[k]]; m_cgy[k] = m_y[m_members[k]]; m_cgz[k] = m_z[m_members[k]];
+				}
+				continue;
+			}
+
+			double cx = 0, cy = 0, cz = 0;
+			for (unsigned int k = kb; k < ke; ++k)
+			{
+				unsigned int p = m_members[k];
+				cx += m_m[p] * m_x[p];
+				cy += m_m[p] * m_y[p];
+				cz += m_m[p] * m_z[p];
+			}
+			double invM = 1.0 / m_clusterMass[c];
+			cx *= invM; cy *= invM; cz *= invM;
+
+			Eigen::Matrix3d apq = Eigen::Matrix3d::Zero();
+			for (unsigned int k = kb; k < ke; ++k)
+			{
+				unsigned int p = m_members[k];
+				Eigen::Vector3d pk(m_x[p] - cx, m_y[p] - cy, m_z[p] - cz);
+				Eigen::Vector3d qk(m_qx[k], m_qy[k], m_qz[k]);
+				apq += m_m[p] * pk * qk.transpose();
+			}
+
+			extractRotation(apq, m_rotation[c]);
+			Eigen::Matrix3d T = m_rotation[c].matrix();
+
+			if (m_beta > 0 && !m_aqqInv[c].isZero())
+			{
+				Eigen::Matrix3d A = apq * m_aqqInv[c];
+				double det = A.determinant();
+				if (det > 1.0e-12)
+				{
+					A /= std::cbrt(det); // volume preservation
+					T = m_beta * A + (1.0 - m_beta) * T;
+				}
+			}
+
+			for (unsigned int k = kb; k < ke; ++k)
+			{
+				Eigen::Vector3d g = T * Eigen::Vector3d(m_qx[k], m_qy[k], m_qz[k]);
+				m_cgx[k] = REAL(g[0] + cx);
+				m_cgy[k] = REAL(g[1] + cy);
+				m_cgz[k] = REAL(g[2] + cz);
+			}
+		}
+	});
+
+	// per particle: average of the goals of its clusters (in cluster order)
+	parallelRanges(getNbParticles(), [&] (unsigned int first, unsigned int last)
+	{
+		for (unsigned int p = first; p < last; ++p)
+		{
+			unsigned int kb = m_particleStart[p];
+			unsigned int ke = m_particleStart[p+1];
+			if (kb == ke)
+			{
+				m_gx[p] = m_x[p]; m_gy[p] = m_y[p]; m_gz[p] = m_z[p];
+				continue;
+			}
+			REAL gx = 0, gy = 0, gz = 0;
+			for (unsigned int j = kb; j < ke; ++j)
+			{
+				unsigned int k = m_memberships[j];
+				gx += m_cgx[k]; gy += m_cgy[k]; gz += m_cgz[k];
+			}
+			REAL inv = REAL(1) / REAL(ke - kb);
+			m_gx[p] = gx * inv; m_gy[p] = gy * inv; m_gz[p] = gz * inv;
+		}
+	});
+}
+
+template <typename PFP>
+void ShapeMatchingClusters<PFP>::step(REAL h)
+{
+	shapeMatch();
+
+	const REAL a = m_alpha / h;
+	const REAL keep = REAL(1) - m_damping;
+	const REAL gx = h * m_gravity[0], gy = h * m_gravity[1], gz = h * m_gravity[2];
+
+	parallelRanges(getNbParticles(), [&] (unsigned int first, unsigned int last)
+	{
+		REAL* x = &m_x[0]; REAL* y = &m_y[0]; REAL* z = &m_z[0];
+		REAL* vx = &m_vx[0]; REAL* vy = &m_vy[0]; REAL* vz = &m_vz[0];
+		const REAL* tx = &m_gx[0]; const REAL* ty = &m_gy[0]; const REAL* tz = &m_gz[0];
+		for (unsigned int p = first; p < last; ++p)
+		{
+			vx[p] = keep * (vx[p] + a * (tx[p] - x[p]) + gx);
+			vy[p] = keep * (vy[p] + a * (ty[p] - y[p]) + gy);
+			vz[p] = keep * (vz[p] + a * (tz[p] - z[p]) + gz);
+		}
+		if (m_fext != NULL)
+		{
+			for (unsigned int p = first; p < last; ++p)
+			{
+				if (m_m[p] <= 0)
+					continue;
+				const VEC3& f = (*m_fext)[m_index[p]];
+				REAL s = keep * h / m_m[p];
+				vx[p] += s * f[0]; vy[p] += s * f[1]; vz[p] += s * f[2];
+			}
+		}
+		for (unsigned int p = first; p < last; ++p)
+		{
+			x[p] += h * vx[p];
+			y[p] += h * vy[p];
+			z[p] += h * vz[p];
+		}
+	});
+}
+
+template <typename PFP>
+unsigned int ShapeMatchingClusters<PFP>::advance(REAL dt)
+{
+	CGoGN_SCOPED_TIMER("Algo::Surface::Simulation::ShapeMatching::ShapeMatchingClusters::advance");
+
+	m_accumulator += dt;
+	unsigned int nbSteps = 0;
+	while (m_accumulator >= m_timeStep && nbSteps < m_maxSubSteps)
+	{
+		step(m_timeStep);
+		m_accumulator -= m_timeStep;
+		++nbSteps;
+	}
+	// drop the time that could not be simulated (avoids the spiral of death)
+	if (m_accumulator >= m_timeStep)
+		m_accumulator = 0;
+
+	if (nbSteps > 0)
+		updatePositions();
+	return nbSteps;
+}
+
+template <typename PFP>
+void ShapeMatchingClusters<PFP>::updatePositions()
+{
+	parallelRanges(getNbParticles(), [&] (unsigned int first, unsigned int last)
+	{
+		for (unsigned int p = first; p < last; ++p)
+			m_position[m_index[p]] = VEC3(m_x[p], m_y[p], m_z[p]);
+	});
+}
+
+template <typename PFP>
+void ShapeMatchingClusters<PFP>::resetVelocities()
+{
+	std::fill(m_vx.begin(), m_vx.end(), REAL(0));
+	std::fill(m_vy.begin(), m_vy.end(), REAL(0));
+	std::fill(m_vz.begin(), m_vz.end(), REAL(0));
+}
+
+} // namespace ShapeMatching
+
+} // namespace Simulation
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -23,6 +23,7 @@
 *******************************************************************************/
 
 #include "Algo/Tiling/tiling.h"
+#include "Algo/Tiling/bulkGrid.h"
 
 #ifndef _TILING_SQUARE_H_
 #define _TILING_SQUARE_H_
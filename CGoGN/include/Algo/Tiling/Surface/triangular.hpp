@@ -53,6 +53,17 @@ void Grid<PFP>::grid(unsigned int x, unsigned int y, bool close)
 	this->m_tableVertDarts.reserve(nbV);
 	this->m_tableFaceDarts.reserve(nbF);
 
+	// direct construction of all the relations when the map allows it
+	// (closed grids only: open grids are sewn by Cube with their border vertex darts)
+	std::vector< std::vector<unsigned int> > cell(2);
+	cell[0] = { 0, 1, 3 };
+	cell[1] = { 1, 2, 3 };
+	if (close && bulkGrid(this->m_map, x, y, cell, close, this->m_tableVertDarts, this->m_tableFaceDarts))
+	{
+		this->m_dart = this->m_tableVertDarts[0];
+		return;
+	}
+
     // creation of triangles and storing vertices
     for (unsigned int i = 0; i < y; ++i)
     {
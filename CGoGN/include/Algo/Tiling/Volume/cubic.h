@@ -23,6 +23,7 @@
 *******************************************************************************/
 
 #include "Algo/Tiling/tiling.h"
+#include "Algo/Tiling/bulkGrid.h"
 
 #ifndef _TILING_CUBIC_H_
 #define _TILING_CUBIC_H_
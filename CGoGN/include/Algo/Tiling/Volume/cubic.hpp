@@ -48,6 +48,10 @@ void Grid<PFP>::grid3D(unsigned int x, unsigned int y, unsigned int z)
     this->m_tableVertDarts.clear();
     this->m_tableVertDarts.reserve((x+1)*(y+1)*(z+1));
 
+	// direct construction of all the relations when the map allows it
+	if (bulkHexaGrid(this->m_map, x, y, z, this->m_tableVertDarts))
+		return;
+
     Dart d0 = grid2D(x, y);
     Dart d1 = this->m_map.template phi<12>(d0);
 
@@ -175,7 +179,8 @@ void Grid<PFP>::embedIntoGrid(VertexAttribute<VEC3, MAP>& position, float x, flo
                 typename PFP::VEC3 pos(-x/2.0f + dx*float(k), -y/2.0f + dy*float(j), -z/2.0f + dz*float(i));
                 Dart d = this->m_tableVertDarts[ i*nbs+j*(this->m_nx+1)+k ];
 
-				Algo::Topo::setOrbitEmbeddingOnNewCell<VERTEX>(this->m_map, d);
+				if (this->m_map.template getEmbedding<VERTEX>(d) == EMBNULL)
+					Algo::Topo::setOrbitEmbeddingOnNewCell<VERTEX>(this->m_map, d);
                 position[d] = pos;
             }
         }
@@ -0,0 +1,100 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef _BULK_GRID_H_
+#define _BULK_GRID_H_
+
+#include <vector>
+#include <type_traits>
+
+#include "Topology/map/map3.h"
+#include "Topology/generic/mapImpl/mapMono.h"
+#include "Topology/generic/traversor/traversorCell.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Tilings
+{
+
+/**
+ * Bulk construction of the topology of a grid of x*y cells (y rows of x cells).
+ * No face is sewn: all the relations are computed from the cell indices and
+ * written directly, in parallel. Vertices are embedded in the same pass if
+ * the VERTEX orbit is embedded (other orbits are left to lazy embedding).
+ * Only available for maps with a single resolution (Map2<MapMono> and derived),
+ * the function returns false for other maps: the caller then sews the faces.
+ * @param cellFaces faces of a cell, given by their corners, counterclockwise:
+ * 0 (0,0), 1 (1,0), 2 (1,1), 3 (0,1); each side of the cell is an edge of exactly one face
+ * @param close close the boundary with a boundary face
+ * (the vertex darts and the phi2 of the border of an open grid differ from the sewing
+ * construction of Square/Triangular::Grid, that Cube relies on)
+ * @param vertexDarts receives one dart per vertex, row by row ((x+1)*(y+1))
+ * @param faceDarts receives one dart per face, cell by cell
+ * @return false if the grid could not be built
+ */
+template <typename MAP>
+bool bulkGrid(MAP& map, unsigned int x, unsigned int y, const std::vector< std::vector<unsigned int> >& cellFaces, bool close,
+	std::vector<Dart>& vertexDarts, std::vector<Dart>& faceDarts, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+} // namespace Tilings
+
+} // namespace Surface
+
+namespace Volume
+{
+
+namespace Tilings
+{
+
+/**
+ * Bulk construction of the topology of a closed grid of x*y*z hexahedra
+ * (same cells and boundary as sewing hexahedra and calling closeMap).
+ * Only available for Map3<MapMono> and derived maps, returns false otherwise.
+ * Vertices are embedded in the same pass if the VERTEX orbit is embedded.
+ * @param vertexDarts receives one dart per vertex, x fastest then y then z
+ * @return false if the grid could not be built
+ */
+template <typename MAP>
+bool bulkHexaGrid(MAP& map, unsigned int x, unsigned int y, unsigned int z,
+	std::vector<Dart>& vertexDarts, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+} // namespace Tilings
+
+} // namespace Volume
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Tiling/bulkGrid.hpp"
+
+#endif
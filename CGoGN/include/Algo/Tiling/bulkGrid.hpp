@@ -0,0 +1,475 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <algorithm>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Tilings
+{
+
+template <typename MAP>
+bool bulkGrid(MAP&, unsigned int, unsigned int, const std::vector< std::vector<unsigned int> >&, bool,
+	std::vector<Dart>&, std::vector<Dart>&, unsigned int, std::false_type)
+{
+	return false;
+}
+
+template <typename MAP>
+bool bulkGrid(MAP& map, unsigned int x, unsigned int y, const std::vector< std::vector<unsigned int> >& cellFaces, bool close,
+	std::vector<Dart>& vertexDarts, std::vector<Dart>& faceDarts, unsigned int nbth, std::true_type)
+{
+	static const unsigned int cornerX[4] = { 0, 1, 1, 0 };
+	static const unsigned int cornerY[4] = { 0, 0, 1, 1 };
+
+	if (x == 0 || y == 0)
+		return false;
+
+	// darts of one cell: origin and destination corners, phi1 / phi_1 in the cell
+	std::vector<unsigned int> origin, dest, next, first;
+	for (unsigned int f = 0; f < cellFaces.size(); ++f)
+	{
+		unsigned int deg = (unsigned int)(cellFaces[f].size());
+		unsigned int base = (unsigned int)(origin.size());
+		first.push_back(base);
+		for (unsigned int e = 0; e < deg; ++e)
+		{
+			origin.push_back(cellFaces[f][e]);
+			dest.push_back(cellFaces[f][(e+1) % deg]);
+			next.push_back(base + (e+1) % deg);
+		}
+	}
+	const unsigned int nbl = (unsigned int)(origin.size());
+
+	// phi2 inside the cell, or side of the cell (0 bottom, 1 right, 2 top, 3 left)
+	std::vector<int> inner(nbl, -1);
+	std::vector<unsigned int> side(nbl, 4);
+	int sideDart[4] = { -1, -1, -1, -1 };
+	int cornerDart[4] = { -1, -1, -1, -1 };
+	for (unsigned int l = 0; l < nbl; ++l)
+	{
+		if (origin[l] > 3 || dest[l] > 3)
+			return false;
+		if (cornerDart[origin[l]] < 0)
+			cornerDart[origin[l]] = int(l);
+		for (unsigned int l2 = 0; l2 < nbl; ++l2)
+		{
+			if (origin[l2] == dest[l] && dest[l2] == origin[l])
+				inner[l] = int(l2);
+		}
+		if (inner[l] < 0)
+		{
+			if (dest[l] != (origin[l] + 1) % 4 || sideDart[origin[l]] >= 0)
+				return false;
+			side[l] = origin[l];
+			sideDart[origin[l]] = int(l);
+		}
+	}
+	for (unsigned int s = 0; s < 4; ++s)
+	{
+		if (sideDart[s] < 0)
+			return false;
+	}
+
+	const unsigned int nbInner = x * y * nbl;
+	const unsigned int nbBound = close ? 2 * (x + y) : 0;
+	const unsigned int nbDarts = nbInner + nbBound;
+
+	std::vector<Dart> darts;
+	map.newDarts(nbDarts, darts);
+
+	const unsigned int nbV = (x+1) * (y+1);
+	const bool embV = map.template isOrbitEmbedded<VERTEX>();
+	std::vector<unsigned int> vEmb;
+	std::vector<unsigned int> dartVertex;
+	if (embV)
+	{
+		vEmb.resize(nbV);
+		for (unsigned int v = 0; v < nbV; ++v)
+			vEmb[v] = map.template newCell<VERTEX>();
+		dartVertex.resize(nbDarts);
+	}
+
+	// boundary darts are numbered counterclockwise along the border
+	auto borderIndex = [&] (unsigned int i, unsigned int j, unsigned int s) -> unsigned int
+	{
+		switch (s)
+		{
+			case 0: return j;
+			case 1: return x + i;
+			case 2: return x + y + (x-1-j);
+			default: return 2*x + y + (y-1-i);
+		}
+	};
+	auto borderDart = [&] (unsigned int k) -> unsigned int
+	{
+		unsigned int i, j, s;
+		if (k < x) { i = 0; j = k; s = 0; }
+		else if (k < x + y) { i = k - x; j = x-1; s = 1; }
+		else if (k < 2*x + y) { i = y-1; j = x-1 - (k - x - y); s = 2; }
+		else { i = y-1 - (k - 2*x - y); j = 0; s = 3; }
+		return (i*x + j) * nbl + sideDart[s];
+	};
+
+	CGoGN::Parallel::foreach_index(map, nbDarts, [&] (unsigned int id, unsigned int)
+	{
+		Dart d = darts[id];
+		if (id < nbInner)
+		{
+			unsigned int l = id % nbl;
+			unsigned int c = id / nbl;
+			unsigned int i = c / x;
+			unsigned int j = c % x;
+			unsigned int base = id - l;
+
+			map.bulkPhi1(d, darts[base + next[l]]);
+
+			Dart e = d;
+			if (inner[l] >= 0)
+				e = darts[base + inner[l]];
+			else
+			{
+				unsigned int s = side[l];
+				int ni = int(i) + (s == 2 ? 1 : 0) - (s == 0 ? 1 : 0);
+				int nj = int(j) + (s == 1 ? 1 : 0) - (s == 3 ? 1 : 0);
+				if (ni >= 0 && nj >= 0 && ni < int(y) && nj < int(x))
+					e = darts[(ni*x + nj) * nbl + sideDart[(s+2) % 4]];
+				else if (close)
+					e = darts[nbInner + borderIndex(i, j, s)];
+			}
+			map.bulkPhi2(d, e);
+
+			if (embV)
+			{
+				unsigned int v = (i + cornerY[origin[l]]) * (x+1) + j + cornerX[origin[l]];
+				dartVertex[id] = v;
+				map.template bulkDartEmbedding<VERTEX>(d, vEmb[v]);
+			}
+		}
+		else
+		{
+			unsigned int k = id - nbInner;
+			unsigned int b = borderDart(k);
+			map.bulkPhi1(d, darts[nbInner + (k + nbBound - 1) % nbBound]);
+			map.bulkPhi2(d, darts[b]);
+
+			if (embV)
+			{
+				// origin of the boundary dart is the destination of the border dart
+				unsigned int l = b % nbl;
+				unsigned int c = b / nbl;
+				unsigned int v = (c / x + cornerY[dest[l]]) * (x+1) + c % x + cornerX[dest[l]];
+				dartVertex[id] = v;
+				map.template bulkDartEmbedding<VERTEX>(d, vEmb[v]);
+			}
+		}
+	}, nbth);
+
+	for (unsigned int k = 0; k < nbBound; ++k)
+		map.template boundaryMark<2>(darts[nbInner + k]);
+
+	if (embV)
+	{
+		std::vector<unsigned int> nbRefs(nbV, 1);
+		for (unsigned int id = 0; id < nbDarts; ++id)
+			++nbRefs[dartVertex[id]];
+		AttributeContainer& cont = map.template getAttributeContainer<VERTEX>();
+		for (unsigned int v = 0; v < nbV; ++v)
+			cont.setNbRefs(vEmb[v], nbRefs[v]);
+	}
+
+	vertexDarts.reserve(vertexDarts.size() + nbV);
+	for (unsigned int i = 0; i <= y; ++i)
+	{
+		for (unsigned int j = 0; j <= x; ++j)
+		{
+			unsigned int ci = std::min(i, y-1);
+			unsigned int cj = std::min(j, x-1);
+			unsigned int corner = (i == ci) ? ((j == cj) ? 0 : 1) : ((j == cj) ? 3 : 2);
+			vertexDarts.push_back(darts[(ci*x + cj) * nbl + cornerDart[corner]]);
+		}
+	}
+
+	faceDarts.reserve(faceDarts.size() + x * y * cellFaces.size());
+	for (unsigned int c = 0; c < x * y; ++c)
+	{
+		for (unsigned int f = 0; f < first.size(); ++f)
+			faceDarts.push_back(darts[c * nbl + first[f]]);
+	}
+
+	return true;
+}
+
+template <typename MAP>
+bool bulkGrid(MAP& map, unsigned int x, unsigned int y, const std::vector< std::vector<unsigned int> >& cellFaces, bool close,
+	std::vector<Dart>& vertexDarts, std::vector<Dart>& faceDarts, unsigned int nbth)
+{
+	return bulkGrid(map, x, y, cellFaces, close, vertexDarts, faceDarts, nbth,
+		typename std::is_base_of<Map2<MapMono>, MAP>::type());
+}
+
+} // namespace Tilings
+
+} // namespace Surface
+
+namespace Volume
+{
+
+namespace Tilings
+{
+
+template <typename MAP>
+bool bulkHexaGrid(MAP&, unsigned int, unsigned int, unsigned int, std::vector<Dart>&, unsigned int, std::false_type)
+{
+	return false;
+}
+
+template <typename MAP>
+bool bulkHexaGrid(MAP& map, unsigned int x, unsigned int y, unsigned int z, std::vector<Dart>& vertexDarts, unsigned int nbth, std::true_type)
+{
+	// corner a+2b+4c of a cell is at offset (a,b,c)
+	// face f is on side f: -x, +x, -y, +y, -z, +z (counterclockwise seen from outside)
+	static const unsigned int faces[6][4] = {
+		{ 0, 4, 6, 2 }, { 1, 3, 7, 5 },
+		{ 0, 1, 5, 4 }, { 2, 6, 7, 3 },
+		{ 0, 2, 3, 1 }, { 4, 5, 7, 6 }
+	};
+
+	if (x == 0 || y == 0 || z == 0)
+		return false;
+
+	const unsigned int n[3] = { x, y, z };
+
+	// darts of one cell: l = 4*face + edge
+	unsigned int origin[24], dest[24], phi2l[24], phi3l[24];
+	int cornerDart[8] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+	for (unsigned int l = 0; l < 24; ++l)
+	{
+		origin[l] = faces[l/4][l%4];
+		dest[l] = faces[l/4][(l+1)%4];
+		if (cornerDart[origin[l]] < 0)
+			cornerDart[origin[l]] = int(l);
+	}
+	for (unsigned int l = 0; l < 24; ++l)
+	{
+		unsigned int f = l / 4;
+		unsigned int bit = 1u << (f / 2);
+		for (unsigned int l2 = 0; l2 < 24; ++l2)
+		{
+			if (origin[l2] == dest[l] && dest[l2] == origin[l])
+				phi2l[l] = l2;
+			if (l2 / 4 == (f ^ 1u) && origin[l2] == (dest[l] ^ bit) && dest[l2] == (origin[l] ^ bit))
+				phi3l[l] = l2;
+		}
+	}
+
+	// outer faces of side f are numbered in the 2D grid of the two other axes
+	unsigned int sideOffset[7];
+	sideOffset[0] = 0;
+	for (unsigned int f = 0; f < 6; ++f)
+	{
+		unsigned int a = f / 2;
+		sideOffset[f+1] = sideOffset[f] + n[(a+1)%3] * n[(a+2)%3];
+	}
+
+	const unsigned int nbCells = x * y * z;
+	const unsigned int nbInner = 24 * nbCells;
+	const unsigned int nbBound = 4 * sideOffset[6];
+	const unsigned int nbDarts = nbInner + nbBound;
+
+	std::vector<Dart> darts;
+	map.newDarts(nbDarts, darts);
+
+	const unsigned int nbV = (x+1) * (y+1) * (z+1);
+	const bool embV = map.template isOrbitEmbedded<VERTEX>();
+	std::vector<unsigned int> vEmb;
+	std::vector<unsigned int> dartVertex;
+	if (embV)
+	{
+		vEmb.resize(nbV);
+		for (unsigned int v = 0; v < nbV; ++v)
+			vEmb[v] = map.template newCell<VERTEX>();
+		dartVertex.resize(nbDarts);
+	}
+
+	auto cellIndex = [&] (const unsigned int* p) -> unsigned int
+	{
+		return (p[2] * y + p[1]) * x + p[0];
+	};
+	auto vertexIndex = [&] (const unsigned int* p, unsigned int corner) -> unsigned int
+	{
+		return ((p[2] + ((corner >> 2) & 1)) * (y+1) + p[1] + ((corner >> 1) & 1)) * (x+1) + p[0] + (corner & 1);
+	};
+	// neighbour of cell p through face f (false on the border)
+	auto neighbour = [&] (const unsigned int* p, unsigned int f, unsigned int* q) -> bool
+	{
+		unsigned int a = f / 2;
+		q[0] = p[0]; q[1] = p[1]; q[2] = p[2];
+		if (f & 1)
+		{
+			if (p[a] + 1 >= n[a])
+				return false;
+			++q[a];
+		}
+		else
+		{
+			if (p[a] == 0)
+				return false;
+			--q[a];
+		}
+		return true;
+	};
+	// index of the boundary dart sewn (phi3) to dart l of the border cell p
+	auto boundaryIndex = [&] (const unsigned int* p, unsigned int l) -> unsigned int
+	{
+		unsigned int f = l / 4;
+		unsigned int a = f / 2;
+		unsigned int face = sideOffset[f] + p[(a+2)%3] * n[(a+1)%3] + p[(a+1)%3];
+		return nbInner + 4 * face + l % 4;
+	};
+
+	// darts of the cells
+	CGoGN::Parallel::foreach_index(map, nbCells, [&] (unsigned int c, unsigned int)
+	{
+		unsigned int p[3], q[3];
+		p[0] = c % x; p[1] = (c / x) % y; p[2] = c / (x * y);
+		const unsigned int base = 24 * c;
+
+		unsigned int vertex[8];
+		for (unsigned int corner = 0; corner < 8; ++corner)
+			vertex[corner] = vertexIndex(p, corner);
+
+		for (unsigned int f = 0; f < 6; ++f)
+		{
+			bool inside = neighbour(p, f, q);
+			unsigned int nbase = 24 * cellIndex(q);
+			for (unsigned int l = 4 * f; l < 4 * f + 4; ++l)
+			{
+				Dart d = darts[base + l];
+				map.bulkPhi1(d, darts[base + 4 * f + (l+1) % 4]);
+				map.bulkPhi2(d, darts[base + phi2l[l]]);
+				map.bulkPhi3(d, darts[inside ? nbase + phi3l[l] : boundaryIndex(p, l)]);
+				if (embV)
+				{
+					dartVertex[base + l] = vertex[origin[l]];
+					map.template bulkDartEmbedding<VERTEX>(d, vEmb[vertex[origin[l]]]);
+				}
+			}
+		}
+	}, nbth);
+
+	// darts of the boundary: one face of 4 darts for each outer face of the grid
+	CGoGN::Parallel::foreach_index(map, sideOffset[6], [&] (unsigned int face, unsigned int)
+	{
+		unsigned int p[3], q[3];
+		unsigned int f = 0;
+		while (face >= sideOffset[f+1])
+			++f;
+		unsigned int a = f / 2;
+		unsigned int r = face - sideOffset[f];
+		p[a] = (f & 1) ? n[a] - 1 : 0;
+		p[(a+1)%3] = r % n[(a+1)%3];
+		p[(a+2)%3] = r / n[(a+1)%3];
+		const unsigned int c = cellIndex(p);
+
+		for (unsigned int e = 0; e < 4; ++e)
+		{
+			unsigned int id = nbInner + 4 * face + e;
+			Dart d = darts[id];
+			unsigned int l = 4 * f + e;
+
+			map.bulkPhi3(d, darts[24 * c + l]);
+			map.bulkPhi1(d, darts[nbInner + 4 * face + (e+3) % 4]);
+
+			// turn around the edge inside the grid until the next outer face
+			unsigned int t[3] = { p[0], p[1], p[2] };
+			unsigned int m = phi2l[l];
+			while (neighbour(t, m/4, q))
+			{
+				m = phi2l[phi3l[m]];
+				t[0] = q[0]; t[1] = q[1]; t[2] = q[2];
+			}
+			map.bulkPhi2(d, darts[boundaryIndex(t, m)]);
+
+			if (embV)
+			{
+				unsigned int v = vertexIndex(p, dest[l]);
+				dartVertex[id] = v;
+				map.template bulkDartEmbedding<VERTEX>(d, vEmb[v]);
+			}
+		}
+	}, nbth);
+
+	for (unsigned int k = nbInner; k < nbDarts; ++k)
+		map.template boundaryMark<3>(darts[k]);
+
+	if (embV)
+	{
+		std::vector<unsigned int> nbRefs(nbV, 1);
+		for (unsigned int id = 0; id < nbDarts; ++id)
+			++nbRefs[dartVertex[id]];
+		AttributeContainer& cont = map.template getAttributeContainer<VERTEX>();
+		for (unsigned int v = 0; v < nbV; ++v)
+			cont.setNbRefs(vEmb[v], nbRefs[v]);
+	}
+
+	vertexDarts.reserve(vertexDarts.size() + nbV);
+	unsigned int p[3];
+	for (unsigned int k = 0; k <= z; ++k)
+	{
+		for (unsigned int j = 0; j <= y; ++j)
+		{
+			for (unsigned int i = 0; i <= x; ++i)
+			{
+				p[0] = std::min(i, x-1); p[1] = std::min(j, y-1); p[2] = std::min(k, z-1);
+				unsigned int corner = (i - p[0]) + 2 * (j - p[1]) + 4 * (k - p[2]);
+				vertexDarts.push_back(darts[24 * cellIndex(p) + cornerDart[corner]]);
+			}
+		}
+	}
+
+	return true;
+}
+
+template <typename MAP>
+bool bulkHexaGrid(MAP& map, unsigned int x, unsigned int y, unsigned int z, std::vector<Dart>& vertexDarts, unsigned int nbth)
+{
+	return bulkHexaGrid(map, x, y, z, vertexDarts, nbth, typename std::is_base_of<Map3<MapMono>, MAP>::type());
+}
+
+} // namespace Tilings
+
+} // namespace Volume
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -26,6 +26,12 @@
 #ifndef __UNIFORM_ORIENTATION__
 #define __UNIFORM_ORIENTATION__
 
+#include <vector>
+#include <unordered_map>
+
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Topology/generic/dartmarker.h"
+
 namespace CGoGN
 {
 
@@ -38,6 +44,8 @@ namespace Topo
 /**
  * @brief Restore an uniform orientation on a mesh that has been imported from set of triangle with non uniform orientation
  * @param map a Map2 or inherited
+ * Boundary edges are paired through a hash table of their vertex embeddings and
+ * the faces are traversed once (breadth first), so the cost is linear in the size of the map.
  * @param faceSeed a dart of a face of the CC to process.
  */
 template <typename MAP>
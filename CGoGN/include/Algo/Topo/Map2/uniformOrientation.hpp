@@ -28,20 +28,12 @@ void reverse2MapFaceKeepPhi2(MAP& map, Dart d)
 }
 
 // private function
-inline Dart findOtherInCouplesOfDarts(const std::vector<Dart>& couples, Dart d)
+template <typename MAP>
+inline unsigned long long orientedEdgeKey(MAP& map, Dart d)
 {
-	unsigned int nb = (unsigned int)(couples.size());
-	for (unsigned int i=0; i<nb; ++i)
-	{
-		if (couples[i] == d)
-		{
-			if (i%2 == 0)
-				return couples[i+1];
-			//else
-				return couples[i-1];
-		}
-	}
-	return NIL;
+	unsigned long long a = map.template getEmbedding<VERTEX>(d);
+	unsigned long long b = map.template getEmbedding<VERTEX>(map.phi1(d));
+	return (a << 32) | b;
 }
 
 
@@ -49,139 +41,105 @@ inline Dart findOtherInCouplesOfDarts(const std::vector<Dart>& couples, Dart d)
 template <typename MAP>
 void uniformOrientationCC(MAP& map, Dart faceSeed)
 {
-	// first bufferize boundary edges
+	// first bufferize boundary edges (dart of the face side)
 	std::vector<Dart> boundEdges;
 	TraversorE<MAP> travEdge(map);
 	for (Dart d=travEdge.begin(); d!= travEdge.end(); d = travEdge.next())
 	{
 		if (map.isBoundaryEdge(d))
+		{
+			if (map.template isBoundaryMarked<2>(d))
+				d = map.phi2(d);
 			boundEdges.push_back(d);
+		}
 	}
 
-	// store couple of boundary edges the have same embedding
+	// store couple of boundary edges the have same embedding:
+	// an edge waits in the table until the next edge with same (oriented) vertices
 	std::vector<Dart> couples;
-	int nb = int(boundEdges.size());
-	int nbm = nb-1;
-	for (int i=0; i< nbm; ++i)
+	std::unordered_map<unsigned long long, Dart> waiting;
+	std::unordered_map<unsigned int, Dart> partner;
+	waiting.reserve(boundEdges.size());
+	partner.reserve(boundEdges.size());
+	for (std::vector<Dart>::iterator it = boundEdges.begin(); it != boundEdges.end(); ++it)
 	{
-		if (boundEdges[i] != NIL)
+		Dart e = *it;
+		std::pair<std::unordered_map<unsigned long long, Dart>::iterator, bool> ins = waiting.insert(std::make_pair(orientedEdgeKey<MAP>(map, e), e));
+		if (!ins.second)
 		{
-			for (int j=i+1; j< nb; ++j)
-			{
-				if (boundEdges[j] != NIL)
-				{
-					Dart d = boundEdges[i];
-					Dart d1 = map.phi1(d);
-					Dart e = boundEdges[j];
-					Dart e1 = map.phi1(e);
-
-					if ((map.template getEmbedding<VERTEX>(d) == map.template getEmbedding<VERTEX>(e)) && (map.template getEmbedding<VERTEX>(d1) == map.template getEmbedding<VERTEX>(e1)))
-					{
-						couples.push_back(d);
-						couples.push_back(e);
-						boundEdges[j] = NIL; // not using the dart again
-						j=nb; // out of the loop
-					}
-				}
-			}
+			Dart d = ins.first->second;
+			couples.push_back(d);
+			couples.push_back(e);
+			partner[d.index] = e;
+			partner[e.index] = d;
+			waiting.erase(ins.first); // not using the darts again
 		}
 	}
+	waiting.clear();
 
-
-	// vector of front propagation for good orientation
+	// breadth first traversal of the faces, with a flag for wrong orientation
 	std::vector<Dart> propag;
 	boundEdges.clear();
 	propag.swap(boundEdges);// reused memory of boundEdges
 
-
-	// vector of front propagation for wrong orientation
-	std::vector<Dart> propag_inv;
-
 	//vector of faces to invert
 	std::vector<Dart> face2invert;
-
-	// optimize memory reserve
-	propag_inv.reserve(1024);
 	face2invert.reserve(1024);
 
 	DartMarker<MAP> cmf(map);
+	DartMarker<MAP> inv(map);
 
 	cmf.template markOrbit<FACE>(faceSeed);
 	propag.push_back(faceSeed);
 
-	while (!propag.empty() || !propag_inv.empty())
+	for (unsigned int head = 0; head < propag.size(); ++head)
 	{
-		if (!propag.empty())
-		{
-			Dart f = propag.back();
-			propag.pop_back();
+		Dart f = propag[head];
+		bool flip = inv.isMarked(f);
 
-			Dart d = f;
-			do
+		Dart d = f;
+		do
+		{
+			Dart e = map.phi2(d);
+			if (map.template isBoundaryMarked<2>(e))
 			{
-				Dart e = map.phi2(d);
-				if (map.template isBoundaryMarked<2>(e))
-				{
-					e = findOtherInCouplesOfDarts(couples,d);
-					if (e!=NIL)
-					{
-						if (!cmf.isMarked(e))
-						{
-							propag_inv.push_back(e);
-							face2invert.push_back(e);
-							cmf.template markOrbit<FACE>(e);
-						}
-						cmf.mark(map.phi2(e));// use cmf also to mark boudary cycle to invert
-					}
-
-				}
-				else
+				std::unordered_map<unsigned int, Dart>::const_iterator ip = partner.find(d.index);
+				if (ip != partner.end())
 				{
+					e = ip->second;
 					if (!cmf.isMarked(e))
 					{
+						// faces linked through a couple have opposite orientation flags
 						propag.push_back(e);
 						cmf.template markOrbit<FACE>(e);
-					}
-				}
-				d= map.phi1(d);
-
-			} while (d!=f);
-		}
-
-		if (!propag_inv.empty())
-		{
-			Dart f = propag_inv.back();
-			propag_inv.pop_back();
-
-			Dart d = f;
-			do
-			{
-				Dart e = map.phi2(d);
-				if (map.template isBoundaryMarked<2>(e))
-				{
-					e = findOtherInCouplesOfDarts(couples,d);
-					if (e!=NIL)
-					{
-						if (!cmf.isMarked(e))
+						if (!flip)
 						{
-							propag.push_back(e);
-							cmf.template markOrbit<FACE>(e);
+							inv.template markOrbit<FACE>(e);
+							face2invert.push_back(e);
 						}
-						cmf.mark(map.phi2(d));// use cmf also to mark boudary cycle to invert
 					}
+					// use cmf also to mark boudary cycle to invert
+					if (flip)
+						cmf.mark(map.phi2(d));
+					else
+						cmf.mark(map.phi2(e));
 				}
-				else
+			}
+			else
+			{
+				if (!cmf.isMarked(e))
 				{
-					if (!cmf.isMarked(e))
+					propag.push_back(e);
+					cmf.template markOrbit<FACE>(e);
+					if (flip)
 					{
-						propag_inv.push_back(e);
+						inv.template markOrbit<FACE>(e);
 						face2invert.push_back(e);
-						cmf.template markOrbit<FACE>(e);
 					}
 				}
-				d= map.phi1(d); // traverse all edges of face
-			} while (d!=f);
-		}
+			}
+			d= map.phi1(d); // traverse all edges of face
+		} while (d!=f);
 	}
 
 	// reverse all faces of the wrong orientation
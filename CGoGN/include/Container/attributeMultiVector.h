@@ -30,6 +30,8 @@
 #include <sstream>
 #include <fstream>
 #include <cstring>
+#include <utility>
+#include <mutex>
 
 #include <typeinfo>
 
@@ -79,6 +81,31 @@ protected:
 	 */
 	unsigned int m_index;
 
+	/**
+	 * dirty tracking state (disabled by default)
+	 * - one flag per block, set by non-const element access
+	 * - half-open ranges [begin,end) of written indices, set by line management
+	 *   and explicit markDirty calls, protected by m_dirtyMutex (line management may
+	 *   run in Parallel::foreach_* workers)
+	 * the state is mutable because consumers (VBO) clear it through const pointers
+	 */
+	bool m_dirtyTracking;
+
+	mutable std::vector<unsigned char> m_dirtyBlocks;
+
+	mutable std::vector< std::pair<unsigned int, unsigned int> > m_dirtyRanges;
+
+	mutable unsigned int m_dirtyEpoch;
+
+	mutable std::mutex m_dirtyMutex;
+
+	/**
+	 * resize the block flags to nbb blocks (new blocks are dirty)
+	 */
+	void resizeDirtyBlocks(unsigned int nbb);
+
+	static unsigned int newDirtyEpoch();
+
 public:
 	AttributeMultiVectorGen(const std::string& strName, const std::string& strType);
 
@@ -179,6 +206,68 @@ public:
 
 	virtual void overwrite(unsigned int src_b, unsigned int src_id, unsigned int dst_b, unsigned int dst_id) = 0;
 
+	/**************************************
+	 *           DIRTY TRACKING           *
+	 **************************************/
+
+	/**
+	 * enable / disable the tracking of modified elements
+	 * enabling the tracking marks the whole attribute dirty.
+	 * Writes through non-const operator[] flag their block. Concurrent writes
+	 * only store the same flag value; writes through raw block pointers
+	 * (getBlocksPointers) are not seen and need an explicit markDirty.
+	 */
+	void setDirtyTracking(bool b);
+
+	bool isDirtyTracking() const;
+
+	/**
+	 * mark element i as modified
+	 */
+	void markDirty(unsigned int i);
+
+	/**
+	 * mark elements of [begin,end) as modified
+	 */
+	void markDirty(unsigned int begin, unsigned int end);
+
+	/**
+	 * mark block b as modified
+	 */
+	void markDirtyBlock(unsigned int b);
+
+	void markAllDirty();
+
+	/**
+	 * is there any modified element since last clearDirty
+	 */
+	bool isDirty() const;
+
+	bool isBlockDirty(unsigned int b) const;
+
+	/**
+	 * get the sorted, disjoint ranges [begin,end) of modified elements
+	 * @param ranges the result
+	 * @param maxGap ranges separated by at most maxGap clean elements are merged
+	 */
+	void getDirtyRanges(std::vector< std::pair<unsigned int, unsigned int> >& ranges, unsigned int maxGap = 0) const;
+
+	/**
+	 * forget modifications (called by the consumer once it is up to date)
+	 * and start a new epoch
+	 */
+	void clearDirty() const;
+
+	/**
+	 * epoch of the dirty state: a consumer synchronized at the current epoch
+	 * only needs the dirty ranges to be up to date
+	 */
+	unsigned int getDirtyEpoch() const;
+
+	/**
+	 * sort ranges and merge those that overlap or are separated by at most maxGap
+	 */
+	static void coalesceRanges(std::vector< std::pair<unsigned int, unsigned int> >& ranges, unsigned int maxGap = 0);
 
 	/**************************************
 	 *            SAVE & LOAD             *
@@ -268,6 +357,12 @@ public:
 	 */
 	unsigned int getBlocksPointers(std::vector<void*>& addr, unsigned int& byteBlockSize) const;
 
+	/**
+	 * Get the table of blocks addresses without copying it
+	 * (valid until a block is added or removed, or the attribute is swapped)
+	 */
+	T* const* getBlocksTable() const;
+
 	/**************************************
 	 *          LINES MANAGEMENT          *
 	 **************************************/
@@ -21,16 +21,20 @@
 * Contact information: cgogn@unistra.fr                                        *
 *                                                                              *
 *******************************************************************************/
+#include <algorithm>
+#include <atomic>
+
 #include "Geometry/vector_gen.h"
 
 namespace CGoGN
 {
 
 inline AttributeMultiVectorGen::AttributeMultiVectorGen(const std::string& strName, const std::string& strType):
-	m_attrName(strName), m_typeName(strType)
+	m_attrName(strName), m_typeName(strType), m_dirtyTracking(false), m_dirtyEpoch(0)
 {}
 
-inline AttributeMultiVectorGen::AttributeMultiVectorGen()
+inline AttributeMultiVectorGen::AttributeMultiVectorGen():
+	m_dirtyTracking(false), m_dirtyEpoch(0)
 {}
 
 inline AttributeMultiVectorGen::~AttributeMultiVectorGen()
@@ -90,6 +94,188 @@ inline CGoGNCodeType AttributeMultiVectorGen::getTypeCode() const
 	return m_typeCode;
 }
 
+/**************************************
+ *           DIRTY TRACKING           *
+ **************************************/
+
+inline unsigned int AttributeMultiVectorGen::newDirtyEpoch()
+{
+	// epochs are unique among all attributes so that a consumer can not
+	// mistake an attribute allocated at the address of a deleted one
+	static std::atomic<unsigned int> counter(0);
+	return ++counter;
+}
+
+inline void AttributeMultiVectorGen::resizeDirtyBlocks(unsigned int nbb)
+{
+	std::lock_guard<std::mutex> lock(m_dirtyMutex);
+	if (m_dirtyTracking)
+		m_dirtyBlocks.resize(nbb, 1);
+}
+
+inline void AttributeMultiVectorGen::setDirtyTracking(bool b)
+{
+	std::lock_guard<std::mutex> lock(m_dirtyMutex);
+	m_dirtyTracking = b;
+	m_dirtyRanges.clear();
+	if (b)
+		m_dirtyBlocks.assign(getNbBlocks(), 1);
+	else
+		m_dirtyBlocks.clear();
+	m_dirtyEpoch = newDirtyEpoch();
+}
+
+inline bool AttributeMultiVectorGen::isDirtyTracking() const
+{
+	return m_dirtyTracking;
+}
+
+inline void AttributeMultiVectorGen::markDirty(unsigned int i)
+{
+	markDirty(i, i + 1);
+}
+
+inline void AttributeMultiVectorGen::markDirty(unsigned int begin, unsigned int end)
+{
+	if (!m_dirtyTracking || begin >= end)
+		return;
+
+	std::lock_guard<std::mutex> lock(m_dirtyMutex);
+
+	// extend the last range when writes are sequential
+	if (!m_dirtyRanges.empty())
+	{
+		std::pair<unsigned int, unsigned int>& last = m_dirtyRanges.back();
+		if (begin <= last.second && end >= last.first)
+		{
+			last.first = std::min(last.first, begin);
+			last.second = std::max(last.second, end);
+			return;
+		}
+	}
+	m_dirtyRanges.push_back(std::make_pair(begin, end));
+
+	// scattered writes: bound the memory by falling back to block flags
+	if (m_dirtyRanges.size() >= 4096)
+	{
+		coalesceRanges(m_dirtyRanges);
+		if (m_dirtyRanges.size() >= 1024)
+		{
+			for (std::vector< std::pair<unsigned int, unsigned int> >::const_iterator it = m_dirtyRanges.begin(); it != m_dirtyRanges.end(); ++it)
+			{
+				unsigned int last = std::min<unsigned int>((it->second - 1) / _BLOCKSIZE_ + 1, uint32(m_dirtyBlocks.size()));
+				for (unsigned int b = it->first / _BLOCKSIZE_; b < last; ++b)
+					m_dirtyBlocks[b] = 1;
+			}
+			m_dirtyRanges.clear();
+		}
+	}
+}
+
+inline void AttributeMultiVectorGen::markDirtyBlock(unsigned int b)
+{
+	if (m_dirtyTracking && b < m_dirtyBlocks.size())
+		m_dirtyBlocks[b] = 1;
+}
+
+inline void AttributeMultiVectorGen::markAllDirty()
+{
+	if (!m_dirtyTracking)
+		return;
+	std::lock_guard<std::mutex> lock(m_dirtyMutex);
+	m_dirtyRanges.clear();
+	m_dirtyBlocks.assign(getNbBlocks(), 1);
+}
+
+inline bool AttributeMultiVectorGen::isDirty() const
+{
+	if (!m_dirtyTracking)
+		return true;
+	std::lock_guard<std::mutex> lock(m_dirtyMutex);
+	if (!m_dirtyRanges.empty())
+		return true;
+	for (std::vector<unsigned char>::const_iterator it = m_dirtyBlocks.begin(); it != m_dirtyBlocks.end(); ++it)
+		if (*it)
+			return true;
+	return false;
+}
+
+inline bool AttributeMultiVectorGen::isBlockDirty(unsigned int b) const
+{
+	if (!m_dirtyTracking)
+		return true;
+	if (b < m_dirtyBlocks.size() && m_dirtyBlocks[b])
+		return true;
+	unsigned int begin = b * _BLOCKSIZE_;
+	unsigned int end = begin + _BLOCKSIZE_;
+	std::lock_guard<std::mutex> lock(m_dirtyMutex);
+	for (std::vector< std::pair<unsigned int, unsigned int> >::const_iterator it = m_dirtyRanges.begin(); it != m_dirtyRanges.end(); ++it)
+		if (it->first < end && it->second > begin)
+			return true;
+	return false;
+}
+
+inline void AttributeMultiVectorGen::getDirtyRanges(std::vector< std::pair<unsigned int, unsigned int> >& ranges, unsigned int maxGap) const
+{
+	ranges.clear();
+	unsigned int nbElts = getNbBlocks() * _BLOCKSIZE_;
+
+	if (!m_dirtyTracking)
+	{
+		if (nbElts > 0)
+			ranges.push_back(std::make_pair(0u, nbElts));
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_dirtyMutex);
+	for (unsigned int b = 0; b < m_dirtyBlocks.size(); ++b)
+	{
+		if (m_dirtyBlocks[b])
+			ranges.push_back(std::make_pair(b * _BLOCKSIZE_, (b + 1) * _BLOCKSIZE_));
+	}
+
+	for (std::vector< std::pair<unsigned int, unsigned int> >::const_iterator it = m_dirtyRanges.begin(); it != m_dirtyRanges.end(); ++it)
+	{
+		unsigned int end = std::min(it->second, nbElts);
+		if (it->first < end)
+			ranges.push_back(std::make_pair(it->first, end));
+	}
+
+	coalesceRanges(ranges, maxGap);
+}
+
+inline void AttributeMultiVectorGen::clearDirty() const
+{
+	std::lock_guard<std::mutex> lock(m_dirtyMutex);
+	m_dirtyRanges.clear();
+	std::fill(m_dirtyBlocks.begin(), m_dirtyBlocks.end(), 0);
+	m_dirtyEpoch = newDirtyEpoch();
+}
+
+inline unsigned int AttributeMultiVectorGen::getDirtyEpoch() const
+{
+	return m_dirtyEpoch;
+}
+
+inline void AttributeMultiVectorGen::coalesceRanges(std::vector< std::pair<unsigned int, unsigned int> >& ranges, unsigned int maxGap)
+{
+	if (ranges.size() < 2)
+		return;
+
+	std::sort(ranges.begin(), ranges.end());
+
+	unsigned int j = 0;
+	for (unsigned int i = 1; i < ranges.size(); ++i)
+	{
+		// compare as gap <= maxGap to avoid overflowing second + maxGap
+		if (ranges[i].first <= ranges[j].second || ranges[i].first - ranges[j].second <= maxGap)
+			ranges[j].second = std::max(ranges[j].second, ranges[i].second);
+		else
+			ranges[++j] = ranges[i];
+	}
+	ranges.resize(j + 1);
+}
+
 /***************************************************************************************************/
 /***************************************************************************************************/
 
@@ -131,6 +317,7 @@ inline void AttributeMultiVector<T>::addBlock()
 {
 	T* ptr = new T[_BLOCKSIZE_];
 	m_tableData.push_back(ptr);
+	resizeDirtyBlocks(uint32(m_tableData.size()));
 	// init
 //	T* endPtr = ptr + _BLOCKSIZE_;
 //	while (ptr != endPtr)
@@ -150,6 +337,7 @@ void AttributeMultiVector<T>::setNbBlocks(unsigned int nbb)
 		for (size_t i = nbb; i < m_tableData.size(); ++i)
 			delete[] m_tableData[i];
 		m_tableData.resize(nbb);
+		resizeDirtyBlocks(nbb);
 	}
 }
 
@@ -172,6 +360,7 @@ void AttributeMultiVector<T>::addBlocksBefore(unsigned int nbb)
 		tempo.push_back(*it);
 
 	m_tableData.swap(tempo);
+	markAllDirty();
 }
 
 template <typename T>
@@ -193,6 +382,7 @@ bool AttributeMultiVector<T>::copy(const AttributeMultiVectorGen* atmvg)
 	for (unsigned int i = 0; i < atmv->m_tableData.size(); ++i)
 		std::memcpy( (void*) m_tableData[i], (void*) atmv->m_tableData[i], _BLOCKSIZE_ * sizeof(T));
 
+	markAllDirty();
 	return true;
 }
 
@@ -213,6 +403,8 @@ bool AttributeMultiVector<T>::swap(AttributeMultiVectorGen* atmvg)
 	}
 
 	m_tableData.swap(atmv->m_tableData) ;
+	markAllDirty();
+	atmv->markAllDirty();
 	return true;
 }
 
@@ -235,6 +427,7 @@ bool AttributeMultiVector<T>::merge(const AttributeMultiVectorGen& att)
 	for (typename std::vector<T*>::const_iterator it = attrib->m_tableData.begin(); it != attrib->m_tableData.end(); ++it)
 		m_tableData.push_back(*it);
 
+	resizeDirtyBlocks(uint32(m_tableData.size()));
 	return true;
 }
 
@@ -244,6 +437,9 @@ inline void AttributeMultiVector<T>::clear()
 	for (typename std::vector< T* >::iterator it = m_tableData.begin(); it != m_tableData.end(); ++it)
 		delete[] (*it);
 	m_tableData.clear();
+	std::lock_guard<std::mutex> lock(m_dirtyMutex);
+	m_dirtyBlocks.clear();
+	m_dirtyRanges.clear();
 }
 
 template <typename T>
@@ -259,6 +455,8 @@ inline int AttributeMultiVector<T>::getSizeOfType() const
 template <typename T>
 inline T& AttributeMultiVector<T>::operator[](unsigned int i)
 {
+	if (m_dirtyTracking)
+		m_dirtyBlocks[i / _BLOCKSIZE_] = 1;
 	return m_tableData[i / _BLOCKSIZE_][i % _BLOCKSIZE_];
 }
 
@@ -282,6 +480,12 @@ unsigned int AttributeMultiVector<T>::getBlocksPointers(std::vector<void*>& addr
 	return uint32(addr.size());
 }
 
+template <typename T>
+inline T* const* AttributeMultiVector<T>::getBlocksTable() const
+{
+	return m_tableData.empty() ? NULL : &m_tableData[0];
+}
+
 /**************************************
  *          LINES MANAGEMENT          *
  **************************************/
@@ -290,12 +494,14 @@ template <typename T>
 inline void AttributeMultiVector<T>::initElt(unsigned int id)
 {
 	m_tableData[id / _BLOCKSIZE_][id % _BLOCKSIZE_] = T(); // T(0);
+	markDirty(id);
 }
 
 template <typename T>
 inline void AttributeMultiVector<T>::copyElt(unsigned int dst, unsigned int src)
 {
 	m_tableData[dst / _BLOCKSIZE_][dst % _BLOCKSIZE_] = m_tableData[src / _BLOCKSIZE_][src % _BLOCKSIZE_];
+	markDirty(dst);
 }
 
 template <typename T>
@@ -304,12 +510,15 @@ void AttributeMultiVector<T>::swapElt(unsigned int id1, unsigned int id2)
 	T data = m_tableData[id1 / _BLOCKSIZE_][id1 % _BLOCKSIZE_] ;
 	m_tableData[id1 / _BLOCKSIZE_][id1 % _BLOCKSIZE_] = m_tableData[id2 / _BLOCKSIZE_][id2 % _BLOCKSIZE_] ;
 	m_tableData[id2 / _BLOCKSIZE_][id2 % _BLOCKSIZE_] = data ;
+	markDirty(id1);
+	markDirty(id2);
 }
 
 template <typename T>
 void AttributeMultiVector<T>::overwrite(unsigned int src_b, unsigned int src_id, unsigned int dst_b, unsigned int dst_id)
 {
 	m_tableData[dst_b][dst_id] = m_tableData[src_b][src_id];
+	markDirty(dst_b * _BLOCKSIZE_ + dst_id);
 }
 
 
@@ -381,6 +590,7 @@ bool AttributeMultiVector<T>::loadBin(CGoGNistream& fs)
 		m_tableData[i] = ptr;
 	}
 
+	markAllDirty();
 	return true;
 }
 
@@ -33,13 +33,13 @@
 #include "Container/fakeAttribute.h"
 #include "Topology/generic/cells.h"
 
-/// Macro that checks if ATTRIBUTEHANDLER type is an AttributeHandler
+/// Macro that checks if ATTRIBUTEHANDLER type is an AttributeHandler (or an AttributeView)
 #define CHECK_ATTRIBUTEHANDLER(ATTRIBUTEHANDLER)\
-	static_assert(std::is_base_of<AttributeHandlerGen, ATTRIBUTEHANDLER>::value, "Error not AttributeHandler");
+	static_assert(std::is_base_of<AttributeHandlerGen, ATTRIBUTEHANDLER>::value || std::is_base_of<AttributeViewGen, ATTRIBUTEHANDLER>::value, "Error not AttributeHandler");
 
-/// Macro that checks if ATTRIBUTEHANDLER type is an AttributeHandler of orbit ORBITVALUE
+/// Macro that checks if ATTRIBUTEHANDLER type is an AttributeHandler (or an AttributeView) of orbit ORBITVALUE
 #define CHECK_ATTRIBUTEHANDLER_ORBIT(ATTRIBUTEHANDLER, ORBITVALUE)\
-	static_assert(std::is_base_of<AttributeHandlerGen, ATTRIBUTEHANDLER>::value, "Error not AttributeHandler");\
+	static_assert(std::is_base_of<AttributeHandlerGen, ATTRIBUTEHANDLER>::value || std::is_base_of<AttributeViewGen, ATTRIBUTEHANDLER>::value, "Error not AttributeHandler");\
 	static_assert(ATTRIBUTEHANDLER::ORBIT == ORBITVALUE, "Error wrong orbit of AttributeHandler");
 
 namespace CGoGN
@@ -408,4 +408,6 @@ inline bool checkAttributeHandlerOrbit(const AttributeHandlerGen& att)
 
 #include "Topology/generic/attributeHandler.hpp"
 
+#include "Topology/generic/attributeView.h"
+
 #endif
@@ -206,7 +206,8 @@ inline const T& AttributeHandler<T, ORB, MAP>::operator[](Cell<ORB> c) const
 {
 	assert(this->valid || !"Invalid AttributeHandler") ;
 	unsigned int a = m_map->getEmbedding(c) ;
-	return m_attrib->operator[](a) ;
+	// const access must not flag the block as modified
+	return static_cast<const AttributeMultiVector<T>*>(m_attrib)->operator[](a) ;
 }
 
 template <typename T, unsigned int ORB, typename MAP>
@@ -220,7 +221,7 @@ template <typename T, unsigned int ORB, typename MAP>
 inline const T& AttributeHandler<T, ORB, MAP>::operator[](unsigned int a) const
 {
 	assert(this->valid || !"Invalid AttributeHandler") ;
-	return m_attrib->operator[](a) ;
+	return static_cast<const AttributeMultiVector<T>*>(m_attrib)->operator[](a) ;
 }
 
 template <typename T, unsigned int ORB, typename MAP>
@@ -0,0 +1,163 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __ATTRIBUTE_VIEW_H__
+#define __ATTRIBUTE_VIEW_H__
+
+#include "Topology/generic/attributeHandler.h"
+
+namespace CGoGN
+{
+
+/**
+ * Common base of attribute views (used by CHECK_ATTRIBUTEHANDLER macros)
+ */
+class AttributeViewGen
+{
+};
+
+/**
+ * Lightweight access-table to an existing attribute for hot loops.
+ * Unlike AttributeHandler, a view does not register in the map: copying or
+ * destroying it is free (no lock), so it can be captured by value in the
+ * lambdas of Parallel::foreach_cell or passed by value to algorithms.
+ * It caches the table of blocks of the attribute and is only valid as long as
+ * the attribute is not removed or swapped and no block is added or removed
+ * (i.e. no new cell in the orbit): rebuild it after topological modifications.
+ * In debug mode, the validity is checked (map stamp & number of blocks) at each access.
+ * Unlike AttributeHandler, the [] operator does not embed cells on the fly.
+ */
+template <typename T, unsigned int ORB, typename MAP>
+class AttributeView : public AttributeViewGen
+{
+protected:
+	// the map that contains the linked attribute
+	MAP* m_map;
+	// the multi-vector that contains attribute data
+	AttributeMultiVector<T>* m_attrib;
+	// cached table of blocks of the multi-vector
+	T* const* m_blocks;
+	// stamp of the map attributes & number of blocks when the view was created
+	unsigned int m_stamp;
+	unsigned int m_nbBlocks;
+
+public:
+	typedef T DATA_TYPE ;
+
+	static const unsigned int ORBIT = ORB;
+
+	/**
+	 * Default constructor
+	 * Constructs a non-valid view
+	 */
+	AttributeView() ;
+
+	/**
+	 * Constructor from an attribute handler
+	 * @param h the attribute handler (can be released after the construction)
+	 */
+	AttributeView(const AttributeHandler<T, ORB, MAP>& h) ;
+
+	/**
+	 * is the view linked to an attribute
+	 */
+	bool isValid() const ;
+
+	/**
+	 * is the view still up to date with the attribute (see class documentation)
+	 */
+	bool isUpToDate() const ;
+
+	MAP* map() const
+	{
+		return m_map ;
+	}
+
+	AttributeMultiVector<T>* getDataVector() const ;
+
+	unsigned int getOrbit() const ;
+
+	/**
+	 * [] operator with cell parameter (the cell must be embedded)
+	 */
+	T& operator[](Cell<ORB> c) ;
+
+	/**
+	 * const [] operator with cell parameter (the cell must be embedded)
+	 */
+	const T& operator[](Cell<ORB> c) const ;
+
+	/**
+	 * at operator (same as [] but with index parameter)
+	 */
+	T& operator[](unsigned int a) ;
+
+	/**
+	 * const at operator (same as [] but with index parameter)
+	 */
+	const T& operator[](unsigned int a) const ;
+
+	/**
+	 * begin / end / next on the lines of the attribute container
+	 */
+	unsigned int begin() const ;
+
+	unsigned int end() const ;
+
+	void next(unsigned int& iter) const ;
+} ;
+
+/**
+ * build a view of the given attribute handler
+ */
+template <typename T, unsigned int ORB, typename MAP>
+inline AttributeView<T, ORB, MAP> make_view(const AttributeHandler<T, ORB, MAP>& h)
+{
+	return AttributeView<T, ORB, MAP>(h) ;
+}
+
+/**
+ *  c++11 shortcuts for attribute views
+ */
+template <typename T, typename MAP>
+using DartAttributeView = AttributeView<T, DART, MAP>;
+
+template <typename T, typename MAP>
+using VertexAttributeView = AttributeView<T, VERTEX, MAP>;
+
+template <typename T, typename MAP>
+using EdgeAttributeView = AttributeView<T, EDGE, MAP>;
+
+template <typename T, typename MAP>
+using FaceAttributeView = AttributeView<T, FACE, MAP>;
+
+template <typename T, typename MAP>
+using VolumeAttributeView = AttributeView<T, VOLUME, MAP>;
+
+} // namespace CGoGN
+
+#include "Topology/generic/attributeView.hpp"
+
+#endif
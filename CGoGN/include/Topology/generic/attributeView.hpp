@@ -0,0 +1,128 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+namespace CGoGN
+{
+
+template <typename T, unsigned int ORB, typename MAP>
+AttributeView<T, ORB, MAP>::AttributeView() :
+	m_map(NULL),
+	m_attrib(NULL),
+	m_blocks(NULL),
+	m_stamp(0),
+	m_nbBlocks(0)
+{}
+
+template <typename T, unsigned int ORB, typename MAP>
+AttributeView<T, ORB, MAP>::AttributeView(const AttributeHandler<T, ORB, MAP>& h) :
+	m_map(NULL),
+	m_attrib(NULL),
+	m_blocks(NULL),
+	m_stamp(0),
+	m_nbBlocks(0)
+{
+	if (h.isValid())
+	{
+		m_map = h.map() ;
+		m_attrib = h.getDataVector() ;
+		m_blocks = m_attrib->getBlocksTable() ;
+		m_stamp = m_map->getAttributesStamp() ;
+		m_nbBlocks = m_attrib->getNbBlocks() ;
+	}
+}
+
+template <typename T, unsigned int ORB, typename MAP>
+inline bool AttributeView<T, ORB, MAP>::isValid() const
+{
+	return m_attrib != NULL ;
+}
+
+template <typename T, unsigned int ORB, typename MAP>
+inline bool AttributeView<T, ORB, MAP>::isUpToDate() const
+{
+	return m_attrib != NULL && m_map->getAttributesStamp() == m_stamp && m_attrib->getNbBlocks() == m_nbBlocks ;
+}
+
+template <typename T, unsigned int ORB, typename MAP>
+inline AttributeMultiVector<T>* AttributeView<T, ORB, MAP>::getDataVector() const
+{
+	return m_attrib ;
+}
+
+template <typename T, unsigned int ORB, typename MAP>
+inline unsigned int AttributeView<T, ORB, MAP>::getOrbit() const
+{
+	return ORB ;
+}
+
+template <typename T, unsigned int ORB, typename MAP>
+inline T& AttributeView<T, ORB, MAP>::operator[](Cell<ORB> c)
+{
+	return operator[](m_map->getEmbedding(c)) ;
+}
+
+template <typename T, unsigned int ORB, typename MAP>
+inline const T& AttributeView<T, ORB, MAP>::operator[](Cell<ORB> c) const
+{
+	return operator[](m_map->getEmbedding(c)) ;
+}
+
+template <typename T, unsigned int ORB, typename MAP>
+inline T& AttributeView<T, ORB, MAP>::operator[](unsigned int a)
+{
+	assert(isUpToDate() || !"Invalid or outdated AttributeView") ;
+	assert(a != EMBNULL || !"AttributeView: cell not embedded") ;
+	// tracking state is read at each write : it may be enabled after the view is built
+	m_attrib->markDirtyBlock(a / _BLOCKSIZE_) ;
+	return m_blocks[a / _BLOCKSIZE_][a % _BLOCKSIZE_] ;
+}
+
+template <typename T, unsigned int ORB, typename MAP>
+inline const T& AttributeView<T, ORB, MAP>::operator[](unsigned int a) const
+{
+	assert(isUpToDate() || !"Invalid or outdated AttributeView") ;
+	assert(a != EMBNULL || !"AttributeView: cell not embedded") ;
+	return m_blocks[a / _BLOCKSIZE_][a % _BLOCKSIZE_] ;
+}
+
+template <typename T, unsigned int ORB, typename MAP>
+inline unsigned int AttributeView<T, ORB, MAP>::begin() const
+{
+	return m_map->template getAttributeContainer<ORB>().begin() ;
+}
+
+template <typename T, unsigned int ORB, typename MAP>
+inline unsigned int AttributeView<T, ORB, MAP>::end() const
+{
+	return m_map->template getAttributeContainer<ORB>().end() ;
+}
+
+template <typename T, unsigned int ORB, typename MAP>
+inline void AttributeView<T, ORB, MAP>::next(unsigned int& iter) const
+{
+	m_map->template getAttributeContainer<ORB>().next(iter) ;
+}
+
+} // namespace CGoGN
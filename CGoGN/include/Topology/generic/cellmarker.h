@@ -259,6 +259,7 @@ public:
 	{
 		assert(this->m_markVector != NULL);
 
+		CGoGN_COUNT("CellMarker::unmarkAll/full_clear");
 		AttributeContainer& cont = this->m_map.template getAttributeContainer<CELL>() ;
 		if (cont.hasBrowser())
 			for (unsigned int i = cont.begin(); i != cont.end(); cont.next(i))
@@ -253,6 +253,7 @@ public:
 //		else
 
 		// always unmark all darts, it's to dangerous because of markOrbit that can mark dart out of Browser !
+		CGoGN_COUNT("DartMarker::unmarkAll/full_clear");
 		this->m_markVector->allFalse();
 	}
 } ;
@@ -377,6 +378,7 @@ public:
 //		else
 
 		// always unmark all darts, it's to dangerous because of markOrbit that can mark dart out of Browser !
+		CGoGN_COUNT("DartMarkerNoUnmark::unmarkAll/full_clear");
 		this->m_markVector->allFalse();
 	}
 
@@ -42,6 +42,8 @@
 #include "Topology/generic/marker.h"
 #include "Topology/generic/functor.h"
 
+#include "Utils/instrumentation.h"
+
 #include <thread>
 #include <mutex>
 
@@ -188,6 +190,12 @@ protected:
 	std::multimap<AttributeMultiVectorGen*, AttributeHandlerGen*> attributeHandlers ;
 	std::mutex attributeHandlersMutex;
 
+	/**
+	 * Stamp of the attributes, changed each time attributes are removed,
+	 * swapped or invalidated (used to detect stale AttributeViews)
+	 */
+	unsigned int m_attributesStamp;
+
 public:
 	static const unsigned int UNKNOWN_ATTRIB = AttributeContainer::UNKNOWN ;
 
@@ -211,6 +219,11 @@ public:
 		return false;
 	}
 
+	/**
+	 * get the stamp of the attributes of the map
+	 */
+	inline unsigned int getAttributesStamp() const;
+
 	inline std::vector<Dart>* askDartBuffer() const;
 	inline void releaseDartBuffer(std::vector<Dart>* vd) const;
 
@@ -39,7 +39,7 @@ inline unsigned int GenericMap::getCurrentThreadIndex() const
 		if (id == m_thread_ids[i])
 			return i;
 	}
-	assert(m_thread_ids.size() < NB_THREADS + 1);
+	assert(m_thread_ids.size() < NB_THREADS);
 	if (m_authorizeExternalThreads)
 	{
 		m_thread_ids.push_back(id);
@@ -78,7 +78,8 @@ inline void GenericMap::removeThreadId(const std::thread::id id)
 
 inline std::thread::id& GenericMap::addEmptyThreadId()
 {
-	assert(m_thread_ids.size() < NB_THREADS + 1);
+	// thread indices must stay in the per thread pools (NB_THREADS entries)
+	assert(m_thread_ids.size() < NB_THREADS);
 	unsigned int size = uint32(m_thread_ids.size());
 	m_thread_ids.resize(size + 1);
 	return m_thread_ids.back();
@@ -106,12 +107,19 @@ inline void GenericMap::setExternalThreadsAuthorization(bool b)
  *         BUFFERS MANAGEMENT           *
  ****************************************/
 
+inline unsigned int GenericMap::getAttributesStamp() const
+{
+	return m_attributesStamp;
+}
+
 inline std::vector<Dart>* GenericMap::askDartBuffer() const
 {
+	CGoGN_COUNT("GenericMap::askDartBuffer");
 	unsigned int thread = getCurrentThreadIndex();
 
 	if (s_vdartsBuffers[thread].empty())
 	{
+		CGoGN_COUNT("GenericMap::askDartBuffer/allocation");
 		std::vector<Dart>* vd = new std::vector<Dart>;
 		vd->reserve(128);
 		return vd;
@@ -128,6 +136,7 @@ inline void GenericMap::releaseDartBuffer(std::vector<Dart>* vd) const
 
 	if (vd->capacity() > 1024)
 	{
+		CGoGN_COUNT("GenericMap::releaseDartBuffer/shrink");
 		std::vector<Dart> v;
 		vd->swap(v);
 		vd->reserve(128);
@@ -301,6 +310,8 @@ AttributeMultiVector<MarkerBool>* GenericMap::askMarkVector()
 {
 	assert(isOrbitEmbedded<ORBIT>() || !"Invalid parameter: orbit not embedded") ;
 
+	CGoGN_COUNT("GenericMap::askMarkVector");
+
 	// get current thread index for table of markers
 	unsigned int thread = getCurrentThreadIndex();
 
@@ -312,6 +323,7 @@ AttributeMultiVector<MarkerBool>* GenericMap::askMarkVector()
 	}
 	else
 	{
+		CGoGN_COUNT("GenericMap::askMarkVector/addMarkerAttribute");
 		std::lock_guard<std::mutex> lockMV(m_MarkerStorageMutex[ORBIT]);
 
 		unsigned int x = m_nextMarkerId++;
@@ -80,6 +80,14 @@ public:
 	template <unsigned int ORBIT>
 	void initDartEmbedding(Dart d, unsigned int emb) ;
 
+	/**
+	 * Set the cell index of the given dimension associated to dart d, without reference counting
+	 * For bulk builders: the number of references of each cell is then set with
+	 * AttributeContainer::setNbRefs (1 + number of darts). Can be called concurrently.
+	 */
+	template <unsigned int ORBIT>
+	inline void bulkDartEmbedding(Dart d, unsigned int emb) ;
+
 	/**
 	 * Copy the index of the cell associated to a dart over an other dart
 	 * @param orbit the id of orbit embedding
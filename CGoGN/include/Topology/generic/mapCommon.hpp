@@ -105,6 +105,14 @@ void MapCommon<MAP_IMPL>::initDartEmbedding(Dart d, unsigned int emb)
 	(*this->m_embeddings[ORBIT])[this->dartIndex(d)] = emb ; // affect the embedding to the dart
 }
 
+template <typename MAP_IMPL>
+template <unsigned int ORBIT>
+inline void MapCommon<MAP_IMPL>::bulkDartEmbedding(Dart d, unsigned int emb)
+{
+	assert(this->template isOrbitEmbedded<ORBIT>() || !"Invalid parameter: orbit not embedded");
+	(*this->m_embeddings[ORBIT])[this->dartIndex(d)] = emb ;
+}
+
 template <typename MAP_IMPL>
 template <unsigned int ORBIT>
 inline void MapCommon<MAP_IMPL>::copyDartEmbedding(Dart dest, Dart src)
@@ -203,6 +211,7 @@ inline bool MapCommon<MAP_IMPL>::removeAttribute(AttributeHandler<T, ORBIT, MAP>
 		for(IT i = bounds.first; i != bounds.second; ++i)
 			(*i).second->setInvalid() ;
 		this->attributeHandlers.erase(bounds.first, bounds.second) ;
+		++this->m_attributesStamp ;
 		return true ;
 	}
 	return false ;
@@ -243,7 +252,10 @@ inline bool MapCommon<MAP_IMPL>::swapAttributes(AttributeHandler<T, ORBIT, MAP>&
 	unsigned int index1 = attr1.getIndex() ;
 	unsigned int index2 = attr2.getIndex() ;
 	if(index1 != index2)
+	{
+		++this->m_attributesStamp ;
 		return this->m_attribs[ORBIT].swapAttributes(index1, index2) ;
+	}
 	return false ;
 }
 
@@ -61,6 +61,12 @@ protected:
 	inline virtual void deleteDart(Dart d);
 
 public:
+	/**
+	 * create nb new darts (fixed points of all relations, without embedding)
+	 * @param darts the new darts are appended to it
+	 */
+	inline void newDarts(unsigned int nb, std::vector<Dart>& darts);
+
 	inline unsigned int dartIndex(Dart d) const;
 
 	inline Dart indexDart(unsigned int index) const;
@@ -106,6 +112,19 @@ protected:
 	template <int I>
 	inline void permutationUnsew(Dart d);
 
+	/**
+	 * direct write of d->e in the I-th permutation (and of e->d in its inverse)
+	 * no check: used by bulk builders that set the successor of every dart
+	 */
+	template <int I>
+	inline void permutationLink(Dart d, Dart e);
+
+	/**
+	 * direct write of d->e in the I-th involution (e->d has to be written too)
+	 */
+	template <int I>
+	inline void involutionLink(Dart d, Dart e);
+
 	virtual void compactTopo();
 
 	/****************************************
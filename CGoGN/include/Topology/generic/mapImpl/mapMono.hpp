@@ -59,6 +59,13 @@ inline void MapMono::deleteDart(Dart d)
 	deleteDartLine(d.index) ;
 }
 
+inline void MapMono::newDarts(unsigned int nb, std::vector<Dart>& darts)
+{
+	darts.reserve(darts.size() + nb);
+	for (unsigned int i = 0; i < nb; ++i)
+		darts.push_back(newDart());
+}
+
 inline unsigned int MapMono::dartIndex(Dart d) const
 {
 	return d.index;
@@ -186,6 +193,19 @@ inline void MapMono::permutationUnsew(Dart d)
 	(*m_permutation_inv[I])[e.index] = e ;
 }
 
+template <int I>
+inline void MapMono::permutationLink(Dart d, Dart e)
+{
+	(*m_permutation[I])[d.index] = e ;
+	(*m_permutation_inv[I])[e.index] = d ;
+}
+
+template <int I>
+inline void MapMono::involutionLink(Dart d, Dart e)
+{
+	(*m_involution[I])[d.index] = e ;
+}
+
 
 /****************************************
  *           DARTS TRAVERSALS           *
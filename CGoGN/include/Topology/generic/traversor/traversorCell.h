@@ -124,6 +124,13 @@ inline void foreach_cell(const MAP& map, FUNC f, TraversalOptim opt = AUTO);
 template <unsigned int ORBIT, typename MAP, typename FUNC>
 inline void foreach_cell_until(const MAP& map, FUNC f, TraversalOptim opt = AUTO);
 
+/*
+ * Is d the dart of smallest index of its ORBIT
+ * (selects one dart per cell without marker, e.g. in parallel traversals of darts)
+ */
+template <unsigned int ORBIT, typename MAP>
+inline bool isFirstDartOfOrbit(const MAP& map, Dart d);
+
 
 namespace Parallel
 {
@@ -139,6 +146,17 @@ namespace Parallel
 template <unsigned int ORBIT, typename MAP, typename FUNC>
 void foreach_cell(MAP& map, FUNC func, TraversalOptim opt = AUTO, unsigned int nbth = NumberOfThreads);
 
+/**
+ * @brief foreach_index
+ * @param map map on which the threads are registered (so that func can use markers and traversors)
+ * @param nb number of indices: func is applied on each index of [0,nb[
+ * @param func function (unsigned int index, unsigned int thread) to apply
+ * @param nbth number of used threads (at most NB_THREADS), thread i (in [0,nbth-1]) processes the i-th contiguous
+ * range of indices, thread 0 is the calling thread
+ */
+template <typename MAP, typename FUNC>
+void foreach_index(MAP& map, unsigned int nb, FUNC func, unsigned int nbth = NumberOfThreads);
+
 } // namespace Parallel
 
 
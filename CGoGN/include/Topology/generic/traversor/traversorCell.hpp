@@ -572,6 +572,19 @@ inline void foreach_cell_until(const MAP& map, FUNC f, TraversalOptim opt)
 }
 
 
+template <unsigned int ORBIT, typename MAP>
+inline bool isFirstDartOfOrbit(const MAP& map, Dart d)
+{
+	bool first = true;
+	map.template foreach_dart_of_orbit<ORBIT>(d, [&] (Dart x)
+	{
+		if (x.index < d.index)
+			first = false;
+	});
+	return first;
+}
+
+
 //template <unsigned int ORBIT, typename MAP, typename FUNC, typename FUNC2>
 //inline void foreach_cell_EvenOdd(const MAP& map, FUNC f, FUNC2 g, unsigned int nbpasses, TraversalOptim opt)
 //{
@@ -894,6 +907,82 @@ void foreach_cell(MAP& map, FUNC func, TraversalOptim opt, unsigned int nbth)
 	}
 }
 
+/// internal functor for foreach_index
+template <typename FUNC>
+class ThreadFunctionIndex
+{
+protected:
+	unsigned int m_first;
+	unsigned int m_last;
+	unsigned int m_id;
+	FUNC& m_lambda;
+	std::thread::id& m_threadId; // ref on thread::id in table of threads in genericMap for init at operator()
+
+public:
+	ThreadFunctionIndex(FUNC& func, unsigned int first, unsigned int last, unsigned int id, std::thread::id& threadId) :
+		m_first(first), m_last(last), m_id(id), m_lambda(func), m_threadId(threadId)
+	{}
+
+	std::thread::id& getThreadId() { return m_threadId; }
+
+	void operator()()
+	{
+		m_threadId = std::this_thread::get_id();
+		for (unsigned int i = m_first; i < m_last; ++i)
+			m_lambda(i, m_id);
+	}
+};
+
+template <typename MAP, typename FUNC>
+void foreach_index(MAP& map, unsigned int nb, FUNC func, unsigned int nbth)
+{
+	// the calling thread processes the first range, the nbth-1 other ones take a
+	// thread slot in the map: the per thread pools have NB_THREADS entries
+	if (nbth > NB_THREADS)
+		nbth = NB_THREADS;
+	if (nbth > nb)
+		nbth = nb;
+	if (nbth < 2)
+	{
+		for (unsigned int i = 0; i < nb; ++i)
+			func(i, 0);
+		return;
+	}
+
+	const unsigned int nbw = nbth - 1;
+	std::thread** threads = new std::thread*[nbw];
+	ThreadFunctionIndex<FUNC>** tfs = new ThreadFunctionIndex<FUNC>*[nbw];
+
+	for (unsigned int i = 0; i < nbw; ++i)
+	{
+		unsigned int first = (unsigned long long)(nb) * (i+1) / nbth;
+		unsigned int last = (unsigned long long)(nb) * (i+2) / nbth;
+		std::thread::id& threadId = map.addEmptyThreadId();
+		tfs[i] = new ThreadFunctionIndex<FUNC>(func, first, last, i+1, threadId);
+		threads[i] = new std::thread( std::ref( *(tfs[i]) ) );
+	}
+
+	const unsigned int last0 = (unsigned long long)(nb) / nbth;
+	for (unsigned int i = 0; i < last0; ++i)
+		func(i, 0);
+
+	// copy the ids before unregistering: removeThreadId moves the entries of the table
+	std::vector<std::thread::id> ids;
+	ids.reserve(nbw);
+	for (unsigned int i = 0; i < nbw; ++i)
+	{
+		threads[i]->join();
+		delete threads[i];
+		ids.push_back(tfs[i]->getThreadId());
+		delete tfs[i];
+	}
+	for (unsigned int i = 0; i < nbw; ++i)
+		map.removeThreadId(ids[i]);
+
+	delete[] tfs;
+	delete[] threads;
+}
+
 } // namespace Parallel
 
 } // namespace CGoGN
@@ -102,6 +102,12 @@ protected:
 	void phi1unsew(Dart d);
 
 public:
+	//! Set phi1(d) = e (and phi_1(e) = d) without any check
+	/*! For bulk builders that compute the successor of every dart.
+	 *  Calls on different darts can be done concurrently.
+	 */
+	void bulkPhi1(Dart d, Dart e);
+
 	/*! @name Generator and Deletor
 	 *  To generate or delete faces in a 1-map
 	 *************************************************************************/
@@ -129,6 +129,12 @@ inline void Map1<MAP_IMPL>::phi1unsew(Dart d)
 	MAP_IMPL::template permutationUnsew<0>(d);
 }
 
+template <typename MAP_IMPL>
+inline void Map1<MAP_IMPL>::bulkPhi1(Dart d, Dart e)
+{
+	MAP_IMPL::template permutationLink<0>(d, e);
+}
+
 /*! @name Generator and Deletor
  *  To generate or delete faces in a 1-map
  *************************************************************************/
@@ -119,6 +119,11 @@ protected:
 	void phi2unsew(Dart d);
 
 public:
+	//! Set phi2(d) = e without any check (phi2(e) = d has to be set too)
+	/*! For bulk builders. Calls on different darts can be done concurrently.
+	 */
+	void bulkPhi2(Dart d, Dart e);
+
 	/*! @name Generator and Deletor
 	 *  To generate or delete faces in a 2-map
 	 *************************************************************************/
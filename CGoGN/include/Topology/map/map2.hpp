@@ -143,6 +143,12 @@ inline void Map2<MAP_IMPL>::phi2unsew(Dart d)
 	MAP_IMPL::template involutionUnsew<0>(d);
 }
 
+template <typename MAP_IMPL>
+inline void Map2<MAP_IMPL>::bulkPhi2(Dart d, Dart e)
+{
+	MAP_IMPL::template involutionLink<0>(d, e);
+}
+
 /*! @name Generator and Deletor
  *  To generate or delete faces in a 2-map
  *************************************************************************/
@@ -119,6 +119,11 @@ protected:
 	void phi3unsew(Dart d);
 
 public:
+	//! Set phi3(d) = e without any check (phi3(e) = d has to be set too)
+	/*! For bulk builders. Calls on different darts can be done concurrently.
+	 */
+	void bulkPhi3(Dart d, Dart e);
+
 	/*! @name Generator and Deletor
 	 *  To generate or delete volumes in a 3-map
 	 *************************************************************************/
@@ -141,6 +141,12 @@ inline void Map3<MAP_IMPL>::phi3unsew(Dart d)
 	MAP_IMPL::template involutionUnsew<1>(d);
 }
 
+template <typename MAP_IMPL>
+inline void Map3<MAP_IMPL>::bulkPhi3(Dart d, Dart e)
+{
+	MAP_IMPL::template involutionLink<1>(d, e);
+}
+
 /*! @name Generator and Deletor
  *  To generate or delete volumes in a 3-map
  *************************************************************************/
@@ -0,0 +1,156 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef _CGOGN_BENCHMARK_H_
+#define _CGOGN_BENCHMARK_H_
+
+#include "Utils/dll.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace CGoGN
+{
+namespace Utils
+{
+
+/**
+ * chrono on the monotonic clock with nanosecond resolution
+ * (Chrono uses gettimeofday and returns milliseconds)
+ */
+class SteadyChrono
+{
+	std::chrono::steady_clock::time_point m_start;
+public:
+	/// start the chrono
+	inline void start() { m_start = std::chrono::steady_clock::now(); }
+
+	/// return elapsed time since start in ns
+	inline double elapsedNs() const
+	{
+		return double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count());
+	}
+
+	/// return elapsed time since start in ms
+	inline double elapsed() const { return elapsedNs() * 1e-6; }
+};
+
+/**
+ * measures of one benchmark (times in ns)
+ */
+struct CGoGN_UTILS_API BenchmarkResult
+{
+	std::string name;
+	unsigned int size;			// problem size (e.g. resolution of the generated mesh)
+	std::vector<double> samples;
+
+	double min, max, mean, stddev;
+	double median, p10, p90;
+
+	/// compute the statistics from the samples
+	void computeStatistics();
+
+	/// percentile p (in [0,1]) of the samples, linearly interpolated
+	static double percentile(const std::vector<double>& sorted, double p);
+};
+
+/**
+ * Benchmark harness: each benchmark is run nbWarmup times without measure,
+ * then nbRuns times, each run being timed separately.
+ * Results can be saved as JSON or CSV, and compared to a CSV baseline
+ * (saved from another build) to detect performance regressions.
+ */
+class CGoGN_UTILS_API Benchmark
+{
+	std::string m_suite;
+	unsigned int m_nbRuns;
+	unsigned int m_nbWarmup;
+	std::string m_filter;
+	std::vector<BenchmarkResult> m_results;
+
+public:
+	Benchmark(const std::string& suite, unsigned int nbRuns = 10, unsigned int nbWarmup = 2);
+
+	void setNbRuns(unsigned int nb) { m_nbRuns = nb > 0 ? nb : 1; }
+	void setNbWarmup(unsigned int nb) { m_nbWarmup = nb; }
+
+	/// only run the benchmarks whose name contains filter
+	void setFilter(const std::string& filter) { m_filter = filter; }
+
+	bool isSelected(const std::string& name) const;
+
+	/**
+	 * run a benchmark
+	 * @param name name of the benchmark (category/name)
+	 * @param size problem size (reported with the result)
+	 * @param setup function called before each run (not timed), e.g. to rebuild a mesh
+	 * @param func function to time
+	 * @return the result, NULL if the benchmark is filtered out
+	 */
+	template <typename SETUP, typename FUNC>
+	const BenchmarkResult* run(const std::string& name, unsigned int size, SETUP setup, FUNC func);
+
+	template <typename FUNC>
+	const BenchmarkResult* run(const std::string& name, unsigned int size, FUNC func);
+
+	const std::vector<BenchmarkResult>& results() const { return m_results; }
+
+	/// print one line per benchmark (median, p10, p90 in ms)
+	void printSummary() const;
+
+	bool saveJSON(const std::string& filename) const;
+
+	bool saveCSV(const std::string& filename) const;
+
+	/**
+	 * compare the medians with those of a baseline saved by saveCSV
+	 * (benchmarks are matched by name and size)
+	 * @param tolerance relative slowdown of the median above which a regression is reported
+	 * @return the number of regressions
+	 */
+	unsigned int compare(const std::string& baselineCSV, double tolerance = 0.1) const;
+
+protected:
+	void addResult(const std::string& name, unsigned int size, const std::vector<double>& samples);
+};
+
+/**
+ * keep a computed value alive so that the compiler does not optimize its computation away
+ */
+CGoGN_UTILS_API extern const void* volatile benchmarkSink;
+
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+	benchmarkSink = &value;
+}
+
+}
+}
+
+#include "Utils/benchmark.hpp"
+
+#endif /* _CGOGN_BENCHMARK_H_ */
@@ -0,0 +1,65 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+namespace CGoGN
+{
+namespace Utils
+{
+
+template <typename SETUP, typename FUNC>
+const BenchmarkResult* Benchmark::run(const std::string& name, unsigned int size, SETUP setup, FUNC func)
+{
+	if (!isSelected(name))
+		return NULL;
+
+	for (unsigned int i = 0; i < m_nbWarmup; ++i)
+	{
+		setup();
+		func();
+	}
+
+	std::vector<double> samples;
+	samples.reserve(m_nbRuns);
+	SteadyChrono ch;
+	for (unsigned int i = 0; i < m_nbRuns; ++i)
+	{
+		setup();
+		ch.start();
+		func();
+		samples.push_back(ch.elapsedNs());
+	}
+
+	addResult(name, size, samples);
+	return &m_results.back();
+}
+
+template <typename FUNC>
+const BenchmarkResult* Benchmark::run(const std::string& name, unsigned int size, FUNC func)
+{
+	return run(name, size, [] () {}, func);
+}
+
+}
+}
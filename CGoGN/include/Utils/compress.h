@@ -27,13 +27,32 @@
 
 
 #include <fstream>
+#include <vector>
 
 namespace CGoGN
 {
 namespace Utils
 {
 
-void zlibVTUWriteCompressed( unsigned char* input, unsigned int nbBytes, std::ofstream& fout);
+/**
+ * compress a buffer with the layout of VTK appended data (vtkZLibDataCompressor, UInt32 header):
+ * [nbBlocks, blockSize, lastBlockSize, compressedSize_0 .. compressedSize_n-1] then the compressed blocks.
+ * The blocks are compressed independently, on nbThreads threads (0 for all the cores).
+ * @param input data to compress
+ * @param nbBytes size of input
+ * @param output the header and the compressed data (replaced)
+ * @param blockSize size of uncompressed blocks
+ * @param level zlib compression level
+ * @param nbThreads number of threads
+ * @return size of output
+ */
+unsigned int zlibVTUCompress(const unsigned char* input, unsigned int nbBytes, std::vector<unsigned char>& output,
+	unsigned int blockSize = 1024*256, int level = 6, unsigned int nbThreads = 0);
+
+/**
+ * compress a buffer (see zlibVTUCompress) and write it in fout
+ */
+void zlibVTUWriteCompressed( unsigned char* input, unsigned int nbBytes, std::ofstream& fout, unsigned int nbThreads = 0);
 
 }
 }
@@ -0,0 +1,194 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef _CGOGN_INSTRUMENTATION_H_
+#define _CGOGN_INSTRUMENTATION_H_
+
+#include "Utils/dll.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+/**
+ * Instrumentation of the hot paths of CGoGN (markers, buffers, containers) and of the Algo entry points.
+ * The macros below expand to nothing unless CGOGN_INSTRUMENTATION is defined
+ * (CMake option CGoGN_WITH_INSTRUMENTATION), the functions of the API are always available:
+ * - CGoGN_COUNT(name) / CGoGN_COUNT_ADD(name, n) : increment an event counter
+ * - CGoGN_GAUGE(name, value) : record a value (count, mean, min, max, last)
+ * - CGoGN_SCOPED_TIMER(name) : time the enclosing scope (and trace it when tracing is enabled)
+ * names must be string literals.
+ */
+
+namespace CGoGN
+{
+namespace Utils
+{
+namespace Instrumentation
+{
+
+class CGoGN_UTILS_API Counter
+{
+	std::string m_name;
+	std::atomic<unsigned long long> m_count;
+
+public:
+	Counter(const std::string& name);
+
+	inline void add(unsigned long long n) { m_count.fetch_add(n, std::memory_order_relaxed); }
+
+	inline unsigned long long value() const { return m_count.load(std::memory_order_relaxed); }
+
+	const std::string& name() const { return m_name; }
+
+	void reset() { m_count.store(0, std::memory_order_relaxed); }
+};
+
+class CGoGN_UTILS_API Gauge
+{
+	std::string m_name;
+	std::atomic<unsigned long long> m_count;
+	std::atomic<double> m_sum;
+	std::atomic<double> m_min;
+	std::atomic<double> m_max;
+	std::atomic<double> m_last;
+
+public:
+	Gauge(const std::string& name);
+
+	void record(double v);
+
+	unsigned long long count() const { return m_count.load(std::memory_order_relaxed); }
+	double mean() const;
+	double min() const { return m_min.load(std::memory_order_relaxed); }
+	double max() const { return m_max.load(std::memory_order_relaxed); }
+	double last() const { return m_last.load(std::memory_order_relaxed); }
+
+	const std::string& name() const { return m_name; }
+
+	void reset();
+};
+
+class CGoGN_UTILS_API Timer
+{
+	std::string m_name;
+	std::atomic<unsigned long long> m_count;
+	std::atomic<unsigned long long> m_totalNs;
+	std::atomic<unsigned long long> m_maxNs;
+
+public:
+	Timer(const std::string& name);
+
+	/// record a call that started at start and lasted durNs
+	void record(std::chrono::steady_clock::time_point start, unsigned long long durNs);
+
+	unsigned long long count() const { return m_count.load(std::memory_order_relaxed); }
+	unsigned long long totalNs() const { return m_totalNs.load(std::memory_order_relaxed); }
+	unsigned long long maxNs() const { return m_maxNs.load(std::memory_order_relaxed); }
+
+	const std::string& name() const { return m_name; }
+
+	void reset();
+};
+
+/**
+ * get the instrument of the given name (created at first call, never destroyed)
+ */
+CGoGN_UTILS_API Counter& counter(const char* name);
+CGoGN_UTILS_API Gauge& gauge(const char* name);
+CGoGN_UTILS_API Timer& timer(const char* name);
+
+class ScopedTimer
+{
+	Timer& m_timer;
+	std::chrono::steady_clock::time_point m_start;
+
+public:
+	inline ScopedTimer(Timer& t) : m_timer(t), m_start(std::chrono::steady_clock::now()) {}
+
+	inline ~ScopedTimer()
+	{
+		unsigned long long d = (unsigned long long)(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count());
+		m_timer.record(m_start, d);
+	}
+};
+
+/**
+ * enable / disable the tracing of the scoped timers (one event per call, stored per thread)
+ */
+CGoGN_UTILS_API void setTracing(bool b);
+
+CGoGN_UTILS_API bool isTracing();
+
+/**
+ * print all the instruments
+ */
+CGoGN_UTILS_API void dump(std::ostream& out);
+
+CGoGN_UTILS_API void dump();
+
+/**
+ * reset all the instruments and forget the trace events
+ */
+CGoGN_UTILS_API void reset();
+
+/**
+ * save the trace events in the Chrome trace event format (chrome://tracing, Perfetto),
+ * the counters and gauges are added as metadata
+ */
+CGoGN_UTILS_API bool saveChromeTrace(const std::string& filename);
+
+} // namespace Instrumentation
+} // namespace Utils
+} // namespace CGoGN
+
+#define CGoGN_INSTR_CONCAT2(a, b) a##b
+#define CGoGN_INSTR_CONCAT(a, b) CGoGN_INSTR_CONCAT2(a, b)
+
+#ifdef CGOGN_INSTRUMENTATION
+
+#define CGoGN_COUNT_ADD(name, n) \
+	do { static CGoGN::Utils::Instrumentation::Counter& cgogn_instr_c = CGoGN::Utils::Instrumentation::counter(name); cgogn_instr_c.add(n); } while (0)
+
+#define CGoGN_COUNT(name) CGoGN_COUNT_ADD(name, 1)
+
+#define CGoGN_GAUGE(name, value) \
+	do { static CGoGN::Utils::Instrumentation::Gauge& cgogn_instr_g = CGoGN::Utils::Instrumentation::gauge(name); cgogn_instr_g.record(double(value)); } while (0)
+
+#define CGoGN_SCOPED_TIMER(name) \
+	static CGoGN::Utils::Instrumentation::Timer& CGoGN_INSTR_CONCAT(cgogn_instr_t, __LINE__) = CGoGN::Utils::Instrumentation::timer(name); \
+	CGoGN::Utils::Instrumentation::ScopedTimer CGoGN_INSTR_CONCAT(cgogn_instr_s, __LINE__)(CGoGN_INSTR_CONCAT(cgogn_instr_t, __LINE__))
+
+#else
+
+#define CGoGN_COUNT_ADD(name, n) do {} while (0)
+#define CGoGN_COUNT(name) do {} while (0)
+#define CGoGN_GAUGE(name, value) do {} while (0)
+#define CGoGN_SCOPED_TIMER(name) do {} while (0)
+
+#endif
+
+#endif /* _CGOGN_INSTRUMENTATION_H_ */
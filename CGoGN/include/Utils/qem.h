@@ -54,6 +54,9 @@ namespace Utils {
  *
  * \brief Quadric for computing the quadric error metric (QEM)
  * introduced by Garland and Heckbert in 1997.
+ *
+ * The quadric matrix is symmetric: only its upper triangle is stored
+ * (10 doubles instead of 16), row by row.
  */
 template <typename REAL>
 class Quadric
@@ -170,7 +173,7 @@ public:
 	 */
 	friend std::ostream& operator<<(std::ostream& out, const Quadric<REAL>& q)
 	{
-		out << q.A ;
+		out << q.getMatrix() ;
 		return out ;
 	} ;
 
@@ -184,7 +187,9 @@ public:
 	 */
 	friend std::istream& operator>>(std::istream& in, Quadric<REAL>& q)
 	{
-		in >> q.A ;
+		MATRIX44 A ;
+		in >> A ;
+		q.setMatrix(A) ;
 		return in ;
 	} ;
 
@@ -197,8 +202,69 @@ public:
 	 */
 	bool findOptimizedPos(VEC3& v) ;
 
+	/*!
+	 * \brief Method to deduce a position in space that minimizes the error
+	 * of the sum of two quadrics, without building the sum
+	 *
+	 * \param q1 first quadric
+	 * \param q2 second quadric
+	 * \param v the ideal position (if it can be computed)
+	 *
+	 * \return true if the ideal position has been computed correctly
+	 */
+	static bool findOptimizedPos(const Quadric<REAL>& q1, const Quadric<REAL>& q2, VEC3& v) ;
+
+	/*!
+	 * \brief Batched version of findOptimizedPos for the sums q1[i] + q2[i]
+	 *
+	 * \param n number of quadric pairs
+	 * \param q1 first quadrics
+	 * \param q2 second quadrics
+	 * \param v will contain the ideal positions
+	 * \param ok will contain for each pair if the position has been computed
+	 */
+	static void findOptimizedPos(unsigned int n, const Quadric<REAL>* const* q1, const Quadric<REAL>* const* q2, VEC3* v, bool* ok) ;
+
+	/*!
+	 * \brief Batched error evaluation of the sums q1[i] + q2[i] at points v[i]
+	 *
+	 * \param n number of quadric pairs
+	 * \param q1 first quadrics
+	 * \param q2 second quadrics
+	 * \param v the points
+	 * \param err will contain the errors
+	 */
+	static void evaluate(unsigned int n, const Quadric<REAL>* const* q1, const Quadric<REAL>* const* q2, const VEC3* v, REAL* err) ;
+
+	/*!
+	 * \brief get the full (symmetric) quadric matrix
+	 */
+	MATRIX44 getMatrix() const ;
+
+	/*!
+	 * \brief set the quadric from a symmetric matrix (only the upper triangle is read)
+	 */
+	void setMatrix(const MATRIX44& A) ;
+
 private:
-	MATRIX44 A ; /*!< The Quadric matrix */
+	/*!
+	 * The upper triangle of the Quadric matrix:
+	 * a00 a01 a02 a03 a11 a12 a13 a22 a23 a33
+	 * (double is crucial here !)
+	 */
+	double Q[10] ;
+
+	/*!
+	 * \brief error of the packed quadric q at the point (x,y,z,w)
+	 */
+	static double evaluate(const double* q, double x, double y, double z, double w) ;
+
+	/*!
+	 * \brief closed form solution of the 3x3 system of the packed quadric q
+	 *
+	 * \return false if the system is (close to) singular
+	 */
+	static bool optimize(const double* q, VEC3& v) ;
 
 	/*!
 	 * \brief method to evaluate the error at a given point in space (homogeneous coordinates)
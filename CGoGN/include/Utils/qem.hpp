@@ -31,13 +31,13 @@ namespace Utils {
 template <typename REAL>
 Quadric<REAL>::Quadric()
 {
-	A.zero() ;
+	zero() ;
 }
 
 template <typename REAL>
 Quadric<REAL>::Quadric(int)
 {
-	A.zero() ;
+	zero() ;
 }
 
 template <typename REAL>
@@ -47,29 +47,35 @@ Quadric<REAL>::Quadric(const VEC3& p1, const VEC3& p2, const VEC3& p3)
 	Geom::Plane3D<REAL> plane(p1, p2, p3) ;
 	const VEC3& n = plane.normal() ;
 
-	Geom::Vector<4,double> p = Geom::Vector<4,double>(n[0],n[1],n[2],plane.d()) ;
-	A = Geom::transposed_vectors_mult(p,p) ;
+	double p[4] = { n[0], n[1], n[2], plane.d() } ;
+	unsigned int k = 0 ;
+	for (unsigned int i = 0; i < 4; ++i)
+		for (unsigned int j = i; j < 4; ++j)
+			Q[k++] = p[i] * p[j] ;
 }
 
 template <typename REAL>
 void
 Quadric<REAL>::zero()
 {
-	A.zero() ;
+	for (unsigned int k = 0; k < 10; ++k)
+		Q[k] = 0.0 ;
 }
 
 template <typename REAL>
 void
 Quadric<REAL>::operator= (const Quadric<REAL>& q)
 {
-	A = q.A ;
+	for (unsigned int k = 0; k < 10; ++k)
+		Q[k] = q.Q[k] ;
 }
 
 template <typename REAL>
 Quadric<REAL>&
 Quadric<REAL>::operator+= (const Quadric<REAL>& q)
 {
-	A += q.A ;
+	for (unsigned int k = 0; k < 10; ++k)
+		Q[k] += q.Q[k] ;
 	return *this ;
 }
 
@@ -77,7 +83,8 @@ template <typename REAL>
 Quadric<REAL>&
 Quadric<REAL>::operator -= (const Quadric<REAL>& q)
 {
-	A -= q.A ;
+	for (unsigned int k = 0; k < 10; ++k)
+		Q[k] -= q.Q[k] ;
 	return *this ;
 }
 
@@ -85,7 +92,8 @@ template <typename REAL>
 Quadric<REAL>&
 Quadric<REAL>::operator *= (const REAL& v)
 {
-	A *= v ;
+	for (unsigned int k = 0; k < 10; ++k)
+		Q[k] *= v ;
 	return *this ;
 }
 
@@ -93,7 +101,8 @@ template <typename REAL>
 Quadric<REAL>&
 Quadric<REAL>::operator /= (const REAL& v)
 {
-	A /= v ;
+	for (unsigned int k = 0; k < 10; ++k)
+		Q[k] /= v ;
 	return *this ;
 }
 
@@ -108,59 +117,133 @@ template <typename REAL>
 REAL
 Quadric<REAL>::operator() (const VEC3& v) const
 {
-	VEC4 hv(v[0], v[1], v[2], 1.0f) ;
-	return evaluate(hv) ;
+	return REAL(evaluate(Q, v[0], v[1], v[2], 1.0)) ;
 }
 
 template <typename REAL>
 bool
 Quadric<REAL>::findOptimizedPos(VEC3& v)
 {
-	VEC4 hv ;
-	bool b = optimize(hv) ;
-	if(b)
+	return optimize(Q, v) ;
+}
+
+template <typename REAL>
+bool
+Quadric<REAL>::findOptimizedPos(const Quadric<REAL>& q1, const Quadric<REAL>& q2, VEC3& v)
+{
+	double q[10] ;
+	for (unsigned int k = 0; k < 10; ++k)
+		q[k] = q1.Q[k] + q2.Q[k] ;
+	return optimize(q, v) ;
+}
+
+template <typename REAL>
+void
+Quadric<REAL>::findOptimizedPos(unsigned int n, const Quadric<REAL>* const* q1, const Quadric<REAL>* const* q2, VEC3* v, bool* ok)
+{
+	for (unsigned int i = 0; i < n; ++i)
+		ok[i] = findOptimizedPos(*q1[i], *q2[i], v[i]) ;
+}
+
+template <typename REAL>
+void
+Quadric<REAL>::evaluate(unsigned int n, const Quadric<REAL>* const* q1, const Quadric<REAL>* const* q2, const VEC3* v, REAL* err)
+{
+	double q[10] ;
+	for (unsigned int i = 0; i < n; ++i)
 	{
-		v[0] = hv[0] ;
-		v[1] = hv[1] ;
-		v[2] = hv[2] ;
+		for (unsigned int k = 0; k < 10; ++k)
+			q[k] = q1[i]->Q[k] + q2[i]->Q[k] ;
+		err[i] = REAL(evaluate(q, v[i][0], v[i][1], v[i][2], 1.0)) ;
 	}
-	return b ;
 }
 
 template <typename REAL>
-REAL
-Quadric<REAL>::evaluate(const VEC4& v) const
+typename Quadric<REAL>::MATRIX44
+Quadric<REAL>::getMatrix() const
 {
-	// Double computation is crucial for stability
-	Geom::Vector<4, double> vd(v);
-	Geom::Vector<4, double> Av = A * vd ;
-	return REAL(vd * Av) ;
+	MATRIX44 A ;
+	unsigned int k = 0 ;
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		for (unsigned int j = i; j < 4; ++j)
+		{
+			A(i, j) = Q[k] ;
+			A(j, i) = Q[k] ;
+			++k ;
+		}
+	}
+	return A ;
+}
+
+template <typename REAL>
+void
+Quadric<REAL>::setMatrix(const MATRIX44& A)
+{
+	unsigned int k = 0 ;
+	for (unsigned int i = 0; i < 4; ++i)
+		for (unsigned int j = i; j < 4; ++j)
+			Q[k++] = A(i, j) ;
+}
+
+template <typename REAL>
+inline double
+Quadric<REAL>::evaluate(const double* q, double x, double y, double z, double w)
+{
+	return q[0]*x*x + q[4]*y*y + q[7]*z*z + q[9]*w*w
+		+ 2.0 * (q[1]*x*y + q[2]*x*z + q[3]*x*w + q[5]*y*z + q[6]*y*w + q[8]*z*w) ;
 }
 
 template <typename REAL>
 bool
-Quadric<REAL>::optimize(VEC4& v) const
+Quadric<REAL>::optimize(const double* q, VEC3& v)
 {
 #ifdef WIN32
-	if (A(0, 0) != A(0, 0))
+	if (q[0] != q[0])
 #else
-	if (std::isnan(A(0, 0)))
+	if (std::isnan(q[0]))
 #endif
 		return false ;
 
-	MATRIX44 A2(A) ;
-	for(int i = 0; i < 3; ++i)
-		A2(3,i) = 0.0f ;
-	A2(3,3) = 1.0f ;
-	MATRIX44 Ainv ;
-	REAL det = REAL(A2.invert(Ainv));
-	if(det > -1e-6 && det < 1e-6)
+	// solve A x = -b with A the upper left 3x3 block and b the last column,
+	// using the (symmetric) adjugate of A
+	double c00 = q[4]*q[7] - q[5]*q[5] ;
+	double c01 = q[2]*q[5] - q[1]*q[7] ;
+	double c02 = q[1]*q[5] - q[2]*q[4] ;
+	double c11 = q[0]*q[7] - q[2]*q[2] ;
+	double c12 = q[1]*q[2] - q[0]*q[5] ;
+	double c22 = q[0]*q[4] - q[1]*q[1] ;
+
+	double det = q[0]*c00 + q[1]*c01 + q[2]*c02 ;
+	REAL rdet = REAL(det) ;
+	if(rdet > -1e-6 && rdet < 1e-6)
 		return false ;
-//	VEC4 right(0,0,0,1) ;
-	Geom::Vector<4, double> right(0,0,0,1) ;
-	v = VEC4(Ainv * right) ;
 
-	return true;
+	double inv = -1.0 / det ;
+	v[0] = REAL((c00*q[3] + c01*q[6] + c02*q[8]) * inv) ;
+	v[1] = REAL((c01*q[3] + c11*q[6] + c12*q[8]) * inv) ;
+	v[2] = REAL((c02*q[3] + c12*q[6] + c22*q[8]) * inv) ;
+
+	return true ;
+}
+
+template <typename REAL>
+REAL
+Quadric<REAL>::evaluate(const VEC4& v) const
+{
+	// Double computation is crucial for stability
+	return REAL(evaluate(Q, v[0], v[1], v[2], v[3])) ;
+}
+
+template <typename REAL>
+bool
+Quadric<REAL>::optimize(VEC4& v) const
+{
+	VEC3 p ;
+	if (!optimize(Q, p))
+		return false ;
+	v = VEC4(p[0], p[1], p[2], REAL(1)) ;
+	return true ;
 }
 
 template <typename REAL, unsigned int N>
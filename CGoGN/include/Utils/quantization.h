@@ -55,6 +55,30 @@ struct CodeVector
 	}
 } ;
 
+/**
+ * Balanced KD-tree over a set of points (the code vectors) for exact nearest neighbour queries
+ * (ties are resolved toward the smallest point index, as a naive search would do)
+ */
+template <typename VEC>
+class CodeVectorKDTree
+{
+	typedef typename VEC::DATA_TYPE REAL ;
+
+private:
+	const std::vector<VEC>& m_points ;
+	std::vector<unsigned int> m_idx ; // points indices, each range [b,e[ is split at (b+e)/2
+	std::vector<unsigned char> m_axis ; // split axis of each node
+
+	void build(unsigned int b, unsigned int e) ;
+	void search(const VEC& x, unsigned int b, unsigned int e, unsigned int& nearest, REAL& distMin) const ;
+
+public:
+	CodeVectorKDTree(const std::vector<VEC>& points) ;
+
+	/// index (in points) of the nearest point of x
+	unsigned int nearest(const VEC& x) const ;
+} ;
+
 template <typename VEC>
 class Quantization
 {
@@ -65,6 +89,7 @@ private:
 	std::vector<CodeVectorID> associatedCodeVectors ; // for each source vector, id of its associated codeVector
 	std::list<CodeVector<VEC> > codeVectors ; // codebook
 	unsigned int nbCodeVectors ; // size of codebook
+	unsigned int nbThreads ; // number of threads used for the assignment step
 
 	VEC meanSourceVector ;
 	float distortion ;
@@ -75,6 +100,12 @@ private:
 	CodeVectorID nearestNeighbour(int v) ; // for the sourceVector of the given index, search the id of the nearest codeVector
 	void algoLloydMax() ; // Lloyd Iteration
 
+	// associate each sourceVector to its nearest codeVector and accumulate the regions properties
+	// (the source vectors are split in nbThreads ranges, partial sums are merged in range order)
+	void assignRegions() ;
+	// total distortion of the current regions (codeVectors with an empty region are removed)
+	void computeDistortion() ;
+
 public:
 	Quantization(const std::vector<VEC>& source) ;
 
@@ -84,9 +115,27 @@ public:
 	void vectorQuantizationNbRegions(unsigned int nbCodeVectors, std::vector<VEC>& result) ;
 	void vectorQuantizationDistortion(float distortionGoal, std::vector<VEC>& result) ;
 
+	/**
+	 * Mini-batch quantization for large sets of source vectors:
+	 * the codebook is initialized by a quantization of a random sample of batchSize source vectors,
+	 * then refined by nbIterations mini-batch k-means steps of batchSize random source vectors.
+	 * A last assignment of all the source vectors gives the result.
+	 */
+	void vectorQuantizationMiniBatch(unsigned int nbCodeVectors, unsigned int batchSize, unsigned int nbIterations, std::vector<VEC>& result, unsigned int seed = 0) ;
+
 	unsigned int getNbCodeVectors() { return nbCodeVectors ; }
 
+	/**
+	 * get the codebook and, for each source vector, the index of its code vector in the codebook
+	 * (only available after a quantization)
+	 */
+	void getCodebook(std::vector<VEC>& codebook, std::vector<unsigned int>& codes) ;
+
+	void setNbThreads(unsigned int nb) { nbThreads = nb > 0 ? nb : 1 ; }
+	unsigned int getNbThreads() { return nbThreads ; }
+
 	// only available after a quantization
+	float getDistortion() { return distortion ; }
 	float getDiscreteEntropy() { return discreteEntropy ; }
 	// available immediately after object construction
 	float getDifferentialEntropy() { return differentialEntropy ; }
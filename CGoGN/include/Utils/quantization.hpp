@@ -26,6 +26,10 @@
 
 #include <cmath>
 #include <limits>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <map>
 
 
 namespace CGoGN
@@ -51,11 +55,105 @@ void set(VEC& v, typename VEC::DATA_TYPE val)
 }
 
 
+template <typename VEC>
+CodeVectorKDTree<VEC>::CodeVectorKDTree(const std::vector<VEC>& points) : m_points(points)
+{
+	m_idx.resize(m_points.size()) ;
+	m_axis.resize(m_points.size()) ;
+	for(unsigned int i = 0; i < m_idx.size(); ++i)
+		m_idx[i] = i ;
+	build(0, uint32(m_idx.size())) ;
+}
+
+template <typename VEC>
+void CodeVectorKDTree<VEC>::build(unsigned int b, unsigned int e)
+{
+	if(e - b < 2)
+	{
+		if(e > b)
+			m_axis[b] = 0 ;
+		return ;
+	}
+
+	// split along the axis of largest extent
+	VEC bbMin = m_points[m_idx[b]] ;
+	VEC bbMax = bbMin ;
+	for(unsigned int i = b + 1; i < e; ++i)
+	{
+		const VEC& p = m_points[m_idx[i]] ;
+		for(unsigned int k = 0; k < VEC::DIMENSION; ++k)
+		{
+			if(p[k] < bbMin[k]) bbMin[k] = p[k] ;
+			if(p[k] > bbMax[k]) bbMax[k] = p[k] ;
+		}
+	}
+	unsigned int axis = 0 ;
+	for(unsigned int k = 1; k < VEC::DIMENSION; ++k)
+	{
+		if(bbMax[k] - bbMin[k] > bbMax[axis] - bbMin[axis])
+			axis = k ;
+	}
+
+	unsigned int m = (b + e) / 2 ;
+	const std::vector<VEC>& points = m_points ;
+	std::nth_element(m_idx.begin() + b, m_idx.begin() + m, m_idx.begin() + e, [&] (unsigned int i, unsigned int j)
+	{
+		return points[i][axis] < points[j][axis] ;
+	}) ;
+	m_axis[m] = (unsigned char)(axis) ;
+
+	build(b, m) ;
+	build(m + 1, e) ;
+}
+
+template <typename VEC>
+void CodeVectorKDTree<VEC>::search(const VEC& x, unsigned int b, unsigned int e, unsigned int& nearest, REAL& distMin) const
+{
+	if(b >= e)
+		return ;
+
+	unsigned int m = (b + e) / 2 ;
+	unsigned int id = m_idx[m] ;
+	VEC vec = x - m_points[id] ;
+	REAL l = vec.norm2() ;
+	if(l < distMin || (l == distMin && id < nearest))
+	{
+		distMin = l ;
+		nearest = id ;
+	}
+
+	unsigned int axis = m_axis[m] ;
+	REAL diff = x[axis] - m_points[id][axis] ;
+	if(diff < 0)
+	{
+		search(x, b, m, nearest, distMin) ;
+		if(diff * diff <= distMin)
+			search(x, m + 1, e, nearest, distMin) ;
+	}
+	else
+	{
+		search(x, m + 1, e, nearest, distMin) ;
+		if(diff * diff <= distMin)
+			search(x, b, m, nearest, distMin) ;
+	}
+}
+
+template <typename VEC>
+unsigned int CodeVectorKDTree<VEC>::nearest(const VEC& x) const
+{
+	unsigned int nearest = 0 ;
+	REAL distMin = std::numeric_limits<REAL>::max() ;
+	search(x, 0, uint32(m_idx.size()), nearest, distMin) ;
+	return nearest ;
+}
+
+
 template <typename VEC>
 Quantization<VEC>::Quantization(const std::vector<VEC>& source) : sourceVectors(source)
 {
 	associatedCodeVectors.resize(sourceVectors.size()) ;
 	nbCodeVectors = 0 ;
+	nbThreads = 1 ;
 	computeMeanSourceVector() ;
 	computeDifferentialEntropy() ;
 }
@@ -91,6 +189,102 @@ typename Quantization<VEC>::CodeVectorID Quantization<VEC>::nearestNeighbour(int
 	return nearest ;
 }
 
+template <typename VEC>
+void Quantization<VEC>::assignRegions()
+{
+	typedef typename VEC::DATA_TYPE REAL;
+
+	// flat copy of the codebook for the KD-tree and the partial sums
+	std::vector<CodeVectorID> cvIds ;
+	std::vector<VEC> cvPos ;
+	cvIds.reserve(codeVectors.size()) ;
+	cvPos.reserve(codeVectors.size()) ;
+	for(CodeVectorID cv = codeVectors.begin(); cv != codeVectors.end(); ++cv)
+	{
+		cvIds.push_back(cv) ;
+		cvPos.push_back(cv->v) ;
+	}
+	const unsigned int nbCV = uint32(cvIds.size()) ;
+	const unsigned int nbSV = uint32(sourceVectors.size()) ;
+
+	CodeVectorKDTree<VEC> tree(cvPos) ;
+
+	unsigned int nbth = nbThreads < nbSV ? nbThreads : nbSV ;
+	if(nbth < 1)
+		nbth = 1 ;
+
+	VEC z ;
+	zero<VEC>(z) ;
+	std::vector<unsigned int> partialNb(nbth * nbCV, 0) ;
+	std::vector<VEC> partialSum(nbth * nbCV, z) ;
+	std::vector<float> partialDist(nbth * nbCV, 0.0f) ;
+
+	auto assignRange = [&] (unsigned int t)
+	{
+		unsigned int first = (unsigned long long)(nbSV) * t / nbth ;
+		unsigned int last = (unsigned long long)(nbSV) * (t + 1) / nbth ;
+		for(unsigned int i = first; i < last; ++i)
+		{
+			unsigned int j = tree.nearest(sourceVectors[i]) ;
+			associatedCodeVectors[i] = cvIds[j] ;
+			unsigned int k = t * nbCV + j ;
+			partialNb[k] += 1 ;
+			VEC vec = sourceVectors[i] - cvPos[j] ;
+			partialDist[k] += REAL(vec.norm2()) ;
+			partialSum[k] += sourceVectors[i] ;
+		}
+	} ;
+
+	if(nbth == 1)
+		assignRange(0) ;
+	else
+	{
+		std::vector<std::thread> threads ;
+		threads.reserve(nbth) ;
+		for(unsigned int t = 0; t < nbth; ++t)
+			threads.push_back(std::thread(assignRange, t)) ;
+		for(unsigned int t = 0; t < nbth; ++t)
+			threads[t].join() ;
+	}
+
+	// merge the partial sums in range order (result does not depend on scheduling)
+	for(unsigned int j = 0; j < nbCV; ++j)
+	{
+		CodeVectorID cv = cvIds[j] ;
+		cv->regionNbVectors = 0 ;
+		cv->regionVectorsSum = z ;
+		cv->regionDistortion = 0.0f ;
+		for(unsigned int t = 0; t < nbth; ++t)
+		{
+			unsigned int k = t * nbCV + j ;
+			cv->regionNbVectors += partialNb[k] ;
+			cv->regionVectorsSum += partialSum[k] ;
+			cv->regionDistortion += partialDist[k] ;
+		}
+	}
+}
+
+template <typename VEC>
+void Quantization<VEC>::computeDistortion()
+{
+	distortion = 0.0f ;
+
+	// sum the distortions associated to the codeVectors
+	// and remove the codeVectors with an empty region
+	CodeVectorID cv = codeVectors.begin() ;
+	while(cv != codeVectors.end())
+	{
+		if(cv->regionNbVectors > 0)
+		{
+			distortion += cv->regionDistortion ;
+			++cv ;
+		}
+		else
+			cv = codeVectors.erase(cv) ;
+	}
+	distortion /= sourceVectors.size() ;
+}
+
 template <typename VEC>
 void Quantization<VEC>::algoLloydMax()
 {
@@ -100,57 +294,29 @@ void Quantization<VEC>::algoLloydMax()
 	{
 		++nbLloydIt ;
 
-		VEC z ;
-		zero<VEC>(z) ;
-
-		// initialize the codeVectors region properties
-		for(CodeVectorID cv = codeVectors.begin(); cv != codeVectors.end(); ++cv)
-		{
-			cv->regionNbVectors = 0 ;
-			cv->regionVectorsSum = z ;
-			cv->regionDistortion = 0.0f ;
-		}
-
 		// For each sourceVector, find its nearest neighbour among the current codeVectors
 		// and update nbVectors and distortion associated to each codeVector.
 		// In the same time, compute for each codeVector the sum of the sourceVectors of its region
 		// (needed if one has to update the positions of the codeVectors)
-		for(unsigned int i = 0; i < sourceVectors.size(); ++i)
-		{
-			CodeVectorID cv = nearestNeighbour(i) ;
-			associatedCodeVectors[i] = cv ;
-			cv->regionNbVectors += 1 ;
-			VEC vec = sourceVectors[i] - cv->v ;
-			cv->regionDistortion += vec.norm2() ;
-			cv->regionVectorsSum += sourceVectors[i] ;
-		}
+		assignRegions() ;
 
 		float oldDistortion = distortion ;
-		distortion = 0.0f ;
-
-		// update the distortion associated to each codeVector
-		// and compute the total distortion
-		for(CodeVectorID cv = codeVectors.begin(); cv != codeVectors.end(); ++cv)
-		{
-			if(cv->regionNbVectors > 0)
-				distortion += cv->regionDistortion ;
-			else
-				codeVectors.erase(cv) ;
-		}
-		distortion /= sourceVectors.size() ;
+		computeDistortion() ;
 
 		if((oldDistortion - distortion) / oldDistortion < epsilonDistortion)
 			finished = true ;
 
-		if(!finished)
-		{
-			// update the codeVectors as the average of the sourceVectors of its region
-			for(CodeVectorID cv = codeVectors.begin(); cv != codeVectors.end(); ++cv)
-				cv->v = cv->regionVectorsSum / typename VEC::DATA_TYPE(cv->regionNbVectors) ;
-		}
+		// update the codeVectors as the average of the sourceVectors of its region
+		// (also on the last iteration : freshly split codeVectors would not be separated otherwise)
+		for(CodeVectorID cv = codeVectors.begin(); cv != codeVectors.end(); ++cv)
+			cv->v = cv->regionVectorsSum / typename VEC::DATA_TYPE(cv->regionNbVectors) ;
 	}
 	while(!finished) ;
 
+	// the codeVectors moved after the last assignment : regions and distortion must describe the final codebook
+	assignRegions() ;
+	computeDistortion() ;
+
 	// sort the codeVectors by ascending distortion
 	CGoGNout << "nbLloydIt -> " << nbLloydIt << CGoGNendl ;
 	codeVectors.sort() ;
@@ -284,6 +450,102 @@ void Quantization<VEC>::vectorQuantizationDistortion(float distortionGoal, std::
 	computeDiscreteEntropy() ;
 }
 
+// Mini-batch k-means (Sculley 2010) with a codebook initialized on a random sample
+template <typename VEC>
+void Quantization<VEC>::vectorQuantizationMiniBatch(unsigned int nbRegions, unsigned int batchSize, unsigned int nbIterations, std::vector<VEC>& result, unsigned int seed)
+{
+	const unsigned int nbSV = uint32(sourceVectors.size()) ;
+	if(nbSV == 0)
+	{
+		codeVectors.clear() ;
+		nbCodeVectors = 0 ;
+		distortion = 0.0f ;
+		result.clear() ;
+		return ;
+	}
+	if(batchSize > nbSV)
+		batchSize = nbSV ;
+	nbRegions = nbRegions > batchSize ? batchSize : nbRegions ;
+
+	std::mt19937 gen(seed) ;
+	std::uniform_int_distribution<unsigned int> pick(0, nbSV - 1) ;
+
+	// initial codebook : quantization of a random sample
+	std::vector<VEC> sample(batchSize) ;
+	for(unsigned int i = 0; i < batchSize; ++i)
+		sample[i] = sourceVectors[pick(gen)] ;
+
+	std::vector<VEC> tmp ;
+	Quantization<VEC> init(sample) ;
+	init.setNbThreads(nbThreads) ;
+	init.vectorQuantizationNbRegions(nbRegions, tmp) ;
+
+	codeVectors = init.codeVectors ;
+	nbCodeVectors = uint32(codeVectors.size()) ;
+
+	std::vector<CodeVectorID> cvIds ;
+	std::vector<VEC> cvPos ;
+	std::vector<unsigned int> cvCount(nbCodeVectors, 0) ;
+	std::vector<unsigned int> batch(batchSize) ;
+	std::vector<unsigned int> batchNearest(batchSize) ;
+
+	for(unsigned int it = 0; it < nbIterations; ++it)
+	{
+		cvIds.clear() ;
+		cvPos.clear() ;
+		for(CodeVectorID cv = codeVectors.begin(); cv != codeVectors.end(); ++cv)
+		{
+			cvIds.push_back(cv) ;
+			cvPos.push_back(cv->v) ;
+		}
+		CodeVectorKDTree<VEC> tree(cvPos) ;
+
+		for(unsigned int i = 0; i < batchSize; ++i)
+		{
+			batch[i] = pick(gen) ;
+			batchNearest[i] = tree.nearest(sourceVectors[batch[i]]) ;
+		}
+
+		// gradient step with a per-codeVector learning rate
+		for(unsigned int i = 0; i < batchSize; ++i)
+		{
+			unsigned int j = batchNearest[i] ;
+			cvCount[j] += 1 ;
+			typename VEC::DATA_TYPE eta = typename VEC::DATA_TYPE(1) / typename VEC::DATA_TYPE(cvCount[j]) ;
+			VEC& c = cvIds[j]->v ;
+			c += (sourceVectors[batch[i]] - c) * eta ;
+		}
+	}
+
+	// final assignment of all the source vectors
+	assignRegions() ;
+	computeDistortion() ;
+	nbCodeVectors = uint32(codeVectors.size()) ;
+
+	result.resize(nbSV) ;
+	for(unsigned int i = 0; i < nbSV ; ++i)
+		result[i] = associatedCodeVectors[i]->v ;
+
+	computeDiscreteEntropy() ;
+}
+
+template <typename VEC>
+void Quantization<VEC>::getCodebook(std::vector<VEC>& codebook, std::vector<unsigned int>& codes)
+{
+	codebook.clear() ;
+	codebook.reserve(codeVectors.size()) ;
+	std::map<const CodeVector<VEC>*, unsigned int> index ;
+	for(CodeVectorID cv = codeVectors.begin(); cv != codeVectors.end(); ++cv)
+	{
+		index[&(*cv)] = uint32(codebook.size()) ;
+		codebook.push_back(cv->v) ;
+	}
+
+	codes.resize(sourceVectors.size()) ;
+	for(unsigned int i = 0; i < sourceVectors.size(); ++i)
+		codes[i] = index[&(*associatedCodeVectors[i])] ;
+}
+
 inline float log2(float x)
 {
     return log(x) / log(2.0f) ;
@@ -11,6 +11,7 @@
 #include <cassert>
 #include <cmath>
 #include <iostream>
+#include <type_traits>
 
 #include <Eigen/Core>
 #include <Eigen/Dense>
@@ -32,9 +33,7 @@ private :
 	static unsigned long cpt_instances;                      // number of instances of the class
 	static Tscalar K_tab [(max_resolution+1)*(max_resolution+1)];   // table containing constants K
 
-//	static Tscalar F_tab [(max_resolution+1)*(max_resolution+1)];   // table for computing the functions : P or Y or y
-
-	static Tscalar F_tab [32][(max_resolution+1)*(max_resolution+1)];
+	static thread_local Tscalar F_tab [(max_resolution+1)*(max_resolution+1)];   // per thread table for computing the functions : P or Y or y
 
 	Tcoef* coefs;                                            // table of coefficients
 
@@ -50,6 +49,7 @@ public :
 	static int get_nb_coefs () { return nb_coefs; }
 
 	// evaluation
+	// the evaluation direction is stored per thread : threadId is unused and only kept for compatibility
 
 	static void set_eval_direction (Tscalar theta, Tscalar phi, unsigned int threadId = 0) ;       // fix the direction in which the SH has to be evaluated
 	static void set_eval_direction (Tscalar x, Tscalar y, Tscalar z, unsigned int threadId = 0) ;  // fix the direction in which the SH has to be evaluated
@@ -83,21 +83,106 @@ public :
 	void fit_to_data(int n, Tdirection* t_theta, Tdirection* t_phi, Tchannel* t_R, Tchannel* t_G, Tchannel* t_B, double lambda, unsigned int threadId = 0);
 	template <typename Tdirection, typename Tchannel>
 	void fit_to_data(int n, Tdirection* t_x, Tdirection* t_y, Tdirection* t_z, Tchannel* t_R, Tchannel* t_G, Tchannel* t_B, double lambda, unsigned int threadId = 0);
+	template <typename Tchannel>
+	void fit_to_data(const Eigen::MatrixXd& basis, Tchannel* t_R, Tchannel* t_G, Tchannel* t_B, double lambda); // basis computed by compute_basis
+
+	// batch : basis functions evaluated at a set of directions (nb_coefs x n matrix, one column per direction)
+	// a basis can be shared by all the functions evaluated or fitted with the same sampling
+	template <typename Tdirection, typename Treal>
+	static void compute_basis (int n, const Tdirection* t_theta, const Tdirection* t_phi, Eigen::Matrix<Treal,Eigen::Dynamic,Eigen::Dynamic>& basis);
+	template <typename Tdirection, typename Treal>
+	static void compute_basis (int n, const Tdirection* t_x, const Tdirection* t_y, const Tdirection* t_z, Eigen::Matrix<Treal,Eigen::Dynamic,Eigen::Dynamic>& basis);
+	template <typename Treal>
+	void evaluate_batch (const Eigen::Matrix<Treal,Eigen::Dynamic,Eigen::Dynamic>& basis, Tcoef* result) const; // result[p] = value in direction p
 
 private :
 	static inline int index (int l, int m) { return l*(l+1)+m; }
 
 	// evaluation :
 	static void init_K_tab (); // compute the normalization constants K_l^m and store them into K_tab
-	static void compute_P_tab (Tscalar t, unsigned int threadId); // Compute Legendre Polynomials at parameter t and store them in F_tab (only for m>=0)
-	static void compute_y_tab (Tscalar phi, unsigned int threadId); // Compute the real basis functions y_l^m at (theta, phi) and store them in F_tab (compute_P_tab must have been called before)
+	static void compute_P_tab (Tscalar t); // Compute Legendre Polynomials at parameter t and store them in F_tab (only for m>=0)
+	static void compute_y_tab (Tscalar phi); // Compute the real basis functions y_l^m at (theta, phi) and store them in F_tab (compute_P_tab must have been called before)
 
 	const Tcoef& get_coef (int i) const {assert ((i>=0 && i<nb_coefs ) || !" maybe you forgot to call set_level()"); return coefs[i];}
 	Tcoef& get_coef (int i) {assert ((i>=0 && i<nb_coefs ) || !" maybe you forgot to call set_level()"); return coefs[i];}
 
 	// fitting
 	template <typename Tchannel>
-	void fit_to_data(int n, Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic>& mM, Tchannel* t_R, Tchannel* t_G, Tchannel* t_B, double lambda);
+	void fit_to_data(int n, const Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic>& mM, Tchannel* t_R, Tchannel* t_G, Tchannel* t_B, double lambda);
+
+	template <typename TS, typename TC> friend class SphericalHarmonicsBatch;
+};
+
+/**
+ * Set of spherical harmonics functions stored channel by channel (SoA) :
+ * for each channel, a nb_functions x nb_coefs matrix (column major, so that
+ * a given coef of all the functions is contiguous).
+ * Evaluation and fitting of all the functions against a shared basis
+ * (see SphericalHarmonics::compute_basis) are matrix products.
+ * Tcoef is a scalar or a Geom::Vector (one channel per component).
+ */
+template <typename Tscalar, typename Tcoef>
+class SphericalHarmonicsBatch
+{
+public:
+	typedef SphericalHarmonics<Tscalar,Tcoef> SH;
+	typedef Eigen::Matrix<Tscalar,Eigen::Dynamic,Eigen::Dynamic> Matrix;
+
+private:
+	// channels of a coef : a single one for a scalar, one per component for a vector
+	template <typename T, bool IS_SCALAR = std::is_arithmetic<T>::value>
+	struct Channels
+	{
+		static const int NB = 1;
+		static Tscalar get(const T& v, int) { return Tscalar(v); }
+		static void set(T& v, int, Tscalar x) { v = T(x); }
+	};
+
+	template <typename T>
+	struct Channels<T, false>
+	{
+		static const int NB = T::DIMENSION;
+		static Tscalar get(const T& v, int c) { return Tscalar(v[c]); }
+		static void set(T& v, int c, Tscalar x) { v[c] = x; }
+	};
+
+public:
+	static const int NB_CHANNELS = Channels<Tcoef>::NB;
+
+private:
+	int m_nbFunctions;
+	Matrix m_coefs[NB_CHANNELS];
+
+public:
+	SphericalHarmonicsBatch(int nbFunctions = 0);
+
+	void resize(int nbFunctions);
+
+	int nb_functions() const { return m_nbFunctions; }
+
+	// coefs of channel c : nb_functions x nb_coefs
+	Matrix& channel(int c) { return m_coefs[c]; }
+	const Matrix& channel(int c) const { return m_coefs[c]; }
+
+	// conversion from / to the AoS representation
+	void set(int f, const SH& sh);
+	void get(int f, SH& sh) const;
+
+	/**
+	 * evaluate all functions in all directions of the basis
+	 * @param basis nb_coefs x n matrix given by SphericalHarmonics::compute_basis
+	 * @param result for each channel, a nb_functions x n matrix
+	 */
+	void evaluate(const Matrix& basis, Matrix* result) const;
+
+	/**
+	 * fit all functions to data sampled in the directions of the basis
+	 * (same system as SphericalHarmonics::fit_to_data, factorized once)
+	 * @param basis nb_coefs x n matrix given by SphericalHarmonics::compute_basis
+	 * @param data for each channel, a nb_functions x n matrix of samples
+	 * @param lambda regularization weight
+	 */
+	void fit_to_data(const Matrix& basis, const Matrix* data, double lambda);
 };
 
 } // namespace Utils
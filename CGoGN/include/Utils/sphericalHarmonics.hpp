@@ -16,7 +16,7 @@ template <typename Tscalar,typename Tcoef> int SphericalHarmonics<Tscalar,Tcoef>
 template <typename Tscalar,typename Tcoef> unsigned long SphericalHarmonics<Tscalar,Tcoef>::cpt_instances = 0;
 
 template <typename Tscalar,typename Tcoef> Tscalar SphericalHarmonics<Tscalar,Tcoef>::K_tab[(max_resolution+1)*(max_resolution+1)];
-template <typename Tscalar,typename Tcoef> Tscalar SphericalHarmonics<Tscalar,Tcoef>::F_tab[32][(max_resolution+1)*(max_resolution+1)];
+template <typename Tscalar,typename Tcoef> thread_local Tscalar SphericalHarmonics<Tscalar,Tcoef>::F_tab[(max_resolution+1)*(max_resolution+1)];
 
 
 /*************************************************************************
@@ -77,52 +77,47 @@ evaluation
 **************************************************************************/
 
 template <typename Tscalar,typename Tcoef>
-void SphericalHarmonics<Tscalar,Tcoef>::set_eval_direction (Tscalar theta, Tscalar phi, unsigned int threadId)
+void SphericalHarmonics<Tscalar,Tcoef>::set_eval_direction (Tscalar theta, Tscalar phi, unsigned int /*threadId*/)
 {
-	assert(threadId < 32);
-	compute_P_tab(std::cos(theta), threadId);
-	compute_y_tab(phi, threadId);
+	compute_P_tab(std::cos(theta));
+	compute_y_tab(phi);
 }
 
 template <typename Tscalar,typename Tcoef>
-void SphericalHarmonics<Tscalar,Tcoef>::set_eval_direction (Tscalar x, Tscalar y, Tscalar z, unsigned int threadId)
+void SphericalHarmonics<Tscalar,Tcoef>::set_eval_direction (Tscalar x, Tscalar y, Tscalar z, unsigned int /*threadId*/)
 {
-	assert(threadId < 32);
-	compute_P_tab(z, threadId);
+	compute_P_tab(z);
 
 	Tscalar phi (0);
 	if ((x*x + y*y) > 0.0)
 		phi = atan2(y, x);
 
-	compute_y_tab(phi, threadId);
+	compute_y_tab(phi);
 }
 
 template <typename Tscalar,typename Tcoef>
-Tcoef SphericalHarmonics<Tscalar,Tcoef>::evaluate (unsigned int threadId) const
+Tcoef SphericalHarmonics<Tscalar,Tcoef>::evaluate (unsigned int /*threadId*/) const
 {
-	assert(threadId < 32);
 	Tcoef r (0); // (0.0,0.0,0.0); //  TODO : use Tcoef (0)
 	for (int i = 0; i < nb_coefs; i++)
 	{
-		r += coefs[i] * F_tab[threadId][i];
+		r += coefs[i] * F_tab[i];
 	}
 	return r;
 }
 
 template <typename Tscalar,typename Tcoef>
-Tcoef SphericalHarmonics<Tscalar,Tcoef>::evaluate_at (Tscalar theta, Tscalar phi, unsigned int threadId) const
+Tcoef SphericalHarmonics<Tscalar,Tcoef>::evaluate_at (Tscalar theta, Tscalar phi, unsigned int /*threadId*/) const
 {
-	assert(threadId < 32);
-	set_eval_direction(theta, phi, threadId);
-	return evaluate(threadId);
+	set_eval_direction(theta, phi);
+	return evaluate();
 }
 
 template <typename Tscalar,typename Tcoef>
-Tcoef SphericalHarmonics<Tscalar,Tcoef>::evaluate_at (Tscalar x, Tscalar y, Tscalar z, unsigned int threadId) const
+Tcoef SphericalHarmonics<Tscalar,Tcoef>::evaluate_at (Tscalar x, Tscalar y, Tscalar z, unsigned int /*threadId*/) const
 {
-	assert(threadId < 32);
-	set_eval_direction(x, y, z, threadId);
-	return evaluate(threadId);
+	set_eval_direction(x, y, z);
+	return evaluate();
 }
 
 template <typename Tscalar,typename Tcoef>
@@ -155,28 +150,28 @@ void SphericalHarmonics<Tscalar,Tcoef>::copy_K_tab (Tscalar tab[])
 */
 
 template <typename Tscalar,typename Tcoef>
-void SphericalHarmonics<Tscalar,Tcoef>::compute_P_tab (Tscalar t, unsigned int threadId)
+void SphericalHarmonics<Tscalar,Tcoef>::compute_P_tab (Tscalar t)
 {
 //	if (t<0) {t=-t*t;} else {t=t*t;} // for plotting only : expand the param near equator
 
-	F_tab[threadId][index(0,0)] = 1;
+	F_tab[index(0,0)] = 1;
 	for (int l = 1; l <= resolution; l++)
 	{
-		F_tab[threadId][index(l,l)] = (1-2*l) * sqrt(1-t*t) * F_tab[threadId][index(l-1,l-1)];  // first diago
-		F_tab[threadId][index(l,l-1)] = t * (2*l-1) * F_tab[threadId][index(l-1,l-1)];// second diago
+		F_tab[index(l,l)] = (1-2*l) * sqrt(1-t*t) * F_tab[index(l-1,l-1)];  // first diago
+		F_tab[index(l,l-1)] = t * (2*l-1) * F_tab[index(l-1,l-1)];// second diago
 		for (int m = 0; m <= l-2; m++)
 		{// remaining of the line under the 2 diago
-			F_tab[threadId][index(l,m)] = t * (2*l-1) / (float) (l-m) * F_tab[threadId][index(l-1,m)] - (l+m-1) / (float) (l-m) * F_tab[threadId][index(l-2,m)];
+			F_tab[index(l,m)] = t * (2*l-1) / (float) (l-m) * F_tab[index(l-1,m)] - (l+m-1) / (float) (l-m) * F_tab[index(l-2,m)];
 		}
 	}
 }
 
 template <typename Tscalar,typename Tcoef>
-void SphericalHarmonics<Tscalar,Tcoef>::compute_y_tab (Tscalar phi, unsigned int threadId)
+void SphericalHarmonics<Tscalar,Tcoef>::compute_y_tab (Tscalar phi)
 {
 	for (int l = 0; l <= resolution; l++)
 	{
-		F_tab[threadId][index(l,0)] *= K_tab[index(l,0)]; // remove for plotting
+		F_tab[index(l,0)] *= K_tab[index(l,0)]; // remove for plotting
 	}
 
 	for (int m = 1; m <= resolution; m++)
@@ -186,10 +181,10 @@ void SphericalHarmonics<Tscalar,Tcoef>::compute_y_tab (Tscalar phi, unsigned int
 
 		for (int l = m; l <= resolution; l++)
 		{
-			F_tab[threadId][index(l,m)] *= M_SQRT2; // std::sqrt(2.0); // remove for plotting
-			F_tab[threadId][index(l,m)] *= K_tab[index(l,m)]; // remove for plotting
-			F_tab[threadId][index(l,-m)] = F_tab[threadId][index(l,m)] * sin_m_phi ; // store the values for -m<0 in the upper triangle
-			F_tab[threadId][index(l,m)] *= cos_m_phi;
+			F_tab[index(l,m)] *= M_SQRT2; // std::sqrt(2.0); // remove for plotting
+			F_tab[index(l,m)] *= K_tab[index(l,m)]; // remove for plotting
+			F_tab[index(l,-m)] = F_tab[index(l,m)] * sin_m_phi ; // store the values for -m<0 in the upper triangle
+			F_tab[index(l,m)] *= cos_m_phi;
 		}
 	}
 
@@ -293,18 +288,10 @@ void SphericalHarmonics<Tscalar,Tcoef>::fit_to_data(
 	Tdirection* t_theta, Tdirection* t_phi,
 	Tchannel* t_R, Tchannel* t_G, Tchannel* t_B,
 	double lambda,
-	unsigned int threadId)
+	unsigned int /*threadId*/)
 {
-	Eigen::MatrixXd mM (nb_coefs,n); // matrix with basis function values, evaluated for all directions
-	// compute mM
-	for (int p = 0; p < n; ++p)
-	{
-		set_eval_direction(t_theta[p], t_phi[p], threadId);
-		for (int i = 0; i < nb_coefs; ++i)
-		{
-			mM(i,p) = F_tab[threadId][i];
-		}
-	}
+	Eigen::MatrixXd mM; // matrix with basis function values, evaluated for all directions
+	compute_basis(n, t_theta, t_phi, mM);
 	fit_to_data(n, mM, t_R, t_G, t_B, lambda);
 }
 
@@ -315,26 +302,29 @@ void SphericalHarmonics<Tscalar,Tcoef>::fit_to_data(
 	Tdirection* t_x, Tdirection* t_y, Tdirection* t_z,
 	Tchannel* t_R, Tchannel* t_G, Tchannel* t_B,
 	double lambda,
-	unsigned int threadId)
+	unsigned int /*threadId*/)
 {
-	Eigen::MatrixXd mM (nb_coefs,n); // matrix with basis function values, evaluated for all directions
-	// compute mM
-	for (int p=0; p<n; ++p)
-	{
-		set_eval_direction(t_x[p],t_y[p],t_z[p], threadId);
-		for (int i=0; i<nb_coefs; ++i)
-		{
-			mM(i,p) = F_tab[threadId][i];
-		}
-	}
+	Eigen::MatrixXd mM; // matrix with basis function values, evaluated for all directions
+	compute_basis(n, t_x, t_y, t_z, mM);
 	fit_to_data(n, mM, t_R, t_G, t_B, lambda);
 }
 
+template <typename Tscalar,typename Tcoef>
+template <typename Tchannel>
+void SphericalHarmonics<Tscalar,Tcoef>::fit_to_data(
+	const Eigen::MatrixXd& basis,
+	Tchannel* t_R, Tchannel* t_G, Tchannel* t_B,
+	double lambda)
+{
+	assert(basis.rows() == nb_coefs || !"basis computed for another level");
+	fit_to_data(int(basis.cols()), basis, t_R, t_G, t_B, lambda);
+}
+
 template <typename Tscalar,typename Tcoef>
 template <typename Tchannel>
 void SphericalHarmonics<Tscalar,Tcoef>::fit_to_data(
 	int n,
-	Eigen::MatrixXd& mM,
+	const Eigen::MatrixXd& mM,
 	Tchannel* t_R, Tchannel* t_G, Tchannel* t_B,
 	double lambda)
 {
@@ -344,22 +334,12 @@ void SphericalHarmonics<Tscalar,Tcoef>::fit_to_data(
 
 	// allocate the memory
 	Eigen::MatrixXd mA (nb_coefs, nb_coefs); // matrix A in linear system AC=B
-	Eigen::MatrixXd mB (nb_coefs, 3); // matrix B in linear system AC=B : contains [t_R, t_G, t_B]
+	Eigen::MatrixXd mB (n, 3); // samples [t_R, t_G, t_B], then matrix B in linear system AC=B
 	Eigen::MatrixXd mC (nb_coefs, 3); // matrix C (solution) in linear system AC=B : contains the RGB coefs of the resulting SH
 
 	// compute mA
-	for (int i = 0; i < nb_coefs; ++i)
-	{
-		for (int j = 0; j < nb_coefs; ++j)
-		{
-			mA(i,j) = 0;
-			for (int p = 0; p < n; ++p)
-			{
-				mA(i,j) += mM(i,p) * mM(j,p);
-			}
-			mA(i,j) *= (1.0-lambda) / n;
-		}
-	}
+	mA.noalias() = mM * mM.transpose();
+	mA *= (1.0-lambda) / n;
 
 	for (int l = 0; l <= resolution; ++l)
 	{
@@ -371,21 +351,14 @@ void SphericalHarmonics<Tscalar,Tcoef>::fit_to_data(
 	}
 
 	// compute mB
-	for (int i = 0; i < nb_coefs; ++i)
+	for (int p = 0; p < n; ++p)
 	{
-		mB(i,0) = 0.0;
-		mB(i,1) = 0.0;
-		mB(i,2) = 0.0;
-		for (int p = 0; p < n; ++p)
-		{
-			mB(i,0) += mM(i,p) * t_R[p];
-			mB(i,1) += mM(i,p) * t_G[p];
-			mB(i,2) += mM(i,p) * t_B[p];
-		}
-		mB(i,0) *= (1.0-lambda) / n;
-		mB(i,1) *= (1.0-lambda) / n;
-		mB(i,2) *= (1.0-lambda) / n;
+		mB(p,0) = t_R[p];
+		mB(p,1) = t_G[p];
+		mB(p,2) = t_B[p];
 	}
+	mB = mM * mB;
+	mB *= (1.0-lambda) / n;
 
 	// solve the system with LDLT decomposition
 	Eigen::LDLT<Eigen::MatrixXd> solver (mA);
@@ -408,6 +381,145 @@ void SphericalHarmonics<Tscalar,Tcoef>::fit_to_data(
 	}
 }
 
+/*************************************************************************
+batch evaluation
+**************************************************************************/
+
+template <typename Tscalar,typename Tcoef>
+template <typename Tdirection, typename Treal>
+void SphericalHarmonics<Tscalar,Tcoef>::compute_basis(
+	int n,
+	const Tdirection* t_theta, const Tdirection* t_phi,
+	Eigen::Matrix<Treal,Eigen::Dynamic,Eigen::Dynamic>& basis)
+{
+	assert ( (nb_coefs > 0) || !" maybe you forgot to call set_level()");
+	basis.resize(nb_coefs, n);
+	for (int p = 0; p < n; ++p)
+	{
+		set_eval_direction(Tscalar(t_theta[p]), Tscalar(t_phi[p]));
+		for (int i = 0; i < nb_coefs; ++i)
+			basis(i,p) = Treal(F_tab[i]);
+	}
+}
+
+template <typename Tscalar,typename Tcoef>
+template <typename Tdirection, typename Treal>
+void SphericalHarmonics<Tscalar,Tcoef>::compute_basis(
+	int n,
+	const Tdirection* t_x, const Tdirection* t_y, const Tdirection* t_z,
+	Eigen::Matrix<Treal,Eigen::Dynamic,Eigen::Dynamic>& basis)
+{
+	assert ( (nb_coefs > 0) || !" maybe you forgot to call set_level()");
+	basis.resize(nb_coefs, n);
+	for (int p = 0; p < n; ++p)
+	{
+		set_eval_direction(Tscalar(t_x[p]), Tscalar(t_y[p]), Tscalar(t_z[p]));
+		for (int i = 0; i < nb_coefs; ++i)
+			basis(i,p) = Treal(F_tab[i]);
+	}
+}
+
+template <typename Tscalar,typename Tcoef>
+template <typename Treal>
+void SphericalHarmonics<Tscalar,Tcoef>::evaluate_batch(
+	const Eigen::Matrix<Treal,Eigen::Dynamic,Eigen::Dynamic>& basis,
+	Tcoef* result) const
+{
+	assert(basis.rows() == nb_coefs || !"basis computed for another level");
+	for (int p = 0; p < basis.cols(); ++p)
+	{
+		Tcoef r (0);
+		for (int i = 0; i < nb_coefs; ++i)
+			r += coefs[i] * Tscalar(basis(i,p));
+		result[p] = r;
+	}
+}
+
+/*************************************************************************
+SphericalHarmonicsBatch
+**************************************************************************/
+
+template <typename Tscalar,typename Tcoef>
+SphericalHarmonicsBatch<Tscalar,Tcoef>::SphericalHarmonicsBatch(int nbFunctions) :
+	m_nbFunctions(0)
+{
+	resize(nbFunctions);
+}
+
+template <typename Tscalar,typename Tcoef>
+void SphericalHarmonicsBatch<Tscalar,Tcoef>::resize(int nbFunctions)
+{
+	assert ( (SH::nb_coefs > 0) || !" maybe you forgot to call set_level()");
+	m_nbFunctions = nbFunctions;
+	for (int c = 0; c < NB_CHANNELS; ++c)
+		m_coefs[c].setZero(nbFunctions, SH::nb_coefs);
+}
+
+template <typename Tscalar,typename Tcoef>
+void SphericalHarmonicsBatch<Tscalar,Tcoef>::set(int f, const SH& sh)
+{
+	assert(f >= 0 && f < m_nbFunctions);
+	for (int i = 0; i < SH::nb_coefs; ++i)
+		for (int c = 0; c < NB_CHANNELS; ++c)
+			m_coefs[c](f,i) = Channels<Tcoef>::get(sh.coefs[i], c);
+}
+
+template <typename Tscalar,typename Tcoef>
+void SphericalHarmonicsBatch<Tscalar,Tcoef>::get(int f, SH& sh) const
+{
+	assert(f >= 0 && f < m_nbFunctions);
+	for (int i = 0; i < SH::nb_coefs; ++i)
+		for (int c = 0; c < NB_CHANNELS; ++c)
+			Channels<Tcoef>::set(sh.coefs[i], c, m_coefs[c](f,i));
+}
+
+template <typename Tscalar,typename Tcoef>
+void SphericalHarmonicsBatch<Tscalar,Tcoef>::evaluate(const Matrix& basis, Matrix* result) const
+{
+	assert(basis.rows() == SH::nb_coefs || !"basis computed for another level");
+	for (int c = 0; c < NB_CHANNELS; ++c)
+		result[c].noalias() = m_coefs[c] * basis;
+}
+
+template <typename Tscalar,typename Tcoef>
+void SphericalHarmonicsBatch<Tscalar,Tcoef>::fit_to_data(const Matrix& basis, const Matrix* data, double lambda)
+{
+	// same system as SphericalHarmonics::fit_to_data : A only depends on the sampling,
+	// so it is factorized once and all the functions and channels are solved together
+	const int nb_coefs = SH::nb_coefs;
+	const int n = int(basis.cols());
+	assert(basis.rows() == nb_coefs || !"basis computed for another level");
+
+	Eigen::MatrixXd mM = basis.template cast<double>();
+
+	Eigen::MatrixXd mA (nb_coefs, nb_coefs);
+	mA.noalias() = mM * mM.transpose();
+	mA *= (1.0-lambda) / n;
+	for (int l = 0; l <= SH::resolution; ++l)
+	{
+		for (int m = -l; m <= l; ++m)
+		{
+			int i = SH::index(l,m);
+			mA(i,i) += lambda * l * (l+1) / (4.0*M_PI);
+		}
+	}
+
+	// one column of B per function and channel
+	Eigen::MatrixXd mB (nb_coefs, NB_CHANNELS * m_nbFunctions);
+	for (int c = 0; c < NB_CHANNELS; ++c)
+	{
+		assert(data[c].rows() == m_nbFunctions && data[c].cols() == n);
+		mB.middleCols(c * m_nbFunctions, m_nbFunctions).noalias() = mM * data[c].template cast<double>().transpose();
+	}
+	mB *= (1.0-lambda) / n;
+
+	Eigen::LDLT<Eigen::MatrixXd> solver (mA);
+	Eigen::MatrixXd mC = solver.solve(mB);
+
+	for (int c = 0; c < NB_CHANNELS; ++c)
+		m_coefs[c] = mC.middleCols(c * m_nbFunctions, m_nbFunctions).transpose().template cast<Tscalar>();
+}
+
 } // namespace Utils
 
 } // namespace CGoGN
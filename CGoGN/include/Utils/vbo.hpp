@@ -42,6 +42,7 @@ void VBO::updateData(std::vector<T>& data)
 
 	m_data_size = VEC_DIM;
 	m_nbElts = uint32(data.size());
+	m_source = NULL;
 	glBindBuffer(GL_ARRAY_BUFFER, *m_id);
 
 	if (sizeof(T) / sizeof(double) == VEC_DIM)
@@ -27,6 +27,7 @@
 
 
 #include <vector>
+#include <algorithm>
 #include "Utils/gl_def.h"
 #include "Container/convert.h"
 #include "Topology/generic/attributeHandler.h"
@@ -70,6 +71,34 @@ protected:
 	/// type name of the last attribute used to fill the VBO
 	std::string m_typeName;
 
+	/// attribute whose data the VBO holds (NULL if filled by other means)
+	const AttributeMultiVectorGen* m_source;
+
+	/// dirty epoch of m_source when the VBO was last updated
+	unsigned int m_sourceEpoch;
+
+	/**
+	 * check if only the dirty ranges of attrib need to be sent
+	 * @param attrib the attribute
+	 * @param nbBytes size of the buffer needed by attrib
+	 */
+	inline bool isSynchronizedWith(const AttributeMultiVectorGen* attrib, unsigned int nbBytes) const
+	{
+		return attrib->isDirtyTracking() && m_source == attrib && m_sourceEpoch == attrib->getDirtyEpoch()
+			&& nbBytes == sizeof(float) * m_data_size * m_nbElts;
+	}
+
+	/**
+	 * record that the VBO is up to date with attrib and reset its dirty state
+	 */
+	inline void setSynchronizedWith(const AttributeMultiVectorGen* attrib)
+	{
+		m_source = attrib;
+		if (attrib->isDirtyTracking())
+			attrib->clearDirty();
+		m_sourceEpoch = attrib->getDirtyEpoch();
+	}
+
 public:
 	/**
 	 * constructor: allocate the OGL VBO
@@ -128,6 +157,10 @@ public:
 
 	/**
 	 * update data from attribute multivector to the vbo (automatic conversion if necessary and possible)
+	 * If the attribute tracks its modifications (AttributeMultiVectorGen::setDirtyTracking) and
+	 * the VBO was last filled from it, only the modified ranges are sent; the dirty state of
+	 * the attribute is then cleared. An attribute feeding several VBOs is entirely re-sent
+	 * to all but the first one updated.
 	 */
 	void updateData(const AttributeMultiVectorGen* attrib);
 
@@ -200,48 +233,64 @@ protected:
 	template <typename T_IN, typename T_OUT, unsigned int NB_COMPONENTS, typename CONVFUNC>
 	void updateDataConversion(const AttributeMultiVectorGen* attrib, CONVFUNC conv)
 	{
-		unsigned int old_nbb =  sizeof(float) * m_data_size * m_nbElts;
 		m_name = attrib->getName();
 		m_typeName = attrib->getTypeName();
-		m_data_size = NB_COMPONENTS;
-
-		// alloue la memoire pour le buffer et initialise le conv
-		T_OUT* typedBuffer = new T_OUT[_BLOCKSIZE_];
 
 		std::vector<void*> addr;
 		unsigned int byteTableSize;
 		unsigned int nbb = attrib->getBlocksPointers(addr, byteTableSize);
 
-		m_nbElts = nbb * _BLOCKSIZE_/(sizeof(T_OUT));
-
-		unsigned int offset = 0;
 		unsigned int szb = _BLOCKSIZE_*sizeof(T_OUT);
 
+		// ranges of elements to send
+		std::vector< std::pair<unsigned int, unsigned int> > ranges;
+
 		// bind buffer to update
 		glBindBuffer(GL_ARRAY_BUFFER, *m_id);
-		if (nbb!=old_nbb)
-			glBufferData(GL_ARRAY_BUFFER, nbb * szb, 0, GL_STREAM_DRAW);
+		if (isSynchronizedWith(attrib, nbb * szb))
+			attrib->getDirtyRanges(ranges, _BLOCKSIZE_ / 16);
+		else
+		{
+			if (nbb * szb != sizeof(float) * m_data_size * m_nbElts)
+				glBufferData(GL_ARRAY_BUFFER, nbb * szb, 0, GL_STREAM_DRAW);
+			if (nbb > 0)
+				ranges.push_back(std::make_pair(0u, nbb * _BLOCKSIZE_));
+		}
 
-		for (unsigned int i = 0; i < nbb; ++i)
+		m_data_size = NB_COMPONENTS;
+		m_nbElts = nbb * _BLOCKSIZE_;
+
+		// alloue la memoire pour le buffer et initialise le conv
+		T_OUT* typedBuffer = new T_OUT[_BLOCKSIZE_];
+
+		for (unsigned int r = 0; r < ranges.size(); ++r)
 		{
-			// convertit les donnees dans le buffer de conv
-			const T_IN* typedIn = reinterpret_cast<const T_IN*>(addr[i]);
-			T_OUT* typedOut = typedBuffer;
-			// compute conversion
-			for (unsigned int j = 0; j < _BLOCKSIZE_; ++j)
-				*typedOut++ = conv(*typedIn++);
-
-			// update sub-vbo
-			glBufferSubData(GL_ARRAY_BUFFER, offset, szb, reinterpret_cast<void*>(typedBuffer));
-			// block suivant
-			offset += szb;
+			unsigned int i = ranges[r].first;
+			while (i < ranges[r].second)
+			{
+				// part of the range inside block i / _BLOCKSIZE_
+				unsigned int j = i % _BLOCKSIZE_;
+				unsigned int n = std::min(ranges[r].second - i, _BLOCKSIZE_ - j);
+
+				// convertit les donnees dans le buffer de conv
+				const T_IN* typedIn = reinterpret_cast<const T_IN*>(addr[i / _BLOCKSIZE_]) + j;
+				T_OUT* typedOut = typedBuffer;
+				for (unsigned int k = 0; k < n; ++k)
+					*typedOut++ = conv(*typedIn++);
+
+				// update sub-vbo
+				glBufferSubData(GL_ARRAY_BUFFER, i * sizeof(T_OUT), n * sizeof(T_OUT), reinterpret_cast<void*>(typedBuffer));
+				i += n;
+			}
 		}
 
 		// libere la memoire de la conversion
 		delete[] typedBuffer;
 
+		setSynchronizedWith(attrib);
 	}
 
+
 };
 
 
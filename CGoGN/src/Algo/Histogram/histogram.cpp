@@ -26,6 +26,8 @@
 
 #include "Algo/Histogram/histogram.h"
 
+#include <functional>
+
 
 namespace CGoGN
 {
@@ -39,25 +41,123 @@ namespace Histogram
 
 void Histogram::initDataConvert(const AttributeConvertGen& conv)
 {
-	unsigned int beg = conv.begin();
-	m_min = conv[beg];
-	m_max = m_min;
-
+	m_dataIdx.clear();
 	m_dataIdx.reserve(conv.nbElements());
-	for (unsigned int i = beg; i!= conv.end(); conv.next(i))
-	{
-		double val = conv[i];
-		m_dataIdx.push_back(std::make_pair(val,i));
-		if (val < m_min)
-			m_min = val;
-		if (val > m_max)
-			m_max = val;
+	m_dataPos.assign(conv.end(), 0xffffffff);
+	for (unsigned int i = conv.begin(); i!= conv.end(); conv.next(i))
+	{
+		m_dataPos[i] = uint32(m_dataIdx.size());
+		m_dataIdx.push_back(std::make_pair(0.0, i));
+	}
+
+	// read (and convert) the values in parallel
+	parallelRanges(uint32(m_dataIdx.size()), [&] (unsigned int, unsigned int first, unsigned int last)
+	{
+		for (unsigned int k = first; k < last; ++k)
+			m_dataIdx[k].first = conv[m_dataIdx[k].second];
+	});
+
+	initDataDone();
+}
+
+void Histogram::computeDataMinMax()
+{
+	if (m_dataIdx.empty())
+	{
+		m_qmin = 0.0;
+		m_qmax = 0.0;
+		return;
 	}
 
+	std::vector< std::pair<double, double> > minmax(m_nbThreads > 0 ? m_nbThreads : 1);
+	parallelRanges(uint32(m_dataIdx.size()), [&] (unsigned int t, unsigned int first, unsigned int last)
+	{
+		double mi = data(first);
+		double ma = mi;
+		for (unsigned int k = first+1; k < last; ++k)
+		{
+			double val = data(k);
+			if (val < mi)
+				mi = val;
+			if (val > ma)
+				ma = val;
+		}
+		minmax[t] = std::make_pair(mi, ma);
+	});
+
+	unsigned int nbth = m_nbThreads < m_dataIdx.size() ? m_nbThreads : uint32(m_dataIdx.size());
+	if (nbth < 1)
+		nbth = 1;
+	m_qmin = minmax[0].first;
+	m_qmax = minmax[0].second;
+	for (unsigned int t = 1; t < nbth; ++t)
+	{
+		if (minmax[t].first < m_qmin)
+			m_qmin = minmax[t].first;
+		if (minmax[t].second > m_qmax)
+			m_qmax = minmax[t].second;
+	}
+}
+
+void Histogram::initDataDone()
+{
+	computeDataMinMax();
+	m_min = m_qmin;
+	m_max = m_qmax;
+
 	m_hcolmap.setMin(m_min);
 	m_hcolmap.setMax(m_max);
 }
 
+void Histogram::updateDataConvert(const AttributeConvertGen& conv, const std::vector<unsigned int>& changed)
+{
+	bool rescan = false;
+	for (std::vector<unsigned int>::const_iterator it = changed.begin(); it != changed.end(); ++it)
+	{
+		unsigned int p = m_dataPos[*it];
+		double old = m_dataIdx[p].first;
+		rescan |= (old == m_qmin) || (old == m_qmax);
+		updateValue(p, conv[*it]);
+	}
+	updateDataDone(rescan);
+}
+
+void Histogram::updateValue(unsigned int p, double val)
+{
+	if (!m_populations.empty())
+	{
+		unsigned int c = whichClass(m_dataIdx[p].first);
+		if (c != 0xffffffff)
+			m_populations[c]--;
+		c = whichClass(val);
+		if (c != 0xffffffff)
+			m_populations[c]++;
+	}
+
+	m_dataIdx[p].first = val;
+	if (val < m_qmin)
+		m_qmin = val;
+	if (val > m_qmax)
+		m_qmax = val;
+}
+
+void Histogram::updateDataDone(bool rescanMinMax)
+{
+	// an old extremum may have been replaced by an inner value
+	if (rescanMinMax)
+		computeDataMinMax();
+
+	m_maxBar = 0;
+	for (unsigned int i = 0; i < m_populations.size(); ++i)
+	{
+		if (m_populations[i] > m_maxBar)
+			m_maxBar = m_populations[i];
+	}
+
+	if (!m_pop_quantiles.empty())
+		populateQuantiles(uint32(m_pop_quantiles.size()));
+}
+
 void Histogram::populateHisto(unsigned int nbclasses)
 {
 	//compute nb classes if necesary
@@ -76,12 +176,24 @@ void Histogram::populateHisto(unsigned int nbclasses)
 	for (unsigned int i = 0; i<m_nbclasses; ++i)
 		m_populations[i] = 0;
 
-	// traverse attribute to populate
-	for (std::vector<std::pair<double,unsigned int> >::const_iterator it = m_dataIdx.begin(); it != m_dataIdx.end(); ++it)
+	// traverse attribute to populate (one population vector per thread, summed after)
+	unsigned int nbth = m_nbThreads > 0 ? m_nbThreads : 1;
+	std::vector< std::vector<unsigned int> > pops(nbth);
+	parallelRanges(uint32(m_dataIdx.size()), [&] (unsigned int t, unsigned int first, unsigned int last)
 	{
-		unsigned int c = whichClass(it->first);
-		if (c != 0xffffffff)
-			m_populations[c]++;
+		std::vector<unsigned int>& pop = pops[t];
+		pop.assign(m_nbclasses, 0);
+		for (unsigned int k = first; k < last; ++k)
+		{
+			unsigned int c = whichClass(data(k));
+			if (c != 0xffffffff)
+				pop[c]++;
+		}
+	});
+	for (unsigned int t = 0; t < nbth; ++t)
+	{
+		for (unsigned int i = 0; i < pops[t].size(); ++i)
+			m_populations[i] += pops[t][i];
 	}
     m_maxBar = 0;
     for (unsigned int i = 0; i<m_nbclasses; ++i)
@@ -96,14 +208,30 @@ void Histogram::populateHisto(unsigned int nbclasses)
 
 }
 
-void Histogram::populateQuantiles(unsigned int nbquantiles)
+void Histogram::multiSelect(std::vector<double>& v, unsigned int b, unsigned int e, const unsigned int* kb, const unsigned int* ke, unsigned int nbth)
 {
-	if (!m_sorted)
+	if (kb == ke)
+		return;
+
+	const unsigned int* km = kb + (ke - kb) / 2;
+	std::nth_element(v.begin()+b, v.begin()+*km, v.begin()+e);
+
+	// keys of left side are in [b,*km[, keys of right side in ]*km,e[
+	if (nbth > 1)
+	{
+		std::thread left(multiSelect, std::ref(v), b, *km, kb, km, nbth/2);
+		multiSelect(v, *km+1, e, km+1, ke, nbth - nbth/2);
+		left.join();
+	}
+	else
 	{
-		std::sort(m_dataIdx.begin(),m_dataIdx.end(),dataComp);
-		m_sorted = true;
+		multiSelect(v, b, *km, kb, km, 1);
+		multiSelect(v, *km+1, e, km+1, ke, 1);
 	}
+}
 
+void Histogram::populateQuantiles(unsigned int nbquantiles)
+{
 	// compute exact populations
 	size_t nb = m_dataIdx.size();
 	double pop = double(nb)/nbquantiles;
@@ -112,20 +240,46 @@ void Histogram::populateQuantiles(unsigned int nbquantiles)
 	for (unsigned int i = 0; i < nbquantiles; ++i)
 		m_pop_quantiles[i]=pop;
 
+	// ranks of the values needed for the boundaries
+	std::vector<uint32> icums(nbquantiles);
+	std::vector<unsigned int> keys;
+	keys.reserve(2*nbquantiles);
+	double cumul = 0.0;
+	for (unsigned int i = 0; i < nbquantiles; ++i)
+	{
+		cumul += m_pop_quantiles[i];
+		icums[i] = uint32(floor(cumul));
+		if (icums[i]+1 < nb)
+		{
+			keys.push_back(icums[i]);
+			keys.push_back(icums[i]+1);
+		}
+	}
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+	// select these ranks in a copy of the values instead of sorting data
+	std::vector<double> values(nb);
+	parallelRanges(uint32(nb), [&] (unsigned int, unsigned int first, unsigned int last)
+	{
+		for (unsigned int k = first; k < last; ++k)
+			values[k] = data(k);
+	});
+	if (!keys.empty())
+		multiSelect(values, 0, uint32(nb), &keys[0], &keys[0] + keys.size(), m_nbThreads);
+
 	m_interv.clear();
 	m_interv.reserve(nbquantiles+1);
 	// quantiles computation
-	m_interv.push_back(m_dataIdx.front().first);
-	double cumul = 0.0;
+	m_interv.push_back(m_qmin);
 	for (unsigned int i = 0; i < nbquantiles; ++i)
 	{
-		cumul += m_pop_quantiles[i];
-		uint32 icum = uint32(floor(cumul));
+		uint32 icum = icums[i];
 		double val = 0.0;
-		if (icum < uint32(m_dataIdx.size()-1))
-			val = (data(icum)+ data(icum+1)) / 2.0;
+		if (icum+1 < nb)
+			val = (values[icum]+ values[icum+1]) / 2.0;
 		else
-			val = m_dataIdx.back().first;
+			val = m_qmax;
 		m_interv.push_back(val);
 	}
 	quantilesAreaCorrection();
@@ -162,38 +316,52 @@ void Histogram::histoColorizeVBO(Utils::VBO& vbo)
 	vbo.setDataSize(3);
 	vbo.allocate(nb);
 	Geom::Vec3f* colors = static_cast<Geom::Vec3f*>(vbo.lockPtr());
-	for (unsigned int i = 0; i<nb; ++i)
+	parallelRanges(nb, [&] (unsigned int, unsigned int first, unsigned int last)
 	{
-		unsigned int j = idx(i);
-		unsigned int c = whichClass(data(i));
-		if (c != 0xffffffff)
-			colors[j] = m_hcolmap.colorIndex(c);
-	}
+		for (unsigned int i = first; i < last; ++i)
+		{
+			unsigned int c = whichClass(data(i));
+			if (c != 0xffffffff)
+				colors[idx(i)] = m_hcolmap.colorIndex(c);
+		}
+	});
 	vbo.releasePtr();
 }
 
-
-unsigned int Histogram::cellsOfHistogramColumn(unsigned int c, std::vector<unsigned int>& vc) const
+void Histogram::quantilesColorizeVBO(Utils::VBO& vbo, const std::vector<Geom::Vec3f>& tc)
 {
-	if (!m_sorted)
+	assert(tc.size() >= m_interv.size() - 1);
+
+	unsigned int nb = uint32(m_dataIdx.size());
+	vbo.setDataSize(3);
+	vbo.allocate(nb);
+	Geom::Vec3f* colors = static_cast<Geom::Vec3f*>(vbo.lockPtr());
+	parallelRanges(nb, [&] (unsigned int, unsigned int first, unsigned int last)
 	{
-		std::sort(m_dataIdx.begin(),m_dataIdx.end(),dataComp);
-		m_sorted = true;
-	}
+		for (unsigned int i = first; i < last; ++i)
+		{
+			unsigned int c = whichQuantille(data(i));
+			if (c != 0xffffffff)
+				colors[idx(i)] = tc[c];
+		}
+	});
+	vbo.releasePtr();
+}
+
 
+unsigned int Histogram::cellsOfHistogramColumn(unsigned int c, std::vector<unsigned int>& vc) const
+{
 	vc.clear();
 
 	double bi = (m_max-m_min)/m_nbclasses * c + m_min;
 	double bs = (m_max-m_min)/m_nbclasses * (c+1) + m_min;
 
 	unsigned int nb = uint32(m_dataIdx.size());
-	unsigned int i=0;
-
-	while ((i<nb) && (data(i)< bi))
-		++i;
-
-	while ((i<nb) && (data(i)< bs))
-		vc.push_back(idx(i++));
+	for (unsigned int i = 0; i < nb; ++i)
+	{
+		if ((data(i) >= bi) && (data(i) < bs))
+			vc.push_back(idx(i));
+	}
 
 	return uint32(vc.size());
 }
@@ -206,13 +374,11 @@ unsigned int Histogram::cellsOfQuantilesColumn(unsigned int c, std::vector<unsig
 	double bs = m_interv[c+1];
 
 	unsigned int nb = uint32(m_dataIdx.size());
-	unsigned int i=0;
-
-	while ((i<nb) && (data(i)< bi))
-		++i;
-
-	while ((i<nb) && (data(i)< bs))
-		vc.push_back(idx(i++));
+	for (unsigned int i = 0; i < nb; ++i)
+	{
+		if ((data(i) >= bi) && (data(i) < bs))
+			vc.push_back(idx(i));
+	}
 
 	return uint32(vc.size());
 }
@@ -31,6 +31,7 @@
 
 #define CGoGN_CONTAINER_DLL_EXPORT 1
 #include "Container/attributeContainer.h"
+#include "Utils/instrumentation.h"
 
 namespace CGoGN
 {
@@ -226,6 +227,7 @@ namespace CGoGN
 
  void AttributeContainer::compact(std::vector<unsigned int>& mapOldNew)
 {
+	CGoGN_SCOPED_TIMER("AttributeContainer::compact");
 	mapOldNew.clear();
 	mapOldNew.resize(realEnd(),0xffffffff);
 
@@ -430,6 +432,9 @@ namespace CGoGN
 
 		--m_size;
 
+		CGoGN_COUNT("AttributeContainer::removeLine");
+		CGoGN_GAUGE("AttributeContainer::removeLine/fill_ratio", fragmentation());
+
 		if (block->empty())		// block is empty after removal
 			m_tableBlocksEmpty.push_back(bi);
 	}
@@ -50,8 +50,9 @@ std::map<std::string, RegisteredBaseAttribute*>* GenericMap::m_attributes_regist
 std::vector<GenericMap*>*  GenericMap::s_instances = NULL;
 
 GenericMap::GenericMap():
-	m_nextMarkerId(0),
 	m_authorizeExternalThreads(false),
+	m_nextMarkerId(0),
+	m_attributesStamp(0),
 	m_manipulator(NULL)
 {
 	if(m_attributes_registry_map == NULL)
@@ -229,6 +230,7 @@ void GenericMap::init(bool addBoundaryMarkers)
 	for(std::multimap<AttributeMultiVectorGen*, AttributeHandlerGen*>::iterator it = attributeHandlers.begin(); it != attributeHandlers.end(); ++it)
 		(*it).second->setInvalid() ;
 	attributeHandlers.clear() ;
+	++m_attributesStamp ;
 }
 
 void GenericMap::clear(bool removeAttrib)
@@ -422,6 +424,7 @@ void GenericMap::restore_shortcuts()
 	for(std::multimap<AttributeMultiVectorGen*, AttributeHandlerGen*>::iterator it = attributeHandlers.begin(); it != attributeHandlers.end(); ++it)
 		(*it).second->setInvalid() ;
 	attributeHandlers.clear() ;
+	++m_attributesStamp ;
 }
 
 void GenericMap::dumpAttributesAndMarkers()
@@ -467,6 +470,7 @@ void GenericMap::dumpAttributesAndMarkers()
 
 void GenericMap::compact(bool topoOnly)
 {
+	CGoGN_SCOPED_TIMER("GenericMap::compact");
 	compactTopo();
 
 	if (topoOnly)
@@ -584,6 +588,8 @@ void GenericMap::moveData(GenericMap &mapf)
 	for(auto it = mapf.attributeHandlers.begin(); it != mapf.attributeHandlers.end(); ++it)
 	   (*it).second->setInvalid() ;
 	mapf.attributeHandlers.clear() ;
+	++m_attributesStamp ;
+	++mapf.m_attributesStamp ;
 }
 
 void GenericMap::garbageMarkVectors()
@@ -0,0 +1,247 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Utils/benchmark.h"
+#include "Utils/cgognStream.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+namespace CGoGN
+{
+namespace Utils
+{
+
+const void* volatile benchmarkSink = NULL;
+
+double BenchmarkResult::percentile(const std::vector<double>& sorted, double p)
+{
+	if (sorted.empty())
+		return 0.0;
+	double pos = p * double(sorted.size() - 1);
+	unsigned int i = (unsigned int)(pos);
+	if (i + 1 >= sorted.size())
+		return sorted.back();
+	double t = pos - double(i);
+	return sorted[i] * (1.0 - t) + sorted[i+1] * t;
+}
+
+void BenchmarkResult::computeStatistics()
+{
+	std::vector<double> sorted(samples);
+	std::sort(sorted.begin(), sorted.end());
+
+	min = sorted.empty() ? 0.0 : sorted.front();
+	max = sorted.empty() ? 0.0 : sorted.back();
+	median = percentile(sorted, 0.5);
+	p10 = percentile(sorted, 0.1);
+	p90 = percentile(sorted, 0.9);
+
+	mean = 0.0;
+	for (unsigned int i = 0; i < sorted.size(); ++i)
+		mean += sorted[i];
+	if (!sorted.empty())
+		mean /= double(sorted.size());
+
+	stddev = 0.0;
+	for (unsigned int i = 0; i < sorted.size(); ++i)
+		stddev += (sorted[i] - mean) * (sorted[i] - mean);
+	if (sorted.size() > 1)
+		stddev = std::sqrt(stddev / double(sorted.size() - 1));
+}
+
+Benchmark::Benchmark(const std::string& suite, unsigned int nbRuns, unsigned int nbWarmup):
+	m_suite(suite),
+	m_nbRuns(nbRuns > 0 ? nbRuns : 1),
+	m_nbWarmup(nbWarmup)
+{}
+
+bool Benchmark::isSelected(const std::string& name) const
+{
+	return m_filter.empty() || name.find(m_filter) != std::string::npos;
+}
+
+void Benchmark::addResult(const std::string& name, unsigned int size, const std::vector<double>& samples)
+{
+	BenchmarkResult r;
+	r.name = name;
+	r.size = size;
+	r.samples = samples;
+	r.computeStatistics();
+	m_results.push_back(r);
+
+	// formatted in a local stream: the flags of CGoGNout are left untouched
+	std::ostringstream line;
+	line << std::left << std::setw(40) << name << std::right
+		 << " size " << std::setw(6) << size
+		 << "  median " << std::setw(10) << std::fixed << std::setprecision(3) << r.median * 1e-6 << " ms"
+		 << "  [p10 " << r.p10 * 1e-6 << ", p90 " << r.p90 * 1e-6 << "]";
+	CGoGNout << line.str() << CGoGNendl;
+}
+
+void Benchmark::printSummary() const
+{
+	CGoGNout << "benchmark suite " << m_suite << " (" << m_nbRuns << " runs, " << m_nbWarmup << " warm-up)" << CGoGNendl;
+	for (unsigned int i = 0; i < m_results.size(); ++i)
+	{
+		const BenchmarkResult& r = m_results[i];
+		std::ostringstream line;
+		line << std::left << std::setw(40) << r.name << std::right
+			 << " size " << std::setw(6) << r.size
+			 << "  median " << std::setw(10) << std::fixed << std::setprecision(3) << r.median * 1e-6 << " ms"
+			 << "  [p10 " << r.p10 * 1e-6 << ", p90 " << r.p90 * 1e-6 << "]"
+			 << "  stddev " << r.stddev * 1e-6;
+		CGoGNout << line.str() << CGoGNendl;
+	}
+}
+
+namespace
+{
+
+std::string jsonString(const std::string& s)
+{
+	std::string res("\"");
+	for (unsigned int i = 0; i < s.size(); ++i)
+	{
+		if (s[i] == '"' || s[i] == '\\')
+			res += '\\';
+		res += s[i];
+	}
+	res += '"';
+	return res;
+}
+
+}
+
+bool Benchmark::saveJSON(const std::string& filename) const
+{
+	std::ofstream out(filename.c_str());
+	if (!out.good())
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl;
+		return false;
+	}
+
+	out << std::setprecision(15);
+	out << "{" << std::endl;
+	out << "\t\"suite\": " << jsonString(m_suite) << "," << std::endl;
+	out << "\t\"runs\": " << m_nbRuns << "," << std::endl;
+	out << "\t\"warmup\": " << m_nbWarmup << "," << std::endl;
+	out << "\t\"unit\": \"ns\"," << std::endl;
+	out << "\t\"benchmarks\": [" << std::endl;
+	for (unsigned int i = 0; i < m_results.size(); ++i)
+	{
+		const BenchmarkResult& r = m_results[i];
+		out << "\t\t{ \"name\": " << jsonString(r.name) << ", \"size\": " << r.size
+			<< ", \"min\": " << r.min << ", \"median\": " << r.median << ", \"mean\": " << r.mean
+			<< ", \"p10\": " << r.p10 << ", \"p90\": " << r.p90 << ", \"max\": " << r.max
+			<< ", \"stddev\": " << r.stddev << ", \"samples\": [";
+		for (unsigned int j = 0; j < r.samples.size(); ++j)
+			out << (j > 0 ? ", " : "") << r.samples[j];
+		out << "] }" << (i + 1 < m_results.size() ? "," : "") << std::endl;
+	}
+	out << "\t]" << std::endl;
+	out << "}" << std::endl;
+
+	return out.good();
+}
+
+bool Benchmark::saveCSV(const std::string& filename) const
+{
+	std::ofstream out(filename.c_str());
+	if (!out.good())
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl;
+		return false;
+	}
+
+	out << std::setprecision(15);
+	out << "suite,name,size,runs,min_ns,median_ns,mean_ns,p10_ns,p90_ns,max_ns,stddev_ns" << std::endl;
+	for (unsigned int i = 0; i < m_results.size(); ++i)
+	{
+		const BenchmarkResult& r = m_results[i];
+		out << m_suite << "," << r.name << "," << r.size << "," << r.samples.size() << ","
+			<< r.min << "," << r.median << "," << r.mean << "," << r.p10 << "," << r.p90 << ","
+			<< r.max << "," << r.stddev << std::endl;
+	}
+
+	return out.good();
+}
+
+unsigned int Benchmark::compare(const std::string& baselineCSV, double tolerance) const
+{
+	std::ifstream in(baselineCSV.c_str());
+	if (!in.good())
+	{
+		CGoGNerr << "Unable to open file " << baselineCSV << CGoGNendl;
+		return 0;
+	}
+
+	// baseline medians by name and size
+	std::map<std::pair<std::string, unsigned int>, double> baseline;
+	std::string line;
+	std::getline(in, line); // header
+	while (std::getline(in, line))
+	{
+		std::vector<std::string> fields;
+		std::stringstream ss(line);
+		std::string f;
+		while (std::getline(ss, f, ','))
+			fields.push_back(f);
+		if (fields.size() < 6)
+			continue;
+		baseline[std::make_pair(fields[1], (unsigned int)(atoi(fields[2].c_str())))] = atof(fields[5].c_str());
+	}
+
+	CGoGNout << "comparison with " << baselineCSV << " (tolerance " << tolerance * 100.0 << "%)" << CGoGNendl;
+	unsigned int nbRegressions = 0;
+	for (unsigned int i = 0; i < m_results.size(); ++i)
+	{
+		const BenchmarkResult& r = m_results[i];
+		std::map<std::pair<std::string, unsigned int>, double>::const_iterator it = baseline.find(std::make_pair(r.name, r.size));
+		if (it == baseline.end() || it->second <= 0.0)
+			continue;
+
+		double ratio = r.median / it->second;
+		bool regression = ratio > 1.0 + tolerance;
+		if (regression)
+			++nbRegressions;
+		std::ostringstream line;
+		line << std::left << std::setw(40) << r.name << std::right
+			 << " size " << std::setw(6) << r.size
+			 << "  " << std::fixed << std::setprecision(3) << it->second * 1e-6 << " ms -> " << r.median * 1e-6 << " ms"
+			 << "  x" << std::setprecision(2) << ratio << (regression ? "  REGRESSION" : "");
+		CGoGNout << line.str() << CGoGNendl;
+	}
+
+	return nbRegressions;
+}
+
+}
+}
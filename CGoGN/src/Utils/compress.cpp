@@ -26,8 +26,8 @@
 #include "Utils/compress.h"
 #include "zlib.h"
 
-#include <iostream>
 #include <vector>
+#include <thread>
 #include <string.h>
 #include <algorithm>
 
@@ -37,72 +37,75 @@ namespace CGoGN
 namespace Utils
 {
 
-void zlibVTUWriteCompressed( unsigned char* input, unsigned int nbBytes, std::ofstream& fout)
+unsigned int zlibVTUCompress(const unsigned char* input, unsigned int nbBytes, std::vector<unsigned char>& output,
+	unsigned int blockSize, int level, unsigned int nbThreads)
 {
+	assert(blockSize > 0);
 
-	std::cout << "Compressor Block " << std::endl;
+	unsigned int nbBlocks = (nbBytes + blockSize - 1) / blockSize;
+	unsigned int lastBlock = nbBytes % blockSize;
 
-	const int CHUNK=1024*256;
-	int level = 6; // compression level 
+	// compress each block in its own buffer
+	std::vector< std::vector<unsigned char> > blocks(nbBlocks);
+	std::vector<unsigned int> header(3 + nbBlocks);
+	header[0] = nbBlocks;
+	header[1] = blockSize;
+	header[2] = lastBlock;
 
-	z_stream strm;
-	strm.zalloc = Z_NULL;
-	strm.zfree = Z_NULL;
-	strm.opaque = Z_NULL;
-	int ret = deflateInit(&strm, level);
-	assert(ret == Z_OK); 
-	if (ret != Z_OK)
-		return;
-
-	unsigned char* bufferOut = new unsigned char[nbBytes];
-	unsigned char* ptrBufferOut = bufferOut;
-
-	std::vector<unsigned int> header;
-	header.reserve(1024);
-	header.resize(3);
-
-	unsigned char* ptrData = input;
-	int remain = nbBytes;
-
-	while (remain >0)
+	auto compressRange = [&] (unsigned int first, unsigned int last)
 	{
-		strm.avail_in = std::min(remain,CHUNK);	// taille buffer
-		strm.next_in = ptrData;					// ptr buffer
-		do
+		for (unsigned int b = first; b < last; ++b)
 		{
-			strm.avail_out = CHUNK;
-			strm.next_out = ptrBufferOut;
-			if (remain>= CHUNK)
-				ret = deflate(&strm, 0);
-			else
-				ret = deflate(&strm, 1);
-			assert(ret != Z_STREAM_ERROR); 
-			unsigned int have = CHUNK - strm.avail_out;
-			ptrBufferOut+=have;
-			header.push_back(have);
-		} while (strm.avail_out == 0);
-
-		remain -= CHUNK;
-		ptrData += CHUNK;	
+			unsigned int size = (b == nbBlocks-1 && lastBlock != 0) ? lastBlock : blockSize;
+			uLongf dstSize = compressBound(size);
+			blocks[b].resize(dstSize);
+			int ret = compress2(&(blocks[b][0]), &dstSize, input + (unsigned long long)(b) * blockSize, size, level);
+			assert(ret == Z_OK);
+			(void)ret;
+			blocks[b].resize(dstSize);
+			header[3 + b] = (unsigned int)(dstSize);
+		}
+	};
+
+	unsigned int nbth = nbThreads > 0 ? nbThreads : std::thread::hardware_concurrency();
+	if (nbth > nbBlocks)
+		nbth = nbBlocks;
+	if (nbth <= 1)
+		compressRange(0, nbBlocks);
+	else
+	{
+		std::vector<std::thread> threads;
+		threads.reserve(nbth);
+		for (unsigned int t = 0; t < nbth; ++t)
+			threads.push_back(std::thread(compressRange, (unsigned long long)(nbBlocks) * t / nbth, (unsigned long long)(nbBlocks) * (t+1) / nbth));
+		for (unsigned int t = 0; t < nbth; ++t)
+			threads[t].join();
 	}
-	deflateEnd(&strm);
 
-	header[0] = (unsigned int)(header.size()-3);
-	header[1] = CHUNK;
-	if (remain != 0)
-		header[2] = remain +CHUNK;
-	else header[2] = 0;
+	// header then blocks in order
+	std::size_t total = header.size() * sizeof(unsigned int);
+	for (unsigned int b = 0; b < nbBlocks; ++b)
+		total += blocks[b].size();
 
-	std::cout << "HEADER "<< std::endl;
-	for (unsigned int i=0; i<header.size(); ++i)
-		std::cout << header[i]<< std::endl;
-
-	fout.write((char*)&header[0], header.size()*sizeof(unsigned int));
-	fout.write((char*)bufferOut, ptrBufferOut - bufferOut);
+	output.resize(total);
+	unsigned char* ptr = &output[0];
+	memcpy(ptr, &header[0], header.size() * sizeof(unsigned int));
+	ptr += header.size() * sizeof(unsigned int);
+	for (unsigned int b = 0; b < nbBlocks; ++b)
+	{
+		if (!blocks[b].empty())
+			memcpy(ptr, &(blocks[b][0]), blocks[b].size());
+		ptr += blocks[b].size();
+	}
 
-	std::cout << "DATA "<<  ptrBufferOut - bufferOut << "bytes writen"<< std::endl;
+	return (unsigned int)(total);
+}
 
-	delete[] bufferOut;
+void zlibVTUWriteCompressed( unsigned char* input, unsigned int nbBytes, std::ofstream& fout, unsigned int nbThreads)
+{
+	std::vector<unsigned char> buffer;
+	unsigned int size = zlibVTUCompress(input, nbBytes, buffer, 1024*256, 6, nbThreads);
+	fout.write((char*)&buffer[0], size);
 }
 
 
@@ -0,0 +1,365 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Utils/instrumentation.h"
+#include "Utils/cgognStream.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace CGoGN
+{
+namespace Utils
+{
+namespace Instrumentation
+{
+
+namespace
+{
+
+struct TraceEvent
+{
+	const Timer* timer;
+	unsigned long long startNs;
+	unsigned long long durNs;
+};
+
+// events are appended by their thread only, the mutex protects them against reset / saveChromeTrace
+struct ThreadTrace
+{
+	unsigned int tid;
+	std::mutex mutex;
+	std::vector<TraceEvent> events;
+};
+
+// registries are never destroyed : instruments may be used until the very end of the program
+std::mutex& registryMutex()
+{
+	static std::mutex* m = new std::mutex;
+	return *m;
+}
+
+std::map<std::string, Counter*>& counters()
+{
+	static std::map<std::string, Counter*>* m = new std::map<std::string, Counter*>;
+	return *m;
+}
+
+std::map<std::string, Gauge*>& gauges()
+{
+	static std::map<std::string, Gauge*>* m = new std::map<std::string, Gauge*>;
+	return *m;
+}
+
+std::map<std::string, Timer*>& timers()
+{
+	static std::map<std::string, Timer*>* m = new std::map<std::string, Timer*>;
+	return *m;
+}
+
+std::vector<ThreadTrace*>& threadTraces()
+{
+	static std::vector<ThreadTrace*>* v = new std::vector<ThreadTrace*>;
+	return *v;
+}
+
+std::atomic<bool> s_tracing(false);
+
+const std::chrono::steady_clock::time_point s_origin = std::chrono::steady_clock::now();
+
+ThreadTrace& currentThreadTrace()
+{
+	static thread_local ThreadTrace* t = NULL;
+	if (t == NULL)
+	{
+		std::lock_guard<std::mutex> lock(registryMutex());
+		t = new ThreadTrace;
+		t->tid = (unsigned int)(threadTraces().size());
+		threadTraces().push_back(t);
+	}
+	return *t;
+}
+
+template <typename T>
+T& getInstrument(std::map<std::string, T*>& registry, const char* name)
+{
+	std::lock_guard<std::mutex> lock(registryMutex());
+	T*& inst = registry[name];
+	if (inst == NULL)
+		inst = new T(name);
+	return *inst;
+}
+
+void atomicAdd(std::atomic<double>& a, double v)
+{
+	double old = a.load(std::memory_order_relaxed);
+	while (!a.compare_exchange_weak(old, old + v, std::memory_order_relaxed)) {}
+}
+
+template <typename T>
+void atomicMin(std::atomic<T>& a, T v)
+{
+	T old = a.load(std::memory_order_relaxed);
+	while (v < old && !a.compare_exchange_weak(old, v, std::memory_order_relaxed)) {}
+}
+
+template <typename T>
+void atomicMax(std::atomic<T>& a, T v)
+{
+	T old = a.load(std::memory_order_relaxed);
+	while (v > old && !a.compare_exchange_weak(old, v, std::memory_order_relaxed)) {}
+}
+
+std::string jsonString(const std::string& s)
+{
+	std::string res("\"");
+	for (unsigned int i = 0; i < s.size(); ++i)
+	{
+		if (s[i] == '"' || s[i] == '\\')
+			res += '\\';
+		res += s[i];
+	}
+	res += '"';
+	return res;
+}
+
+}
+
+Counter::Counter(const std::string& name):
+	m_name(name),
+	m_count(0)
+{}
+
+Gauge::Gauge(const std::string& name):
+	m_name(name)
+{
+	reset();
+}
+
+void Gauge::record(double v)
+{
+	m_count.fetch_add(1, std::memory_order_relaxed);
+	atomicAdd(m_sum, v);
+	atomicMin(m_min, v);
+	atomicMax(m_max, v);
+	m_last.store(v, std::memory_order_relaxed);
+}
+
+double Gauge::mean() const
+{
+	unsigned long long n = count();
+	return n > 0 ? m_sum.load(std::memory_order_relaxed) / double(n) : 0.0;
+}
+
+void Gauge::reset()
+{
+	m_count.store(0, std::memory_order_relaxed);
+	m_sum.store(0.0, std::memory_order_relaxed);
+	m_min.store(std::numeric_limits<double>::max(), std::memory_order_relaxed);
+	m_max.store(-std::numeric_limits<double>::max(), std::memory_order_relaxed);
+	m_last.store(0.0, std::memory_order_relaxed);
+}
+
+Timer::Timer(const std::string& name):
+	m_name(name),
+	m_count(0),
+	m_totalNs(0),
+	m_maxNs(0)
+{}
+
+void Timer::record(std::chrono::steady_clock::time_point start, unsigned long long durNs)
+{
+	m_count.fetch_add(1, std::memory_order_relaxed);
+	m_totalNs.fetch_add(durNs, std::memory_order_relaxed);
+	atomicMax(m_maxNs, durNs);
+
+	if (s_tracing.load(std::memory_order_relaxed))
+	{
+		TraceEvent e;
+		e.timer = this;
+		e.startNs = (unsigned long long)(std::chrono::duration_cast<std::chrono::nanoseconds>(start - s_origin).count());
+		e.durNs = durNs;
+		ThreadTrace& tt = currentThreadTrace();
+		std::lock_guard<std::mutex> lock(tt.mutex);
+		tt.events.push_back(e);
+	}
+}
+
+void Timer::reset()
+{
+	m_count.store(0, std::memory_order_relaxed);
+	m_totalNs.store(0, std::memory_order_relaxed);
+	m_maxNs.store(0, std::memory_order_relaxed);
+}
+
+Counter& counter(const char* name)
+{
+	return getInstrument(counters(), name);
+}
+
+Gauge& gauge(const char* name)
+{
+	return getInstrument(gauges(), name);
+}
+
+Timer& timer(const char* name)
+{
+	return getInstrument(timers(), name);
+}
+
+void setTracing(bool b)
+{
+	s_tracing.store(b);
+}
+
+bool isTracing()
+{
+	return s_tracing.load();
+}
+
+void dump(std::ostream& out)
+{
+	std::lock_guard<std::mutex> lock(registryMutex());
+
+#ifndef CGOGN_INSTRUMENTATION
+	out << "(CGoGN compiled without instrumentation: only user instruments are reported)" << std::endl;
+#endif
+
+	// name column wide enough for the longest instrument name
+	std::size_t w = 40;
+	for (std::map<std::string, Counter*>::const_iterator it = counters().begin(); it != counters().end(); ++it)
+		w = std::max(w, it->first.size());
+	for (std::map<std::string, Gauge*>::const_iterator it = gauges().begin(); it != gauges().end(); ++it)
+		w = std::max(w, it->first.size());
+	for (std::map<std::string, Timer*>::const_iterator it = timers().begin(); it != timers().end(); ++it)
+		w = std::max(w, it->first.size());
+	const int nw = int(w);
+
+	out << "counters:" << std::endl;
+	for (std::map<std::string, Counter*>::const_iterator it = counters().begin(); it != counters().end(); ++it)
+		out << "  " << std::left << std::setw(nw) << it->first << std::right << " " << it->second->value() << std::endl;
+
+	out << std::left << std::setw(nw + 3) << "gauges:" << std::right << "   count        mean         min         max        last" << std::endl;
+	for (std::map<std::string, Gauge*>::const_iterator it = gauges().begin(); it != gauges().end(); ++it)
+	{
+		const Gauge& g = *(it->second);
+		out << "  " << std::left << std::setw(nw) << it->first << std::right << " " << std::setw(8) << g.count();
+		if (g.count() > 0)
+			out << " " << std::setw(11) << g.mean() << " " << std::setw(11) << g.min() << " " << std::setw(11) << g.max() << " " << std::setw(11) << g.last();
+		out << std::endl;
+	}
+
+	out << std::left << std::setw(nw + 3) << "timers:" << std::right << "   calls    total ms     mean us      max us" << std::endl;
+	for (std::map<std::string, Timer*>::const_iterator it = timers().begin(); it != timers().end(); ++it)
+	{
+		const Timer& t = *(it->second);
+		out << "  " << std::left << std::setw(nw) << it->first << std::right << " " << std::setw(8) << t.count()
+			<< std::fixed << std::setprecision(3)
+			<< " " << std::setw(11) << double(t.totalNs()) * 1e-6
+			<< " " << std::setw(11) << (t.count() > 0 ? double(t.totalNs()) * 1e-3 / double(t.count()) : 0.0)
+			<< " " << std::setw(11) << double(t.maxNs()) * 1e-3 << std::endl;
+		out.unsetf(std::ios::fixed);
+	}
+}
+
+void dump()
+{
+	std::stringstream ss;
+	dump(ss);
+	CGoGNout << ss.str() << CGoGNflush;
+}
+
+void reset()
+{
+	std::lock_guard<std::mutex> lock(registryMutex());
+	for (std::map<std::string, Counter*>::iterator it = counters().begin(); it != counters().end(); ++it)
+		it->second->reset();
+	for (std::map<std::string, Gauge*>::iterator it = gauges().begin(); it != gauges().end(); ++it)
+		it->second->reset();
+	for (std::map<std::string, Timer*>::iterator it = timers().begin(); it != timers().end(); ++it)
+		it->second->reset();
+	for (unsigned int i = 0; i < threadTraces().size(); ++i)
+	{
+		ThreadTrace& tt = *(threadTraces()[i]);
+		std::lock_guard<std::mutex> ttLock(tt.mutex);
+		tt.events.clear();
+	}
+}
+
+bool saveChromeTrace(const std::string& filename)
+{
+	std::ofstream out(filename.c_str());
+	if (!out.good())
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl;
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(registryMutex());
+
+	out << std::fixed << std::setprecision(3);
+	out << "{\"traceEvents\":[" << std::endl;
+	bool first = true;
+	for (unsigned int i = 0; i < threadTraces().size(); ++i)
+	{
+		ThreadTrace& tt = *(threadTraces()[i]);
+		std::lock_guard<std::mutex> ttLock(tt.mutex);
+		for (unsigned int j = 0; j < tt.events.size(); ++j)
+		{
+			const TraceEvent& e = tt.events[j];
+			out << (first ? "" : ",\n") << "{\"name\":" << jsonString(e.timer->name()) << ",\"cat\":\"cgogn\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tt.tid
+				<< ",\"ts\":" << double(e.startNs) * 1e-3 << ",\"dur\":" << double(e.durNs) * 1e-3 << "}";
+			first = false;
+		}
+	}
+	out << std::endl << "]," << std::endl;
+
+	out << "\"displayTimeUnit\":\"ns\"," << std::endl;
+	out << "\"otherData\":{";
+	first = true;
+	for (std::map<std::string, Counter*>::const_iterator it = counters().begin(); it != counters().end(); ++it)
+	{
+		out << (first ? "" : ",") << std::endl << jsonString(it->first) << ":\"" << it->second->value() << "\"";
+		first = false;
+	}
+	for (std::map<std::string, Gauge*>::const_iterator it = gauges().begin(); it != gauges().end(); ++it)
+	{
+		out << (first ? "" : ",") << std::endl << jsonString(it->first) << ":\"mean " << it->second->mean() << " max " << it->second->max() << " last " << it->second->last() << "\"";
+		first = false;
+	}
+	out << std::endl << "}}" << std::endl;
+
+	return out.good();
+}
+
+} // namespace Instrumentation
+} // namespace Utils
+} // namespace CGoGN
@@ -34,7 +34,7 @@ namespace CGoGN
 namespace Utils
 {
 
-VBO::VBO(const std::string& name) : m_data_size(0), m_nbElts(0), m_lock(false), m_name(name)/*, m_conv(NULL)*/
+VBO::VBO(const std::string& name) : m_data_size(0), m_nbElts(0), m_lock(false), m_name(name), m_source(NULL), m_sourceEpoch(0)/*, m_conv(NULL)*/
 {
 	glGenBuffers(1, &(*m_id));
 	m_refs.reserve(4);
@@ -44,7 +44,9 @@ VBO::VBO(const std::string& name) : m_data_size(0), m_nbElts(0), m_lock(false),
 VBO::VBO(const VBO& vbo) :
 	m_data_size(vbo.m_data_size),
 	m_nbElts(vbo.m_nbElts),
-	m_lock(false)
+	m_lock(false),
+	m_source(NULL),
+	m_sourceEpoch(0)
 {
 	glGenBuffers(1, &(*m_id));
 
@@ -74,6 +76,7 @@ void VBO::sameAllocSameBufferSize(const VBO& vbo)
 {
 	m_data_size = vbo.m_data_size;
 	m_nbElts = vbo.m_nbElts;
+	m_source = NULL;
 	unsigned int nbbytes =  sizeof(float) * m_data_size * m_nbElts;
 	bind();
 	glBufferData(GL_ARRAY_BUFFER, nbbytes, NULL, GL_STREAM_DRAW);
@@ -120,31 +123,47 @@ void VBO::updateData(const AttributeMultiVectorGen* attrib)
 		return;
 	}
 
-	unsigned int old_nbb =  sizeof(float) * m_data_size * m_nbElts;
 	m_name = attrib->getName();
 	m_typeName = attrib->getTypeName();
-	m_data_size = attrib->getSizeOfType() / sizeof(float);
 
 	std::vector<void*> addr;
 	unsigned int byteTableSize;
 	unsigned int nbb = attrib->getBlocksPointers(addr, byteTableSize);
+	unsigned int sizeOfType = attrib->getSizeOfType();
 
+	// ranges of elements to send
+	std::vector< std::pair<unsigned int, unsigned int> > ranges;
 
 	glBindBuffer(GL_ARRAY_BUFFER, *m_id);
 
-	if (nbb!=old_nbb)
-		glBufferData(GL_ARRAY_BUFFER, nbb * byteTableSize, 0, GL_STREAM_DRAW);
-
-	m_nbElts = nbb * byteTableSize / attrib->getSizeOfType();
+	if (isSynchronizedWith(attrib, nbb * byteTableSize))
+		attrib->getDirtyRanges(ranges, _BLOCKSIZE_ / 16);
+	else
+	{
+		if (nbb * byteTableSize != sizeof(float) * m_data_size * m_nbElts)
+			glBufferData(GL_ARRAY_BUFFER, nbb * byteTableSize, 0, GL_STREAM_DRAW);
+		if (nbb > 0)
+			ranges.push_back(std::make_pair(0u, nbb * _BLOCKSIZE_));
+	}
 
-	unsigned int offset = 0;
+	m_data_size = sizeOfType / sizeof(float);
+	m_nbElts = nbb * byteTableSize / sizeOfType;
 
-	for (unsigned int i = 0; i < nbb; ++i)
+	for (unsigned int r = 0; r < ranges.size(); ++r)
 	{
-		glBufferSubData(GL_ARRAY_BUFFER, offset, byteTableSize, addr[i]);
-		offset += byteTableSize;
+		unsigned int i = ranges[r].first;
+		while (i < ranges[r].second)
+		{
+			// part of the range inside block i / _BLOCKSIZE_
+			unsigned int j = i % _BLOCKSIZE_;
+			unsigned int n = std::min(ranges[r].second - i, _BLOCKSIZE_ - j);
+			const char* src = reinterpret_cast<const char*>(addr[i / _BLOCKSIZE_]) + j * sizeOfType;
+			glBufferSubData(GL_ARRAY_BUFFER, i * sizeOfType, n * sizeOfType, src);
+			i += n;
+		}
 	}
 
+	setSynchronizedWith(attrib);
 }
 
 
@@ -157,6 +176,7 @@ void* VBO::lockPtr()
 	}
 
 	m_lock = true;
+	m_source = NULL;
 	glBindBuffer(GL_ARRAY_BUFFER, *m_id);
 	return glMapBuffer(GL_ARRAY_BUFFER, GL_READ_WRITE);
 }
@@ -190,6 +210,7 @@ void VBO::copyData(void *ptr) const
 void VBO::allocate(unsigned int nbElts)
 {
 	m_nbElts = nbElts;
+	m_source = NULL;
 
 	if (m_data_size ==0)
 	{
@@ -33,6 +33,17 @@ public:
 	 */
 	void Compute(double* outIntegral, double* outArea, CartesianFunction f, void* userDataFunction, CartesianDomain dom, void* userDataDomain) const;
 
+	/*
+	 *	Same as Compute, for a function already evaluated at the quadrature samples
+	 *	(e.g. a spherical harmonics batch evaluation on a basis computed once for the samples)
+	 *
+	 *	fValues: value of the function at each sample, in the order given by GetSamples
+	 */
+	void ComputeSampled(double* outIntegral, double* outArea, const double* fValues, CartesianDomain dom, void* userDataDomain) const;
+
+	unsigned int NbSamples() const { return rOrder; }				// Number of quadrature samples of the current rule
+	void GetSamples(const double*& x, const double*& y, const double*& z) const;	// Directions of the quadrature samples
+
 protected:
 	unsigned int rId;
 	unsigned int rOrder;
@@ -25,6 +25,13 @@ bool EdgeSelector_Radiance<PFP>::init()
 	m_nb_coefs = SH::get_nb_coefs();
 
 	m_integrator.Init(29) ;
+	const double* sx ;
+	const double* sy ;
+	const double* sz ;
+	m_integrator.GetSamples(sx, sy, sz) ;
+	SH::compute_basis(m_integrator.NbSamples(), sx, sy, sz, m_integratorBasis) ;
+	m_radianceValues.resize(m_integrator.NbSamples()) ;
+	m_errorValues.resize(m_integrator.NbSamples()) ;
 
 	// init QEM quadrics
 	for (Vertex v : allVerticesOf(m))
@@ -259,7 +266,7 @@ typename PFP::REAL EdgeSelector_Radiance<PFP>::computeRadianceError(Dart d, cons
 
 		double integral;
 		double area;
-		m_integrator.Compute(&integral, &area, EdgeSelector_Radiance<PFP>::SHEvalCartesian_Error, &diffRad, EdgeSelector_Radiance<PFP>::isInHemisphere, n0.data());
+		integrateRadianceError(diffRad, n0, integral, area);
 
 		error += tArea * integral / area;
 
@@ -290,7 +297,7 @@ typename PFP::REAL EdgeSelector_Radiance<PFP>::computeRadianceError(Dart d, cons
 
 		double integral;
 		double area;
-		m_integrator.Compute(&integral, &area, EdgeSelector_Radiance<PFP>::SHEvalCartesian_Error, &diffRad, EdgeSelector_Radiance<PFP>::isInHemisphere, n1.data());
+		integrateRadianceError(diffRad, n1, integral, area);
 
 		error += tArea * integral / area;
 
@@ -301,6 +308,16 @@ typename PFP::REAL EdgeSelector_Radiance<PFP>::computeRadianceError(Dart d, cons
 	return error;
 }
 
+template <typename PFP>
+void EdgeSelector_Radiance<PFP>::integrateRadianceError(const SH& r, VEC3& n, double& integral, double& area)
+{
+	r.evaluate_batch(m_integratorBasis, &m_radianceValues[0]) ;
+	for (unsigned int i = 0 ; i < m_radianceValues.size() ; ++i)
+		m_errorValues[i] = m_radianceValues[i].norm2() ;
+
+	m_integrator.ComputeSampled(&integral, &area, &m_errorValues[0], EdgeSelector_Radiance<PFP>::isInHemisphere, n.data()) ;
+}
+
 } // namespace SCHNApps
 
 } // namespace CGoGN
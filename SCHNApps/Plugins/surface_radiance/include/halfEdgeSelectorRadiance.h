@@ -46,6 +46,9 @@ private:
 	unsigned int m_nb_coefs;
 
 	SphericalFunctionIntegratorCartesian m_integrator;
+	Eigen::Matrix<REAL, Eigen::Dynamic, Eigen::Dynamic> m_integratorBasis; // SH basis evaluated at the integrator samples
+	std::vector<VEC3> m_radianceValues;
+	std::vector<double> m_errorValues;
 
 	std::multimap<float, Dart> halfEdges;
 	typename std::multimap<float, Dart>::iterator cur;
@@ -56,6 +59,8 @@ private:
 	void recomputeQuadric(const Dart d);
 
 	typename PFP::REAL computeRadianceError(Dart d);
+	// integral of the squared norm of r over the hemisphere of n (r evaluated in batch at the integrator samples)
+	void integrateRadianceError(const SH& r, VEC3& n, double& integral, double& area);
 
 	static bool isInHemisphere(double x, double y, double z, void* u)
 	{ // true iff [x,y,z] and u have the same direction
@@ -63,13 +68,6 @@ private:
 		return x*n[0] + y*n[1] + z*n[2] >= 0.0;
 	}
 
-	static double SHEvalCartesian_Error(double x, double y, double z, void* u)
-	{
-		SH& e = *(SH*)(u);
-		VEC3 c = e.evaluate_at(x, y, z, 0);
-		return c.norm2();
-	}
-
 public:
 	HalfEdgeSelector_Radiance(
 		MAP& m,
@@ -66,3 +66,38 @@ void SphericalFunctionIntegratorCartesian::Compute(double* outIntegral, double*
 	*outIntegral = intVal * 4.0 * M_PI;
 	*outArea = areaVal * 4.0 * M_PI;
 }
+
+void SphericalFunctionIntegratorCartesian::ComputeSampled(double* outIntegral, double* outArea, const double* fValues, CartesianDomain dom, void* userDataDomain) const
+{
+	double intVal = 0.0;
+	double areaVal = 0.0;
+
+	double* px = quadValues;
+	double* py = quadValues + rOrder;
+	double* pz = quadValues + 2 * rOrder;
+	double* pw = quadValues + 3 * rOrder;
+
+	for(unsigned i = 0 ; i < rOrder ; i++)
+	{
+		const double x = *px++;
+		const double y = *py++;
+		const double z = *pz++;
+		const double w = *pw++;
+
+		if(dom(x, y, z, userDataDomain))
+		{
+			intVal += w * fValues[i];
+			areaVal += w;
+		}
+	}
+
+	*outIntegral = intVal * 4.0 * M_PI;
+	*outArea = areaVal * 4.0 * M_PI;
+}
+
+void SphericalFunctionIntegratorCartesian::GetSamples(const double*& x, const double*& y, const double*& z) const
+{
+	x = quadValues;
+	y = quadValues + rOrder;
+	z = quadValues + 2 * rOrder;
+}
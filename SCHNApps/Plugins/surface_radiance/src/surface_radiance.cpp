@@ -662,6 +662,14 @@ void Surface_Radiance_Plugin::computeRadianceDistance(
 	SphericalFunctionIntegratorCartesian integrator;
 	integrator.Init(29);
 
+	// SH basis evaluated once at the integrator samples, shared by all the vertices
+	const double* sx;
+	const double* sy;
+	const double* sz;
+	integrator.GetSamples(sx, sy, sz);
+	Eigen::Matrix<PFP2::REAL, Eigen::Dynamic, Eigen::Dynamic> integratorBasis;
+	Utils::SphericalHarmonics<PFP2::REAL, PFP2::VEC3>::compute_basis(integrator.NbSamples(), sx, sy, sz, integratorBasis);
+
 	PFP2::MAP* map1 = mh1->getMap();
 	PFP2::MAP* map2 = mh2->getMap();
 
@@ -721,9 +729,15 @@ void Surface_Radiance_Plugin::computeRadianceDistance(
 		Utils::SphericalHarmonics<PFP2::REAL, PFP2::VEC3> diffRad(mapParams1.radiance[v]);
 		diffRad -= CPR;
 
+		std::vector<PFP2::VEC3> radValues(integrator.NbSamples());
+		std::vector<double> errValues(integrator.NbSamples());
+		diffRad.evaluate_batch(integratorBasis, &radValues[0]);
+		for (unsigned int i = 0; i < radValues.size(); ++i)
+			errValues[i] = radValues[i].norm2();
+
 		double integral;
 		double area;
-		integrator.Compute(&integral, &area, SHEvalCartesian_Error, &diffRad, isInHemisphere, N.data());
+		integrator.ComputeSampled(&integral, &area, &errValues[0], isInHemisphere, N.data());
 
 		PFP2::REAL radError = integral / area;
 
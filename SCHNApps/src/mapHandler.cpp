@@ -163,12 +163,20 @@ void MapHandlerGen::notifyAttributeModification(const AttributeHandlerGen& attr)
 {
 	QString nameAttr = QString::fromStdString(attr.name());
 
-	if (m_vbo.contains(nameAttr))
-		m_vbo[nameAttr]->updateData(attr);
-
 	if (m_bbVertexAttribute && m_bbVertexAttribute->getName() == attr.name())
 		updateBB();
 
+	// attributes with a VBO track their modifications: only the modified parts are sent.
+	// Writes through raw pointers are not tracked: if nothing is known to be modified,
+	// the whole attribute is sent
+	if (m_vbo.contains(nameAttr))
+	{
+		AttributeMultiVectorGen* amv = attr.getDataVectorGen();
+		if (!amv->isDirty())
+			amv->markAllDirty();
+		m_vbo[nameAttr]->updateData(attr);
+	}
+
 	DEBUG_EMIT("attributeModified");
 	emit(attributeModified(attr.getOrbit(), nameAttr));
 
@@ -271,6 +279,10 @@ Utils::VBO* MapHandlerGen::createVBO(const AttributeMultiVectorGen* attr)
 		Utils::VBO* vbo = getVBO(name);
 		if(!vbo)
 		{
+			// track modifications so that only modified blocks are sent on update
+			AttributeMultiVectorGen* amv = m_map->getAttributeVectorGen(VERTEX, attr->getName());
+			if (amv)
+				amv->setDirtyTracking(true);
 			vbo = new Utils::VBO(attr->getName());
 			vbo->updateData(attr);
 			m_vbo.insert(name, vbo);
@@ -328,6 +340,9 @@ void MapHandlerGen::deleteVBO(const QString& name)
 	if (m_vbo.contains(name))
 	{
 		Utils::VBO* vbo = m_vbo[name];
+		AttributeMultiVectorGen* amv = m_map->getAttributeVectorGen(VERTEX, name.toUtf8().constData());
+		if (amv)
+			amv->setDirtyTracking(false);
 		m_vbo.remove(name);
 		DEBUG_EMIT("vboRemoved");
 		emit(vboRemoved(vbo));